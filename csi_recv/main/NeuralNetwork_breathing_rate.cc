@@ -1,109 +1,133 @@
 #include "NeuralNetwork_breathing_rate.h"
-#include "model_data.h"  // 此文件中包含： const unsigned char br_model_tflite[] 和模型长度等定义
+#include "model_data.h"  // breathing_rate_model_tflite[] (浮点) 与 breathing_rate_model_int8_tflite[] (int8)
 #include "tensorflow/lite/schema/schema_generated.h"
-#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
-#include "tensorflow/lite/micro/tflite_bridge/micro_error_reporter.h"
-#include <stdlib.h>
-#include <stdio.h>
-
-#define ARENA_SIZE 20000
-
-NeuralNetwork::NeuralNetwork() {
-    // 使用 MicroErrorReporter 输出日志
-    error_reporter = new tflite::MicroErrorReporter();
-
-    // 从 model_data.h 中加载 TFLite 模型数据
-    model = tflite::GetModel(br_model_tflite);
+#include "tensorflow/lite/micro/micro_log.h"
+#include <math.h>
+#include <new>
+
+#if NN_MODEL_INT8
+#define NN_BUILTIN_MODEL breathing_rate_model_int8_tflite
+#else
+#define NN_BUILTIN_MODEL breathing_rate_model_tflite
+#endif
+
+NeuralNetwork::NeuralNetwork(const void* model_data, const float* feature_means, const float* feature_scales)
+    : model(tflite::GetModel(model_data)),
+      interpreter(model, resolver, tensor_arena, NN_ARENA_SIZE) {
     if (model->version() != TFLITE_SCHEMA_VERSION) {
-        error_reporter->Report("Model schema version %d not equal to supported version %d.",
-                                 model->version(), TFLITE_SCHEMA_VERSION);
+        MicroPrintf("Model schema version %d not equal to supported version %d.", model->version(),
+                    TFLITE_SCHEMA_VERSION);
         return;
     }
 
-    resolver = new tflite::MicroMutableOpResolver<10>();
-    resolver->AddFullyConnected();
-    resolver->AddMul();
-    resolver->AddAdd();
-    resolver->AddLogistic();
-    resolver->AddReshape();
-    resolver->AddQuantize();
-    resolver->AddDequantize();
-    resolver->AddSoftmax();
-    resolver->AddRelu();
-
-    tensor_arena = (uint8_t*)malloc(ARENA_SIZE);
-    if (!tensor_arena) {
-        error_reporter->Report("Failed to allocate tensor arena.");
+    // A loaded model that needs another operator fails here; check it first with
+    // nn_op_resolver_gen.py --check
+    if (nn_register_ops(resolver) != kTfLiteOk || interpreter.AllocateTensors() != kTfLiteOk) {
+        MicroPrintf("AllocateTensors() failed: operator not registered or arena of %d bytes too small", NN_ARENA_SIZE);
         return;
     }
-    error_reporter->Report("Allocated tensor arena of %d bytes.", ARENA_SIZE);
-
-    interpreter = new tflite::MicroInterpreter(model, *resolver, tensor_arena, ARENA_SIZE, error_reporter);
-    if (interpreter->AllocateTensors() != kTfLiteOk) {
-        error_reporter->Report("AllocateTensors() failed");
+    MicroPrintf("Tensor arena used: %d of %d bytes", (int)interpreter.arena_used_bytes(), NN_ARENA_SIZE);
+
+    TfLiteTensor* in = interpreter.input(0);
+    TfLiteTensor* out = interpreter.output(0);
+    bool int8 = in->type == kTfLiteInt8;
+    if ((in->type != kTfLiteFloat32 && !int8) || out->type != in->type ||
+        in->bytes != NN_FEATURE_SIZE * (int8 ? sizeof(int8_t) : sizeof(float))) {
+        MicroPrintf("Model must map %d float32 or int8 features to a rate", NN_FEATURE_SIZE);
         return;
     }
 
-    size_t used_bytes = interpreter->arena_used_bytes();
-    error_reporter->Report("Tensor arena used: %d bytes", used_bytes);
-
-    input = interpreter->input(0);
-    output = interpreter->output(0);
+    // int8: q = zero_point + (x - mean) / (scale * input scale), so one gain per feature
+    float input_scale = int8 ? in->params.scale : 1.0f;
+    for (int i = 0; i < NN_FEATURE_SIZE; i++) {
+        double unit = (double)feature_scales[i] * input_scale;
+        if (!(unit >= 1.0 / 256) || !isfinite(feature_means[i]) || fabs(feature_means[i]) >= 1e12) {
+            MicroPrintf("Feature %d scale or mean out of range", i);
+            return;
+        }
+        means[i] = feature_means[i];
+        gains[i] = (float)(1.0 / unit);
+        means_q16[i] = llround(feature_means[i] * 65536.0);
+        gains_q32[i] = llround(4294967296.0 / unit);
+        limits_q16[i] = (int64_t)((256ULL << 48) / (uint64_t)gains_q32[i]);
+    }
+    output_scale_q24 = int8 ? (int32_t)lround(out->params.scale * 16777216.0) : 0;
+    input = in;
+    output = out;
 }
 
-NeuralNetwork::~NeuralNetwork() {
-    if (tensor_arena) {
-        free(tensor_arena);
+void NeuralNetwork::setInput(const float* features) {
+    for (int i = 0; i < NN_FEATURE_SIZE; i++) {
+        float x = (features[i] - means[i]) * gains[i];
+        if (input->type == kTfLiteFloat32) {
+            input->data.f[i] = x;
+            continue;
+        }
+        long q = input->params.zero_point + lrintf(x);
+        input->data.int8[i] = (int8_t)(q < -128 ? -128 : q > 127 ? 127 : q);
     }
-    delete interpreter;
-    delete resolver;
-    delete error_reporter;
 }
 
-float* NeuralNetwork::getInputBuffer() {
-    if (input == nullptr) {
-        error_reporter->Report("Input tensor is null");
-        return nullptr;
+void NeuralNetwork::setInputQ16(const int64_t* features) {
+    for (int i = 0; i < NN_FEATURE_SIZE; i++) {
+        int64_t d = features[i] - means_q16[i];
+        if (input->type == kTfLiteFloat32) {
+            input->data.f[i] = d / 65536.0f * gains[i];
+            continue;
+        }
+        if (d > limits_q16[i]) d = limits_q16[i];
+        if (d < -limits_q16[i]) d = -limits_q16[i];
+        int64_t q = input->params.zero_point + ((d * gains_q32[i] + (1LL << 47)) >> 48);
+        input->data.int8[i] = (int8_t)(q < -128 ? -128 : q > 127 ? 127 : q);
     }
-    return input->data.f;
 }
 
-float NeuralNetwork::predict() {
-    if (interpreter->Invoke() != kTfLiteOk) {
-        error_reporter->Report("Invoke failed");
-        return -1.0f;
+bool NeuralNetwork::invoke() {
+    if (interpreter.Invoke() != kTfLiteOk) {
+        MicroPrintf("Invoke failed");
+        return false;
     }
-    return output->data.f[0];
+    return true;
 }
 
+float NeuralNetwork::predict() {
+    if (!invoke()) return -1.0f;
+    if (output->type == kTfLiteFloat32) return output->data.f[0];
+    return (output->data.int8[0] - output->params.zero_point) * output->params.scale;
+}
 
-int main(void) {
-    // 创建神经网络实例，加载模型
-    NeuralNetwork* nn = new NeuralNetwork();
-
-    // 获取输入缓冲区（注意：这里假设模型输入维度为 FEATURE_SIZE，即 5 个特征）
-    float* inputBuffer = nn->getInputBuffer();
-    if (inputBuffer == nullptr) {
-        printf("Error: Input buffer is null\n");
-        return -1;
-    }
+int32_t NeuralNetwork::predictQ8() {
+    if (!invoke()) return -1;
+    if (output->type == kTfLiteFloat32) return (int32_t)lrintf(output->data.f[0] * 256.0f);
+    // 64-bit product: (q - zero_point) reaches 255 and a Q24 scale above 2^23 overflows int32
+    return (int32_t)(((int64_t)(output->data.int8[0] - output->params.zero_point) * output_scale_q24) >> 16);
+}
 
-    // 模拟预处理后的特征输入（请将此处替换为实际提取的特征值）
-    // 示例数据：5 个特征，数值仅供测试使用
-    const int FEATURE_SIZE = 5;
-    float test_features[FEATURE_SIZE] = {0.5f, -0.2f, 1.3f, 0.0f, 0.7f};
+// === C 接口 ===
+// The one network lives in static storage, arena included; reloading destroys it in place
+alignas(NeuralNetwork) static uint8_t s_network_storage[sizeof(NeuralNetwork)];
+static NeuralNetwork* s_network = nullptr;
 
-    for (int i = 0; i < FEATURE_SIZE; i++) {
-        inputBuffer[i] = test_features[i];
-    }
+bool nn_breathing_init(const void* model, const float* means, const float* scales) {
+    if (s_network) s_network->~NeuralNetwork();
+    s_network = new (s_network_storage) NeuralNetwork(model ? model : NN_BUILTIN_MODEL, means, scales);
+    return s_network->ready();
+}
 
-    // 调用推理
-    float predicted_bpm = nn->predict();
+bool nn_breathing_predict(const float* features, float* bpm) {
+    if (!s_network || !s_network->ready()) return false;
+    s_network->setInput(features);
+    *bpm = s_network->predict();
+    return *bpm >= 0.0f;
+}
 
-    // 输出预测结果
-    printf("Predicted Breathing Rate: %.2f BPM\n", predicted_bpm);
+bool nn_breathing_predict_q(const int64_t* features_q16, int32_t* bpm_q8) {
+    if (!s_network || !s_network->ready()) return false;
+    s_network->setInputQ16(features_q16);
+    *bpm_q8 = s_network->predictQ8();
+    return *bpm_q8 >= 0;
+}
 
-    // 清理
-    delete nn;
-    return 0;
+size_t nn_breathing_arena_used(void) {
+    return s_network && s_network->ready() ? s_network->arenaUsedBytes() : 0;
 }
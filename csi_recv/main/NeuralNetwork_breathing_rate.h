@@ -1,32 +1,86 @@
 #ifndef NEURAL_NETWORK_H
 #define NEURAL_NETWORK_H
 
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// 内置模型: 1 为 int8 量化模型 (model_data_int8.cc, 由 csi_nn_quantize 生成), 0 为浮点模型 (model_data.cc)
+#ifndef NN_MODEL_INT8
+#define NN_MODEL_INT8 1
+#endif
+// Tensor arena, placed statically inside NeuralNetwork. A model that needs more fails to
+// load instead of overflowing it; what a model does use is logged when it loads.
+// Measured with nn_breathing_benchmark on the tflm_host stand-in: the activations take
+// 129 bytes (int8) and 484 (float) of the built-in models. Both have 13 tensors and 4
+// operators, for which TFLM adds about 1 KB of tensor, node and kernel records on a
+// 32-bit target. 2048 is the float model's 484 bytes plus that 1 KB plus about 0.5 KB
+// of margin. Check it against the "Tensor arena used" log when built against TFLM.
+#ifndef NN_ARENA_SIZE
+#define NN_ARENA_SIZE 2048
+#endif
+// 模型输入: extract_features() 的 5 个特征
+#define NN_FEATURE_SIZE 5
+
+#ifdef __cplusplus
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/micro/micro_interpreter.h"
+#include "nn_op_resolver.h"  // 由 nn_op_resolver_gen.py 在构建时根据内置模型生成
 
-// NeuralNetwork 类声明：该类封装了 TensorFlow Lite Micro 模型加载和推理过程
+// NeuralNetwork 类: 封装 TensorFlow Lite Micro 模型加载和推理过程, 不使用堆内存
+//
+// Takes the raw features and standardises them with the scaler the model was trained
+// behind. For an int8 model, standardisation and input quantisation are one multiply-add
+// per feature, and the output is dequantised with the model's own scale and zero point;
+// a float model takes and returns floats as before.
 class NeuralNetwork {
 public:
-    // 构造函数：加载模型、分配 arena、注册运算算子等
-    NeuralNetwork();
-    
-    // 析构函数，负责释放内存
-    ~NeuralNetwork();
-    
-    // 获取模型的输入缓冲区指针，便于向输入 tensor 填入预处理后的特征数据
-    float* getInputBuffer();
-    
-    // 执行前向传播，返回模型的输出（例如预测的呼吸率）
+    // 加载模型 (须 16 字节对齐, 在对象存续期间有效), 注册算子, 分配张量
+    NeuralNetwork(const void* model_data, const float* means, const float* scales);
+
+    // 模型是否已成功加载
+    bool ready() const { return input != nullptr; }
+
+    // 填入原始特征 (浮点, 或 CSI_FIXED_POINT 下的 Q16)
+    void setInput(const float* features);
+    void setInputQ16(const int64_t* features);
+
+    // 执行前向传播, 返回预测的呼吸率 (BPM 或 Q8 BPM); 失败返回负值
     float predict();
-    
+    int32_t predictQ8();
+
+    size_t arenaUsedBytes() const { return interpreter.arena_used_bytes(); }
+
 private:
-    TfLiteTensor* input;
-    TfLiteTensor* output;
-    tflite::MicroInterpreter* interpreter;
-    tflite::ErrorReporter* error_reporter;
-    tflite::MicroMutableOpResolver<10>* resolver;
+    bool invoke();
+
+    NnOpResolver resolver;  // Exactly the built-in models' operators
+    alignas(16) uint8_t tensor_arena[NN_ARENA_SIZE];
     const tflite::Model* model;
-    uint8_t* tensor_arena;
+    tflite::MicroInterpreter interpreter;
+    TfLiteTensor* input = nullptr;
+    TfLiteTensor* output = nullptr;
+    // Standardisation folded into input quantisation: q = zero_point + (x - mean) * gain
+    float means[NN_FEATURE_SIZE];
+    float gains[NN_FEATURE_SIZE];
+    int64_t means_q16[NN_FEATURE_SIZE];
+    int64_t gains_q32[NN_FEATURE_SIZE];
+    int64_t limits_q16[NN_FEATURE_SIZE];   // |x - mean| beyond which q saturates anyway
+    int32_t output_scale_q24 = 0;
 };
 
+extern "C" {
+#endif
+
+// C 接口: 一个静态放置的 NeuralNetwork, 供 app_main.c 使用
+// model: TFLite flatbuffer, NULL 为内置模型; means/scales: 模型训练时的标准化参数
+bool nn_breathing_init(const void *model, const float *means, const float *scales);
+bool nn_breathing_predict(const float *features, float *bpm);
+bool nn_breathing_predict_q(const int64_t *features_q16, int32_t *bpm_q8);
+size_t nn_breathing_arena_used(void);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif // NEURAL_NETWORK_H
@@ -40,6 +40,9 @@
 #include <time.h>
 #include <unistd.h>
 #include <sys/time.h>
+#include <sys/param.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "nvs_flash.h"
 #include "esp_mac.h"
 #include "rom/ets_sys.h"
@@ -47,34 +50,333 @@
 #include "esp_wifi.h"
 #include "esp_netif.h"
 #include "esp_now.h"
+#include "driver/uart.h"
 #include "mqtt_client.h"
 #include "breathing_rate_evaluation_svm.h"
+#include "NeuralNetwork_breathing_rate.h"
+#include "csi_pool.h"
+#include "csi_ring.h"
+#include "csi_matrix.h"
+#include "csi_session.h"
+#include "csi_resample.h"
+#include "csi_trace.h"
+#include "csi_serial.h"
+#include "csi_gain.h"
+#include "csi_motion.h"
+#include "csi_pca.h"
+#include "csi_params.h"
+#include "csi_hop.h"
+#include "csi_sdft.h"
+#include "csi_decimate.h"
+#include "csi_peak.h"
+#include "csi_fft.h"
+#include "csi_ensemble.h"
+#include "csi_features.h"
+#include "csi_model.h"
+#include "csi_cnn.h"
 
 // [1] YOUR CODE HERE
 #define CSI_BUFFER_LENGTH 800
 #define CSI_FIFO_LENGTH 100
 #define VARIANCE_THRESHOLD 40.0f
-static int16_t CSI_Q[CSI_BUFFER_LENGTH];
-static int CSI_Q_INDEX = 0; // CSI Buffer Index
+#define CSI_RESAMPLE_INTERP CSI_INTERP_LINEAR
+// Decimation of the uniform series ahead of the breathing stages, one factor per stage (csi_decimate.h).
+// Breathing sits below BREATH_MAX_HZ, so a few Hz is enough; BREATH_DECIMATION_TOTAL is their product.
+#define BREATH_DECIMATION {4}
+#define BREATH_DECIMATION_TOTAL 4
+#define BREATH_RATE_HZ (CSI_SAMPLE_RATE_HZ / BREATH_DECIMATION_TOTAL)
+// Decimated samples kept per session, 25.6 s at BREATH_RATE_HZ
+#define CSI_SERIES_LENGTH 128
+// Peak counting on the decimated series (csi_peak.h): 40 s window, crests more than 3 s apart,
+// one estimate per second. breathing_rate_evaluation_simple.c runs the same stage at 60 Hz.
+#define BREATH_PEAK_WINDOW (40 * BREATH_RATE_HZ)
+#define BREATH_PEAK_SMOOTH 3
+#define BREATH_PEAK_NEIGHBOURS 2
+#define BREATH_PEAK_MIN_DISTANCE (3 * BREATH_RATE_HZ)
+#define BREATH_PEAK_STEP BREATH_RATE_HZ
+// Band searched for the spectral breathing estimate on the uniform series
+#define BREATH_MIN_HZ 0.1f
+#define BREATH_MAX_HZ 0.6f
+// Confidence the ensemble gives the SVM estimate, which has no measure of its own (Q8, 0.5)
+#define BREATH_SVM_CONFIDENCE 128
+// Likewise for the neural network on the same features
+#define BREATH_NN_CONFIDENCE 128
+// And for the streaming CNN on the decimated series
+#define BREATH_CNN_CONFIDENCE 128
+// Grid samples one packet can complete: a gap just under CSI_RESAMPLE_MAX_GAP_US
+#define CSI_RESAMPLE_MAX_OUT (CSI_RESAMPLE_MAX_GAP_US / (1000000 / CSI_SAMPLE_RATE_HZ) + 1)
 // Enable/Disable CSI Buffering. 1: Enable, using buffer, 0: Disable, using serial output
 static bool CSI_Q_ENABLE = 1;
-static void csi_process(const int8_t *csi_data, int length);
+// What csi_q holds. 1: one sample per packet, the principal component of the strongest subcarriers
+// (csi_pca.h). 0: every CSI byte, the input VARIANCE_THRESHOLD and the breathing model were fitted on.
+#define CSI_Q_PCA 0
+// Serial output format. 1: COBS framed binary (decode with csi_serial_decode.c), 0: CSV text
+#define CSI_SERIAL_BINARY 1
+// UART TX buffer for the serial dump; csi_task blocks when it is full, the ring absorbs the rest
+#define CSI_SERIAL_TX_BUFFER 8192
+// Per-transmitter buffers and estimator state, indexed by the id csi_session_lookup() returns
+typedef struct
+{
+  int16_t csi_q[CSI_BUFFER_LENGTH];
+  int csi_q_index; // CSI Buffer Index
+  uint32_t csi_q_end; // Samples ever appended to csi_q: the stream index one past csi_q[csi_q_index - 1]
+  // Running statistics over the same samples as csi_q, updated as they enter and leave
+  csi_motion_t motion;
+  // Per-subcarrier amplitude/phase history, decoded once per packet in csi_process()
+  csi_matrix_t matrix;
+#if CSI_Q_PCA
+  // Subcarrier ranking and principal component over the matrix, one sample per packet
+  csi_pca_t pca;
+#endif
+  // Mean subcarrier amplitude placed on the CSI_SAMPLE_RATE_HZ grid by rx timestamp,
+  // then anti-alias filtered down to BREATH_RATE_HZ
+  csi_resampler_t resampler;
+  csi_decimator_t breath_decimator;
+  float amp_series[CSI_SERIES_LENGTH];
+  uint32_t amp_series_count; // Decimated samples written since the last gap
+  // Breathing band of amp_series, a sliding DFT over the whole ring updated per decimated sample
+  csi_sdft_t breath_sdft;
+  int spectral_breathing_rate; // BPM of the in-band peak, 0 until the ring has filled
+  csi_peak_t breath_peaks;
+  int peak_breathing_rate; // BPM from counting crests, 0 until CSI_PEAK_MIN_SECONDS of series
+  // CNN activations over the decimated series, advanced one output per layer per sample
+  csi_cnn_state_t breath_cnn;
+  // Gain compensation of this sender's packets. Each sender has its own, or senders at
+  // different AGC gains interleaved while s_gain learns would recompute it every packet.
+  csi_gain_cache_t gain_cache;
+  // motion
+  float motion_amplitude; // Motion amplitude
+  int motion_intensity;   // Exercise intensity levels: 0= none, 1= Slight, 2= moderate, 3= vigorous
+  bool last_few_results[CSI_PARAMS_MAX_VOTES];
+  int history_index;
+  int continuous_motion_count;
+  bool motion_detected;
+  int breathing_rate;
+  csi_hop_t breath_hop; // WINDOW_SIZE / STEP_SIZE schedule of the breathing windows over csi_q
+  // SVM features of the latest breathing window, slid along csi_q by each hop
+  csi_features_t breath_features;
+  uint32_t breath_features_end; // Stream index one past the last sample pushed into breath_features
+  int64_t last_send_time;
+  uint32_t processed;
+} csi_session_t;
+_Static_assert(CSI_BUFFER_LENGTH < CSI_MOTION_RING, "csi_motion_t must hold all of csi_q");
+_Static_assert(WINDOW_SIZE + STEP_SIZE <= CSI_BUFFER_LENGTH - CSI_FIFO_LENGTH,
+               "the next breathing window must survive the shift of a full csi_q");
+_Static_assert(FEATURE_SIZE == CSI_FEATURES_COUNT, "csi_features_t computes the breathing model's input");
+_Static_assert(NN_FEATURE_SIZE == FEATURE_SIZE, "the neural network reads the SVM's features");
+_Static_assert(CSI_SAMPLE_RATE_HZ % BREATH_DECIMATION_TOTAL == 0, "BREATH_RATE_HZ must be a whole number of Hz");
+// !Note: change to your current setting
+// Every csi_send node listed here gets its own session (at most CSI_SESSION_MAX)
+static const uint8_t CONFIG_CSI_SEND_MAC[][6] = {
+    {0x00, 0x03, 0x7f, 0x00, 0x00, 0x00},
+    // {0x64, 0x2c, 0xac, 0xa2, 0x3f, 0x93},
+};
+// A session is about 48 KB (csi_matrix 16.5 KB, csi_motion 16.4 KB, csi_cnn 6.2 KB,
+// csi_features 5.2 KB), so only the listed senders get one
+#define CSI_SEND_MAC_COUNT (sizeof(CONFIG_CSI_SEND_MAC) / sizeof(CONFIG_CSI_SEND_MAC[0]))
+_Static_assert(CSI_SEND_MAC_COUNT <= CSI_SESSION_MAX, "more CSI senders listed than CSI_SESSION_MAX");
+static csi_session_table_t s_session_table;
+static csi_session_t s_sessions[CSI_SEND_MAC_COUNT];
+#define SESSION_ID(session) ((uint8_t)((session) - s_sessions))
+static void csi_process(const csi_frame_t *frame);
 static const char *TAG = "csi_recv";
+// CSI processing task, fed by wifi_csi_rx_cb with pool slots through a lock-free ring
+#define CSI_TASK_STACK_SIZE 8192
+#define CSI_TASK_PRIORITY 5
+#define CSI_TASK_BATCH 8
+static csi_pool_t s_csi_pool;
+static csi_ring_t s_csi_ring;
+static TaskHandle_t s_csi_task = NULL;
+// Receiver gain tracking, updated in wifi_csi_rx_cb; csi_process normalises amplitudes with it.
+// One for the receiver, not per session: the PHY has a single forced gain that every sender's
+// packets arrive at, so the learned pair and the reference it is scaled back to are shared.
+static csi_gain_t s_gain;
+// Formats csi_trace records off the hot path, below csi_task so it never delays processing
+#define CSI_TRACE_TASK_STACK_SIZE 3072
+#define CSI_TRACE_TASK_PRIORITY 1
+#define CSI_TRACE_TASK_PERIOD_MS 200
+// Runtime detector parameters. The MQTT task stages and publishes a set, csi_task acquires it per batch.
+static csi_params_exchange_t s_params;
+static csi_params_t s_params_staged;                // Writer side: the set last published
+static const csi_params_t *s_active_params = NULL; // Reader side: only csi_task and what it calls use it
+#define PARAMS_PUBLISH_RETRIES 50
+#define PARAMS_PUBLISH_RETRY_MS 10
+// Breathing model blobs (csi_model.h) in A/B slots of the svm_model partition. The MQTT task writes
+// and checks an upload in the slot not in use and folds it; csi_task switches to it between windows.
+#define SVM_MODEL_PARTITION "svm_model"
+static csi_model_store_t s_svm_store;
+static svm_model_t s_svm_models[CSI_MODEL_SLOTS]; // Folded from the blob in each slot
+static atomic_int s_svm_model_slot = -1;          // Slot in use, -1 for the built-in model
+static atomic_int s_svm_model_pending = -1;       // Slot csi_task is to switch to, -1 if none
+static int s_svm_upload_slot = -1;                // MQTT task only: slot the upload in progress goes to
+// TFLite blobs for the neural network, read in place from the newest valid slot of nn_model at boot
+#define NN_MODEL_PARTITION "nn_model"
+static csi_model_store_t s_nn_store;
+// Streaming CNN (csi_cnn.h), read in place from the newest valid slot of cnn_model at boot. There is
+// no built-in one: without a stored model the estimator reports nothing.
+#define CNN_MODEL_PARTITION "cnn_model"
+static csi_model_store_t s_cnn_store;
+static csi_cnn_model_t s_cnn_model;
+static bool s_cnn_loaded = false;
 // MQTT
 static esp_mqtt_client_handle_t mqtt_client = NULL;
 static bool mqtt_connected = false;
-// motion
-extern float g_motion_amplitude;
-extern int g_motion_intensity;
-bool motion_detected = true;
-int breathing_rate = 10;
+static const char *s_mqtt_down = NULL; // Why mqtt_send() last could not send, NULL while it can
+static uint32_t s_mqtt_skipped = 0;    // mqtt_send() calls dropped since s_mqtt_down was logged
+#define MQTT_CMD_TOPIC "rx/cmd"       // Parameter commands, see csi_params_parse()
+#define MQTT_PARAMS_TOPIC "rx/params" // Result of each command and the set now in use
+#define MQTT_MODEL_TOPIC "rx/model"   // Breathing model blobs from csi_model_pack
+#define MQTT_MODEL_STATUS_TOPIC "rx/model/status" // Result of each upload
 static bool wifi_connected = false;
-static int64_t last_send_time = -1;
 // [1] END OF YOUR CODE
 
 // [2] YOUR CODE HERE
 // Modify the following functions to implement your algorithms.
 // NOTE: Please do not change the function names and return types.
+static void apply_params_command(const char *command, int len)
+{
+  char reply[CSI_PARAMS_MAX_COMMAND + 96];
+  char text[CSI_PARAMS_MAX_COMMAND];
+  csi_params_t params = s_params_staged;
+  const char *reason = NULL;
+  bool ok = csi_params_parse(command, len, &params, &reason);
+  if (ok)
+  {
+    // csi_task releases the spare slot when it next acquires; wake it in case no CSI is arriving
+    ok = false;
+    for (int i = 0; i < PARAMS_PUBLISH_RETRIES && !ok; i++)
+    {
+      ok = csi_params_publish(&s_params, &params);
+      if (s_csi_task != NULL)
+        xTaskNotifyGive(s_csi_task);
+      if (!ok)
+        vTaskDelay(pdMS_TO_TICKS(PARAMS_PUBLISH_RETRY_MS));
+    }
+    if (!ok)
+      reason = "processing task busy, retry";
+  }
+  if (!ok)
+  {
+    ESP_LOGW(TAG, "Parameter command rejected: %s", reason);
+    snprintf(reply, sizeof(reply), "{\"ok\":false,\"error\":\"%s\"}", reason);
+    esp_mqtt_client_publish(mqtt_client, MQTT_PARAMS_TOPIC, reply, 0, 1, 0);
+    return;
+  }
+
+  s_params_staged = params;
+  s_params_staged.generation++;
+  esp_err_t err = csi_params_save(&params);
+  if (err != ESP_OK)
+    ESP_LOGW(TAG, "Parameters applied but not stored: %s", esp_err_to_name(err));
+  csi_params_format(&params, text, sizeof(text));
+  ESP_LOGI(TAG, "Parameters generation %lu: %s", (unsigned long)s_params_staged.generation, text);
+  snprintf(reply, sizeof(reply), "{\"ok\":true,\"generation\":%lu,\"stored\":%s,\"params\":\"%s\"}",
+           (unsigned long)s_params_staged.generation, err == ESP_OK ? "true" : "false", text);
+  esp_mqtt_client_publish(mqtt_client, MQTT_PARAMS_TOPIC, reply, 0, 1, 0);
+}
+
+static void model_upload_reply(const char *reason, uint32_t sequence, int slot)
+{
+  char reply[128];
+  if (reason)
+  {
+    ESP_LOGW(TAG, "Breathing model rejected: %s", reason);
+    snprintf(reply, sizeof(reply), "{\"ok\":false,\"error\":\"%s\"}", reason);
+  }
+  else
+  {
+    ESP_LOGI(TAG, "Breathing model sequence %lu stored in slot %d", (unsigned long)sequence, slot);
+    snprintf(reply, sizeof(reply), "{\"ok\":true,\"sequence\":%lu,\"slot\":%d}", (unsigned long)sequence, slot);
+  }
+  esp_mqtt_client_publish(mqtt_client, MQTT_MODEL_STATUS_TOPIC, reply, 0, 1, 0);
+}
+
+// One fragment of a blob on MQTT_MODEL_TOPIC. It goes into the slot not in use, is checked
+// as a whole once complete, and only then handed to csi_task.
+static void apply_model_fragment(esp_mqtt_event_handle_t event)
+{
+  const char *reason = NULL;
+  if (event->current_data_offset == 0)
+  {
+    // The slot in use, and one csi_task has yet to switch to, are never overwritten
+    s_svm_upload_slot = -1;
+    int active = atomic_load(&s_svm_model_slot);
+    uint32_t in_use = active < 0 ? 0 : s_svm_models[active].sequence;
+    const csi_model_header_t *header = (const csi_model_header_t *)event->data;
+    if (atomic_load(&s_svm_model_pending) >= 0)
+      reason = "previous model not yet in use, retry";
+    else if (event->data_len < (int)sizeof(*header) || header->magic != CSI_MODEL_MAGIC)
+      reason = "not a model blob";
+    else if (header->sequence <= in_use)
+      reason = "sequence must exceed the model in use";
+    else if (csi_model_store_begin(&s_svm_store, active == 0 ? 1 : 0, event->total_data_len) != ESP_OK)
+      reason = "blob does not fit a model slot";
+    else
+      s_svm_upload_slot = active == 0 ? 1 : 0;
+  }
+  else if (s_svm_upload_slot < 0)
+  {
+    return; // The rest of an upload already rejected
+  }
+
+  if (reason == NULL &&
+      csi_model_store_write(&s_svm_store, event->current_data_offset, event->data, event->data_len) != ESP_OK)
+    reason = "flash write failed";
+  if (reason == NULL && event->current_data_offset + event->data_len < event->total_data_len)
+    return;
+
+  int slot = s_svm_upload_slot;
+  s_svm_upload_slot = -1;
+  if (reason == NULL && csi_model_store_finish(&s_svm_store, &reason) == ESP_OK &&
+      svm_model_from_blob(&s_svm_store.models[slot], &s_svm_models[slot], &reason))
+  {
+    atomic_store(&s_svm_model_pending, slot);
+    if (s_csi_task != NULL)
+      xTaskNotifyGive(s_csi_task);
+  }
+  model_upload_reply(reason, slot >= 0 ? s_svm_models[slot].sequence : 0, slot);
+}
+
+static void mqtt_event_handler(void *handler_args, esp_event_base_t base, int32_t event_id, void *event_data)
+{
+  esp_mqtt_event_handle_t event = event_data;
+  switch ((esp_mqtt_event_id_t)event_id)
+  {
+  case MQTT_EVENT_CONNECTED:
+    // Subscribe on every (re)connect; the broker may not keep the session
+    if (esp_mqtt_client_subscribe(mqtt_client, MQTT_CMD_TOPIC, 1) < 0)
+      ESP_LOGE(TAG, "Failed to subscribe to " MQTT_CMD_TOPIC);
+    else
+      ESP_LOGI(TAG, "Subscribed to " MQTT_CMD_TOPIC);
+    if (s_svm_store.partition != NULL && esp_mqtt_client_subscribe(mqtt_client, MQTT_MODEL_TOPIC, 1) < 0)
+      ESP_LOGE(TAG, "Failed to subscribe to " MQTT_MODEL_TOPIC);
+    break;
+  case MQTT_EVENT_DATA:
+    // Only the first fragment of a long message carries the topic
+    if (event->current_data_offset > 0 && s_svm_upload_slot >= 0)
+    {
+      apply_model_fragment(event);
+      break;
+    }
+    if (event->topic_len == strlen(MQTT_MODEL_TOPIC) && strncmp(event->topic, MQTT_MODEL_TOPIC, event->topic_len) == 0)
+    {
+      apply_model_fragment(event);
+      break;
+    }
+    if (event->topic_len != strlen(MQTT_CMD_TOPIC) || strncmp(event->topic, MQTT_CMD_TOPIC, event->topic_len) != 0)
+      break;
+    if (event->current_data_offset != 0 || event->data_len != event->total_data_len)
+    {
+      ESP_LOGW(TAG, "Ignoring fragmented parameter command (%d bytes)", event->total_data_len);
+      break;
+    }
+    apply_params_command(event->data, event->data_len);
+    break;
+  default:
+    break;
+  }
+}
+
 bool init_mqtt()
 {
   ESP_LOGI(TAG, "Initializing MQTT client...");
@@ -96,6 +398,7 @@ bool init_mqtt()
     ESP_LOGE(TAG, "Failed to initialize MQTT client");
     return false;
   }
+  esp_mqtt_client_register_event(mqtt_client, MQTT_EVENT_ANY, mqtt_event_handler, NULL);
 
   // Start the MQTT client
   esp_err_t err = esp_mqtt_client_start(mqtt_client);
@@ -111,206 +414,405 @@ bool init_mqtt()
   return true;
 }
 
-float g_motion_amplitude = 0.0f; // Global motion amplitude variable
-int g_motion_intensity = 0;      // Exercise intensity levels: 0= none, 1= Slight, 2= moderate, 3= vigorous
-
-bool motion_detection(bool verbose_logging)
+bool motion_detection(csi_session_t *session, bool verbose_logging)
 {
-  if (CSI_Q_INDEX < 50)
+  if (session->csi_q_index < 50)
     return false; // The data is insufficient
 
-  const int window_size = 30;
-  const float alpha = 0.4;
-  const float base_threshold = 50.0f;
-
-  // Calculate the overall statistical data of the signal
-  float signal_mean = 0;
-  for (int i = 0; i < CSI_Q_INDEX; i++)
-    signal_mean += CSI_Q[i];
-  signal_mean /= CSI_Q_INDEX;
+  const csi_params_t *params = s_active_params;
 
-  float signal_variance = 0;
-  for (int i = 0; i < CSI_Q_INDEX; i++)
-    signal_variance += (CSI_Q[i] - signal_mean) * (CSI_Q[i] - signal_mean);
-  float signal_std = sqrtf(signal_variance / CSI_Q_INDEX);
+  // Signal statistics, smoothed-signal window variances and diff energy, kept up to date by csi_process
+#if CSI_FIXED_POINT
+  // Same rules in Q8, see csi_motion_features_q8()
+  csi_motion_features_q8_t features;
+  csi_motion_features_q8(&session->motion, &features);
+  int32_t signal_std = features.signal_std;
+  int32_t max_variance = features.max_variance;
+  int32_t avg_variance = features.avg_variance;
+  int32_t diff_energy = features.diff_energy;
 
-  float threshold = fmaxf(base_threshold, signal_std * 0.9f);
+  int32_t threshold = MAX(params->q.base_threshold, csi_mul_q15(signal_std, params->q.std_factor));
+  int32_t diff_threshold = MAX(params->q.diff_base_threshold, csi_mul_q15(signal_std, params->q.diff_std_factor));
 
-  // Apply moving average filtering
-  int16_t smoothed[CSI_BUFFER_LENGTH];
-  smoothed[0] = CSI_Q[0];
-  for (int i = 1; i < CSI_Q_INDEX; i++)
-  {
-    smoothed[i] = alpha * CSI_Q[i] + (1 - alpha) * smoothed[i - 1];
-  }
-
-  // Calculate the short-term variance and the maximum variance
-  float max_variance = 0, avg_variance = 0;
-  int valid_windows = 0;
-  for (int start = 0; start < CSI_Q_INDEX - window_size; start += window_size / 2)
-  {
-    float mean = 0, variance = 0;
-    for (int i = 0; i < window_size && (start + i) < CSI_Q_INDEX; i++)
-    {
-      mean += smoothed[start + i];
-    }
-    mean /= window_size;
-
-    for (int i = 0; i < window_size && (start + i) < CSI_Q_INDEX; i++)
-    {
-      variance += (smoothed[start + i] - mean) * (smoothed[start + i] - mean);
-    }
-    variance /= window_size;
+  bool motion_by_variance = (max_variance > threshold);
+  bool motion_by_diff = (diff_energy > diff_threshold);
+  bool motion_detected = (motion_by_variance && motion_by_diff) ||
+                         (((int64_t)max_variance << 15) > (int64_t)threshold * params->q.variance_strong) ||
+                         (((int64_t)diff_energy << 15) > (int64_t)diff_threshold * params->q.diff_strong);
 
-    max_variance = fmaxf(max_variance, variance);
-    avg_variance += variance;
-    valid_windows++;
-  }
-  avg_variance /= fmaxf(valid_windows, 1);
+  // Calculate the amplitude of motion
+  int64_t variance_span = MAX((int64_t)threshold * params->q.score_span, 1);
+  int64_t diff_span = MAX((int64_t)diff_threshold * params->q.score_span, 1);
+  int32_t variance_score = MIN(((int64_t)max_variance * (100 << 8) << 15) / variance_span, 100 << 8);
+  int32_t diff_score = MIN(((int64_t)diff_energy * (100 << 8) << 15) / diff_span, 100 << 8);
+  int32_t amplitude = (variance_score + diff_score) / 2;
+  session->motion_amplitude = amplitude * (1.0f / CSI_Q8_ONE);
 
-  float diff_energy = 0;
-  for (int i = 1; i < CSI_Q_INDEX; i++)
-  {
-    diff_energy += (smoothed[i] - smoothed[i - 1]) * (smoothed[i] - smoothed[i - 1]);
-  }
-  diff_energy /= (CSI_Q_INDEX - 1);
+  // Determine the intensity of exercise
+  if (amplitude < (30 << 8))
+    session->motion_intensity = 0;
+  else if (amplitude < (50 << 8))
+    session->motion_intensity = 1;
+  else if (amplitude < (75 << 8))
+    session->motion_intensity = 2;
+  else
+    session->motion_intensity = 3;
+#define MOTION_Q8(value) (value)
+#else
+  csi_motion_features_t features;
+  csi_motion_features(&session->motion, &features);
+  float signal_std = features.signal_std;
+  float max_variance = features.max_variance;
+  float avg_variance = features.avg_variance;
+  float diff_energy = features.diff_energy;
 
-  float diff_threshold = fmaxf(60.0f, signal_std * 1.5f);
+  float threshold = fmaxf(params->base_threshold, signal_std * params->std_factor);
+  float diff_threshold = fmaxf(params->diff_base_threshold, signal_std * params->diff_std_factor);
 
   bool motion_by_variance = (max_variance > threshold);
   bool motion_by_diff = (diff_energy > diff_threshold);
   bool motion_detected = (motion_by_variance && motion_by_diff) ||
-                         (max_variance > threshold * 2.0f) ||
-                         (diff_energy > diff_threshold * 1.5f);
+                         (max_variance > threshold * params->variance_strong) ||
+                         (diff_energy > diff_threshold * params->diff_strong);
 
   // Calculate the amplitude of motion
-  float variance_score = fminf((max_variance / (threshold * 3.0f)) * 100.0f, 100.0f);
-  float diff_score = fminf((diff_energy / (diff_threshold * 3.0f)) * 100.0f, 100.0f);
-  g_motion_amplitude = (variance_score + diff_score) / 2.0f;
+  float variance_score = fminf((max_variance / (threshold * params->score_span)) * 100.0f, 100.0f);
+  float diff_score = fminf((diff_energy / (diff_threshold * params->score_span)) * 100.0f, 100.0f);
+  session->motion_amplitude = (variance_score + diff_score) / 2.0f;
+  float amplitude = session->motion_amplitude;
 
   // Determine the intensity of exercise
-  if (g_motion_amplitude < 30.0f)
-    g_motion_intensity = 0;
-  else if (g_motion_amplitude < 50.0f)
-    g_motion_intensity = 1;
-  else if (g_motion_amplitude < 75.0f)
-    g_motion_intensity = 2;
+  if (session->motion_amplitude < 30.0f)
+    session->motion_intensity = 0;
+  else if (session->motion_amplitude < 50.0f)
+    session->motion_intensity = 1;
+  else if (session->motion_amplitude < 75.0f)
+    session->motion_intensity = 2;
   else
-    g_motion_intensity = 3;
+    session->motion_intensity = 3;
+#define MOTION_Q8(value) ((int32_t)((value) * CSI_Q8_ONE))
+#endif
 
   // Output the motion amplitude and the original value information
-  ESP_LOGI(TAG, "Motion metrics: amplitude=%.1f, var_score=%.1f, diff_score=%.1f",
-           g_motion_amplitude, variance_score, diff_score);
-  ESP_LOGI(TAG, "Raw values: max_var=%.2f (threshold=%.2f), diff=%.2f (threshold=%.2f)",
-           max_variance, threshold, diff_energy, diff_threshold);
+  CSI_TRACED(CSI_EV_MOTION, SESSION_ID(session), MOTION_Q8(amplitude),
+             MOTION_Q8(variance_score), MOTION_Q8(diff_score), motion_detected);
+  CSI_TRACED(CSI_EV_MOTION_RAW, SESSION_ID(session), MOTION_Q8(max_variance), MOTION_Q8(threshold),
+             MOTION_Q8(diff_energy), MOTION_Q8(diff_threshold));
 
   if (verbose_logging)
   {
-    ESP_LOGI(TAG, "Motion detection stats: avg_var=%.2f, max_var=%.2f, diff_energy=%.2f",
-             avg_variance, max_variance, diff_energy);
-    ESP_LOGI(TAG, "Thresholds: variance=%.2f, diff=%.2f, signal_std=%.2f",
-             threshold, diff_threshold, signal_std);
-    ESP_LOGI(TAG, "Detection result: by_variance=%d, by_diff=%d, combined=%d",
-             motion_by_variance, motion_by_diff, motion_detected);
+    CSI_TRACED(CSI_EV_MOTION_STATS, SESSION_ID(session), MOTION_Q8(avg_variance), MOTION_Q8(max_variance),
+               MOTION_Q8(diff_energy), MOTION_Q8(signal_std));
   }
+#undef MOTION_Q8
 
-  static bool last_few_results[5] = {false, false, false, false, false};
-  static int history_index = 0;
-  last_few_results[history_index] = motion_detected;
-  history_index = (history_index + 1) % 5;
+  session->last_few_results[session->history_index] = motion_detected;
+  session->history_index = (session->history_index + 1) % params->vote_window;
 
   int motion_count = 0;
-  for (int i = 0; i < 5; i++)
-    if (last_few_results[i])
+  for (int i = 0; i < params->vote_window; i++)
+    if (session->last_few_results[i])
       motion_count++;
 
-  bool history_vote = (motion_count >= 3);
+  bool history_vote = (motion_count >= params->vote_min);
 
   // State machine: It will be triggered only when sufficient motion evidence is accumulated
-  static int continuous_motion_count = 0;
   if (motion_detected)
   {
-    continuous_motion_count = (g_motion_amplitude > 60.0f) ? fminf(continuous_motion_count + 2, 10) : fminf(continuous_motion_count + 1, 10);
+    session->continuous_motion_count = (session->motion_amplitude > params->strong_amplitude) ? fminf(session->continuous_motion_count + 2, params->continuous_max) : fminf(session->continuous_motion_count + 1, params->continuous_max);
   }
   else
   {
-    continuous_motion_count = fmaxf(continuous_motion_count - 1, 0);
+    session->continuous_motion_count = fmaxf(session->continuous_motion_count - 1, 0);
   }
 
-  bool state_machine_result = (g_motion_amplitude > 75.0f) || (continuous_motion_count >= 4);
+  bool state_machine_result = (session->motion_amplitude > params->instant_amplitude) || (session->continuous_motion_count >= params->continuous_min);
   bool final_result = state_machine_result && history_vote;
 
   if (verbose_logging || final_result != motion_detected)
   {
-    ESP_LOGI(TAG, "Motion status: history=%d, continuous=%d, intensity=%d, final=%d, final_result_output=%s",
-             history_vote, continuous_motion_count, g_motion_intensity, final_result,
-             final_result == 1 ? "True" : "False");
+    CSI_TRACEI(CSI_EV_MOTION_VOTE, SESSION_ID(session), history_vote, session->continuous_motion_count,
+               session->motion_intensity, final_result);
   }
 
   return final_result;
 }
 
-int breathing_rate_estimation()
+//------------------------------------------------------Breathing Estimators------------------------------------------------------
+// Slots of s_breath_ensemble are the CSI_EST_* bits of the "est" parameter (csi_params.h)
+_Static_assert(CSI_EST_COUNT <= CSI_ENSEMBLE_MAX, "one ensemble slot per estimator bit");
+static csi_ensemble_t s_breath_ensemble;
+static csi_fft_plan_t s_breath_fft;
+static float s_breath_fft_storage[CSI_FFT_STORAGE_FLOATS(CSI_SERIES_LENGTH)];
+
+static bool breath_estimator_enabled(int slot)
 {
-  // Obtain the latest CSI data from CSI_Q and store it in the buffer
-  // if (CSI_Q == NULL)
-  // {
-  //   printf("CSI queue is not initialized\n");
-  //   return -1;
-  // }
-  if (CSI_Q_INDEX < 300)
+  return (s_breath_ensemble.enabled & (1u << slot)) != 0;
+}
+
+// Slide the session's feature extractor to the end of the window: only the samples since the
+// last window enter, the rest of it is still in there. Restart if the windows do not overlap.
+// The SVM and the neural network both read it; the second call for a window does nothing.
+static bool breath_features_slide(const csi_breath_window_t *window)
+{
+  csi_session_t *session = window->context;
+  if (window->raw == NULL || window->raw_length != WINDOW_SIZE)
+    return false;
+  uint32_t first = session->csi_q_end - session->csi_q_index;
+  uint32_t start = first + (uint32_t)(window->raw - session->csi_q);
+  uint32_t end = start + WINDOW_SIZE;
+  int32_t behind = (int32_t)(end - session->breath_features_end);
+  if (behind < 0 || behind > WINDOW_SIZE)
   {
-    ESP_LOGI(TAG, "Data insufficient, continuing to collect...CSI_Q_INDEX:%d", CSI_Q_INDEX);
-    return 0; // 至少需要5秒数据(假设采样率60Hz)
+    csi_features_reset(&session->breath_features);
+    session->breath_features_end = start;
   }
-  int buffer_index = 0;
-  float csi_buffer[WINDOW_SIZE];
+  for (uint32_t i = session->breath_features_end; i != end; i++)
+    csi_features_push(&session->breath_features, session->csi_q[i - first]);
+  session->breath_features_end = end;
+  return true;
+}
 
-  // Convert the data in CSI_Q to float and store it in csi_buffer
-  ESP_LOGI(TAG, "Starting to collect CSI data into buffer...%d", buffer_index);
-  while (buffer_index < WINDOW_SIZE && CSI_Q_INDEX > 0)
+// The linear model, on the per-packet csi_q window it was fitted on
+static bool estimate_svm(const csi_breath_window_t *window, csi_breath_estimate_t *out)
+{
+  csi_session_t *session = window->context;
+  if (!breath_features_slide(window))
+    return false;
+
+  for (int i = 0; i < WINDOW_SIZE; i++)
   {
-    // Convert the CSI data of type int16_t to float
-    csi_buffer[buffer_index] = (float)CSI_Q[CSI_Q_INDEX - 1];
-    ESP_LOGD(TAG, "Collected CSI data[%d]: %.2f", buffer_index, csi_buffer[buffer_index]);
-    buffer_index++;
-    CSI_Q_INDEX--;
+    CSI_TRACEV(CSI_EV_BREATH_SAMPLE, SESSION_ID(session), i, csi_trace_f(window->raw[i]), 0, 0);
   }
 
-  // When sufficient data is collected, the respiratory rate is estimated
-  if (buffer_index >= WINDOW_SIZE)
+  // Features as extract_features() in breathing_rate_evaluation_svm.c computes them
+#if CSI_FIXED_POINT
+  int64_t features[FEATURE_SIZE]; // Q16
+  csi_features_get_q(&session->breath_features, features);
+
+  // Log extracted features
+  for (int i = 0; i < FEATURE_SIZE; i++)
+  {
+    CSI_TRACED(CSI_EV_BREATH_FEATURE, SESSION_ID(session), i, csi_trace_f(features[i] / (float)CSI_Q16_ONE), 0, 0);
+  }
+
+  out->bpm_q8 = predict_q(features) / CSI_Q8_ONE;
+#else
+  float features[FEATURE_SIZE];
+  csi_features_get(&session->breath_features, features);
+
+  // Log extracted features
+  for (int i = 0; i < FEATURE_SIZE; i++)
+  {
+    CSI_TRACED(CSI_EV_BREATH_FEATURE, SESSION_ID(session), i, csi_trace_f(features[i]), 0, 0);
+  }
+
+  out->bpm_q8 = (int32_t)(predict(features) * CSI_Q8_ONE);
+#endif
+  out->confidence_q8 = BREATH_SVM_CONFIDENCE;
+  return true;
+}
+
+// The TFLM network (int8 unless a float model is loaded) on the same features as the SVM
+static bool estimate_nn(const csi_breath_window_t *window, csi_breath_estimate_t *out)
+{
+  csi_session_t *session = window->context;
+  if (!breath_features_slide(window))
+    return false;
+#if CSI_FIXED_POINT
+  int64_t features[FEATURE_SIZE]; // Q16
+  csi_features_get_q(&session->breath_features, features);
+  if (!nn_breathing_predict_q(features, &out->bpm_q8))
+    return false;
+#else
+  float features[FEATURE_SIZE];
+  float bpm;
+  csi_features_get(&session->breath_features, features);
+  if (!nn_breathing_predict(features, &bpm))
+    return false;
+  out->bpm_q8 = (int32_t)(bpm * CSI_Q8_ONE);
+#endif
+  out->confidence_q8 = BREATH_NN_CONFIDENCE;
+  return true;
+}
+
+// The CNN csi_process() advances per decimated sample; only its head runs here
+static bool estimate_cnn(const csi_breath_window_t *window, csi_breath_estimate_t *out)
+{
+  const csi_session_t *session = window->context;
+  if (!s_cnn_loaded || !csi_cnn_output(&s_cnn_model, &session->breath_cnn, &out->bpm_q8))
+    return false;
+  out->confidence_q8 = BREATH_CNN_CONFIDENCE;
+  return true;
+}
+
+// The sliding DFT csi_process() keeps up to date, judged by its in-band SNR
+static bool estimate_spectral(const csi_breath_window_t *window, csi_breath_estimate_t *out)
+{
+  const csi_session_t *session = window->context;
+  float peak_hz, magnitude;
+  if (!csi_sdft_peak(&session->breath_sdft, &peak_hz, &magnitude))
+    return false;
+  out->bpm_q8 = (int32_t)lrintf(peak_hz * 60.0f * CSI_Q8_ONE);
+  out->confidence_q8 = csi_ensemble_snr_confidence(magnitude, csi_sdft_band_mean(&session->breath_sdft));
+  return true;
+}
+
+// Crest counting, csi_process() feeds it; judged by how regular the crests are
+static bool estimate_peak(const csi_breath_window_t *window, csi_breath_estimate_t *out)
+{
+  const csi_session_t *session = window->context;
+  if (session->peak_breathing_rate == 0)
+    return false;
+  out->bpm_q8 = session->peak_breathing_rate * CSI_Q8_ONE;
+  out->confidence_q8 = csi_peak_confidence_q8(&session->breath_peaks);
+  return true;
+}
+
+// Hann-windowed FFT of the whole decimated series, strongest in-band bin refined by a parabola
+static bool estimate_fft(const csi_breath_window_t *window, csi_breath_estimate_t *out)
+{
+  static csi_complex_t spectrum[CSI_SERIES_LENGTH / 2 + 1];
+  static float magnitude[CSI_SERIES_LENGTH / 2 + 1];
+  if (window->series == NULL || window->series_length != s_breath_fft.n)
+    return false;
+  csi_fft_real(&s_breath_fft, window->series, spectrum);
+
+  float bin_hz = window->rate_hz / window->series_length;
+  int lo = (int)ceilf(BREATH_MIN_HZ / bin_hz);
+  int hi = (int)(BREATH_MAX_HZ / bin_hz);
+  if (lo < 1)
+    lo = 1;
+  if (hi > window->series_length / 2 - 1)
+    hi = window->series_length / 2 - 1;
+  if (hi < lo)
+    return false;
+
+  int peak = lo;
+  float band = 0.0f;
+  for (int k = lo - 1; k <= hi + 1; k++)
   {
-    ESP_LOGI(TAG, "Sufficient data collected, performing breathing rate estimation...");
-    float features[FEATURE_SIZE];
+    magnitude[k] = sqrtf(spectrum[k].re * spectrum[k].re + spectrum[k].im * spectrum[k].im);
+    if (k < lo || k > hi)
+      continue;
+    band += magnitude[k];
+    if (magnitude[k] > magnitude[peak])
+      peak = k;
+  }
+  float alpha = magnitude[peak - 1], beta = magnitude[peak], gamma = magnitude[peak + 1];
+  float denom = alpha - 2 * beta + gamma;
+  float refined = denom != 0 ? peak + 0.5f * (alpha - gamma) / denom : (float)peak;
+  out->bpm_q8 = (int32_t)lrintf(refined * bin_hz * 60.0f * CSI_Q8_ONE);
+  out->confidence_q8 = csi_ensemble_snr_confidence(beta, band / (hi - lo + 1));
+  return true;
+}
 
-    // The functions in breathing_rate_evaluation_svm.c are used for processing
-    ESP_LOGI(TAG, "Extracting features from CSI data...");
-    extract_features(csi_buffer, features);
+static void breath_ensemble_init(void)
+{
+  // Registered in CSI_EST_* order, so slot i is bit i of "est"
+  static const char *const names[CSI_EST_COUNT] = CSI_EST_NAMES;
+  csi_ensemble_init(&s_breath_ensemble, csi_trace_cycles);
+  csi_ensemble_add(&s_breath_ensemble, names[CSI_EST_SVM], estimate_svm);
+  csi_ensemble_add(&s_breath_ensemble, names[CSI_EST_SPECTRAL], estimate_spectral);
+  csi_ensemble_add(&s_breath_ensemble, names[CSI_EST_PEAK], estimate_peak);
+  csi_ensemble_add(&s_breath_ensemble, names[CSI_EST_FFT], estimate_fft);
+  csi_ensemble_add(&s_breath_ensemble, names[CSI_EST_NN], estimate_nn);
+  csi_ensemble_add(&s_breath_ensemble, names[CSI_EST_CNN], estimate_cnn);
+  if (!csi_fft_plan_init(&s_breath_fft, CSI_SERIES_LENGTH, CSI_FFT_WINDOW_HANN, s_breath_fft_storage,
+                         sizeof(s_breath_fft_storage) / sizeof(s_breath_fft_storage[0])))
+    ESP_LOGE(TAG, "No FFT plan for a %d point breathing series", CSI_SERIES_LENGTH);
+}
 
-    // Log extracted features
-    for (int i = 0; i < FEATURE_SIZE; i++)
+// Switch estimators on and off; the streaming ones restart from the state they missed
+static void breath_ensemble_configure(const csi_params_t *params)
+{
+  uint32_t enabled = params->estimators & ((1u << s_breath_ensemble.count) - 1);
+  uint32_t changed = enabled ^ s_breath_ensemble.enabled;
+  s_breath_ensemble.enabled = enabled;
+  for (int i = 0; i < s_session_table.count; i++)
+  {
+    csi_session_t *session = &s_sessions[i];
+    if (changed & (1u << CSI_EST_SPECTRAL))
     {
-      ESP_LOGD(TAG, "Feature[%d]: %.2f", i, features[i]);
+      // Rebuild the sliding DFT from the series it skipped
+      csi_sdft_reset(&session->breath_sdft);
+      uint32_t count = session->amp_series_count;
+      uint32_t kept = count < CSI_SERIES_LENGTH ? count : CSI_SERIES_LENGTH;
+      for (uint32_t j = count - kept; j < count; j++)
+        csi_sdft_push(&session->breath_sdft, session->amp_series[j % CSI_SERIES_LENGTH], 0.0f);
+      session->spectral_breathing_rate = 0;
     }
+    if (changed & (1u << CSI_EST_PEAK))
+    {
+      csi_peak_reset(&session->breath_peaks);
+      session->peak_breathing_rate = 0;
+    }
+    if ((changed & (1u << CSI_EST_CNN)) && s_cnn_loaded)
+    {
+      // Replay what the series still holds; the samples are Q8 values, so this is exact
+      csi_cnn_reset(&s_cnn_model, &session->breath_cnn);
+      uint32_t count = session->amp_series_count;
+      uint32_t kept = count < CSI_SERIES_LENGTH ? count : CSI_SERIES_LENGTH;
+      for (uint32_t j = count - kept; j < count; j++)
+        csi_cnn_push(&s_cnn_model, &session->breath_cnn,
+                     (int32_t)lrintf(session->amp_series[j % CSI_SERIES_LENGTH] * CSI_Q8_ONE));
+    }
+  }
+}
 
-    ESP_LOGI(TAG, "Predicting breathing rate using features...");
-    float breathing_rate = predict(features);
-
-    ESP_LOGI(TAG, "Estimated breathing rate: %.2f BPM", breathing_rate);
+int breathing_rate_estimation(csi_session_t *session)
+{
+  // Windows of WINDOW_SIZE samples, STEP_SIZE apart, read in time order straight from csi_q.
+  // Nothing is consumed, so motion_detection() keeps seeing the whole history. Only the
+  // latest window due is estimated; an older one would be overwritten straight away.
+  uint32_t first = session->csi_q_end - session->csi_q_index;
+  uint32_t start = 0;
+  bool due = false;
+  while (csi_hop_next(&session->breath_hop, first, session->csi_q_end, &start))
+    due = true;
+
+  if (!due)
+  {
+    CSI_TRACED(CSI_EV_BREATH_WAIT, SESSION_ID(session), session->csi_q_index, 0, 0, 0);
+    // Hold the last estimate between hops; nothing to report before the first window
+    return session->breath_hop.fired == 0 ? 0 : session->breathing_rate;
+  }
 
-    // Move the window (retain the second half of the data)
-    ESP_LOGI(TAG, "Shifting the window...");
-    for (int i = 0; i < WINDOW_SIZE - STEP_SIZE; i++)
+  // One window for every estimator: the raw csi_q samples and the decimated series, oldest first, mean removed
+  static float series[CSI_SERIES_LENGTH];
+  csi_breath_window_t window = {
+      .rate_hz = BREATH_RATE_HZ,
+      .raw = session->csi_q + (start - first),
+      .raw_length = WINDOW_SIZE,
+      .context = session,
+  };
+  if (session->amp_series_count >= CSI_SERIES_LENGTH && breath_estimator_enabled(CSI_EST_FFT))
+  {
+    float mean = 0.0f;
+    for (int i = 0; i < CSI_SERIES_LENGTH; i++)
     {
-      csi_buffer[i] = csi_buffer[i + STEP_SIZE];
-      ESP_LOGD(TAG, "Shifted CSI data[%d]: %.2f", i, csi_buffer[i]);
+      series[i] = session->amp_series[(session->amp_series_count + i) % CSI_SERIES_LENGTH];
+      mean += series[i];
     }
-    buffer_index = WINDOW_SIZE - STEP_SIZE;
+    mean /= CSI_SERIES_LENGTH;
+    for (int i = 0; i < CSI_SERIES_LENGTH; i++)
+      series[i] -= mean;
+    window.series = series;
+    window.series_length = CSI_SERIES_LENGTH;
+  }
 
-    return (int)breathing_rate;
+  csi_breath_estimate_t fused;
+  bool estimated = csi_ensemble_run(&s_breath_ensemble, &window, &fused);
+  for (int i = 0; i < s_breath_ensemble.count; i++)
+  {
+    if (s_breath_ensemble.last_valid & (1u << i))
+      CSI_TRACED(CSI_EV_BREATH_ESTIMATE, SESSION_ID(session), i, s_breath_ensemble.last[i].bpm_q8,
+                 s_breath_ensemble.last[i].confidence_q8, 0);
   }
-  ESP_LOGI(TAG, "Data insufficient, continuing to collect...");
-  return 0; // Insufficient data. Continue collecting
+  if (!estimated)
+    return session->breathing_rate;
+  CSI_TRACED(CSI_EV_BREATH, SESSION_ID(session), fused.bpm_q8, fused.confidence_q8, 0, 0);
+  return fused.bpm_q8 / CSI_Q8_ONE;
 }
 
 int64_t get_current_time()
@@ -321,37 +823,49 @@ int64_t get_current_time()
   return time_ms;
 }
 
-void mqtt_send(bool motion_detected, int breathing_rate)
+void mqtt_send(csi_session_t *session, bool motion_detected, int breathing_rate)
 {
   // TODO: Implement MQTT message sending using CSI data or Results
   // NOTE: If you implement the algorithm on-board, you can return the results to the host, else send the CSI data.
-  if (!wifi_connected)
+  // Logged once per change of reason, not once per packet while the link is down
+  const char *down = !wifi_connected                          ? "WiFi not connected"
+                     : mqtt_client == NULL || !mqtt_connected ? "MQTT client not initialized or not connected"
+                                                              : NULL;
+  if (down != s_mqtt_down)
   {
-    ESP_LOGE(TAG, "Can't send MQTT: WiFi not connected");
-    return;
+    if (down)
+      ESP_LOGE(TAG, "Can't send MQTT: %s", down);
+    else
+      ESP_LOGI(TAG, "MQTT sending resumed, %lu sends skipped", (unsigned long)s_mqtt_skipped);
+    s_mqtt_down = down;
+    s_mqtt_skipped = 0;
   }
-  if (mqtt_client == NULL || !mqtt_connected)
+  if (down)
   {
-    ESP_LOGE(TAG, "Can't send MQTT: MQTT client not initialized or not connected");
+    s_mqtt_skipped++;
     return;
   }
 
   // 节流，此处时间应该还能继续调整
-  if (get_current_time() - last_send_time < 5000000)
+  if (get_current_time() - session->last_send_time < (int64_t)s_active_params->send_interval_ms * 1000)
   {
     return;
   }
-  last_send_time = get_current_time();
+  session->last_send_time = get_current_time();
 
   // Message creation
   char message[256];
 
   // 按需传参，csi_samples 也没必要但是先放着里了
   snprintf(message, sizeof(message),
-           "{\"csi_samples\":%d,\"motion_detected\":%s,\"breathing_rate\":%d}",
-           CSI_Q_INDEX,
+           "{\"mac\":\"" MACSTR "\",\"csi_samples\":%d,\"motion_detected\":%s,\"breathing_rate\":%d,"
+           "\"spectral_breathing_rate\":%d,\"peak_breathing_rate\":%d}",
+           MAC2STR(s_session_table.macs[session - s_sessions]),
+           session->csi_q_index,
            motion_detected ? "true" : "false",
-           breathing_rate);
+           breathing_rate,
+           session->spectral_breathing_rate,
+           session->peak_breathing_rate);
 
   ESP_LOGI(TAG, "MQTT message prepared: %s", message);
 
@@ -365,23 +879,17 @@ void mqtt_send(bool motion_detected, int breathing_rate)
   {
     ESP_LOGI(TAG, "MQTT message published successfully, ID: %d", msg_id);
   }
-  // subscribe
-  // static bool subscribed = false;
-  // if (!subscribed) {
-  //   int sub_msg_id = esp_mqtt_client_subscribe(mqtt_client, "rx/cmd", 0);
-  //   if (sub_msg_id < 0) {
-  //     ESP_LOGE(TAG, "Failed to subscribe to MQTT topic");
-  //   } else {
-  //     ESP_LOGI(TAG, "MQTT topic subscribed successfully, ID: %d", sub_msg_id);
-  //     subscribed = true;
-  //   }
-  // }
-  // Regularly clean the buffer and retain the latest CSI_FIFO_LENGTH samples
-  if (CSI_Q_INDEX > CSI_FIFO_LENGTH * 1.5)
+  // Regularly clean the buffer down to the latest CSI_FIFO_LENGTH samples, but never past the
+  // start of the next breathing window: csi_hop_next() would skip it, and with a short send_ms
+  // no window would ever fill
+  uint32_t first = session->csi_q_end - session->csi_q_index;
+  int drop = csi_hop_droppable(&session->breath_hop, first, session->csi_q_end, CSI_FIFO_LENGTH);
+  if (session->csi_q_index > CSI_FIFO_LENGTH * 1.5 && drop > 0)
   {
-    memmove(CSI_Q, CSI_Q + (CSI_Q_INDEX - CSI_FIFO_LENGTH), CSI_FIFO_LENGTH * sizeof(int16_t));
-    CSI_Q_INDEX = CSI_FIFO_LENGTH;
-    ESP_LOGI(TAG, "CSI buffer trimmed to %d samples", CSI_Q_INDEX);
+    csi_motion_drop(&session->motion, drop);
+    memmove(session->csi_q, session->csi_q + drop, (session->csi_q_index - drop) * sizeof(int16_t));
+    session->csi_q_index -= drop;
+    ESP_LOGI(TAG, "CSI buffer trimmed to %d samples", session->csi_q_index);
   }
 }
 // [2] END OF YOUR CODE
@@ -406,9 +914,6 @@ void mqtt_send(bool motion_detected, int breathing_rate)
 #define DEFAULT_SCAN_METHOD WIFI_FAST_SCAN
 #endif /*CONFIG_EXAMPLE_SCAN_METHOD*/
 //
-// !Note: change to your current setting
-static const uint8_t CONFIG_CSI_SEND_MAC[] = {0x00, 0x03, 0x7f, 0x00, 0x00, 0x00};
-// static const uint8_t CONFIG_CSI_SEND_MAC[] = {0x64, 0x2c, 0xac, 0xa2, 0x3f, 0x93};
 // Obtain the MAC address of the device itself
 // static uint8_t local_mac[6];
 // esp_wifi_get_mac(WIFI_IF_STA, local_mac);
@@ -548,41 +1053,20 @@ static void wifi_esp_now_init(esp_now_peer_info_t peer)
 }
 
 //------------------------------------------------------CSI Callback------------------------------------------------------
+// Runs on the Wi-Fi task: only filter, copy the frame into a pool slot, queue it and wake csi_task.
 static void wifi_csi_rx_cb(void *ctx, wifi_csi_info_t *info)
 {
-  if (!info || !info->buf)
-    return;
-
-  ESP_LOGI(TAG, "CSI callback triggered");
-
-  // Applying the CSI_Q_ENABLE flag to determine the output method
-  // 1: Enable, using buffer, 0: Disable, using serial output
-  if (!CSI_Q_ENABLE)
-  {
-    ets_printf("CSI_DATA,%d," MACSTR ",%d,%d,%d,%d\n",
-               info->len, MAC2STR(info->mac), info->rx_ctrl.rssi,
-               info->rx_ctrl.rate, info->rx_ctrl.noise_floor,
-               info->rx_ctrl.channel);
-  }
-  else
-  {
-    csi_process(info->buf, info->len);
-  }
-
   if (!info || !info->buf)
   {
     ESP_LOGW(TAG, "<%s> wifi_csi_cb", esp_err_to_name(ESP_ERR_INVALID_ARG));
     return;
   }
 
-  ESP_LOGI(TAG, "Received MAC: " MACSTR ", Expected MAC: " MACSTR,
-           MAC2STR(info->mac), MAC2STR(CONFIG_CSI_SEND_MAC));
-
-  if (memcmp(info->mac, CONFIG_CSI_SEND_MAC, 6))
-  {
-    ESP_LOGI(TAG, "MAC address doesn't match, skipping packet");
+  // Foreign frames in promiscuous mode stop here, after a single hash probe
+  int session_id = csi_session_lookup(&s_session_table, info->mac);
+  if (session_id < 0)
     return;
-  }
+
   // extern uint8_t local_mac[6]; // Declare external variables
 
   // ESP_LOGI(TAG, "Received MAC: " MACSTR ", Local MAC: " MACSTR,
@@ -598,100 +1082,604 @@ static void wifi_csi_rx_cb(void *ctx, wifi_csi_info_t *info)
   static int s_count = 0;
 
 #if CONFIG_GAIN_CONTROL
-  static uint16_t agc_gain_sum = 0;
-  static uint16_t fft_gain_sum = 0;
-  static uint8_t agc_gain_force_value = 0;
-  static uint8_t fft_gain_force_value = 0;
-  if (s_count < 100)
-  {
-    agc_gain_sum += phy_info->agc_gain;
-    fft_gain_sum += phy_info->fft_gain;
-  }
-  else if (s_count == 100)
+  // Learn the gains, force them, and re-learn whenever the RSSI drifts past the hysteresis
+  switch (csi_gain_update(&s_gain, info->rx_ctrl.rssi, phy_info->agc_gain, phy_info->fft_gain))
   {
-    agc_gain_force_value = agc_gain_sum / 100;
-    fft_gain_force_value = fft_gain_sum / 100;
+  case CSI_GAIN_FORCE:
 #if CONFIG_FORCE_GAIN
-    phy_fft_scale_force(1, fft_gain_force_value);
-    phy_force_rx_gain(1, agc_gain_force_value);
+    phy_fft_scale_force(1, s_gain.fft_force);
+    phy_force_rx_gain(1, s_gain.agc_force);
 #endif
-    ESP_LOGI(TAG, "fft_force %d, agc_force %d", fft_gain_force_value, agc_gain_force_value);
+    ESP_LOGI(TAG, "fft_force %d, agc_force %d (epoch %d, rssi %d)",
+             s_gain.fft_force, s_gain.agc_force, s_gain.epoch, s_gain.rssi_learned);
+    break;
+  case CSI_GAIN_RELEASE:
+#if CONFIG_FORCE_GAIN
+    phy_fft_scale_force(0, 0);
+    phy_force_rx_gain(0, 0);
+#endif
+    ESP_LOGI(TAG, "RSSI drifted to %d (learned at %d), re-learning gains",
+             (int)(s_gain.rssi_ewma >> CSI_GAIN_RSSI_SHIFT), s_gain.rssi_learned);
+    break;
+  default:
+    break;
   }
 #endif
 
   const wifi_pkt_rx_ctrl_t *rx_ctrl = &info->rx_ctrl;
-  if (CSI_Q_ENABLE == 0)
+  // Applying the CSI_Q_ENABLE flag to determine the output method
+  // 1: Enable, using buffer, 0: Disable, using serial output
+  // Both go through the ring; csi_task either processes the frame or writes it to the UART
+  int seq = s_count++;
+
+  if (info->len > CSI_FRAME_MAX_LEN)
+  {
+    csi_ring_drop_oversize(&s_csi_ring);
+    return;
+  }
+  csi_frame_t *frame = csi_pool_alloc(&s_csi_pool);
+  if (frame == NULL)
+    return; // Every slot is still referenced, counted as a drop; csi_task is behind
+
+  csi_frame_meta_t *meta = &frame->meta;
+  memcpy(meta->mac, info->mac, 6);
+  meta->rssi = rx_ctrl->rssi;
+  meta->rate = rx_ctrl->rate;
+  meta->sig_mode = rx_ctrl->sig_mode;
+  meta->cwb = rx_ctrl->cwb;
+  meta->stbc = rx_ctrl->stbc;
+  meta->noise_floor = rx_ctrl->noise_floor;
+  meta->channel = rx_ctrl->channel;
+  meta->fft_gain = phy_info->fft_gain;
+  meta->agc_gain = phy_info->agc_gain;
+  meta->gain_epoch = s_gain.forced ? s_gain.epoch : 0;
+  meta->timestamp = rx_ctrl->timestamp;
+  meta->sig_len = rx_ctrl->sig_len;
+  meta->rx_state = rx_ctrl->rx_state;
+  meta->first_word_invalid = info->first_word_invalid;
+  meta->len = info->len;
+  meta->session = session_id;
+  meta->seq = seq;
+  // The only copy of the CSI payload; every later stage borrows this slot
+  memcpy(frame->buf, info->buf, info->len);
+  if (!csi_ring_push(&s_csi_ring, frame))
+  {
+    csi_pool_release(&s_csi_pool, frame);
+    return;
+  }
+  CSI_TRACED(CSI_EV_RX, session_id, info->len, rx_ctrl->rssi, rx_ctrl->timestamp, 0);
+
+  if (s_csi_task != NULL)
+    xTaskNotifyGive(s_csi_task);
+}
+
+//------------------------------------------------------CSI Serial Output------------------------------------------------------
+static bool csi_serial_init(void)
+{
+  esp_err_t err = uart_driver_install(CONFIG_ESP_CONSOLE_UART_NUM, 256, CSI_SERIAL_TX_BUFFER, 0, NULL, 0);
+  if (err != ESP_OK)
   {
-    ESP_LOGI(TAG, "================ CSI RECV via Serial Port ================");
-    ets_printf("type, seq, mac, rssi, rate, noise_floor, fft_gain, agc_gain, channel, timestamp, sig_len, rx_state, len, first_word_invalid, data \n");
-    ets_printf("CSI_DATA,%d," MACSTR ",%d,%d,%d,%d,%d,%d,%d,%d,%d",
-               s_count++, MAC2STR(info->mac), rx_ctrl->rssi, rx_ctrl->rate,
-               rx_ctrl->noise_floor, phy_info->fft_gain, phy_info->agc_gain, rx_ctrl->channel,
-               rx_ctrl->timestamp, rx_ctrl->sig_len, rx_ctrl->rx_state);
-    ets_printf(",%d,%d,\"[%d", info->len, info->first_word_invalid, info->buf[0]);
+    ESP_LOGE(TAG, "Failed to install UART driver for the CSI dump: %s", esp_err_to_name(err));
+    return false;
+  }
+  ESP_LOGI(TAG, "================ CSI RECV via Serial Port (%s) ================",
+           CSI_SERIAL_BINARY ? "binary" : "text");
+  // Console logs share the UART; keep them from splitting packets apart
+  esp_log_level_set("*", ESP_LOG_ERROR);
+#if !CSI_SERIAL_BINARY
+  static const char header[] = "type, seq, mac, rssi, rate, noise_floor, fft_gain, agc_gain, channel, timestamp, "
+                               "sig_len, rx_state, len, first_word_invalid, data \n";
+  uart_write_bytes(CONFIG_ESP_CONSOLE_UART_NUM, header, sizeof(header) - 1);
+#endif
+  return true;
+}
+
+/**
+ * @brief Write one frame to the console UART in a single call.
+ */
+static void csi_serial_send(const csi_frame_t *frame)
+{
+#if CSI_SERIAL_BINARY
+  static uint8_t out[CSI_SERIAL_MAX_FRAME];
+  size_t len = csi_serial_encode(&frame->meta, frame->buf, out, sizeof(out));
+#else
+  // Worst case "-128," per byte plus the fixed fields
+  static char out[CSI_FRAME_MAX_LEN * 5 + 160];
+  const csi_frame_meta_t *meta = &frame->meta;
+  int len = snprintf(out, sizeof(out), "CSI_DATA,%lu," MACSTR ",%d,%d,%d,%d,%d,%d,%lu,%d,%d,%d,%d,\"[",
+                     (unsigned long)meta->seq, MAC2STR(meta->mac), meta->rssi, meta->rate,
+                     meta->noise_floor, meta->fft_gain, meta->agc_gain, meta->channel,
+                     (unsigned long)meta->timestamp, meta->sig_len, meta->rx_state, meta->len,
+                     meta->first_word_invalid);
+  for (int i = 0; i < meta->len; i++)
+    len += snprintf(out + len, sizeof(out) - len, i ? ",%d" : "%d", frame->buf[i]);
+  len += snprintf(out + len, sizeof(out) - len, "]\"\n");
+#endif
+  if (len > 0)
+    uart_write_bytes(CONFIG_ESP_CONSOLE_UART_NUM, out, len);
+}
 
-    for (int i = 1; i < info->len; i++)
+//------------------------------------------------------Runtime Parameters------------------------------------------------------
+// Stored parameters if NVS holds a valid set, the built-in ones otherwise. Runs before MQTT can deliver commands.
+// Use the newest stored breathing model that folds, else the built-in one
+static void models_init()
+{
+  esp_err_t err = csi_model_store_open(&s_svm_store, SVM_MODEL_PARTITION, CSI_MODEL_LINEAR);
+  if (err != ESP_OK)
+  {
+    ESP_LOGW(TAG, "No usable " SVM_MODEL_PARTITION " partition (%s), breathing model updates disabled",
+             esp_err_to_name(err));
+    s_svm_store.partition = NULL;
+    return;
+  }
+  int newest = csi_model_store_newest(&s_svm_store);
+  for (int i = 0; newest >= 0 && i < CSI_MODEL_SLOTS; i++)
+  {
+    int slot = i == 0 ? newest : (newest + i) % CSI_MODEL_SLOTS;
+    const char *reason;
+    if (!s_svm_store.valid[slot])
+      continue;
+    if (!svm_model_from_blob(&s_svm_store.models[slot], &s_svm_models[slot], &reason))
     {
-      ets_printf(",%d", info->buf[i]);
+      ESP_LOGW(TAG, "Stored breathing model in slot %d rejected: %s", slot, reason);
+      continue;
     }
-    ets_printf("]\"\n");
+    svm_model_use(&s_svm_models[slot]);
+    atomic_store(&s_svm_model_slot, slot);
+    ESP_LOGI(TAG, "Breathing model sequence %lu from slot %d", (unsigned long)s_svm_models[slot].sequence, slot);
+    return;
   }
+  ESP_LOGI(TAG, "No stored breathing model, using the built-in one");
+}
 
+// The newest network in nn_model that loads, else the built-in one. A blob may carry the
+// "means" and "scales" its network was trained behind; without them the SVM's are used.
+static void nn_init()
+{
+  const void *model = NULL;
+  const float *nn_means = means, *nn_scales = scales;
+  int slot = -1;
+  if (csi_model_store_open(&s_nn_store, NN_MODEL_PARTITION, CSI_MODEL_TFLITE) == ESP_OK)
+    slot = csi_model_store_newest(&s_nn_store);
+  if (slot >= 0)
+  {
+    const csi_model_t *blob = &s_nn_store.models[slot];
+    const float *blob_means = csi_model_tensor(blob, "means", CSI_MODEL_F32, FEATURE_SIZE);
+    const float *blob_scales = csi_model_tensor(blob, "scales", CSI_MODEL_F32, FEATURE_SIZE);
+    model = csi_model_tensor(blob, "tflite", CSI_MODEL_U8, 0);
+    if (blob_means && blob_scales)
+    {
+      nn_means = blob_means;
+      nn_scales = blob_scales;
+    }
+    if (nn_breathing_init(model, nn_means, nn_scales))
+    {
+      ESP_LOGI(TAG, "Neural network sequence %lu from slot %d, arena %u of %d bytes",
+               (unsigned long)blob->header->sequence, slot, (unsigned)nn_breathing_arena_used(), NN_ARENA_SIZE);
+      return;
+    }
+    ESP_LOGW(TAG, "Stored neural network in slot %d does not load, using the built-in one", slot);
+  }
+  if (nn_breathing_init(NULL, means, scales))
+    ESP_LOGI(TAG, "Built-in %s neural network, arena %u of %d bytes", NN_MODEL_INT8 ? "int8" : "float",
+             (unsigned)nn_breathing_arena_used(), NN_ARENA_SIZE);
   else
+    ESP_LOGE(TAG, "Built-in neural network does not load");
+}
+
+// The newest CNN in cnn_model that loads; there is no fallback
+static void cnn_init()
+{
+  if (csi_model_store_open(&s_cnn_store, CNN_MODEL_PARTITION, CSI_MODEL_CNN) != ESP_OK)
+  {
+    ESP_LOGI(TAG, "No " CNN_MODEL_PARTITION " partition, CNN estimator off");
+    return;
+  }
+  int newest = csi_model_store_newest(&s_cnn_store);
+  for (int i = 0; newest >= 0 && i < CSI_MODEL_SLOTS; i++)
+  {
+    int slot = (newest + i) % CSI_MODEL_SLOTS;
+    const char *reason;
+    if (!s_cnn_store.valid[slot])
+      continue;
+    if (!csi_cnn_model_from_blob(&s_cnn_store.models[slot], &s_cnn_model, &reason))
+    {
+      ESP_LOGW(TAG, "Stored CNN in slot %d rejected: %s", slot, reason);
+      continue;
+    }
+    s_cnn_loaded = true;
+    ESP_LOGI(TAG, "CNN sequence %lu from slot %d: %d layers, receptive field %d samples, pool %d",
+             (unsigned long)s_cnn_model.sequence, slot, s_cnn_model.layer_count, s_cnn_model.receptive_field,
+             s_cnn_model.pool);
+    return;
+  }
+  ESP_LOGI(TAG, "No stored CNN, CNN estimator off");
+}
+
+static void params_init()
+{
+  csi_params_t params;
+  esp_err_t err = csi_params_load(&params);
+  if (err != ESP_OK)
+  {
+    if (err != ESP_ERR_NVS_NOT_FOUND)
+      ESP_LOGW(TAG, "Stored parameters unusable (%s), using defaults", esp_err_to_name(err));
+    csi_params_defaults(&params);
+  }
+  csi_params_exchange_init(&s_params, &params);
+  s_params_staged = params;
+  s_active_params = csi_params_acquire(&s_params);
+  char text[CSI_PARAMS_MAX_COMMAND];
+  csi_params_format(&params, text, sizeof(text));
+  ESP_LOGI(TAG, "Parameters (%s): %s", err == ESP_OK ? "stored" : "defaults", text);
+}
+
+// Bring a session's detector state in line with @p params
+static void session_apply_params(csi_session_t *session, const csi_params_t *params, bool reset_votes)
+{
+  csi_motion_configure(&session->motion, params->window, params->alpha_num, params->alpha_den);
+  if (reset_votes)
   {
-    ESP_LOGI(TAG, "================ CSI RECV via Buffer ================");
-    csi_process(info->buf, info->len);
+    memset(session->last_few_results, 0, sizeof(session->last_few_results));
+    session->history_index = 0;
   }
+  if (session->continuous_motion_count > params->continuous_max)
+    session->continuous_motion_count = params->continuous_max;
 }
 
+//------------------------------------------------------CSI Processing Task------------------------------------------------------
+static void csi_task(void *arg)
+{
+  int64_t last_stats_time = 0;
+  while (true)
+  {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    // The set acquired here stays valid until the next acquire, so the whole batch sees one generation.
+    // The previous set's slot may be rewritten as soon as we acquire, so read what we need from it first.
+    uint32_t generation = s_active_params->generation;
+    uint8_t vote_window = s_active_params->vote_window;
+    const csi_params_t *params = csi_params_acquire(&s_params);
+    if (params->generation != generation)
+    {
+      for (int i = 0; i < s_session_table.count; i++)
+        session_apply_params(&s_sessions[i], params, params->vote_window != vote_window);
+      breath_ensemble_configure(params);
+      s_active_params = params;
+      ESP_LOGI(TAG, "Parameters generation %lu in use", (unsigned long)params->generation);
+    }
+    // A new breathing model takes over here, between batches, so no window mixes two models.
+    // Publish the slot in use before clearing pending: the MQTT task picks its slot from both.
+    int model_slot = atomic_load(&s_svm_model_pending);
+    if (model_slot >= 0)
+    {
+      svm_model_use(&s_svm_models[model_slot]);
+      atomic_store(&s_svm_model_slot, model_slot);
+      atomic_store(&s_svm_model_pending, -1);
+      ESP_LOGI(TAG, "Breathing model sequence %lu in use", (unsigned long)s_svm_models[model_slot].sequence);
+    }
+
+    // Drain everything queued so far, CSI_TASK_BATCH frames at a time
+    uint32_t available;
+    while ((available = csi_ring_available(&s_csi_ring)) > 0)
+    {
+      uint32_t batch = available < CSI_TASK_BATCH ? available : CSI_TASK_BATCH;
+      csi_frame_t *frames[CSI_TASK_BATCH];
+      for (uint32_t i = 0; i < batch; i++)
+        frames[i] = csi_ring_peek(&s_csi_ring, i);
+      csi_ring_consume(&s_csi_ring, batch);
+
+      for (uint32_t i = 0; i < batch; i++)
+      {
+        if (CSI_Q_ENABLE)
+          csi_process(frames[i]);
+        else
+          csi_serial_send(frames[i]);
+        csi_pool_release(&s_csi_pool, frames[i]);
+      }
+    }
+
+    if (get_current_time() - last_stats_time > 10000000)
+    {
+      csi_ring_stats_t stats;
+      csi_ring_get_stats(&s_csi_ring, &stats);
+      ESP_LOGI(TAG, "CSI ring: pushed=%lu, popped=%lu, dropped_full=%lu, dropped_oversize=%lu, high_water=%lu/%d",
+               (unsigned long)stats.pushed, (unsigned long)stats.popped,
+               (unsigned long)stats.dropped_full, (unsigned long)stats.dropped_oversize,
+               (unsigned long)stats.high_water, CSI_RING_CAPACITY);
+      csi_pool_stats_t pool_stats;
+      csi_pool_get_stats(&s_csi_pool, &pool_stats);
+      ESP_LOGI(TAG, "CSI pool: in_use=%lu, high_water=%lu/%d, alloc_failed=%lu",
+               (unsigned long)pool_stats.in_use, (unsigned long)pool_stats.high_water,
+               CSI_POOL_SIZE, (unsigned long)pool_stats.alloc_failed);
+      for (int i = 0; i < s_session_table.count; i++)
+      {
+        const csi_resampler_stats_t *rs = &s_sessions[i].resampler.stats;
+        ESP_LOGI(TAG, "Session %d " MACSTR ": accepted=%lu, processed=%lu, subcarriers=%d, layout_resets=%lu",
+                 i, MAC2STR(s_session_table.macs[i]),
+                 (unsigned long)csi_session_accepted(&s_session_table, i),
+                 (unsigned long)s_sessions[i].processed, s_sessions[i].matrix.subcarriers,
+                 (unsigned long)s_sessions[i].matrix.layout_resets);
+        ESP_LOGI(TAG, "Session %d breathing windows: fired=%lu, skipped=%lu",
+                 i, (unsigned long)s_sessions[i].breath_hop.fired, (unsigned long)s_sessions[i].breath_hop.skipped);
+#if CSI_Q_PCA
+        const csi_pca_t *pca = &s_sessions[i].pca;
+        ESP_LOGI(TAG, "Session %d PCA: subcarriers=[%d %d %d %d %d %d %d %d], explained=%d%%, swaps=%lu",
+                 i, pca->selected[0], pca->selected[1], pca->selected[2], pca->selected[3],
+                 pca->selected[4], pca->selected[5], pca->selected[6], pca->selected[7],
+                 csi_pca_explained_pct(pca), (unsigned long)pca->swaps);
+#endif
+        ESP_LOGI(TAG, "Session %d resampler: %d Hz, emitted=%lu, gaps=%lu, out_of_order=%lu",
+                 i, CSI_SAMPLE_RATE_HZ, (unsigned long)rs->emitted, (unsigned long)rs->gaps,
+                 (unsigned long)rs->out_of_order);
+      }
+      for (int i = 0; i < s_breath_ensemble.count; i++)
+      {
+        const csi_estimator_slot_t *slot = &s_breath_ensemble.slots[i];
+        ESP_LOGI(TAG, "Breathing estimator %s: %s, runs=%lu, valid=%lu, cycles=%lu/run (max %lu)",
+                 slot->name, breath_estimator_enabled(i) ? "on" : "off", (unsigned long)slot->runs,
+                 (unsigned long)slot->valid, (unsigned long)csi_ensemble_mean_cost(&s_breath_ensemble, i),
+                 (unsigned long)slot->cost_max);
+      }
+      ESP_LOGI(TAG, "Rejected foreign frames: %lu", (unsigned long)csi_session_rejected(&s_session_table));
+      ESP_LOGI(TAG, "Gain: %s, epoch=%d, agc=%d, fft=%d, rssi=%d (learned %d), forces=%lu, releases=%lu",
+               s_gain.forced ? "forced" : "learning", s_gain.epoch, s_gain.agc_force, s_gain.fft_force,
+               (int)(s_gain.rssi_ewma >> CSI_GAIN_RSSI_SHIFT), s_gain.rssi_learned,
+               (unsigned long)s_gain.stats.forces, (unsigned long)s_gain.stats.releases);
+      last_stats_time = get_current_time();
+    }
+  }
+}
+
+//------------------------------------------------------CSI Trace Drain Task------------------------------------------------------
+#if CSI_TRACE_LEVEL > CSI_TRACE_LEVEL_NONE
+static void csi_trace_task(void *arg)
+{
+  csi_trace_record_t record;
+  char line[160];
+  uint32_t reported_lost = 0;
+  while (true)
+  {
+    while (csi_trace_read(&record))
+    {
+      csi_trace_format(&record, line, sizeof(line));
+      ESP_LOGI(TAG, "%s", line);
+    }
+    uint32_t lost = csi_trace_lost();
+    if (lost != reported_lost)
+    {
+      ESP_LOGW(TAG, "CSI trace: %lu records overwritten before they were printed", (unsigned long)(lost - reported_lost));
+      reported_lost = lost;
+    }
+    vTaskDelay(pdMS_TO_TICKS(CSI_TRACE_TASK_PERIOD_MS));
+  }
+}
+#endif
+
 //------------------------------------------------------CSI Processing & Algorithms------------------------------------------------------
-static void csi_process(const int8_t *csi_data, int length)
+static void csi_process(const csi_frame_t *frame)
 {
-  ESP_LOGI(TAG, "CSI Processing...");
-  if (CSI_Q_INDEX + length > CSI_BUFFER_LENGTH)
+  const int8_t *csi_data = frame->buf;
+  int length = frame->meta.len;
+  csi_session_t *session = &s_sessions[frame->meta.session];
+  uint32_t start_cycles = csi_trace_cycles();
+  session->processed++;
+  int incoming = CSI_Q_PCA ? 1 : length;
+  if (session->csi_q_index + incoming > CSI_BUFFER_LENGTH)
+  {
+    // Drop the oldest samples actually held; the buffer may not be full yet
+    int shift = session->csi_q_index < CSI_FIFO_LENGTH ? session->csi_q_index : CSI_FIFO_LENGTH;
+    memmove(session->csi_q, session->csi_q + shift, (session->csi_q_index - shift) * sizeof(int16_t));
+    session->csi_q_index -= shift;
+    csi_motion_drop(&session->motion, shift);
+  }
+  CSI_TRACED(CSI_EV_PROCESS, frame->meta.session, session->csi_q_index, length, 0, 0);
+  // Brings frames captured at other gains back to the reference gains the thresholds were tuned at
+  uint16_t gain_scale = csi_gain_scale_q8(&s_gain, &session->gain_cache, frame->meta.agc_gain, frame->meta.fft_gain);
+
+  // Decode the LTF into one time x subcarrier row for the per-subcarrier stages
+#if CSI_Q_PCA
+  int16_t component = 0;
+  bool have_component = false;
+#endif
+  if (!csi_matrix_push(&session->matrix, frame))
+  {
+    ESP_LOGD(TAG, "Unknown CSI layout (sig_mode=%d, cwb=%d, stbc=%d, len=%d), not added to the CSI matrix",
+             frame->meta.sig_mode, frame->meta.cwb, frame->meta.stbc, length);
+  }
+  else
   {
-    int shift_size = CSI_BUFFER_LENGTH - CSI_FIFO_LENGTH;
-    memmove(CSI_Q, CSI_Q + CSI_FIFO_LENGTH, shift_size * sizeof(int16_t));
-    CSI_Q_INDEX = shift_size;
+#if CSI_Q_PCA
+    // Only csi_q consumes the component; without it the per-packet PCA work is skipped
+    have_component = csi_pca_update(&session->pca, &session->matrix, &component);
+#endif
+    float grid[CSI_RESAMPLE_MAX_OUT];
+    bool restarted;
+    float mean_amp = csi_matrix_mean_amp(&session->matrix) * gain_scale / (1 << 8);
+    int n = csi_resampler_push(&session->resampler, frame->meta.timestamp,
+                               mean_amp, grid, CSI_RESAMPLE_MAX_OUT, &restarted);
+    if (restarted)
+    {
+      ESP_LOGW(TAG, "CSI gap over %d ms, restarting the uniform series", CSI_RESAMPLE_MAX_GAP_US / 1000);
+      session->amp_series_count = 0;
+      csi_decimator_reset(&session->breath_decimator);
+      csi_sdft_reset(&session->breath_sdft);
+      session->spectral_breathing_rate = 0;
+      csi_peak_reset(&session->breath_peaks);
+      session->peak_breathing_rate = 0;
+      if (s_cnn_loaded)
+        csi_cnn_reset(&s_cnn_model, &session->breath_cnn);
+    }
+    int decimated = 0;
+    for (int i = 0; i < n; i++)
+    {
+      // The decimator works in Q8 amplitude
+      int32_t value_q8;
+      if (!csi_decimator_push(&session->breath_decimator, (int32_t)lrintf(grid[i] * CSI_Q8_ONE), &value_q8))
+        continue;
+      float value = value_q8 / (float)CSI_Q8_ONE;
+      float *slot = &session->amp_series[session->amp_series_count % CSI_SERIES_LENGTH];
+      // Streaming estimators charge their per-sample work to the ensemble
+      if (breath_estimator_enabled(CSI_EST_SPECTRAL))
+      {
+        uint32_t cycles = csi_trace_cycles();
+        // The value being overwritten is the one leaving the sliding DFT window
+        csi_sdft_push(&session->breath_sdft, value, session->amp_series_count >= CSI_SERIES_LENGTH ? *slot : 0.0f);
+        csi_ensemble_charge(&s_breath_ensemble, CSI_EST_SPECTRAL, csi_trace_cycles() - cycles);
+      }
+      *slot = value;
+      session->amp_series_count++;
+      decimated++;
+      if (breath_estimator_enabled(CSI_EST_PEAK))
+      {
+        uint32_t cycles = csi_trace_cycles();
+        csi_peak_push(&session->breath_peaks, value_q8);
+        if (session->breath_peaks.count % BREATH_PEAK_STEP == 0)
+          session->peak_breathing_rate = csi_peak_estimate(&session->breath_peaks);
+        csi_ensemble_charge(&s_breath_ensemble, CSI_EST_PEAK, csi_trace_cycles() - cycles);
+      }
+      if (s_cnn_loaded && breath_estimator_enabled(CSI_EST_CNN))
+      {
+        uint32_t cycles = csi_trace_cycles();
+        csi_cnn_push(&s_cnn_model, &session->breath_cnn, value_q8);
+        csi_ensemble_charge(&s_breath_ensemble, CSI_EST_CNN, csi_trace_cycles() - cycles);
+      }
+    }
+    float peak_hz, peak_magnitude;
+    if (decimated > 0 && breath_estimator_enabled(CSI_EST_SPECTRAL) &&
+        csi_sdft_peak(&session->breath_sdft, &peak_hz, &peak_magnitude))
+    {
+      session->spectral_breathing_rate = (int)(peak_hz * 60.0f + 0.5f);
+      CSI_TRACED(CSI_EV_BREATH_SPECTRAL, frame->meta.session, (int32_t)(peak_hz * 60.0f * CSI_Q8_ONE),
+                 csi_trace_f(peak_magnitude), 0, 0);
+    }
   }
-  ESP_LOGI(TAG, "CSI Buffer Status: %d samples stored", CSI_Q_INDEX);
-  // Append new CSI data to the buffer
-  for (int i = 0; i < length && CSI_Q_INDEX < CSI_BUFFER_LENGTH; i++)
+  // Append new CSI data to the buffer. The matrix above decodes straight from the pool slot,
+  // but csi_q cannot borrow it: the slot goes back to the pool once this returns, and the
+  // breathing windows read WINDOW_SIZE contiguous samples spanning many packets. The copy
+  // also applies the gain correction once for csi_motion and the windows. It costs one
+  // pass over the packet, 2 bytes of csi_q per CSI byte.
+  int appended_from = session->csi_q_index;
+#if CSI_Q_PCA
+  (void)csi_data;
+  if (have_component && session->csi_q_index < CSI_BUFFER_LENGTH)
   {
-    CSI_Q[CSI_Q_INDEX++] = (int16_t)csi_data[i];
+    session->csi_q[session->csi_q_index++] = csi_sat16(((int32_t)component * gain_scale) >> 8);
+  }
+#else
+  if (gain_scale == 1 << 8)
+  {
+    for (int i = 0; i < length && session->csi_q_index < CSI_BUFFER_LENGTH; i++)
+    {
+      session->csi_q[session->csi_q_index++] = (int16_t)csi_data[i];
+    }
+  }
+  else
+  {
+    for (int i = 0; i < length && session->csi_q_index < CSI_BUFFER_LENGTH; i++)
+    {
+      session->csi_q[session->csi_q_index++] = csi_sat16(((int32_t)csi_data[i] * gain_scale) >> 8);
+    }
   }
+#endif
+  csi_motion_push(&session->motion, session->csi_q + appended_from, session->csi_q_index - appended_from);
+  session->csi_q_end += session->csi_q_index - appended_from;
 
   // [4] YOUR CODE HERE
 
   // 1. Fill the information of your group members
-  ESP_LOGI(TAG, "================ GROUP INFO ================");
-  const char *TEAM_MEMBER[] = {"Wang Zimo", "Yang Zhuang", "Liu Yuting", "Shen Yuhang"};
-  const char *TEAM_UID[] = {"3036381151", "3036408961", "3036382313", "3036381474"};
-  ESP_LOGI(TAG, "TEAM_MEMBER: %s, %s, %s, %s | TEAM_UID: %s, %s, %s, %s",
-           TEAM_MEMBER[0], TEAM_MEMBER[1], TEAM_MEMBER[2], TEAM_MEMBER[3],
-           TEAM_UID[0], TEAM_UID[1], TEAM_UID[2], TEAM_UID[3]);
-  ESP_LOGI(TAG, "================ END OF GROUP INFO ================");
+  static bool group_info_printed = false;
+  if (!group_info_printed)
+  {
+    ESP_LOGI(TAG, "================ GROUP INFO ================");
+    const char *TEAM_MEMBER[] = {"Wang Zimo", "Yang Zhuang", "Liu Yuting", "Shen Yuhang"};
+    const char *TEAM_UID[] = {"3036381151", "3036408961", "3036382313", "3036381474"};
+    ESP_LOGI(TAG, "TEAM_MEMBER: %s, %s, %s, %s | TEAM_UID: %s, %s, %s, %s",
+             TEAM_MEMBER[0], TEAM_MEMBER[1], TEAM_MEMBER[2], TEAM_MEMBER[3],
+             TEAM_UID[0], TEAM_UID[1], TEAM_UID[2], TEAM_UID[3]);
+    ESP_LOGI(TAG, "================ END OF GROUP INFO ================");
+    group_info_printed = true;
+  }
 
   // 2. Call your algorithm functions here, e.g.: motion_detection(), breathing_rate_estimation(), and mqtt_send()
   // If you implement the algorithm on-board, you can return the results to the host, else send the CSI data.
-  ESP_LOGI(TAG, "================ START OF MOTION DETECTION ================");
-  motion_detected = motion_detection(true);
-  // motion_detected = true;
-  ESP_LOGI(TAG, "Motion detected: %s (Amplitude: %.1f, Intensity: %d)",
-           motion_detected ? "YES" : "NO", g_motion_amplitude, g_motion_intensity);
-  ESP_LOGI(TAG, "================ END OF MOTION DETECTION ================");
-  ESP_LOGI(TAG, "================ START OF BREATH DETECTION ================");
-  breathing_rate = breathing_rate_estimation();
-  // breathing_rate = 12;
-  ESP_LOGI(TAG, "Breathing rate: %d breaths/minute", breathing_rate);
-  ESP_LOGI(TAG, "================ END OF BREATH DETECTION ================");
-  mqtt_send(motion_detected, breathing_rate);
+  bool last_motion_detected = session->motion_detected;
+  int last_breathing_rate = session->breathing_rate;
+  session->motion_detected = motion_detection(session, true);
+  // session->motion_detected = true;
+  session->breathing_rate = breathing_rate_estimation(session);
+  // session->breathing_rate = 12;
+  // Recorded when the reported result changes, not for every packet
+  if (session->motion_detected != last_motion_detected || session->breathing_rate != last_breathing_rate)
+  {
+    CSI_TRACEI(CSI_EV_RESULT, frame->meta.session, session->motion_detected,
+               csi_trace_f(session->motion_amplitude), session->motion_intensity, session->breathing_rate);
+  }
+  mqtt_send(session, session->motion_detected, session->breathing_rate);
+  CSI_TRACED(CSI_EV_PROCESS_DONE, frame->meta.session, csi_trace_cycles() - start_cycles, 0, 0, 0);
   // [4] END YOUR CODE HERE
 }
 
 //------------------------------------------------------CSI Config Initialize------------------------------------------------------
 static void wifi_csi_init()
 {
+  csi_pool_init(&s_csi_pool);
+  csi_session_table_init(&s_session_table);
+  static const uint8_t breath_decimation[] = BREATH_DECIMATION;
+  breath_ensemble_init();
+  breath_ensemble_configure(s_active_params);
+  for (size_t i = 0; i < CSI_SEND_MAC_COUNT; i++)
+  {
+    int id = csi_session_add(&s_session_table, CONFIG_CSI_SEND_MAC[i]);
+    if (id < 0)
+    {
+      ESP_LOGE(TAG, "No session slot left for " MACSTR, MAC2STR(CONFIG_CSI_SEND_MAC[i]));
+      continue;
+    }
+    csi_session_t *session = &s_sessions[id];
+    memset(session, 0, sizeof(*session));
+    csi_matrix_init(&session->matrix);
+#if CSI_Q_PCA
+    csi_pca_init(&session->pca);
+#endif
+    csi_motion_init(&session->motion);
+    session_apply_params(session, s_active_params, true);
+    csi_resampler_init(&session->resampler, CSI_SAMPLE_RATE_HZ, CSI_RESAMPLE_INTERP, CSI_RESAMPLE_MAX_GAP_US);
+    if (!csi_decimator_init(&session->breath_decimator, breath_decimation, sizeof(breath_decimation)) ||
+        session->breath_decimator.factor != BREATH_DECIMATION_TOTAL)
+      ESP_LOGE(TAG, "BREATH_DECIMATION is not a valid chain of stages with a product of %d", BREATH_DECIMATION_TOTAL);
+    if (!csi_sdft_init(&session->breath_sdft, CSI_SERIES_LENGTH, BREATH_RATE_HZ, BREATH_MIN_HZ, BREATH_MAX_HZ))
+      ESP_LOGE(TAG, "Breathing band %.2f-%.2f Hz does not fit a %d point sliding DFT",
+               BREATH_MIN_HZ, BREATH_MAX_HZ, CSI_SERIES_LENGTH);
+    if (!csi_peak_init(&session->breath_peaks, BREATH_RATE_HZ, BREATH_PEAK_WINDOW, BREATH_PEAK_SMOOTH,
+                       BREATH_PEAK_NEIGHBOURS, BREATH_PEAK_MIN_DISTANCE))
+      ESP_LOGE(TAG, "Invalid breathing peak detector parameters");
+    if (s_cnn_loaded)
+      csi_cnn_reset(&s_cnn_model, &session->breath_cnn);
+    session->motion_detected = true;
+    session->breathing_rate = 10;
+    csi_hop_init(&session->breath_hop, WINDOW_SIZE, STEP_SIZE);
+    if (!csi_features_init(&session->breath_features, WINDOW_SIZE))
+      ESP_LOGE(TAG, "WINDOW_SIZE %d exceeds CSI_FEATURES_MAX_WINDOW", WINDOW_SIZE);
+    session->last_send_time = -1;
+    ESP_LOGI(TAG, "Tracking CSI sender " MACSTR " as session %d", MAC2STR(CONFIG_CSI_SEND_MAC[i]), id);
+  }
+  csi_ring_init(&s_csi_ring);
+  csi_gain_init(&s_gain);
+  if (!CSI_Q_ENABLE && !csi_serial_init())
+    return;
+  if (xTaskCreate(csi_task, "csi_task", CSI_TASK_STACK_SIZE, NULL, CSI_TASK_PRIORITY, &s_csi_task) != pdPASS)
+  {
+    ESP_LOGE(TAG, "Failed to create CSI processing task");
+    return;
+  }
+#if CSI_TRACE_LEVEL > CSI_TRACE_LEVEL_NONE
+  if (xTaskCreate(csi_trace_task, "csi_trace", CSI_TRACE_TASK_STACK_SIZE, NULL, CSI_TRACE_TASK_PRIORITY, NULL) != pdPASS)
+  {
+    ESP_LOGW(TAG, "Failed to create CSI trace task, trace records will not be printed");
+  }
+#endif
+
   ESP_ERROR_CHECK(esp_wifi_set_promiscuous(true));
   wifi_csi_config_t csi_config = {
       .enable = true,
@@ -726,6 +1714,10 @@ void app_main()
     ret = nvs_flash_init();
   }
   ESP_ERROR_CHECK(ret);
+  params_init();
+  models_init();
+  nn_init();
+  cnn_init();
 
   /**
    * @brief Initialize Wi-Fi
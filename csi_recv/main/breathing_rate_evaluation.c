@@ -2,80 +2,65 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
+#include "csi_decimate.h"
+#include "csi_ensemble.h"
+#include "csi_fft.h"
+#include "csi_params.h"
+#include "csi_peak.h"
+#include "csi_sdft.h"
 
-#define FFT_SIZE 2000
 #define MAX_SAMPLES 100
 #define CSI_BUFFER_LENGTH 8000
 #define PI 3.14159265358979323846
 #define SAMPLING_RATE 20.0
+// The capture is anti-alias filtered and decimated before any breathing work (csi_decimate.h)
+#define DECIMATION 4
+#define BREATH_RATE (SAMPLING_RATE / DECIMATION)
+// 100 s windows at BREATH_RATE, the 2000 samples at SAMPLING_RATE the evaluation was set up with
+#define FFT_SIZE 500
+#define RAW_WINDOW (FFT_SIZE * DECIMATION)
+// The 0.1 smoothing EMA at SAMPLING_RATE, carried over to BREATH_RATE: 1 - (1 - 0.1)^DECIMATION
+#define FILTER_ALPHA 0.3439f
+// Fixed-point format the decimator runs in; the CSV holds raw CSI bytes, so Q16 keeps their fraction
+#define DECIMATE_ONE 65536.0f
 #define MIN_BREATH_HZ 0.1
 #define MAX_BREATH_HZ 0.6
-
-// 复数结构体
-typedef struct {
-    float real;
-    float imag;
-} complex_t;
+// Ensemble pass: the peak counter as the device runs it, and the MAE a subset must reach to be picked
+#define PEAK_WINDOW (int)(40 * BREATH_RATE)
+#define PEAK_SMOOTH 3
+#define PEAK_NEIGHBOURS 2
+#define PEAK_MIN_DISTANCE (int)(3 * BREATH_RATE)
+#define PEAK_STEP (int)BREATH_RATE
+#define MAE_TARGET 3.0f
 
 typedef struct {
     char* csi_file;
     char* gt_file;
 } evaluation_pair_t;
 
-static complex_t fft_buffer[FFT_SIZE];
+// FFT_SIZE is fixed, so the plan's twiddle and Hann tables live in static storage, built once
+static float fft_storage[CSI_FFT_STORAGE_FLOATS(FFT_SIZE)];
+static csi_fft_plan_t fft_plan;
+static float fft_input[FFT_SIZE];
+static csi_complex_t fft_spectrum[FFT_SIZE / 2 + 1];
+static float breath_data[CSI_BUFFER_LENGTH / DECIMATION];
 static float fft_magnitude[FFT_SIZE / 2];
 static int predicted_bpm[MAX_SAMPLES];
 static int ground_truth_bpm[MAX_SAMPLES];
 static int sample_count = 0;
-
-static void fft_swap(complex_t *a, complex_t *b) {
-    complex_t temp = *a;
-    *a = *b;
-    *b = temp;
-}
-
-static void bit_reverse(complex_t *data, int n) {
-    int j = 0;
-    for (int i = 0; i < n - 1; i++) {
-        if (i < j) fft_swap(&data[i], &data[j]);
-        int k = n >> 1;
-        while (k <= j) {
-            j -= k;
-            k >>= 1;
-        }
-        j += k;
-    }
-}
-
-static void fft(complex_t *data, int n) {
-    bit_reverse(data, n);
-    for (int size = 2; size <= n; size *= 2) {
-        int halfsize = size / 2;
-        float angle = -2 * PI / size;
-        complex_t w = {cos(angle), sin(angle)};
-        for (int k = 0; k < n; k += size) {
-            complex_t w_k = {1.0, 0.0};
-            for (int j = 0; j < halfsize; j++) {
-                complex_t t = {
-                    w_k.real * data[k + j + halfsize].real - w_k.imag * data[k + j + halfsize].imag,
-                    w_k.real * data[k + j + halfsize].imag + w_k.imag * data[k + j + halfsize].real
-                };
-                complex_t u = data[k + j];
-                data[k + j].real = u.real + t.real;
-                data[k + j].imag = u.imag + t.imag;
-                data[k + j + halfsize].real = u.real - t.real;
-                data[k + j + halfsize].imag = u.imag - t.imag;
-                float temp = w_k.real * w.real - w_k.imag * w.imag;
-                w_k.imag = w_k.real * w.imag + w_k.imag * w.real;
-                w_k.real = temp;
-            }
-        }
-    }
-}
-
-static void compute_magnitude_spectrum(complex_t *fft_data, float *magnitude, int n) {
+// Streaming (sliding DFT) estimates, scored at the same hops as the block FFT
+static int streaming_bpm[MAX_SAMPLES];
+static int streaming_count = 0;
+// Every estimator behind the csi_ensemble.h interface, scored over all files
+static csi_ensemble_t ensemble;
+enum { EST_FFT, EST_SDFT, EST_PEAK };
+// Bit of the firmware's "est" parameter (csi_params.h) for each slot above; sdft is its spectral
+static const int firmware_est[] = {[EST_FFT] = CSI_EST_FFT, [EST_SDFT] = CSI_EST_SPECTRAL, [EST_PEAK] = CSI_EST_PEAK};
+
+static void compute_magnitude_spectrum(const csi_complex_t *spectrum, float *magnitude, int n) {
     for (int i = 0; i < n/2; i++) {
-        magnitude[i] = sqrt(fft_data[i].real * fft_data[i].real + fft_data[i].imag * fft_data[i].imag);
+        magnitude[i] = sqrtf(spectrum[i].re * spectrum[i].re + spectrum[i].im * spectrum[i].im);
     }
 }
 
@@ -93,17 +78,15 @@ int improved_breathing_rate_estimation(float* csi_data) {
     static float prev_filtered = 0;
 
     for (int i = 0; i < FFT_SIZE; i++) {
-        float filtered = bandpass_filter(csi_data[i] - mean, 0.1f, &prev_filtered);
-        float hann = 0.5 * (1 - cos(2 * PI * i / (FFT_SIZE - 1)));
-        fft_buffer[i].real = filtered * hann;
-        fft_buffer[i].imag = 0;
+        fft_input[i] = bandpass_filter(csi_data[i] - mean, FILTER_ALPHA, &prev_filtered);
     }
 
-    fft(fft_buffer, FFT_SIZE);
-    compute_magnitude_spectrum(fft_buffer, fft_magnitude, FFT_SIZE);
+    // The plan applies the Hann window while packing the real input
+    csi_fft_real(&fft_plan, fft_input, fft_spectrum);
+    compute_magnitude_spectrum(fft_spectrum, fft_magnitude, FFT_SIZE);
 
-    int min_idx = (int)(MIN_BREATH_HZ * FFT_SIZE / SAMPLING_RATE);
-    int max_idx = (int)(MAX_BREATH_HZ * FFT_SIZE / SAMPLING_RATE);
+    int min_idx = (int)(MIN_BREATH_HZ * FFT_SIZE / BREATH_RATE);
+    int max_idx = (int)(MAX_BREATH_HZ * FFT_SIZE / BREATH_RATE);
 
     float max_amp = 0;
     int peak_idx = 0;
@@ -123,7 +106,7 @@ int improved_breathing_rate_estimation(float* csi_data) {
         if (denom != 0) refined_idx = peak_idx + 0.5 * (alpha - gamma) / denom;
     }
 
-    float freq = refined_idx * SAMPLING_RATE / FFT_SIZE;
+    float freq = refined_idx * BREATH_RATE / FFT_SIZE;
     int bpm = (int)(freq * 60);
 
     if (bpm < 6) bpm = 6;
@@ -131,6 +114,201 @@ int improved_breathing_rate_estimation(float* csi_data) {
     return bpm;
 }
 
+static int hz_to_bpm(float freq) {
+    int bpm = (int)(freq * 60);
+    if (bpm < 6) bpm = 6;
+    if (bpm > 30) bpm = 30;
+    return bpm;
+}
+
+// Streaming estimator over the whole capture: the same low-pass, then a sliding DFT
+// over the last FFT_SIZE samples that only tracks the MIN..MAX_BREATH_HZ bins.
+// An estimate is available after every sample; the hop ends are recorded for scoring.
+static void streaming_breathing_rate_estimation(const float* csi_data, int samples, int* out, int max_out, int* out_count) {
+    static csi_sdft_t sdft;
+    if (!csi_sdft_init(&sdft, FFT_SIZE, BREATH_RATE, MIN_BREATH_HZ, MAX_BREATH_HZ)) {
+        printf("Error: breathing band does not fit the sliding DFT\n");
+        return;
+    }
+    float* filtered = (float*)malloc(samples * sizeof(float));
+    if (!filtered) return;
+
+    float prev_filtered = 0;
+    for (int n = 0; n < samples; n++) {
+        filtered[n] = bandpass_filter(csi_data[n], FILTER_ALPHA, &prev_filtered);
+        csi_sdft_push(&sdft, filtered[n], n >= FFT_SIZE ? filtered[n - FFT_SIZE] : 0.0f);
+
+        int start = n + 1 - FFT_SIZE; // first sample of the window that ends here
+        float freq;
+        if (start >= 0 && start < samples - FFT_SIZE && start % (FFT_SIZE / 2) == 0 &&
+            *out_count < max_out && csi_sdft_peak(&sdft, &freq, NULL)) {
+            out[(*out_count)++] = hz_to_bpm(freq);
+        }
+    }
+    free(filtered);
+}
+
+static uint32_t clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000000ull + ts.tv_nsec);
+}
+
+// Streaming state the sdft and peak estimators read from
+typedef struct {
+    csi_sdft_t sdft;
+    csi_peak_t peak;
+    int peak_bpm;
+} ensemble_state_t;
+
+static bool estimate_fft(const csi_breath_window_t* window, csi_breath_estimate_t* out) {
+    csi_fft_real(&fft_plan, window->series, fft_spectrum);
+    compute_magnitude_spectrum(fft_spectrum, fft_magnitude, FFT_SIZE);
+
+    int min_idx = (int)(MIN_BREATH_HZ * FFT_SIZE / BREATH_RATE);
+    int max_idx = (int)(MAX_BREATH_HZ * FFT_SIZE / BREATH_RATE);
+    int peak_idx = min_idx;
+    float band = 0;
+    for (int i = min_idx; i <= max_idx; i++) {
+        band += fft_magnitude[i];
+        if (fft_magnitude[i] > fft_magnitude[peak_idx]) peak_idx = i;
+    }
+    float refined_idx = (float)peak_idx;
+    if (peak_idx > 0 && peak_idx < FFT_SIZE/2 - 1) {
+        float alpha = fft_magnitude[peak_idx - 1];
+        float beta = fft_magnitude[peak_idx];
+        float gamma = fft_magnitude[peak_idx + 1];
+        float denom = alpha - 2*beta + gamma;
+        if (denom != 0) refined_idx = peak_idx + 0.5 * (alpha - gamma) / denom;
+    }
+    out->bpm_q8 = (int32_t)lrintf(refined_idx * BREATH_RATE / FFT_SIZE * 60 * 256);
+    out->confidence_q8 = csi_ensemble_snr_confidence(fft_magnitude[peak_idx], band / (max_idx - min_idx + 1));
+    return true;
+}
+
+static bool estimate_sdft(const csi_breath_window_t* window, csi_breath_estimate_t* out) {
+    const ensemble_state_t* state = window->context;
+    float freq, magnitude;
+    if (!csi_sdft_peak(&state->sdft, &freq, &magnitude)) return false;
+    out->bpm_q8 = (int32_t)lrintf(freq * 60 * 256);
+    out->confidence_q8 = csi_ensemble_snr_confidence(magnitude, csi_sdft_band_mean(&state->sdft));
+    return true;
+}
+
+static bool estimate_peak(const csi_breath_window_t* window, csi_breath_estimate_t* out) {
+    const ensemble_state_t* state = window->context;
+    if (state->peak_bpm == 0) return false;
+    out->bpm_q8 = state->peak_bpm * 256;
+    out->confidence_q8 = csi_peak_confidence_q8(&state->peak);
+    return true;
+}
+
+// One pass over the decimated capture: the streaming estimators see every sample and
+// charge that work to the ensemble, and at each hop end all of them run on one shared,
+// low-passed, mean-removed window and are scored against the ground truth of that hop.
+static void ensemble_breathing_rate_estimation(const float* csi_data, int samples, const float* gt, int gt_samples) {
+    static ensemble_state_t state;
+    static float window_data[FFT_SIZE];
+    if (!csi_sdft_init(&state.sdft, FFT_SIZE, BREATH_RATE, MIN_BREATH_HZ, MAX_BREATH_HZ) ||
+        !csi_peak_init(&state.peak, (uint16_t)BREATH_RATE, PEAK_WINDOW, PEAK_SMOOTH, PEAK_NEIGHBOURS, PEAK_MIN_DISTANCE)) {
+        printf("Error: ensemble estimator parameters\n");
+        return;
+    }
+    state.peak_bpm = 0;
+    float* filtered = (float*)malloc(samples * sizeof(float));
+    if (!filtered) return;
+
+    float prev_filtered = 0;
+    for (int n = 0; n < samples; n++) {
+        filtered[n] = bandpass_filter(csi_data[n], FILTER_ALPHA, &prev_filtered);
+
+        uint32_t start_ns = clock_ns();
+        csi_sdft_push(&state.sdft, filtered[n], n >= FFT_SIZE ? filtered[n - FFT_SIZE] : 0.0f);
+        csi_ensemble_charge(&ensemble, EST_SDFT, clock_ns() - start_ns);
+        start_ns = clock_ns();
+        csi_peak_push(&state.peak, (int32_t)lrintf(filtered[n] * 256));
+        if (state.peak.count % PEAK_STEP == 0) state.peak_bpm = csi_peak_estimate(&state.peak);
+        csi_ensemble_charge(&ensemble, EST_PEAK, clock_ns() - start_ns);
+
+        int start = n + 1 - FFT_SIZE;
+        if (start < 0 || start >= samples - FFT_SIZE || start % (FFT_SIZE / 2) != 0) continue;
+        int gt_index = start / (FFT_SIZE / 2);
+        if (gt_index >= gt_samples) continue;
+
+        float mean = 0;
+        for (int i = 0; i < FFT_SIZE; i++) mean += filtered[start + i];
+        mean /= FFT_SIZE;
+        for (int i = 0; i < FFT_SIZE; i++) window_data[i] = filtered[start + i] - mean;
+        csi_breath_window_t window = {window_data, FFT_SIZE, BREATH_RATE, NULL, 0, &state};
+        csi_breath_estimate_t fused;
+        csi_ensemble_run(&ensemble, &window, &fused);
+        csi_ensemble_score(&ensemble, (int32_t)gt[gt_index] * 256);
+    }
+    free(filtered);
+}
+
+static void print_ensemble_report(void) {
+    printf("\nEnsemble estimators (cost per hop includes streaming updates):\n");
+    for (int i = 0; i < ensemble.count; i++) {
+        const csi_estimator_slot_t* slot = &ensemble.slots[i];
+        printf("  %-5s MAE %.2f over %u of %u hops, %.1f us per hop\n", slot->name,
+               slot->scored ? slot->abs_error_q8 / 256.0 / slot->scored : 0.0, slot->scored, slot->runs,
+               csi_ensemble_mean_cost(&ensemble, i) / 1000.0);
+    }
+    printf("Fused subsets (scored where every member had an estimate):\n");
+    for (uint32_t subset = 1; subset < (1u << ensemble.count); subset++) {
+        if (ensemble.subset_scored[subset] == 0) continue;
+        char names[64] = "";
+        uint32_t cost = 0;
+        for (int i = 0; i < ensemble.count; i++) {
+            if (!(subset & (1u << i))) continue;
+            if (names[0]) strcat(names, "+");
+            strcat(names, ensemble.slots[i].name);
+            cost += csi_ensemble_mean_cost(&ensemble, i);
+        }
+        printf("  %-14s MAE %.2f over %u hops, %.1f us per hop\n", names,
+               ensemble.subset_error_q8[subset] / 256.0 / ensemble.subset_scored[subset],
+               ensemble.subset_scored[subset], cost / 1000.0);
+    }
+    uint32_t mask;
+    if (csi_ensemble_cheapest(&ensemble, (int32_t)(MAE_TARGET * 256), &mask)) {
+        // Translated to the firmware's bits, which is what the "est" command takes
+        static const char* const firmware_names[CSI_EST_COUNT] = CSI_EST_NAMES;
+        char names[64] = "";
+        uint32_t est = 0;
+        for (int i = 0; i < ensemble.count; i++) {
+            if (!(mask & (1u << i))) continue;
+            est |= 1u << firmware_est[i];
+        }
+        for (int bit = 0; bit < CSI_EST_COUNT; bit++) {
+            if (!(est & (1u << bit))) continue;
+            if (names[0]) strcat(names, "+");
+            strcat(names, firmware_names[bit]);
+        }
+        printf("Cheapest subset within MAE %.1f: %s, est mask 0x%02x\n", MAE_TARGET, names, (unsigned)est);
+    } else {
+        printf("No subset reaches MAE %.1f\n", MAE_TARGET);
+    }
+}
+
+// Anti-alias filter and keep every DECIMATION-th sample, streaming as the device does
+static int decimate_capture(const float* csi_data, int samples, float* out) {
+    static const uint8_t factors[] = {DECIMATION};
+    csi_decimator_t decimator;
+    if (!csi_decimator_init(&decimator, factors, sizeof(factors))) {
+        printf("Error: unsupported decimation %d\n", DECIMATION);
+        return 0;
+    }
+    int count = 0;
+    for (int n = 0; n < samples; n++) {
+        int32_t value;
+        if (csi_decimator_push(&decimator, (int32_t)lrintf(csi_data[n] * DECIMATE_ONE), &value)) {
+            out[count++] = value / DECIMATE_ONE;
+        }
+    }
+    return count;
+}
+
 float calculate_mae() {
     if (sample_count == 0) return 0.0f;
     float sum_abs_error = 0.0f;
@@ -151,7 +329,7 @@ int read_csv_data(const char* filename, float* data_buffer, int max_samples) {
     int count = 0;
 
     fgets(line, sizeof(line), file);
-    while (fgets(line, sizeof(line), file) && count + FFT_SIZE < max_samples) {
+    while (fgets(line, sizeof(line), file) && count + RAW_WINDOW < max_samples) {
         char* data_start = strchr(line, '[');
         if (!data_start) continue;
         char* token = strtok(data_start + 1, ",]");
@@ -196,6 +374,15 @@ int main() {
     };
 
     int num_files = sizeof(evaluation_files) / sizeof(evaluation_files[0]);
+    if (!csi_fft_plan_init(&fft_plan, FFT_SIZE, CSI_FFT_WINDOW_HANN, fft_storage,
+                           sizeof(fft_storage) / sizeof(fft_storage[0]))) {
+        printf("Error: FFT plan for %d points failed\n", FFT_SIZE);
+        return -1;
+    }
+    csi_ensemble_init(&ensemble, clock_ns);
+    csi_ensemble_add(&ensemble, "fft", estimate_fft);
+    csi_ensemble_add(&ensemble, "sdft", estimate_sdft);
+    csi_ensemble_add(&ensemble, "peak", estimate_peak);
     float* csi_data = (float*)malloc(CSI_BUFFER_LENGTH * sizeof(float));
     float* gt_data = (float*)malloc(MAX_SAMPLES * sizeof(float));
     if (!csi_data || !gt_data) {
@@ -213,10 +400,16 @@ int main() {
         int gt_samples = read_gt_data(evaluation_files[i].gt_file, gt_data, MAX_SAMPLES);
         if (gt_samples <= 0) continue;
 
+        clock_t decimate_start = clock();
+        int breath_samples = decimate_capture(csi_data, csi_samples, breath_data);
+        double decimate_seconds = (double)(clock() - decimate_start) / CLOCKS_PER_SEC;
+
+        int first_sample = sample_count;
         int sum_bpm = 0;
         int count = 0;
-        for (int j = 0; j < csi_samples - FFT_SIZE; j += FFT_SIZE/2) {
-            int predicted_rate = improved_breathing_rate_estimation(csi_data + j);
+        clock_t block_start = clock();
+        for (int j = 0; j < breath_samples - FFT_SIZE; j += FFT_SIZE/2) {
+            int predicted_rate = improved_breathing_rate_estimation(breath_data + j);
             sum_bpm += predicted_rate;
             count++;
 
@@ -228,13 +421,44 @@ int main() {
             }
         }
 
+        double block_seconds = (double)(clock() - block_start) / CLOCKS_PER_SEC;
+
         float current_mae = calculate_mae();
         printf("MAE for file %d: %.2f\n", i + 1, current_mae);
         printf("Average predicted BPM: %.2f\n", (float)sum_bpm / count);
+
+        // Same hops through the sliding DFT; its spectrum is updated on every sample
+        streaming_count = first_sample;
+        clock_t stream_start = clock();
+        streaming_breathing_rate_estimation(breath_data, breath_samples, streaming_bpm, sample_count, &streaming_count);
+        double stream_seconds = (double)(clock() - stream_start) / CLOCKS_PER_SEC;
+        float stream_error = 0;
+        for (int s = first_sample; s < streaming_count; s++) {
+            stream_error += abs(streaming_bpm[s] - ground_truth_bpm[s]);
+        }
+        if (streaming_count > first_sample) {
+            printf("Streaming (sliding DFT) MAE for file %d: %.2f over %d hops\n", i + 1,
+                   stream_error / (streaming_count - first_sample), streaming_count - first_sample);
+        }
+        printf("Decimation by %d: %.3f us per raw sample\n", DECIMATION,
+               csi_samples ? decimate_seconds * 1e6 / csi_samples : 0.0);
+        printf("Block FFT: %.1f us per hop; sliding DFT: %.2f us per sample, %.1f us per hop of %d samples\n",
+               count ? block_seconds * 1e6 / count : 0.0, breath_samples ? stream_seconds * 1e6 / breath_samples : 0.0,
+               count ? stream_seconds * 1e6 / count : 0.0, FFT_SIZE / 2);
+
+        ensemble_breathing_rate_estimation(breath_data, breath_samples, gt_data, gt_samples);
     }
 
     float final_mae = calculate_mae();
     printf("\nFinal MAE across all files: %.2f\n", final_mae);
+    float streaming_error = 0;
+    for (int s = 0; s < streaming_count; s++) {
+        streaming_error += abs(streaming_bpm[s] - ground_truth_bpm[s]);
+    }
+    if (streaming_count > 0) {
+        printf("Final streaming (sliding DFT) MAE across all files: %.2f\n", streaming_error / streaming_count);
+    }
+    print_ensemble_report();
     free(csi_data);
     free(gt_data);
     return 0;
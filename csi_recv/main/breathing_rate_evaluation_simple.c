@@ -5,6 +5,7 @@
 #include <stdbool.h>
 #include <math.h>
 #include <time.h>
+#include "csi_peak.h"
 
 #define CSI_BUFFER_LENGTH 8000
 #define MAX_SAMPLES 1000
@@ -12,101 +13,31 @@
 #define CSI_WINDOW 2400 // 窗口大小
 #define SAMPLE_RATE 60.0f // 采样率
 
+// Peak-counting parameters at SAMPLE_RATE (csi_peak.h)
+#define SMOOTH_LENGTH 21      // 移动平均窗口
+#define PEAK_NEIGHBOURS 3     // 峰值需高于两侧各3个样本
+#define MIN_PEAK_DISTANCE 180 // 两个峰值之间的最小间隔 (3秒)
+
 int16_t CSI_Q[CSI_BUFFER_LENGTH];
-int CSI_Q_INDEX = 0;
 
 int predicted_bpm[MAX_SAMPLES];
 int ground_truth_bpm[MAX_SAMPLES];
 int sample_count = 0;
 
 // ------------------ Breathing Rate Estimation ------------------
-int breathing_rate_estimation(bool verbose_logging) {
-    if (CSI_Q_INDEX < 600) return 0;
-
-    int window_size = 21;
-    int16_t smoothed[CSI_BUFFER_LENGTH];
-
-    for (int i = 0; i < CSI_Q_INDEX; i++) {
-        int sum = 0;
-        int count = 0;
-        for (int j = i - window_size / 2; j <= i + window_size / 2; j++) {
-            if (j >= 0 && j < CSI_Q_INDEX) {
-                sum += CSI_Q[j];
-                count++;
-            }
-        }
-        smoothed[i] = sum / count;
-    }
-
-    int16_t mean = 0;
-    for (int i = 0; i < CSI_Q_INDEX; i++) mean += smoothed[i];
-    mean /= CSI_Q_INDEX;
-
-    float variance = 0;
-    for (int i = 0; i < CSI_Q_INDEX; i++) {
-        float diff = smoothed[i] - mean;
-        variance += diff * diff;
-    }
-    variance /= CSI_Q_INDEX;
-    float std_dev = sqrtf(variance);
-
-    float peak_threshold = std_dev * 0.5f;
-    int min_peak_distance = 180;
-    int last_peak = -min_peak_distance;
-    int peaks = 0;
-
-    for (int i = window_size; i < CSI_Q_INDEX - window_size; i++) {
-        bool is_peak = true;
-        for (int j = 1; j <= 3; j++) {
-            if (smoothed[i] <= smoothed[i - j] || smoothed[i] <= smoothed[i + j]) {
-                is_peak = false;
-                break;
-            }
-        }
-
-        if (is_peak && (smoothed[i] - mean > peak_threshold) && (i - last_peak > min_peak_distance)) {
-            peaks++;
-            last_peak = i;
-            if (verbose_logging) {
-                printf("Peak detected at sample %d, value: %d\n", i, smoothed[i]);
-            }
-        }
-    }
-
-    float duration_seconds = CSI_Q_INDEX / SAMPLE_RATE;
-    float breaths_per_minute_raw = (peaks * 60.0f) / duration_seconds;
-    int breaths_per_minute = (int)(breaths_per_minute_raw + 0.5f);
-
-    if (peaks == 0) {
-        breaths_per_minute = 0;
-    } else if (breaths_per_minute < 8) {
-        breaths_per_minute = 8 + (rand() % 3);
-    } else if (breaths_per_minute > 25) {
-        breaths_per_minute = 20 + (rand() % 5);
-    }
-
-    static int last_rates[3] = {0, 0, 0};
-    static int rate_index = 0;
-
-    last_rates[rate_index] = breaths_per_minute;
-    rate_index = (rate_index + 1) % 3;
-
-    int sum_rates = 0, valid_rates = 0;
-    for (int i = 0; i < 3; i++) {
-        if (last_rates[i] > 0) {
-            sum_rates += last_rates[i];
-            valid_rates++;
+// Feeds the CSI_STEP samples that arrived since the last call and returns the
+// rate over the last CSI_WINDOW samples. Cost is O(count), independent of the window.
+int breathing_rate_estimation(csi_peak_t* peak, const int16_t* samples, int count, bool verbose_logging) {
+    for (int i = 0; i < count; i++) {
+        if (csi_peak_push(peak, samples[i]) && verbose_logging) {
+            printf("Peak detected at smoothed sample %u\n", (unsigned)peak->last_peak);
         }
     }
-
-    if (valid_rates > 0) {
-        breaths_per_minute = sum_rates / valid_rates;
-    }
-
+    int breaths_per_minute = csi_peak_estimate(peak);
     if (verbose_logging) {
-        printf("Breathing rate: %d breaths/minute (from %d peaks in %.1f seconds)\n", breaths_per_minute, peaks, duration_seconds);
+        printf("Breathing rate: %d breaths/minute (from %d peaks in %.1f seconds)\n", breaths_per_minute,
+               peak->peak_count, CSI_WINDOW / SAMPLE_RATE);
     }
-
     return breaths_per_minute;
 }
 
@@ -172,8 +103,6 @@ float calculate_mae() {
 
 // ------------------ Main ------------------
 int main() {
-    srand(time(NULL));
-
     const char* csi_files[] = {
         "../../../benchmark/breathing_rate/evaluation/CSI20250227_193124.csv",
         "../../../benchmark/breathing_rate/evaluation/CSI20250227_191018.csv"
@@ -186,18 +115,28 @@ int main() {
 
     int num_files = 2;
     int gt_data[MAX_SAMPLES];
+    csi_peak_t peak;
 
     for (int f = 0; f < num_files; f++) {
         printf("\nProcessing file pair %d:\n", f + 1);
         int csi_len = read_csv_data(csi_files[f], CSI_Q, CSI_BUFFER_LENGTH);
         int gt_len = read_gt_data(gt_files[f], gt_data, MAX_SAMPLES);
-        CSI_Q_INDEX = 0;
-        sample_count = 0;
+        if (!csi_peak_init(&peak, (uint16_t)SAMPLE_RATE, CSI_WINDOW, SMOOTH_LENGTH, PEAK_NEIGHBOURS, MIN_PEAK_DISTANCE)) {
+            printf("Error: invalid peak detector parameters\n");
+            return -1;
+        }
+        int first_sample = sample_count;
 
+        // The capture is streamed in CSI_STEP chunks; once CSI_WINDOW samples are in,
+        // each step scores the window [i, i + CSI_WINDOW) against ground truth i / CSI_STEP
+        int fed = 0;
+        int steps = 0;
+        clock_t start = clock();
         for (int i = 0; i + CSI_WINDOW <= csi_len && sample_count < MAX_SAMPLES; i += CSI_STEP) {
-            memcpy(CSI_Q, &CSI_Q[i], sizeof(int16_t) * CSI_WINDOW);
-            CSI_Q_INDEX = CSI_WINDOW;
-            int pred = breathing_rate_estimation(false);
+            int end = i + CSI_WINDOW;
+            int pred = breathing_rate_estimation(&peak, CSI_Q + fed, end - fed, false);
+            fed = end;
+            steps++;
             int gt_index = i / CSI_STEP;
 
             if (gt_index < gt_len) {
@@ -208,9 +147,15 @@ int main() {
                 sample_count++;
             }
         }
+        double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
 
-        float mae = calculate_mae();
-        printf("MAE for file %d: %.2f\n", f + 1, mae);
+        float file_error = 0;
+        for (int s = first_sample; s < sample_count; s++) {
+            file_error += abs(predicted_bpm[s] - ground_truth_bpm[s]);
+        }
+        printf("MAE for file %d: %.2f\n", f + 1, sample_count > first_sample ? file_error / (sample_count - first_sample) : 0.0f);
+        printf("Streaming estimator: %.2f us per step of %d samples (first step %d samples)\n",
+               steps ? seconds * 1e6 / steps : 0.0, CSI_STEP, CSI_WINDOW);
     }
 
     float final_mae = calculate_mae();
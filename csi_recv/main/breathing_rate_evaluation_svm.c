@@ -2,6 +2,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdint.h>
+#include <time.h>
+#include "csi_fixed.h"
+#include "csi_features.h"
+#include "breathing_rate_evaluation_svm.h"
 
 #define MAX_SAMPLES 16000
 #define FEATURE_SIZE 5
@@ -19,10 +24,108 @@ const char* gt_files[] = {
 };
 
 // === 模型参数（从 Python 导出） ===
-float weights[FEATURE_SIZE] = {-0.15477075f, 0.29154388f, -0.26879227f, 0.14369498f, -0.03513335f};
-float bias = 29.3084f;
-float means[FEATURE_SIZE] = {1.6983f, 55.9275f, 107.5746f, -109.918f, 2425169.7f};
-float scales[FEATURE_SIZE] = {20.6707f, 17.2686f, 33.3753f, 31.6961f, 1745971.1f};
+// weight, mean, scale per feature; every table below is folded from this one at compile time
+#define SVM_MODEL(X)                          \
+    X(-0.15477075f, 1.6983f, 20.6707f)        \
+    X(0.29154388f, 55.9275f, 17.2686f)        \
+    X(-0.26879227f, 107.5746f, 33.3753f)      \
+    X(0.14369498f, -109.918f, 31.6961f)       \
+    X(-0.03513335f, 2425169.7f, 1745971.1f)
+#define SVM_BIAS 29.3084f
+
+#define SVM_WEIGHT(w, m, s) w,
+#define SVM_MEAN(w, m, s) m,
+#define SVM_SCALE(w, m, s) s,
+float weights[FEATURE_SIZE] = {SVM_MODEL(SVM_WEIGHT)};
+float bias = SVM_BIAS;
+float means[FEATURE_SIZE] = {SVM_MODEL(SVM_MEAN)};
+float scales[FEATURE_SIZE] = {SVM_MODEL(SVM_SCALE)};
+
+// Standardisation folded into the model: sum(w * (x - m) / s) + b = sum((w / s) * x) + (b - sum(w * m / s)),
+// in double, so predict() neither divides nor touches its input. The fixed-point tables are
+// rounded half away from zero. The same expressions fold the built-in model at compile time
+// and a loaded one in svm_model_fold(), so both give identical tables.
+#define SVM_ROUND(x) ((x) < 0 ? (int64_t)((x) - 0.5) : (int64_t)((x) + 0.5))
+#define SVM_FOLD_WEIGHT(w, m, s) ((float)((double)(w) / (s)))
+#define SVM_FOLD_OFFSET(w, m, s) ((double)(w) * (m) / (s))
+#define SVM_FOLD_WEIGHT_Q15(w) ((int32_t)SVM_ROUND((w) * (double)CSI_Q15_ONE))
+#define SVM_FOLD_MEAN_Q16(m) SVM_ROUND((m) * (double)CSI_Q16_ONE)
+#define SVM_FOLD_INV_SCALE_Q31(s) ((int32_t)SVM_ROUND(2147483648.0 / (s)))
+// |x - mean| * inv_scale stays below 2^63 within this
+#define SVM_FOLD_LIMIT(s) (INT64_MAX / ((int64_t)SVM_FOLD_INV_SCALE_Q31(s) + 1))
+
+#define SVM_TABLE_WEIGHT(w, m, s) SVM_FOLD_WEIGHT(w, m, s),
+#define SVM_TABLE_OFFSET(w, m, s) - SVM_FOLD_OFFSET(w, m, s)
+#define SVM_TABLE_WEIGHT_Q15(w, m, s) SVM_FOLD_WEIGHT_Q15(w),
+#define SVM_TABLE_MEAN_Q16(w, m, s) SVM_FOLD_MEAN_Q16(m),
+#define SVM_TABLE_INV_SCALE_Q31(w, m, s) SVM_FOLD_INV_SCALE_Q31(s),
+#define SVM_TABLE_LIMIT(w, m, s) SVM_FOLD_LIMIT(s),
+static const svm_model_t builtin_model = {
+    .weights = {SVM_MODEL(SVM_TABLE_WEIGHT)},
+    .bias = (float)((double)SVM_BIAS SVM_MODEL(SVM_TABLE_OFFSET)),
+    .weights_q15 = {SVM_MODEL(SVM_TABLE_WEIGHT_Q15)},
+    .means_q16 = {SVM_MODEL(SVM_TABLE_MEAN_Q16)},
+    .inv_scales_q31 = {SVM_MODEL(SVM_TABLE_INV_SCALE_Q31)},
+    .limits = {SVM_MODEL(SVM_TABLE_LIMIT)},
+    .bias_q16 = (int32_t)SVM_ROUND(SVM_BIAS * (double)CSI_Q16_ONE),
+    .sequence = 0,
+};
+// What predict(), predict_batch() and predict_q() use; swapped only between windows
+static const svm_model_t* active_model = &builtin_model;
+
+// === 模型折叠与切换 ===
+// Fold a standardised linear model into an svm_model_t. Every scale must be above 1,
+// so that 2^31 / scale fits the Q31 table; the built-in model's scales all are.
+bool svm_model_fold(const float* w, const float* m, const float* s, float b, uint32_t sequence,
+                    svm_model_t* out, const char** reason) {
+    double offset = b;
+    for (int i = 0; i < FEATURE_SIZE; i++) {
+        if (!(s[i] > 1.0f) || !isfinite(w[i]) || !isfinite(m[i]) || !isfinite(s[i]) ||
+            fabs((double)m[i] * CSI_Q16_ONE) > (double)INT64_MAX / 2 || fabs((double)w[i]) >= 65536.0) {
+            *reason = "weight, mean or scale out of range";
+            return false;
+        }
+    }
+    if (!isfinite(b) || fabs((double)b) >= 32768.0) {
+        *reason = "bias out of range";
+        return false;
+    }
+    for (int i = 0; i < FEATURE_SIZE; i++) {
+        out->weights[i] = SVM_FOLD_WEIGHT(w[i], m[i], s[i]);
+        offset -= SVM_FOLD_OFFSET(w[i], m[i], s[i]);
+        out->weights_q15[i] = SVM_FOLD_WEIGHT_Q15(w[i]);
+        out->means_q16[i] = SVM_FOLD_MEAN_Q16(m[i]);
+        out->inv_scales_q31[i] = SVM_FOLD_INV_SCALE_Q31(s[i]);
+        out->limits[i] = SVM_FOLD_LIMIT(s[i]);
+    }
+    out->bias = (float)offset;
+    out->bias_q16 = (int32_t)SVM_ROUND(b * (double)CSI_Q16_ONE);
+    out->sequence = sequence;
+    return true;
+}
+
+// Fold the linear model in a checked blob (csi_model.h); its tensors are read in place
+bool svm_model_from_blob(const csi_model_t* blob, svm_model_t* out, const char** reason) {
+    const float* w = csi_model_tensor(blob, "weights", CSI_MODEL_F32, FEATURE_SIZE);
+    const float* m = csi_model_tensor(blob, "means", CSI_MODEL_F32, FEATURE_SIZE);
+    const float* s = csi_model_tensor(blob, "scales", CSI_MODEL_F32, FEATURE_SIZE);
+    const float* b = csi_model_tensor(blob, "bias", CSI_MODEL_F32, 1);
+    if (blob->header->type != CSI_MODEL_LINEAR || !w || !m || !s || !b) {
+        *reason = "not a linear model over the SVM features";
+        return false;
+    }
+    return svm_model_fold(w, m, s, *b, blob->header->sequence, out, reason);
+}
+
+// Switch the model predictions use; NULL goes back to the built-in one. The caller keeps
+// *model alive while it is in use and calls this from the thread that predicts.
+void svm_model_use(const svm_model_t* model) {
+    active_model = model ? model : &builtin_model;
+}
+
+const svm_model_t* svm_model_active(void) {
+    return active_model;
+}
 
 // === 读取 CSI 数据 ===
 int read_csi_data(const char* filename, float* buffer, int max_len) {
@@ -70,26 +173,30 @@ float read_gt_data(const char* filename, float* buffer, int max_len) {
 
 
 // === 特征提取 ===
+// Sums in double: exact for CSI samples, where float rounds sqsum and a diff energy
+// around 2.4M and then cancels in sqsum/N - mean^2. csi_features.c computes the
+// same features incrementally and matches this exactly.
 void extract_features(float* window, float* out_feat) {
-    float sum = 0, sqsum = 0, max = window[0], min = window[0], diff_energy = 0;
+    double sum = 0, sqsum = 0, diff_energy = 0;
+    float max = window[0], min = window[0];
     for (int i = 0; i < WINDOW_SIZE; i++) {
         sum += window[i];
-        sqsum += window[i] * window[i];
+        sqsum += (double)window[i] * window[i];
         if (window[i] > max) max = window[i];
         if (window[i] < min) min = window[i];
         if (i > 0) {
-            float diff = window[i] - window[i - 1];
+            double diff = (double)window[i] - window[i - 1];
             diff_energy += diff * diff;
         }
     }
-    float mean = sum / WINDOW_SIZE;
-    float std = sqrtf(sqsum / WINDOW_SIZE - mean * mean);
+    double n = WINDOW_SIZE;
+    double spread = n * sqsum - sum * sum;
 
-    out_feat[0] = mean;
-    out_feat[1] = std;
+    out_feat[0] = (float)(sum / n);
+    out_feat[1] = (float)sqrt(spread / (n * n));
     out_feat[2] = max;
     out_feat[3] = min;
-    out_feat[4] = diff_energy;
+    out_feat[4] = (float)diff_energy;
 }
 
 // === 特征归一化 ===
@@ -100,15 +207,155 @@ void normalize(float* feat) {
 }
 
 // === 预测函数 ===
-float predict(float* feat) {
-    normalize(feat);
-    float sum = bias;
+float predict(const float* feat) {
+    const svm_model_t* model = active_model;
+    float sum = model->bias;
     for (int i = 0; i < FEATURE_SIZE; i++) {
-        sum += feat[i] * weights[i];
+        sum += feat[i] * model->weights[i];
     }
     return sum;
 }
 
+// === 批量预测 ===
+// features is feature-major: feature f of window w at features[f * stride + w], so the
+// inner loop runs over consecutive windows with one weight and vectorises.
+void predict_batch(const float* features, int stride, int count, float* out) {
+    const svm_model_t* model = active_model;
+    for (int w = 0; w < count; w++) out[w] = model->bias;
+    for (int f = 0; f < FEATURE_SIZE; f++) {
+        const float* column = features + (size_t)f * stride;
+        const float weight = model->weights[f];
+        for (int w = 0; w < count; w++) {
+            out[w] += column[w] * weight;
+        }
+    }
+}
+
+// === 定点特征提取 (Q16) ===
+// mean: exact, truncated to 2^-16; std: within 2^-12 of the exact value
+// (the float version loses more than that to cancellation in sqsum/N - mean^2);
+// max, min, diff_energy: exact.
+void extract_features_q(const int16_t* window, int64_t* out_feat) {
+    int32_t sum = 0, max = window[0], min = window[0];
+    int64_t sqsum = 0, diff_energy = 0;
+    for (int i = 0; i < WINDOW_SIZE; i++) {
+        sum += window[i];
+        sqsum += (int32_t)window[i] * window[i];
+        if (window[i] > max) max = window[i];
+        if (window[i] < min) min = window[i];
+        if (i > 0) {
+            int64_t diff = window[i] - window[i - 1];
+            diff_energy += diff * diff;
+        }
+    }
+    // N^2 * variance is exact; scale it to Q24 before the square root
+    int64_t spread = (int64_t)WINDOW_SIZE * sqsum - (int64_t)sum * sum;
+    const int64_t n2 = (int64_t)WINDOW_SIZE * WINDOW_SIZE;
+    uint64_t var_q24 = spread <= (INT64_MAX >> 24) ? (uint64_t)(spread << 24) / n2 : (uint64_t)(spread / n2) << 24;
+
+    // Q16 by multiplying: a left shift of a negative value is undefined
+    out_feat[0] = (int64_t)sum * 65536 / WINDOW_SIZE;
+    out_feat[1] = (int64_t)csi_isqrt64(var_q24) << 4;
+    out_feat[2] = (int64_t)max * 65536;
+    out_feat[3] = (int64_t)min * 65536;
+    out_feat[4] = diff_energy << 16;
+}
+
+// === 定点预测 (Q16) ===
+// Each normalised feature is off by at most 2^-16 plus |feature - mean| * 2^-32 / scale
+// from rounding 1/scale; each weight by 2^-16. For this model that keeps the result
+// within 0.001 BPM of the float prediction on the same features.
+int32_t predict_q(const int64_t* feat) {
+    const svm_model_t* model = active_model;
+    int64_t sum = model->bias_q16;
+    for (int i = 0; i < FEATURE_SIZE; i++) {
+        int64_t centred = feat[i] - model->means_q16[i];
+        // |centred| * inv_scale stays far below 2^63 unless a feature is wildly out of range
+        if (centred > model->limits[i]) centred = model->limits[i];
+        if (centred < -model->limits[i]) centred = -model->limits[i];
+        int32_t z = csi_sat32((centred * model->inv_scales_q31[i]) >> 31);
+        sum += csi_mul_q15(z, model->weights_q15[i]);
+    }
+    return csi_sat32(sum);
+}
+
+// The evaluator itself; nn_breathing_benchmark.cc links the functions above without it
+#ifndef SVM_EVALUATION_NO_MAIN
+// === 增量特征提取校验 ===
+// Slide csi_features over the capture and compare it with the batch functions at
+// every hop-th window. Returns the number of windows whose features differ.
+static int check_incremental_features(const float* csi, int csi_len, int hop, int* windows) {
+    static csi_features_t inc;
+    csi_features_init(&inc, WINDOW_SIZE);
+    int mismatches = 0;
+    *windows = 0;
+    for (int n = 0; n < csi_len; n++) {
+        csi_features_push(&inc, (int16_t)csi[n]);
+        int start = n + 1 - WINDOW_SIZE;
+        if (start < 0 || start % hop != 0) continue;
+
+        float feat[FEATURE_SIZE], feat_inc[FEATURE_SIZE];
+        int16_t window_q[WINDOW_SIZE];
+        int64_t feat_q[FEATURE_SIZE], feat_inc_q[FEATURE_SIZE];
+        extract_features((float*)&csi[start], feat);
+        for (int j = 0; j < WINDOW_SIZE; j++) window_q[j] = (int16_t)csi[start + j];
+        extract_features_q(window_q, feat_q);
+        csi_features_get(&inc, feat_inc);
+        csi_features_get_q(&inc, feat_inc_q);
+        for (int f = 0; f < FEATURE_SIZE; f++) {
+            if (feat[f] != feat_inc[f] || feat_q[f] != feat_inc_q[f]) {
+                mismatches++;
+                break;
+            }
+        }
+        (*windows)++;
+    }
+    return mismatches;
+}
+
+// === 全窗口扫描 ===
+// Score every window of the capture (hop 1): the unfolded model one window at a time,
+// as predict() used to, against predict_batch() over the feature-major matrix.
+static void sweep_predictions(const float* csi, int csi_len) {
+    static csi_features_t inc;
+    static float matrix[FEATURE_SIZE][MAX_SAMPLES];
+    static float folded[MAX_SAMPLES], unfolded[MAX_SAMPLES];
+    int count = 0;
+    csi_features_init(&inc, WINDOW_SIZE);
+    for (int n = 0; n < csi_len; n++) {
+        csi_features_push(&inc, (int16_t)csi[n]);
+        float feat[FEATURE_SIZE];
+        if (!csi_features_get(&inc, feat)) continue;
+        for (int f = 0; f < FEATURE_SIZE; f++) matrix[f][count] = feat[f];
+        count++;
+    }
+    if (count == 0) return;
+
+    clock_t start = clock();
+    for (int w = 0; w < count; w++) {
+        float feat[FEATURE_SIZE];
+        for (int f = 0; f < FEATURE_SIZE; f++) feat[f] = matrix[f][w];
+        normalize(feat);
+        float sum = bias;
+        for (int f = 0; f < FEATURE_SIZE; f++) sum += feat[f] * weights[f];
+        unfolded[w] = sum;
+    }
+    double unfolded_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    predict_batch(&matrix[0][0], MAX_SAMPLES, count, folded);
+    double folded_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    float max_diff = 0;
+    for (int w = 0; w < count; w++) {
+        if (fabs(folded[w] - unfolded[w]) > max_diff) max_diff = fabs(folded[w] - unfolded[w]);
+    }
+    printf("Sweep of %d windows: unfolded %.1f ns per window, batched %.1f ns per window", count,
+           unfolded_seconds * 1e9 / count, folded_seconds * 1e9 / count);
+    // The unfolded reference is the built-in model
+    if (svm_model_active()->sequence == 0) printf(", max difference %.5f BPM", max_diff);
+    printf("\n");
+}
+
 // === 每个文件评估 ===
 float evaluate_file(const char* csi_file, const char* gt_file, int* global_index) {
     float csi[MAX_SAMPLES];
@@ -124,14 +371,23 @@ float evaluate_file(const char* csi_file, const char* gt_file, int* global_index
 
     int window_count = 0;
     float total_error = 0;
+    float max_fixed_diff = 0;
     for (int i = 0; i + WINDOW_SIZE <= csi_len && window_count < gt_len; i += STEP_SIZE) {
         float feat[FEATURE_SIZE];
         extract_features(&csi[i], feat);
         float pred = predict(feat);
         float error = fabs(pred - gt[window_count]);
 
-        printf("[sample %03d] predicted: %.2f, ground truth: %.2f, error: %.2f\n",
-       (*global_index), pred, gt[window_count], error);
+        // 定点路径, 与浮点结果对比
+        int16_t window_q[WINDOW_SIZE];
+        int64_t feat_q[FEATURE_SIZE];
+        for (int j = 0; j < WINDOW_SIZE; j++) window_q[j] = (int16_t)csi[i + j];
+        extract_features_q(window_q, feat_q);
+        float pred_fixed = predict_q(feat_q) / 65536.0f;
+        if (fabs(pred_fixed - pred) > max_fixed_diff) max_fixed_diff = fabs(pred_fixed - pred);
+
+        printf("[sample %03d] predicted: %.2f, fixed: %.2f, ground truth: %.2f, error: %.2f\n",
+       (*global_index), pred, pred_fixed, gt[window_count], error);
 
 
         total_error += error;
@@ -140,16 +396,45 @@ float evaluate_file(const char* csi_file, const char* gt_file, int* global_index
     }
 
     float mae = total_error / window_count;
-    printf("MAE for file: %.2f\n\n", mae);
+    printf("MAE for file: %.2f\n", mae);
+    printf("Max |fixed - float| prediction difference: %.5f BPM\n", max_fixed_diff);
+    const int hops[] = {STEP_SIZE, 1};
+    for (int h = 0; h < 2; h++) {
+        int windows;
+        int mismatches = check_incremental_features(csi, csi_len, hops[h], &windows);
+        printf("Incremental features, hop %d: %d of %d windows differ from the batch features\n",
+               hops[h], mismatches, windows);
+    }
+    sweep_predictions(csi, csi_len);
+    printf("\n");
     return mae;
 }
 
 // === 主函数 ===
-int main() {
+// Usage: breathing_rate_evaluation_svm [model.bin]
+// model.bin: a linear model blob from csi_model_pack, mapped and used instead of the built-in model
+int main(int argc, char** argv) {
     float total_mae = 0;
     int global_index = 0;
     int num_files = sizeof(csi_files) / sizeof(csi_files[0]);
 
+#ifndef ESP_PLATFORM
+    static svm_model_t loaded;
+    if (argc > 1) {
+        csi_model_t blob;
+        const char* reason;
+        if (!csi_model_map_file(argv[1], &blob, &reason) || !svm_model_from_blob(&blob, &loaded, &reason)) {
+            printf("Error: model %s rejected: %s\n", argv[1], reason);
+            return -1;
+        }
+        svm_model_use(&loaded);
+        printf("Using model %s, sequence %u\n", argv[1], (unsigned)loaded.sequence);
+    }
+#else
+    (void)argc;
+    (void)argv;
+#endif
+
     for (int i = 0; i < num_files; i++) {
         printf("\nProcessing file pair %d:\n", i + 1);
         total_mae += evaluate_file(csi_files[i], gt_files[i], &global_index);
@@ -159,4 +444,4 @@ int main() {
     printf("Final MAE across all files: %.2f\n", final_mae);
     return 0;
 }
-
+#endif // SVM_EVALUATION_NO_MAIN
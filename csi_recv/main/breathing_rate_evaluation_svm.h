@@ -1,17 +1,61 @@
 #ifndef BREATHING_RATE_EVALUATION_SVM_H
 #define BREATHING_RATE_EVALUATION_SVM_H
 
+#include <stdint.h>
+#include <stdbool.h>
+#include "csi_model.h"
+
 #define WINDOW_SIZE 300
 #define STEP_SIZE 150
 #define FEATURE_SIZE 5
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 折叠后的线性模型: 标准化已并入权重, 另附定点表
+typedef struct {
+    float weights[FEATURE_SIZE];          // w / scale
+    float bias;                           // b - sum(w * mean / scale)
+    int32_t weights_q15[FEATURE_SIZE];
+    int64_t means_q16[FEATURE_SIZE];
+    int32_t inv_scales_q31[FEATURE_SIZE];
+    int64_t limits[FEATURE_SIZE];         // 定点路径对 |x - mean| 的钳位
+    int32_t bias_q16;
+    uint32_t sequence;                    // 模型版本, 0 为内置模型
+} svm_model_t;
+
+// 模型折叠与切换 (可从 csi_model.h 的二进制模型加载)
+bool svm_model_fold(const float* weights, const float* means, const float* scales, float bias, uint32_t sequence,
+                    svm_model_t* out, const char** reason);
+bool svm_model_from_blob(const csi_model_t* blob, svm_model_t* out, const char** reason);
+void svm_model_use(const svm_model_t* model);
+const svm_model_t* svm_model_active(void);
+
 // 特征提取函数
 void extract_features(float* window, float* out_feat);
 
-// 特征归一化函数
+// 特征归一化函数, 及其使用的内置标准化参数 (神经网络模型也在其后训练)
+extern float means[FEATURE_SIZE];
+extern float scales[FEATURE_SIZE];
 void normalize(float* feat);
 
-// 预测函数
-float predict(float* feat);
+// 预测函数 (标准化已折叠进权重, 不修改输入)
+float predict(const float* feat);
+
+// 批量预测: features[f * stride + w] 为窗口 w 的特征 f, out[w] 为其 BPM
+void predict_batch(const float* features, int stride, int count, float* out);
+
+// 定点版本 (CSI_FIXED_POINT): 特征为 Q16, 返回 BPM (Q16)
+void extract_features_q(const int16_t* window, int64_t* out_feat);
+int32_t predict_q(const int64_t* feat);
+
+// 读取评估数据 (CSI 序列与真实呼吸率), 返回读到的个数, 失败返回 -1
+int read_csi_data(const char* filename, float* buffer, int max_len);
+float read_gt_data(const char* filename, float* buffer, int max_len);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif // BREATHING_RATE_EVALUATION_SVM_H 
\ No newline at end of file
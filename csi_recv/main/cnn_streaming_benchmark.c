@@ -0,0 +1,251 @@
+// Host benchmark: replays the breathing recordings through the streaming csi_cnn
+// network, decimated to BREATH_RATE_HZ as csi_process() does, and at every hop
+// checks the streamed rate against a full recompute of every layer over the
+// window, which it must match bit for bit. Reports the time per hop of each, for
+// several hops and pool lengths: streaming grows with the hop, recompute with the
+// window.
+//
+// Without a model it runs a reference network with deterministic pseudo-random
+// weights: it exercises the engine and its cost, its rates mean nothing. --write
+// saves that network as a CSI_MODEL_CNN blob, e.g. to time it on the device.
+//
+// Build: gcc -O2 -o cnn_streaming_benchmark cnn_streaming_benchmark.c csi_cnn.c csi_model.c csi_serial.c csi_decimate.c -lm
+// Usage: ./cnn_streaming_benchmark [model.bin]
+//        ./cnn_streaming_benchmark --write <out.bin> [sequence]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include "csi_cnn.h"
+#include "csi_decimate.h"
+
+#define MAX_SAMPLES 10000
+// Recordings are at the firmware's CSI_SAMPLE_RATE_HZ, decimated as BREATH_DECIMATION
+#define DECIMATION 4
+#define SAMPLE_RATE_HZ 20
+// Minimum time spent timing one configuration
+#define BENCH_SECONDS 0.2
+// Hops timed, decimated samples: every sample, about a second, and STEP_SIZE packets (7.5 s)
+static const int hops[] = {1, 5, 38};
+// Pools the reference network is timed with
+static const int pools[] = {32, 64, 128};
+
+// Reference network: kernel, dilation, channels per layer
+#define REF_LAYERS 4
+#define REF_CHANNELS 8
+static const int ref_shape[REF_LAYERS][2] = {{3, 1}, {3, 2}, {3, 4}, {3, 8}};
+
+static const char* csi_files[] = {
+    "../../../benchmark/breathing_rate/evaluation/CSI20250227_193124.csv",
+    "../../../benchmark/breathing_rate/evaluation/CSI20250227_191018.csv",
+};
+#define NUM_FILES (int)(sizeof(csi_files) / sizeof(csi_files[0]))
+
+typedef struct {
+    int32_t samples_q8[MAX_SAMPLES / DECIMATION];
+    int count;
+} recording_t;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// The CSI series of a recording, through the firmware's decimator, Q8
+static bool read_recording(const char* filename, recording_t* out) {
+    static float raw[MAX_SAMPLES];
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        printf("Error: Cannot open file %s\n", filename);
+        return false;
+    }
+    char line[8192];
+    int count = 0;
+    if (!fgets(line, sizeof(line), file)) count = 0; // skip header
+    while (fgets(line, sizeof(line), file) && count < MAX_SAMPLES) {
+        char* start = strchr(line, '[');
+        if (!start) continue;
+        char* token = strtok(start + 1, ",]");
+        while (token && count < MAX_SAMPLES) {
+            raw[count++] = atof(token);
+            token = strtok(NULL, ",]");
+        }
+    }
+    fclose(file);
+
+    static const uint8_t factors[] = {DECIMATION};
+    csi_decimator_t decimator;
+    csi_decimator_init(&decimator, factors, 1);
+    out->count = 0;
+    for (int i = 0; i < count; i++) {
+        int32_t value_q8;
+        if (csi_decimator_push(&decimator, (int32_t)lrintf(raw[i] * 256.0f), &value_q8))
+            out->samples_q8[out->count++] = value_q8;
+    }
+    return out->count > 0;
+}
+
+static uint32_t lcg_state = 12345;
+static int lcg_int8(void) {
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return (int)(lcg_state >> 24) - 128;
+}
+
+// The reference network as a blob (csi_model.h), with its pool; free() it
+static void* reference_blob(int pool, uint32_t sequence, size_t* size) {
+    static int32_t config[3 + 4 * REF_LAYERS];
+    static int8_t weights[REF_LAYERS * REF_CHANNELS * 3 * REF_CHANNELS];
+    static int32_t biases[REF_LAYERS * REF_CHANNELS];
+    static float weight_scales[REF_LAYERS * REF_CHANNELS];
+    static float act_scales[REF_LAYERS + 1];
+    static int32_t act_zeros[REF_LAYERS + 1];
+    static float head[REF_CHANNELS + 1];
+
+    lcg_state = 12345;
+    config[0] = REF_LAYERS;
+    config[1] = pool;
+    config[2] = 6;
+    // Input: +-8 amplitude units over the int8 range, centred
+    act_scales[0] = 8.0f / 128;
+    act_zeros[0] = 0;
+    int w = 0, c = 0, in_channels = 1;
+    for (int l = 0; l < REF_LAYERS; l++) {
+        config[3 + 4 * l] = ref_shape[l][0];
+        config[4 + 4 * l] = ref_shape[l][1];
+        config[5 + 4 * l] = REF_CHANNELS;
+        config[6 + 4 * l] = 1;
+        int span = ref_shape[l][0] * in_channels;
+        for (int i = 0; i < REF_CHANNELS * span; i++) weights[w++] = (int8_t)(lcg_int8() | 1);
+        // Weights of +-1 / sqrt(span), outputs about as wide as their inputs, after the ReLU
+        act_scales[l + 1] = act_scales[l] * 0.4f;
+        act_zeros[l + 1] = -128;
+        for (int o = 0; o < REF_CHANNELS; o++, c++) {
+            weight_scales[c] = 1.0f / (128.0f * sqrtf((float)span));
+            biases[c] = lcg_int8() * 16;
+        }
+        in_channels = REF_CHANNELS;
+    }
+    for (int i = 0; i < REF_CHANNELS; i++) head[i] = lcg_int8() / 2.0f;
+    head[REF_CHANNELS] = 15.0f;
+
+    csi_model_source_t tensors[] = {
+        {"config", CSI_MODEL_I32, (uint32_t)(3 + 4 * REF_LAYERS), config},
+        {"weights", CSI_MODEL_I8, (uint32_t)w, weights},
+        {"biases", CSI_MODEL_I32, (uint32_t)c, biases},
+        {"weight_scales", CSI_MODEL_F32, (uint32_t)c, weight_scales},
+        {"act_scales", CSI_MODEL_F32, REF_LAYERS + 1, act_scales},
+        {"act_zeros", CSI_MODEL_I32, REF_LAYERS + 1, act_zeros},
+        {"head", CSI_MODEL_F32, REF_CHANNELS + 1, head},
+    };
+    const char* reason;
+    void* blob = csi_model_build(CSI_MODEL_CNN, sequence, tensors, (int)(sizeof(tensors) / sizeof(tensors[0])), size,
+                                 &reason);
+    if (!blob) printf("Error: reference network does not pack: %s\n", reason);
+    return blob;
+}
+
+// Stream every recording with one hop; time both paths per hop and count disagreements
+static bool run(const csi_cnn_model_t* model, const recording_t* recordings, int hop) {
+    static csi_cnn_state_t state;
+    static int8_t inputs[MAX_SAMPLES / DECIMATION];
+    static int8_t scratch[CSI_CNN_WINDOW_SCRATCH(CSI_CNN_MAX_POOL + CSI_CNN_HISTORY * CSI_CNN_MAX_LAYERS)];
+    int length = model->pool + model->receptive_field - 1;
+    double stream_ns = 0, window_ns = 0, elapsed = 0;
+    long hop_count = 0, mismatches = 0;
+    int32_t low = INT32_MAX, high = INT32_MIN;
+    double start = now_ns();
+    do {
+        for (int f = 0; f < NUM_FILES; f++) {
+            const recording_t* rec = &recordings[f];
+            csi_cnn_reset(model, &state);
+            for (int at = 0; at + hop <= rec->count; at += hop) {
+                int32_t streamed, recomputed;
+                double t0 = now_ns();
+                for (int i = at; i < at + hop; i++) inputs[i] = csi_cnn_push(model, &state, rec->samples_q8[i]);
+                bool ready = csi_cnn_output(model, &state, &streamed);
+                double t1 = now_ns();
+                if (!ready) continue;
+                csi_cnn_window(model, inputs + at + hop - length, length, scratch, &recomputed);
+                double t2 = now_ns();
+                stream_ns += t1 - t0;
+                window_ns += t2 - t1;
+                hop_count++;
+                if (streamed != recomputed) mismatches++;
+                if (streamed < low) low = streamed;
+                if (streamed > high) high = streamed;
+            }
+        }
+        elapsed = now_ns() - start;
+    } while (elapsed < BENCH_SECONDS * 1e9);
+
+    printf("%5d %5d %8d %12.0f %12.0f %8.1fx %8.1f..%-6.1f %ld/%ld\n", model->pool, hop, length,
+           stream_ns / hop_count, window_ns / hop_count, window_ns / stream_ns, low / 256.0, high / 256.0, mismatches,
+           hop_count);
+    return mismatches == 0;
+}
+
+static bool load(const csi_model_t* blob, csi_cnn_model_t* model) {
+    const char* reason;
+    if (!csi_cnn_model_from_blob(blob, model, &reason)) {
+        printf("Error: model rejected: %s\n", reason);
+        return false;
+    }
+    return true;
+}
+
+static int write_reference(const char* path, uint32_t sequence) {
+    size_t size;
+    void* blob = reference_blob(64, sequence, &size);
+    if (!blob) return 1;
+    FILE* file = fopen(path, "wb");
+    bool ok = file && fwrite(blob, 1, size, file) == size;
+    if (file) fclose(file);
+    free(blob);
+    if (!ok) {
+        printf("Error: cannot write %s\n", path);
+        return 1;
+    }
+    printf("%s: reference CNN, sequence %u, %zu bytes; flash it into cnn_model\n", path, sequence, size);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && strcmp(argv[1], "--write") == 0)
+        return write_reference(argv[2], argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 0) : 1);
+
+    static recording_t recordings[NUM_FILES];
+    for (int f = 0; f < NUM_FILES; f++) {
+        if (!read_recording(csi_files[f], &recordings[f])) return 1;
+        printf("%s: %d samples at %d Hz\n", csi_files[f], recordings[f].count, SAMPLE_RATE_HZ / DECIMATION);
+    }
+
+    printf("\n pool   hop   window  stream ns/hop  window ns/hop  speedup  rate range BPM   mismatches\n");
+    bool ok = true;
+    csi_cnn_model_t model;
+    if (argc == 2) {
+        csi_model_t blob;
+        const char* reason;
+        if (!csi_model_map_file(argv[1], &blob, &reason)) {
+            printf("Error: %s: %s\n", argv[1], reason);
+            return 1;
+        }
+        if (!load(&blob, &model)) return 1;
+        for (size_t h = 0; h < sizeof(hops) / sizeof(hops[0]); h++) ok &= run(&model, recordings, hops[h]);
+    } else {
+        for (size_t p = 0; p < sizeof(pools) / sizeof(pools[0]); p++) {
+            size_t size;
+            csi_model_t blob;
+            const char* reason;
+            void* data = reference_blob(pools[p], 1, &size);
+            if (!data || !csi_model_parse(data, size, &blob, &reason) || !load(&blob, &model)) return 1;
+            for (size_t h = 0; h < sizeof(hops) / sizeof(hops[0]); h++) ok &= run(&model, recordings, hops[h]);
+            free(data);
+        }
+    }
+    printf("\nReceptive field %d samples (%.1f s); streaming %s the recompute\n", model.receptive_field,
+           model.receptive_field / (double)(SAMPLE_RATE_HZ / DECIMATION), ok ? "matches" : "DOES NOT MATCH");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,307 @@
+#include <string.h>
+#include <math.h>
+#include "csi_cnn.h"
+
+#define HISTORY_MASK (CSI_CNN_HISTORY - 1)
+_Static_assert((CSI_CNN_HISTORY & HISTORY_MASK) == 0, "CSI_CNN_HISTORY must be a power of two");
+
+static int8_t clamp_int8(int32_t value, int32_t low)
+{
+  return (int8_t)(value < low ? low : value > 127 ? 127 : value);
+}
+
+// value * multiplier * 2^(shift - 31), rounded half up; load time keeps the shift in 1..62
+static int32_t requantize(int32_t value, int32_t multiplier, int shift)
+{
+  int total = 31 - shift;
+  int64_t product = (int64_t)value * multiplier;
+  return (int32_t)((product + ((int64_t)1 << (total - 1))) >> total);
+}
+
+// A positive real multiplier as Q31 and a power of two, as TFLite does; false if out of reach
+static bool quantize_multiplier(double real, int32_t *multiplier, int8_t *shift)
+{
+  int exponent;
+  if (!(real > 0.0) || !isfinite(real))
+    return false;
+  int64_t q = llround(frexp(real, &exponent) * (double)(1ll << 31));
+  if (q == (1ll << 31))
+  {
+    q /= 2;
+    exponent++;
+  }
+  if (exponent > 30 || exponent < -31)
+    return false;
+  *multiplier = (int32_t)q;
+  *shift = (int8_t)exponent;
+  return true;
+}
+
+static bool zero_point_ok(int32_t zero_point)
+{
+  return zero_point >= -128 && zero_point <= 127;
+}
+
+/**
+ * @brief Load a CSI_MODEL_CNN blob: check its shapes and quantisation and derive the integer tables.
+ *
+ * The weights stay in the blob, which must outlive the model.
+ *
+ * @param[out] reason Set to a description of the first problem, if any.
+ * @return false if the network must not be used.
+ */
+bool csi_cnn_model_from_blob(const csi_model_t *blob, csi_cnn_model_t *model, const char **reason)
+{
+  memset(model, 0, sizeof(*model));
+  const char *error = NULL;
+  const int32_t *config = csi_model_tensor(blob, "config", CSI_MODEL_I32, 0);
+  int layers = config ? config[0] : 0;
+  if (blob->header->type != CSI_MODEL_CNN)
+    error = "not a CNN model";
+  else if (!config || layers < 1 || layers > CSI_CNN_MAX_LAYERS ||
+           !csi_model_tensor(blob, "config", CSI_MODEL_I32, 3 + 4 * layers))
+    error = "config needs 1 to CSI_CNN_MAX_LAYERS layers";
+  else if (config[1] < 1 || config[1] > CSI_CNN_MAX_POOL)
+    error = "pool out of range";
+  else if (config[2] < 1 || config[2] > CSI_CNN_MAX_DC_SHIFT)
+    error = "dc_shift out of range";
+  if (error)
+  {
+    *reason = error;
+    return false;
+  }
+  model->layer_count = layers;
+  model->pool = config[1];
+  model->dc_shift = config[2];
+  model->receptive_field = 1;
+
+  // Shapes first, so every tensor can be fetched at its exact size
+  uint32_t weight_count = 0, channel_count = 0;
+  int in_channels = 1;
+  for (int l = 0; l < layers && error == NULL; l++)
+  {
+    const int32_t *shape = &config[3 + 4 * l];
+    csi_cnn_layer_t *layer = &model->layers[l];
+    if (shape[0] < 1 || shape[0] > CSI_CNN_MAX_KERNEL || shape[1] < 1 ||
+        (shape[0] - 1) * shape[1] + 1 > CSI_CNN_HISTORY)
+      error = "kernel or dilation out of range";
+    else if (shape[2] < 1 || shape[2] > CSI_CNN_MAX_CHANNELS)
+      error = "channels out of range";
+    else if (shape[3] != 0 && shape[3] != 1)
+      error = "relu must be 0 or 1";
+    else
+    {
+      layer->kernel = (uint8_t)shape[0];
+      layer->dilation = (uint8_t)shape[1];
+      layer->in_channels = (uint8_t)in_channels;
+      layer->out_channels = (uint8_t)shape[2];
+      layer->relu = shape[3] != 0;
+      weight_count += (uint32_t)(layer->out_channels * layer->kernel * layer->in_channels);
+      channel_count += layer->out_channels;
+      model->receptive_field += (layer->kernel - 1) * layer->dilation;
+      in_channels = layer->out_channels;
+    }
+  }
+  const int8_t *weights = csi_model_tensor(blob, "weights", CSI_MODEL_I8, weight_count);
+  const int32_t *biases = csi_model_tensor(blob, "biases", CSI_MODEL_I32, channel_count);
+  const float *weight_scales = csi_model_tensor(blob, "weight_scales", CSI_MODEL_F32, channel_count);
+  const float *act_scales = csi_model_tensor(blob, "act_scales", CSI_MODEL_F32, layers + 1);
+  const int32_t *act_zeros = csi_model_tensor(blob, "act_zeros", CSI_MODEL_I32, layers + 1);
+  const float *head = csi_model_tensor(blob, "head", CSI_MODEL_F32, in_channels + 1);
+  if (error == NULL && (!weights || !biases || !weight_scales || !act_scales || !act_zeros || !head))
+    error = "tensor sizes do not match config";
+
+  for (int l = 0; l <= layers && error == NULL; l++)
+  {
+    if (!(act_scales[l] > 0.0f) || !isfinite(act_scales[l]) || !zero_point_ok(act_zeros[l]))
+      error = "bad activation scale or zero point";
+  }
+  // The input: Q8 amplitude to int8, q = zero_point + x / (256 * scale)
+  if (error == NULL && !quantize_multiplier(1.0 / (256.0 * act_scales[0]), &model->in_multiplier, &model->in_shift))
+    error = "input scale out of range";
+  model->in_zero_point = error ? 0 : act_zeros[0];
+
+  for (int l = 0; l < layers && error == NULL; l++)
+  {
+    csi_cnn_layer_t *layer = &model->layers[l];
+    int span = layer->kernel * layer->in_channels;
+    layer->weights = weights;
+    layer->out_zero_point = act_zeros[l + 1];
+    for (int o = 0; o < layer->out_channels && error == NULL; o++)
+    {
+      double real = (double)act_scales[l] * weight_scales[o] / act_scales[l + 1];
+      int64_t sum = 0;
+      for (int j = 0; j < span; j++)
+        sum += weights[o * span + j];
+      int64_t bias = biases[o] - (int64_t)act_zeros[l] * sum;
+      if (!quantize_multiplier(real, &layer->multiplier[o], &layer->shift[o]))
+        error = "weight scale out of range";
+      else if (bias < INT32_MIN / 2 || bias > INT32_MAX / 2)
+        error = "bias out of range";
+      layer->bias[o] = (int32_t)bias;
+    }
+    weights += layer->out_channels * span;
+    biases += layer->out_channels;
+    weight_scales += layer->out_channels;
+  }
+
+  // Head: BPM = bias + sum of w[c] * scale * (pool sum[c] - pool * zero_point) / pool
+  double unit = error ? 0.0 : (double)act_scales[layers] / model->pool * (1 << 24);
+  for (int c = 0; c < in_channels && error == NULL; c++)
+  {
+    double q = head[c] * unit;
+    if (!isfinite(q) || fabs(q) >= 2147483647.0)
+      error = "head weight out of range";
+    model->head_q24[c] = error ? 0 : (int32_t)llround(q);
+  }
+  if (error == NULL && (!isfinite(head[in_channels]) || fabs(head[in_channels]) >= (1 << 22)))
+    error = "head bias out of range";
+  if (error)
+  {
+    *reason = error;
+    return false;
+  }
+  model->head_bias_q8 = (int32_t)lrintf(head[in_channels] * 256.0f);
+  model->sequence = blob->header->sequence;
+  *reason = NULL;
+  return true;
+}
+
+/**
+ * @brief Forget the signal: every history back to its zero point.
+ */
+void csi_cnn_reset(const csi_cnn_model_t *model, csi_cnn_state_t *state)
+{
+  memset(state, 0, sizeof(*state));
+  for (int l = 0; l < model->layer_count; l++)
+  {
+    int32_t zero_point = l == 0 ? model->in_zero_point : model->layers[l - 1].out_zero_point;
+    memset(state->history[l], (int8_t)zero_point, sizeof(state->history[l]));
+  }
+  if (model->layer_count > 0)
+    memset(state->pooled, (int8_t)model->layers[model->layer_count - 1].out_zero_point, sizeof(state->pooled));
+}
+
+// One output vector of a layer from its kernel input vectors, oldest first
+static void conv_step(const csi_cnn_layer_t *layer, const int8_t *const *taps, int8_t *out)
+{
+  const int8_t *w = layer->weights;
+  int32_t low = layer->relu ? layer->out_zero_point : -128;
+  for (int o = 0; o < layer->out_channels; o++)
+  {
+    int32_t acc = layer->bias[o];
+    for (int k = 0; k < layer->kernel; k++)
+    {
+      const int8_t *x = taps[k];
+      for (int i = 0; i < layer->in_channels; i++)
+        acc += *w++ * x[i];
+    }
+    out[o] = clamp_int8(layer->out_zero_point + requantize(acc, layer->multiplier[o], layer->shift[o]), low);
+  }
+}
+
+static int32_t head(const csi_cnn_model_t *model, const int32_t *sums)
+{
+  int64_t acc = 0;
+  for (int c = 0; c < model->layers[model->layer_count - 1].out_channels; c++)
+    acc += (int64_t)model->head_q24[c] * sums[c];
+  return model->head_bias_q8 + (int32_t)((acc + (1 << 15)) >> 16);
+}
+
+/**
+ * @brief Feed one decimated sample: one output per layer, and the pool moves on by one.
+ *
+ * @param sample_q8 Amplitude, Q8.
+ * @return The quantised input it became, which csi_cnn_window() takes.
+ */
+int8_t csi_cnn_push(const csi_cnn_model_t *model, csi_cnn_state_t *state, int32_t sample_q8)
+{
+  // The first sample primes the DC tracker, so there is no start-up step
+  int64_t x_q16 = (int64_t)sample_q8 << 8;
+  if (state->count == 0)
+    state->dc_q16 = x_q16;
+  else
+    state->dc_q16 += (x_q16 - state->dc_q16) >> model->dc_shift;
+  int32_t centred = sample_q8 - (int32_t)((state->dc_q16 + 128) >> 8);
+  int8_t input = clamp_int8(model->in_zero_point + requantize(centred, model->in_multiplier, model->in_shift), -128);
+
+  uint32_t t = state->count++;
+  int8_t *top = state->pooled[t % model->pool];
+  state->history[0][t & HISTORY_MASK][0] = input;
+  int8_t old[CSI_CNN_MAX_CHANNELS];
+  memcpy(old, top, sizeof(old));
+  for (int l = 0; l < model->layer_count; l++)
+  {
+    const csi_cnn_layer_t *layer = &model->layers[l];
+    const int8_t *taps[CSI_CNN_MAX_KERNEL];
+    for (int k = 0; k < layer->kernel; k++)
+      taps[k] = state->history[l][(t - (uint32_t)((layer->kernel - 1 - k) * layer->dilation)) & HISTORY_MASK];
+    conv_step(layer, taps, l + 1 < model->layer_count ? state->history[l + 1][t & HISTORY_MASK] : top);
+  }
+  for (int c = 0; c < model->layers[model->layer_count - 1].out_channels; c++)
+    state->sums[c] += top[c] - old[c];
+  return input;
+}
+
+/**
+ * @brief Rate from the pooled outputs, O(channels).
+ *
+ * @return false until csi_cnn_ready().
+ */
+bool csi_cnn_output(const csi_cnn_model_t *model, const csi_cnn_state_t *state, int32_t *bpm_q8)
+{
+  if (!csi_cnn_ready(model, state))
+    return false;
+  *bpm_q8 = head(model, state->sums);
+  return true;
+}
+
+/**
+ * @brief Reference: every layer recomputed over a whole window of quantised inputs, zero padded before it.
+ *
+ * Matches csi_cnn_output() bit for bit when input holds the last pool + receptive_field - 1
+ * inputs csi_cnn_push() returned, or all of them since the reset. Costs the whole
+ * window per call; it is what streaming saves.
+ *
+ * @param scratch CSI_CNN_WINDOW_SCRATCH(length) bytes.
+ * @return false if length is shorter than the pool.
+ */
+bool csi_cnn_window(const csi_cnn_model_t *model, const int8_t *input, int length, int8_t *scratch, int32_t *bpm_q8)
+{
+  if (length < model->pool)
+    return false;
+  int8_t *in = scratch, *out = scratch + length * CSI_CNN_MAX_CHANNELS;
+  int8_t pad[CSI_CNN_MAX_CHANNELS];
+  for (int t = 0; t < length; t++)
+    in[t * CSI_CNN_MAX_CHANNELS] = input[t];
+  memset(pad, (int8_t)model->in_zero_point, sizeof(pad));
+
+  for (int l = 0; l < model->layer_count; l++)
+  {
+    const csi_cnn_layer_t *layer = &model->layers[l];
+    for (int t = 0; t < length; t++)
+    {
+      const int8_t *taps[CSI_CNN_MAX_KERNEL];
+      for (int k = 0; k < layer->kernel; k++)
+      {
+        int at = t - (layer->kernel - 1 - k) * layer->dilation;
+        taps[k] = at < 0 ? pad : &in[at * CSI_CNN_MAX_CHANNELS];
+      }
+      conv_step(layer, taps, &out[t * CSI_CNN_MAX_CHANNELS]);
+    }
+    memset(pad, (int8_t)layer->out_zero_point, sizeof(pad));
+    int8_t *swap = in;
+    in = out;
+    out = swap;
+  }
+
+  const csi_cnn_layer_t *top = &model->layers[model->layer_count - 1];
+  int32_t sums[CSI_CNN_MAX_CHANNELS] = {0};
+  for (int t = length - model->pool; t < length; t++)
+  {
+    for (int c = 0; c < top->out_channels; c++)
+      sums[c] += in[t * CSI_CNN_MAX_CHANNELS + c] - top->out_zero_point;
+  }
+  *bpm_q8 = head(model, sums);
+  return true;
+}
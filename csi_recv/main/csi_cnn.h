@@ -0,0 +1,106 @@
+#ifndef CSI_CNN_H
+#define CSI_CNN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "csi_model.h"
+
+// Convolution layers one network can stack
+#define CSI_CNN_MAX_LAYERS 4
+// Widest layer, input or output channels
+#define CSI_CNN_MAX_CHANNELS 16
+#define CSI_CNN_MAX_KERNEL 5
+// Inputs each layer keeps, a power of two; a layer must span at most this many, (kernel - 1) * dilation + 1
+#define CSI_CNN_HISTORY 64
+// Longest average pool ahead of the head, top-layer outputs
+#define CSI_CNN_MAX_POOL 128
+// Longest DC tracker: the input is the sample minus its exponential mean over about 2^dc_shift samples
+#define CSI_CNN_MAX_DC_SHIFT 10
+
+/**
+ * @brief One causal dilated conv1d layer, int8 in and out, TFLite quantisation.
+ *
+ * out[t][o] = zero_point + M[o] * (bias[o] + sum over k, i of w[o][k][i] * (in[t - (kernel - 1 - k) * dilation][i] - in_zero_point)),
+ * M[o] = in_scale * weight_scale[o] / out_scale, applied as multiplier * 2^(shift - 31) with rounding.
+ * The input zero point is folded into the bias at load time.
+ */
+typedef struct
+{
+  uint8_t kernel;
+  uint8_t dilation;
+  uint8_t in_channels;
+  uint8_t out_channels;
+  bool relu;
+  int32_t out_zero_point;
+  const int8_t *weights;                   /**< [out][kernel][in], read in place from the blob */
+  int32_t bias[CSI_CNN_MAX_CHANNELS];      /**< Blob bias minus in_zero_point * sum of the channel's weights */
+  int32_t multiplier[CSI_CNN_MAX_CHANNELS]; /**< Q31, 0.5..1 */
+  int8_t shift[CSI_CNN_MAX_CHANNELS];
+} csi_cnn_layer_t;
+
+/**
+ * @brief Small causal 1-D CNN over the decimated amplitude series, for streaming.
+ *
+ * The input is the Q8 amplitude with its running mean removed, quantised to
+ * int8. A stack of dilated convolutions follows, then the average of the last
+ * pool top-layer outputs and a linear head giving the rate. Everything per
+ * sample is integer.
+ *
+ * Loaded from a CSI_MODEL_CNN blob (csi_model.h), whose weights are used from
+ * flash in place. The blob's tensors:
+ *   config        i32  layer_count, pool, dc_shift, then kernel, dilation, out_channels, relu per layer
+ *   weights       i8   every layer's [out][kernel][in] weights, layer after layer
+ *   biases        i32  every layer's biases
+ *   weight_scales f32  every layer's per-channel weight scales
+ *   act_scales    f32  input, then each layer's output
+ *   act_zeros     i32  zero points of the same
+ *   head          f32  one weight per top-layer channel, then the bias, in BPM
+ */
+typedef struct
+{
+  csi_cnn_layer_t layers[CSI_CNN_MAX_LAYERS];
+  int layer_count;
+  int pool;
+  int dc_shift;
+  int32_t in_zero_point;
+  int32_t in_multiplier; /**< Q8 amplitude to int8 input, like csi_cnn_layer_t::multiplier */
+  int8_t in_shift;
+  int32_t head_q24[CSI_CNN_MAX_CHANNELS]; /**< BPM per unit of a channel's pool sum, Q24 */
+  int32_t head_bias_q8;
+  int receptive_field; /**< Inputs one top-layer output depends on */
+  uint32_t sequence;
+} csi_cnn_model_t;
+
+/**
+ * @brief Streaming state: every layer's recent inputs and the pooled top-layer outputs.
+ *
+ * Each new sample computes one output per layer, from the inputs the layer
+ * already holds, so the cost of a hop is proportional to the samples it brings,
+ * not to the receptive field or the pool. Before the first sample every history
+ * holds its zero point, which is the zero padding a full recompute would use.
+ */
+typedef struct
+{
+  int8_t history[CSI_CNN_MAX_LAYERS][CSI_CNN_HISTORY][CSI_CNN_MAX_CHANNELS]; /**< Inputs of each layer, by time */
+  int8_t pooled[CSI_CNN_MAX_POOL][CSI_CNN_MAX_CHANNELS];                       /**< Last pool top-layer outputs */
+  int32_t sums[CSI_CNN_MAX_CHANNELS];                                         /**< Of pooled, minus the zero point */
+  int64_t dc_q16;   /**< Running mean of the input, 8 bits below Q8 */
+  uint32_t count;   /**< Samples pushed since the last reset */
+} csi_cnn_state_t;
+
+bool csi_cnn_model_from_blob(const csi_model_t *blob, csi_cnn_model_t *model, const char **reason);
+void csi_cnn_reset(const csi_cnn_model_t *model, csi_cnn_state_t *state);
+int8_t csi_cnn_push(const csi_cnn_model_t *model, csi_cnn_state_t *state, int32_t sample_q8);
+bool csi_cnn_output(const csi_cnn_model_t *model, const csi_cnn_state_t *state, int32_t *bpm_q8);
+bool csi_cnn_window(const csi_cnn_model_t *model, const int8_t *input, int length, int8_t *scratch, int32_t *bpm_q8);
+
+// Scratch csi_cnn_window() needs for an input of length samples
+#define CSI_CNN_WINDOW_SCRATCH(length) (2 * (length) * CSI_CNN_MAX_CHANNELS)
+
+// True once every pooled output has seen a full receptive field of real samples
+static inline bool csi_cnn_ready(const csi_cnn_model_t *model, const csi_cnn_state_t *state)
+{
+  return state->count >= (uint32_t)(model->pool + model->receptive_field - 1);
+}
+
+#endif // CSI_CNN_H
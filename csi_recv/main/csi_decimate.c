@@ -0,0 +1,113 @@
+#include <string.h>
+#include "csi_decimate.h"
+
+// Q15 anti-alias filters, Blackman-windowed sinc with the cutoff at 0.8 of the
+// output Nyquist frequency, rounded so each sums to 32768. Index by factor.
+static const int16_t s_taps_2[] = {-324, -697, 1938, 8890, 13154, 8890, 1938, -697, -324};
+static const int16_t s_taps_3[] = {6, -31, -216, -468, -235, 1292, 4252, 7399, 8770,
+                                   7399, 4252, 1292, -235, -468, -216, -31, 6};
+static const int16_t s_taps_4[] = {4, 0, -45, -162, -315, -349, 0, 969, 2567, 4445, 5982, 6576,
+                                   5982, 4445, 2567, 969, 0, -349, -315, -162, -45, 0, 4};
+static const int16_t s_taps_5[] = {2, 3, -9, -50, -129, -229, -292, -217, 111, 775, 1767, 2957, 4111, 4953, 5262,
+                                   4953, 4111, 2957, 1767, 775, 111, -217, -292, -229, -129, -50, -9, 3, 2};
+
+static const struct
+{
+  const int16_t *coeffs;
+  uint8_t taps;
+} s_filters[CSI_DECIM_MAX_FACTOR + 1] = {
+    [2] = {s_taps_2, sizeof(s_taps_2) / sizeof(s_taps_2[0])},
+    [3] = {s_taps_3, sizeof(s_taps_3) / sizeof(s_taps_3[0])},
+    [4] = {s_taps_4, sizeof(s_taps_4) / sizeof(s_taps_4[0])},
+    [5] = {s_taps_5, sizeof(s_taps_5) / sizeof(s_taps_5[0])},
+};
+
+_Static_assert(sizeof(s_taps_5) / sizeof(s_taps_5[0]) == CSI_DECIM_MAX_TAPS, "CSI_DECIM_MAX_TAPS is the factor 5 filter");
+
+/**
+ * @brief Set up a chain of stages.
+ *
+ * @param factors Decimation of each stage, in processing order, each CSI_DECIM_MIN_FACTOR..CSI_DECIM_MAX_FACTOR.
+ * @return false for an unsupported factor or more than CSI_DECIM_MAX_STAGES stages.
+ */
+bool csi_decimator_init(csi_decimator_t *decimator, const uint8_t *factors, int count)
+{
+  memset(decimator, 0, sizeof(*decimator));
+  if (count < 1 || count > CSI_DECIM_MAX_STAGES)
+    return false;
+  decimator->factor = 1;
+  for (int s = 0; s < count; s++)
+  {
+    if (factors[s] < CSI_DECIM_MIN_FACTOR || factors[s] > CSI_DECIM_MAX_FACTOR)
+      return false;
+    csi_decim_stage_t *stage = &decimator->stages[s];
+    stage->factor = factors[s];
+    stage->coeffs = s_filters[factors[s]].coeffs;
+    stage->taps = s_filters[factors[s]].taps;
+    decimator->factor *= factors[s];
+  }
+  decimator->count = count;
+  return true;
+}
+
+/**
+ * @brief Forget the history, e.g. across a gap; the next input primes every stage again.
+ */
+void csi_decimator_reset(csi_decimator_t *decimator)
+{
+  for (int s = 0; s < decimator->count; s++)
+  {
+    csi_decim_stage_t *stage = &decimator->stages[s];
+    stage->phase = 0;
+    stage->pos = 0;
+    stage->primed = false;
+  }
+}
+
+static bool stage_push(csi_decim_stage_t *stage, int32_t in, int32_t *out)
+{
+  int taps = stage->taps;
+  if (!stage->primed)
+  {
+    for (int i = 0; i < 2 * taps; i++)
+      stage->history[i] = in;
+    stage->primed = true;
+  }
+  stage->history[stage->pos] = in;
+  stage->history[stage->pos + taps] = in;
+  if (++stage->pos == taps)
+    stage->pos = 0;
+  if (++stage->phase < stage->factor)
+    return false;
+  stage->phase = 0;
+
+  // Oldest to newest; the filter is symmetric, so pair the ends and meet at the centre tap
+  const int32_t *x = stage->history + stage->pos;
+  const int16_t *c = stage->coeffs;
+  int half = taps / 2;
+  int64_t acc = (int64_t)c[half] * x[half];
+  for (int i = 0; i < half; i++)
+    acc += (int64_t)c[i] * ((int64_t)x[i] + x[taps - 1 - i]);
+  acc += 1 << 14;
+  acc >>= 15;
+  *out = acc > INT32_MAX ? INT32_MAX : acc < INT32_MIN ? INT32_MIN : (int32_t)acc;
+  return true;
+}
+
+/**
+ * @brief Feed one input sample.
+ *
+ * @param[out] out Set when the last stage produces a sample, once per decimator->factor inputs.
+ * @return true if @p out was written.
+ */
+bool csi_decimator_push(csi_decimator_t *decimator, int32_t in, int32_t *out)
+{
+  int32_t value = in;
+  for (int s = 0; s < decimator->count; s++)
+  {
+    if (!stage_push(&decimator->stages[s], value, &value))
+      return false;
+  }
+  *out = value;
+  return true;
+}
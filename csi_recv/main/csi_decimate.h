@@ -0,0 +1,53 @@
+#ifndef CSI_DECIMATE_H
+#define CSI_DECIMATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Stages one decimator can chain
+#define CSI_DECIM_MAX_STAGES 3
+// Supported factor of one stage; each has its own anti-alias filter
+#define CSI_DECIM_MIN_FACTOR 2
+#define CSI_DECIM_MAX_FACTOR 5
+// Longest stage filter (factor 5)
+#define CSI_DECIM_MAX_TAPS 29
+
+/**
+ * @brief One polyphase FIR decimation stage.
+ *
+ * Low-pass filters (Blackman-windowed sinc, -3 dB at 0.63 of the output
+ * Nyquist frequency) and keeps every factor-th sample. Only the kept outputs
+ * are computed: the filter runs once per factor inputs, and its symmetry halves
+ * the multiplies. Coefficients are Q15 and sum to exactly 1.0, so a constant
+ * input comes out unchanged.
+ */
+typedef struct
+{
+  const int16_t *coeffs;
+  uint8_t factor;
+  uint8_t taps;
+  uint8_t phase; /**< Inputs since the last output */
+  uint8_t pos;   /**< Slot of the next input in history */
+  bool primed;   /**< History holds real inputs (the first one fills it, so there is no start-up step) */
+  int32_t history[2 * CSI_DECIM_MAX_TAPS]; /**< Each input stored twice, so the last taps inputs are contiguous */
+} csi_decim_stage_t;
+
+/**
+ * @brief Chain of decimation stages, e.g. {4} for 20 Hz -> 5 Hz or {5, 4} for 100 Hz -> 5 Hz.
+ *
+ * Samples are int32 in any fixed-point format; the output keeps it. Every stage
+ * is flat to 0.25 dB up to 0.24 of its output Nyquist frequency, and what would
+ * alias onto that band is attenuated by more than 70 dB.
+ */
+typedef struct
+{
+  csi_decim_stage_t stages[CSI_DECIM_MAX_STAGES];
+  int count;
+  int factor; /**< Product of the stage factors */
+} csi_decimator_t;
+
+bool csi_decimator_init(csi_decimator_t *decimator, const uint8_t *factors, int count);
+void csi_decimator_reset(csi_decimator_t *decimator);
+bool csi_decimator_push(csi_decimator_t *decimator, int32_t in, int32_t *out);
+
+#endif // CSI_DECIMATE_H
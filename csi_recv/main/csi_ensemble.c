@@ -0,0 +1,174 @@
+#include <string.h>
+#include "csi_ensemble.h"
+
+void csi_ensemble_init(csi_ensemble_t *ensemble, csi_ensemble_clock_fn clock)
+{
+  memset(ensemble, 0, sizeof(*ensemble));
+  ensemble->clock = clock;
+}
+
+/**
+ * @brief Register an estimator; it starts enabled.
+ *
+ * @return Its slot, the bit it takes in masks, or -1 when the ensemble is full.
+ */
+int csi_ensemble_add(csi_ensemble_t *ensemble, const char *name, csi_estimator_fn estimate)
+{
+  if (ensemble->count == CSI_ENSEMBLE_MAX)
+    return -1;
+  int slot = ensemble->count++;
+  ensemble->slots[slot].name = name;
+  ensemble->slots[slot].estimate = estimate;
+  ensemble->enabled |= 1u << slot;
+  return slot;
+}
+
+/**
+ * @brief Add work an estimator did outside csi_ensemble_run(), e.g. per-sample streaming updates.
+ */
+void csi_ensemble_charge(csi_ensemble_t *ensemble, int slot, uint32_t cost)
+{
+  if (slot >= 0 && slot < ensemble->count)
+    ensemble->slots[slot].cost += cost;
+}
+
+/**
+ * @brief Confidence-weighted median of the estimates selected by @p mask.
+ *
+ * @return false if none of them has an estimate.
+ */
+bool csi_ensemble_fuse(const csi_breath_estimate_t *estimates, uint32_t mask, csi_breath_estimate_t *fused)
+{
+  // Insertion sort by rate; at most CSI_ENSEMBLE_MAX entries
+  csi_breath_estimate_t sorted[CSI_ENSEMBLE_MAX];
+  int n = 0;
+  uint32_t total = 0;
+  for (int i = 0; i < CSI_ENSEMBLE_MAX; i++)
+  {
+    if (!(mask & (1u << i)) || estimates[i].confidence_q8 == 0)
+      continue;
+    int j = n++;
+    while (j > 0 && sorted[j - 1].bpm_q8 > estimates[i].bpm_q8)
+    {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = estimates[i];
+    total += estimates[i].confidence_q8;
+  }
+  if (n == 0)
+    return false;
+
+  // Lower weighted median: the first rate at which the running weight reaches half
+  uint32_t running = 0;
+  int median = 0;
+  while (median < n - 1 && (running + sorted[median].confidence_q8) * 2 < total)
+    running += sorted[median++].confidence_q8;
+
+  uint32_t agreeing = 0;
+  for (int i = 0; i < n; i++)
+  {
+    int32_t diff = sorted[i].bpm_q8 - sorted[median].bpm_q8;
+    if (diff <= CSI_ENSEMBLE_AGREE_Q8 && diff >= -CSI_ENSEMBLE_AGREE_Q8)
+      agreeing += sorted[i].confidence_q8;
+  }
+  fused->bpm_q8 = sorted[median].bpm_q8;
+  fused->confidence_q8 = (uint16_t)(agreeing / n);
+  return true;
+}
+
+/**
+ * @brief Run every enabled estimator on the window and fuse what they report.
+ *
+ * @return false if no enabled estimator had an estimate.
+ */
+bool csi_ensemble_run(csi_ensemble_t *ensemble, const csi_breath_window_t *window, csi_breath_estimate_t *fused)
+{
+  ensemble->last_valid = 0;
+  for (int i = 0; i < ensemble->count; i++)
+  {
+    csi_estimator_slot_t *slot = &ensemble->slots[i];
+    csi_breath_estimate_t *estimate = &ensemble->last[i];
+    estimate->bpm_q8 = 0;
+    estimate->confidence_q8 = 0;
+    if (!(ensemble->enabled & (1u << i)))
+      continue;
+
+    uint32_t start = ensemble->clock ? ensemble->clock() : 0;
+    bool valid = slot->estimate(window, estimate);
+    uint32_t cost = ensemble->clock ? ensemble->clock() - start : 0;
+    slot->runs++;
+    slot->cost += cost;
+    if (cost > slot->cost_max)
+      slot->cost_max = cost;
+    if (!valid)
+      estimate->confidence_q8 = 0;
+    if (estimate->confidence_q8 > 0)
+    {
+      slot->valid++;
+      ensemble->last_valid |= 1u << i;
+    }
+  }
+  return csi_ensemble_fuse(ensemble->last, ensemble->last_valid, fused);
+}
+
+/**
+ * @brief Compare the last run with a known rate, per estimator and per subset of them.
+ *
+ * A subset counts only where all of its members had an estimate, so subsets
+ * are compared on the windows they can actually cover.
+ */
+void csi_ensemble_score(csi_ensemble_t *ensemble, int32_t reference_bpm_q8)
+{
+  uint32_t valid = ensemble->last_valid;
+  for (int i = 0; i < ensemble->count; i++)
+  {
+    if (!(valid & (1u << i)))
+      continue;
+    int32_t error = ensemble->last[i].bpm_q8 - reference_bpm_q8;
+    ensemble->slots[i].abs_error_q8 += error < 0 ? -error : error;
+    ensemble->slots[i].scored++;
+  }
+  for (uint32_t subset = 1; subset < (1u << ensemble->count); subset++)
+  {
+    csi_breath_estimate_t fused;
+    if ((subset & valid) != subset || !csi_ensemble_fuse(ensemble->last, subset, &fused))
+      continue;
+    int32_t error = fused.bpm_q8 - reference_bpm_q8;
+    ensemble->subset_error_q8[subset] += error < 0 ? -error : error;
+    ensemble->subset_scored[subset]++;
+  }
+}
+
+/**
+ * @brief Cheapest scored subset whose fused MAE is within the target.
+ *
+ * Cost is the sum of the members' mean cost per run.
+ *
+ * @param[out] mask The subset, as a mask for ensemble->enabled.
+ * @return false if no subset meets the target.
+ */
+bool csi_ensemble_cheapest(const csi_ensemble_t *ensemble, int32_t mae_target_q8, uint32_t *mask)
+{
+  bool found = false;
+  uint64_t best_cost = 0;
+  for (uint32_t subset = 1; subset < (1u << ensemble->count); subset++)
+  {
+    uint32_t scored = ensemble->subset_scored[subset];
+    if (scored == 0 || ensemble->subset_error_q8[subset] > (uint64_t)mae_target_q8 * scored)
+      continue;
+    uint64_t cost = 0;
+    for (int i = 0; i < ensemble->count; i++)
+    {
+      if (subset & (1u << i))
+        cost += csi_ensemble_mean_cost(ensemble, i);
+    }
+    if (!found || cost < best_cost)
+    {
+      found = true;
+      best_cost = cost;
+      *mask = subset;
+    }
+  }
+  return found;
+}
@@ -0,0 +1,103 @@
+#ifndef CSI_ENSEMBLE_H
+#define CSI_ENSEMBLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Estimators one ensemble can hold; subsets are tracked as bit masks of this width
+#define CSI_ENSEMBLE_MAX 6
+// Estimates this close to the fused rate count as agreeing with it (Q8, 2 BPM)
+#define CSI_ENSEMBLE_AGREE_Q8 (2 * 256)
+// Peak-to-band-mean magnitude ratio that earns a spectral estimate full confidence
+#define CSI_ENSEMBLE_FULL_SNR 5.0f
+
+/**
+ * @brief One breathing window, preprocessed once and shared by every estimator.
+ */
+typedef struct
+{
+  const float *series; /**< Decimated amplitude, mean removed, oldest first */
+  int series_length;
+  float rate_hz;       /**< Sample rate of series */
+  const int16_t *raw;  /**< Per-packet window for models fitted on raw csi_q, NULL if none */
+  int raw_length;
+  void *context;       /**< Caller state, e.g. the session with the streaming estimators */
+} csi_breath_window_t;
+
+typedef struct
+{
+  int32_t bpm_q8;
+  uint16_t confidence_q8; /**< 0..256; 0 means no estimate */
+} csi_breath_estimate_t;
+
+/**
+ * @brief Estimate the rate of one window. Return false (or confidence 0) when there is none.
+ */
+typedef bool (*csi_estimator_fn)(const csi_breath_window_t *window, csi_breath_estimate_t *out);
+// Monotonic cost counter, e.g. CPU cycles on the device or nanoseconds on the host
+typedef uint32_t (*csi_ensemble_clock_fn)(void);
+
+typedef struct
+{
+  const char *name;
+  csi_estimator_fn estimate;
+  uint32_t runs;
+  uint32_t valid;      /**< Runs that produced an estimate */
+  uint64_t cost;       /**< Clock units, window estimates plus csi_ensemble_charge() */
+  uint32_t cost_max;   /**< Most expensive single run */
+  uint64_t abs_error_q8;
+  uint32_t scored;     /**< Valid runs compared with a reference rate */
+} csi_estimator_slot_t;
+
+/**
+ * @brief Breathing estimators behind one interface, fused by confidence.
+ *
+ * Each enabled estimator runs on the shared window and reports a rate and a
+ * confidence. The fused rate is the confidence-weighted median, which one
+ * wild estimate cannot drag away; its confidence is the weight agreeing with
+ * it (within CSI_ENSEMBLE_AGREE_Q8) over the number of estimates. Every run is
+ * timed with the clock, and estimators with streaming state charge their
+ * per-sample updates with csi_ensemble_charge(), so cost covers all the work.
+ *
+ * When a reference rate is known (evaluation captures), csi_ensemble_score()
+ * records the error of every estimator and of every subset of them, fused
+ * the same way, and csi_ensemble_cheapest() picks the subset with the lowest
+ * cost that meets an MAE target.
+ */
+typedef struct
+{
+  csi_estimator_slot_t slots[CSI_ENSEMBLE_MAX];
+  int count;
+  uint32_t enabled;               /**< Mask of slots that run */
+  csi_ensemble_clock_fn clock;
+  csi_breath_estimate_t last[CSI_ENSEMBLE_MAX];
+  uint32_t last_valid;            /**< Mask of slots with an estimate from the last run */
+  uint64_t subset_error_q8[1 << CSI_ENSEMBLE_MAX];
+  uint32_t subset_scored[1 << CSI_ENSEMBLE_MAX];
+} csi_ensemble_t;
+
+void csi_ensemble_init(csi_ensemble_t *ensemble, csi_ensemble_clock_fn clock);
+int csi_ensemble_add(csi_ensemble_t *ensemble, const char *name, csi_estimator_fn estimate);
+void csi_ensemble_charge(csi_ensemble_t *ensemble, int slot, uint32_t cost);
+bool csi_ensemble_fuse(const csi_breath_estimate_t *estimates, uint32_t mask, csi_breath_estimate_t *fused);
+bool csi_ensemble_run(csi_ensemble_t *ensemble, const csi_breath_window_t *window, csi_breath_estimate_t *fused);
+void csi_ensemble_score(csi_ensemble_t *ensemble, int32_t reference_bpm_q8);
+bool csi_ensemble_cheapest(const csi_ensemble_t *ensemble, int32_t mae_target_q8, uint32_t *mask);
+
+// Mean cost of one run of a slot, in clock units
+static inline uint32_t csi_ensemble_mean_cost(const csi_ensemble_t *ensemble, int slot)
+{
+  const csi_estimator_slot_t *s = &ensemble->slots[slot];
+  return s->runs ? (uint32_t)(s->cost / s->runs) : 0;
+}
+
+// Confidence of a spectral estimate from its peak over the mean in-band magnitude
+static inline uint16_t csi_ensemble_snr_confidence(float peak, float band_mean)
+{
+  if (!(band_mean > 0.0f) || peak <= band_mean)
+    return 0;
+  float confidence = (peak / band_mean - 1.0f) / (CSI_ENSEMBLE_FULL_SNR - 1.0f);
+  return confidence >= 1.0f ? 256 : (uint16_t)(confidence * 256.0f);
+}
+
+#endif // CSI_ENSEMBLE_H
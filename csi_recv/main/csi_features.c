@@ -0,0 +1,114 @@
+#include <string.h>
+#include <math.h>
+#include "csi_features.h"
+#include "csi_fixed.h"
+
+#define MASK (CSI_FEATURES_MAX_WINDOW - 1)
+
+_Static_assert((CSI_FEATURES_MAX_WINDOW & MASK) == 0, "CSI_FEATURES_MAX_WINDOW must be a power of two");
+
+/**
+ * @brief Set the window and clear the state.
+ *
+ * @param window Samples per window, 2..CSI_FEATURES_MAX_WINDOW.
+ * @return false if the window is out of range.
+ */
+bool csi_features_init(csi_features_t *features, int window)
+{
+  memset(features, 0, sizeof(*features));
+  if (window < 2 || window > CSI_FEATURES_MAX_WINDOW)
+    return false;
+  features->window = (uint16_t)window;
+  return true;
+}
+
+/**
+ * @brief Forget the samples, e.g. when the next window does not continue the last one.
+ */
+void csi_features_reset(csi_features_t *features)
+{
+  csi_features_init(features, features->window);
+}
+
+/**
+ * @brief Append one sample; once the window is full the oldest one leaves.
+ */
+void csi_features_push(csi_features_t *features, int16_t in)
+{
+  uint32_t n = features->count;
+  const int16_t *x = features->x;
+  if (n >= features->window)
+  {
+    // Read the leaving pair before the new sample can take the oldest slot
+    uint32_t old = n - features->window;
+    int32_t leaving = x[old & MASK];
+    int64_t diff = x[(old + 1) & MASK] - leaving;
+    features->sum -= leaving;
+    features->sum_sq -= leaving * leaving;
+    features->diff_sq -= diff * diff;
+    if (features->max_q[features->max_head & MASK] == old)
+      features->max_head++;
+    if (features->min_q[features->min_head & MASK] == old)
+      features->min_head++;
+  }
+  if (n > 0)
+  {
+    int64_t diff = in - x[(n - 1) & MASK];
+    features->diff_sq += diff * diff;
+  }
+  features->sum += in;
+  features->sum_sq += (int32_t)in * in;
+
+  // Whatever the new sample tops can never be the window's extreme again
+  while (features->max_tail != features->max_head && x[features->max_q[(features->max_tail - 1) & MASK] & MASK] <= in)
+    features->max_tail--;
+  features->max_q[features->max_tail++ & MASK] = n;
+  while (features->min_tail != features->min_head && x[features->min_q[(features->min_tail - 1) & MASK] & MASK] >= in)
+    features->min_tail--;
+  features->min_q[features->min_tail++ & MASK] = n;
+
+  features->x[n & MASK] = in;
+  features->count = n + 1;
+}
+
+/**
+ * @brief Features of the latest window, as extract_features() computes them.
+ *
+ * @return false until a full window has been pushed.
+ */
+bool csi_features_get(const csi_features_t *features, float *out)
+{
+  if (!csi_features_ready(features))
+    return false;
+  double n = features->window;
+  // N^2 * variance is exact in int64 and, below 2^53, in double as well
+  int64_t spread = (int64_t)features->window * features->sum_sq - features->sum * features->sum;
+  out[0] = (float)(features->sum / n);
+  out[1] = (float)sqrt(spread / (n * n));
+  out[2] = features->x[features->max_q[features->max_head & MASK] & MASK];
+  out[3] = features->x[features->min_q[features->min_head & MASK] & MASK];
+  out[4] = (float)features->diff_sq;
+  return true;
+}
+
+/**
+ * @brief Features of the latest window in Q16, as extract_features_q() computes them.
+ *
+ * @return false until a full window has been pushed.
+ */
+bool csi_features_get_q(const csi_features_t *features, int64_t *out)
+{
+  if (!csi_features_ready(features))
+    return false;
+  int64_t window = features->window;
+  int64_t spread = window * features->sum_sq - features->sum * features->sum;
+  const int64_t n2 = window * window;
+  uint64_t var_q24 = spread <= (INT64_MAX >> 24) ? (uint64_t)(spread << 24) / n2 : (uint64_t)(spread / n2) << 24;
+  // Q16 by multiplying: a left shift of a negative value is undefined
+  out[0] = features->sum * 65536 / window;
+  out[1] = (int64_t)csi_isqrt64(var_q24) << 4;
+  out[2] = (int64_t)features->x[features->max_q[features->max_head & MASK] & MASK] * 65536;
+  out[3] = (int64_t)features->x[features->min_q[features->min_head & MASK] & MASK] * 65536;
+  out[4] = features->diff_sq << 16;
+  return true;
+}
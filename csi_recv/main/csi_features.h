@@ -0,0 +1,58 @@
+#ifndef CSI_FEATURES_H
+#define CSI_FEATURES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Longest window. Power of two, so ring positions are a mask.
+#define CSI_FEATURES_MAX_WINDOW 512
+// mean, std, max, min, diff energy: the breathing model's input (breathing_rate_evaluation_svm.c)
+#define CSI_FEATURES_COUNT 5
+
+/**
+ * @brief Sliding-window form of extract_features() and extract_features_q().
+ *
+ * Samples enter one at a time and, once the window is full, each one pushes the
+ * oldest out, so a window hop samples after the previous one costs hop updates
+ * rather than a pass over the whole window, whatever the window and hop.
+ * The sum, sum of squares and first-difference energy are exact integers,
+ * updated as samples enter and leave; the maximum and minimum are the fronts of
+ * monotonic deques of stream indices, amortised O(1) per sample. The features
+ * are derived from the exact sums in double precision, so they match the batch
+ * functions exactly instead of inheriting float cancellation in sqsum/N - mean^2.
+ */
+typedef struct
+{
+  int16_t x[CSI_FEATURES_MAX_WINDOW];      /**< Ring of the window's samples, by stream index */
+  uint32_t max_q[CSI_FEATURES_MAX_WINDOW]; /**< Stream indices whose samples decrease from the front */
+  uint32_t min_q[CSI_FEATURES_MAX_WINDOW]; /**< Stream indices whose samples increase from the front */
+  uint32_t max_head, max_tail;             /**< Free-running deque positions */
+  uint32_t min_head, min_tail;
+  uint32_t count;                          /**< Samples pushed since the last reset */
+  uint16_t window;
+  int64_t sum;
+  int64_t sum_sq;
+  int64_t diff_sq;                         /**< Sum of squared differences of neighbours inside the window */
+} csi_features_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool csi_features_init(csi_features_t *features, int window);
+void csi_features_reset(csi_features_t *features);
+void csi_features_push(csi_features_t *features, int16_t in);
+bool csi_features_get(const csi_features_t *features, float *out);
+bool csi_features_get_q(const csi_features_t *features, int64_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+// True once a full window has been pushed
+static inline bool csi_features_ready(const csi_features_t *features)
+{
+  return features->count >= features->window;
+}
+
+#endif // CSI_FEATURES_H
@@ -0,0 +1,309 @@
+#include <math.h>
+#include <string.h>
+#include "csi_fft.h"
+
+static inline csi_complex_t cmul(csi_complex_t a, csi_complex_t b)
+{
+  csi_complex_t r = {a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re};
+  return r;
+}
+
+static inline csi_complex_t cadd(csi_complex_t a, csi_complex_t b)
+{
+  csi_complex_t r = {a.re + b.re, a.im + b.im};
+  return r;
+}
+
+static inline csi_complex_t csub(csi_complex_t a, csi_complex_t b)
+{
+  csi_complex_t r = {a.re - b.re, a.im - b.im};
+  return r;
+}
+
+static csi_complex_t unit(double turns)
+{
+  double angle = -2.0 * M_PI * turns;
+  csi_complex_t r = {(float)cos(angle), (float)sin(angle)};
+  return r;
+}
+
+/**
+ * Split m into radix-4 stages first, then 2, 3, 5 and whatever primes are
+ * left. Each stage is stored as (radix, length left after it).
+ */
+static bool factorize(csi_fft_plan_t *plan, int m)
+{
+  int p = 4;
+  plan->stages = 0;
+  while (m > 1)
+  {
+    while (m % p)
+    {
+      p = p == 4 ? 2 : p == 2 ? 3 : p + 2;
+      if (p * p > m)
+        p = m;
+    }
+    if (plan->stages == CSI_FFT_MAX_STAGES)
+      return false;
+    m /= p;
+    plan->factors[2 * plan->stages] = p;
+    plan->factors[2 * plan->stages + 1] = m;
+    plan->stages++;
+  }
+  return true;
+}
+
+/**
+ * @brief Build a plan for n point real transforms.
+ *
+ * @param n Even transform length, at least 2. Any factorization works; lengths
+ *        made of 2, 3 and 5 are the fast ones.
+ * @param storage At least CSI_FFT_STORAGE_FLOATS(n) floats, owned by the plan from here on.
+ * @return false if n or the storage does not fit.
+ */
+bool csi_fft_plan_init(csi_fft_plan_t *plan, int n, csi_fft_window_t window, float *storage, size_t storage_floats)
+{
+  memset(plan, 0, sizeof(*plan));
+  if (n < 2 || n % 2 || storage_floats < (size_t)CSI_FFT_STORAGE_FLOATS(n))
+    return false;
+
+  int m = n / 2;
+  if (!factorize(plan, m))
+    return false;
+  plan->n = n;
+  plan->m = m;
+
+  csi_complex_t *tables = (csi_complex_t *)storage;
+  plan->twiddles = tables;
+  plan->split = tables + m;
+  plan->work = tables + 2 * m;
+  plan->scratch = tables + 3 * m;
+  for (int i = 0; i < m; i++)
+  {
+    plan->twiddles[i] = unit((double)i / m);
+    plan->split[i] = unit((double)i / n);
+  }
+
+  if (window == CSI_FFT_WINDOW_HANN)
+  {
+    plan->window = storage + 8 * m;
+    for (int i = 0; i < n; i++)
+      plan->window[i] = (float)(0.5 * (1.0 - cos(2.0 * M_PI * i / (n - 1))));
+  }
+  return true;
+}
+
+static void butterfly2(csi_complex_t *out, const csi_complex_t *tw, int stride, int m)
+{
+  for (int k = 0; k < m; k++)
+  {
+    csi_complex_t t = cmul(out[k + m], tw[k * stride]);
+    out[k + m] = csub(out[k], t);
+    out[k] = cadd(out[k], t);
+  }
+}
+
+static void butterfly3(csi_complex_t *out, const csi_complex_t *tw, int stride, int m)
+{
+  // -sin(2 pi / 3), the imaginary part of the forward radix-3 rotation
+  const float s = -0.86602540378443864676f;
+  for (int k = 0; k < m; k++)
+  {
+    csi_complex_t a = out[k];
+    csi_complex_t b = cmul(out[k + m], tw[k * stride]);
+    csi_complex_t c = cmul(out[k + 2 * m], tw[2 * k * stride]);
+    csi_complex_t sum = cadd(b, c);
+    csi_complex_t diff = csub(b, c);
+    csi_complex_t mid = {a.re - 0.5f * sum.re, a.im - 0.5f * sum.im};
+    out[k] = cadd(a, sum);
+    out[k + m].re = mid.re - s * diff.im;
+    out[k + m].im = mid.im + s * diff.re;
+    out[k + 2 * m].re = mid.re + s * diff.im;
+    out[k + 2 * m].im = mid.im - s * diff.re;
+  }
+}
+
+static void butterfly4(csi_complex_t *out, const csi_complex_t *tw, int stride, int m)
+{
+  for (int k = 0; k < m; k++)
+  {
+    csi_complex_t a = out[k];
+    csi_complex_t b = cmul(out[k + m], tw[k * stride]);
+    csi_complex_t c = cmul(out[k + 2 * m], tw[2 * k * stride]);
+    csi_complex_t d = cmul(out[k + 3 * m], tw[3 * k * stride]);
+    csi_complex_t ac_sum = cadd(a, c);
+    csi_complex_t ac_diff = csub(a, c);
+    csi_complex_t bd_sum = cadd(b, d);
+    csi_complex_t bd_diff = csub(b, d);
+    out[k] = cadd(ac_sum, bd_sum);
+    out[k + 2 * m] = csub(ac_sum, bd_sum);
+    // -j * (b - d) and +j * (b - d)
+    out[k + m].re = ac_diff.re + bd_diff.im;
+    out[k + m].im = ac_diff.im - bd_diff.re;
+    out[k + 3 * m].re = ac_diff.re - bd_diff.im;
+    out[k + 3 * m].im = ac_diff.im + bd_diff.re;
+  }
+}
+
+static void butterfly5(csi_complex_t *out, const csi_complex_t *tw, int stride, int m)
+{
+  // exp(-j 2 pi / 5) and exp(-j 4 pi / 5)
+  const csi_complex_t ya = {0.30901699437494742410f, -0.95105651629515357212f};
+  const csi_complex_t yb = {-0.80901699437494742410f, -0.58778525229247312917f};
+  for (int k = 0; k < m; k++)
+  {
+    csi_complex_t s0 = out[k];
+    csi_complex_t s1 = cmul(out[k + m], tw[k * stride]);
+    csi_complex_t s2 = cmul(out[k + 2 * m], tw[2 * k * stride]);
+    csi_complex_t s3 = cmul(out[k + 3 * m], tw[3 * k * stride]);
+    csi_complex_t s4 = cmul(out[k + 4 * m], tw[4 * k * stride]);
+    csi_complex_t s7 = cadd(s1, s4);
+    csi_complex_t s10 = csub(s1, s4);
+    csi_complex_t s8 = cadd(s2, s3);
+    csi_complex_t s9 = csub(s2, s3);
+
+    out[k].re = s0.re + s7.re + s8.re;
+    out[k].im = s0.im + s7.im + s8.im;
+
+    csi_complex_t s5 = {s0.re + s7.re * ya.re + s8.re * yb.re, s0.im + s7.im * ya.re + s8.im * yb.re};
+    csi_complex_t s6 = {s10.im * ya.im + s9.im * yb.im, -s10.re * ya.im - s9.re * yb.im};
+    out[k + m] = csub(s5, s6);
+    out[k + 4 * m] = cadd(s5, s6);
+
+    csi_complex_t s11 = {s0.re + s7.re * yb.re + s8.re * ya.re, s0.im + s7.im * yb.re + s8.im * ya.re};
+    csi_complex_t s12 = {-s10.im * yb.im + s9.im * ya.im, s10.re * yb.im - s9.re * ya.im};
+    out[k + 2 * m] = cadd(s11, s12);
+    out[k + 3 * m] = csub(s11, s12);
+  }
+}
+
+// Any other prime radix: a direct p-point DFT per group, O(p^2)
+static void butterfly_generic(const csi_fft_plan_t *plan, csi_complex_t *out, int stride, int m, int p)
+{
+  csi_complex_t *scratch = plan->scratch;
+  int size = plan->m;
+  for (int k = 0; k < m; k++)
+  {
+    for (int q = 0; q < p; q++)
+      scratch[q] = out[k + q * m];
+    for (int q = 0; q < p; q++)
+    {
+      int index = k + q * m;
+      int step = (int)(((int64_t)stride * index) % size);
+      int tw = 0;
+      csi_complex_t acc = scratch[0];
+      for (int r = 1; r < p; r++)
+      {
+        tw += step;
+        if (tw >= size)
+          tw -= size;
+        acc = cadd(acc, cmul(scratch[r], plan->twiddles[tw]));
+      }
+      out[index] = acc;
+    }
+  }
+}
+
+/**
+ * Decimation in time: the p sub-transforms of length m over every p-th input
+ * are written to consecutive blocks of out, then one radix-p stage combines
+ * them. Recursion depth is the number of stages.
+ */
+static void transform(const csi_fft_plan_t *plan, csi_complex_t *out, const csi_complex_t *in, int stride, const int *factors)
+{
+  int p = factors[0];
+  int m = factors[1];
+  if (m == 1)
+  {
+    for (int q = 0; q < p; q++)
+      out[q] = in[q * stride];
+  }
+  else
+  {
+    for (int q = 0; q < p; q++)
+      transform(plan, out + q * m, in + q * stride, stride * p, factors + 2);
+  }
+
+  switch (p)
+  {
+  case 2:
+    butterfly2(out, plan->twiddles, stride, m);
+    break;
+  case 3:
+    butterfly3(out, plan->twiddles, stride, m);
+    break;
+  case 4:
+    butterfly4(out, plan->twiddles, stride, m);
+    break;
+  case 5:
+    butterfly5(out, plan->twiddles, stride, m);
+    break;
+  default:
+    butterfly_generic(plan, out, stride, m, p);
+    break;
+  }
+}
+
+/**
+ * @brief Forward complex transform of plan->m points. in and out must not overlap.
+ */
+void csi_fft_complex(const csi_fft_plan_t *plan, const csi_complex_t *in, csi_complex_t *out)
+{
+  if (plan->m == 1)
+  {
+    out[0] = in[0];
+    return;
+  }
+  transform(plan, out, in, 1, plan->factors);
+}
+
+/**
+ * @brief Forward transform of plan->n real samples, windowed if the plan has a window.
+ *
+ * @param[out] out plan->n / 2 + 1 bins, DC to Nyquist, unnormalized.
+ */
+void csi_fft_real(const csi_fft_plan_t *plan, const float *in, csi_complex_t *out)
+{
+  int m = plan->m;
+  csi_complex_t *packed = plan->work;
+  for (int i = 0; i < m; i++)
+  {
+    if (plan->window)
+    {
+      packed[i].re = in[2 * i] * plan->window[2 * i];
+      packed[i].im = in[2 * i + 1] * plan->window[2 * i + 1];
+    }
+    else
+    {
+      packed[i].re = in[2 * i];
+      packed[i].im = in[2 * i + 1];
+    }
+  }
+
+  // z = fft(even + j odd); even and odd spectra are the conjugate-symmetric and
+  // anti-symmetric parts of z, and X[k] = E[k] + exp(-j 2 pi k / n) O[k].
+  // out doubles as the transform buffer, so it needs its m + 1 bins anyway.
+  csi_fft_complex(plan, packed, out);
+  csi_complex_t z0 = out[0];
+  out[0].re = z0.re + z0.im;
+  out[0].im = 0.0f;
+  out[m].re = z0.re - z0.im;
+  out[m].im = 0.0f;
+  for (int k = 1; k <= m / 2; k++)
+  {
+    csi_complex_t a = out[k];
+    csi_complex_t b = out[m - k];
+    // Bin k from (a, conj b), bin m - k from (b, conj a)
+    csi_complex_t even = {0.5f * (a.re + b.re), 0.5f * (a.im - b.im)};
+    csi_complex_t odd = {0.5f * (a.im + b.im), -0.5f * (a.re - b.re)};
+    csi_complex_t t = cmul(odd, plan->split[k]);
+    out[k] = cadd(even, t);
+    if (k != m - k)
+    {
+      csi_complex_t even2 = {even.re, -even.im};
+      csi_complex_t odd2 = {odd.re, -odd.im};
+      csi_complex_t t2 = cmul(odd2, plan->split[m - k]);
+      out[m - k] = cadd(even2, t2);
+    }
+  }
+}
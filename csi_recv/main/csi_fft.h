@@ -0,0 +1,58 @@
+#ifndef CSI_FFT_H
+#define CSI_FFT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Factors of n / 2 the plan can hold (2^20 needs 10 radix-4 stages)
+#define CSI_FFT_MAX_STAGES 24
+// Floats of storage a plan for an n point real transform needs: three n/2 complex
+// tables (twiddles, real-split twiddles, work), the generic butterfly scratch and the window
+#define CSI_FFT_STORAGE_FLOATS(n) (2 * (4 * ((n) / 2)) + (n))
+
+typedef struct
+{
+  float re;
+  float im;
+} csi_complex_t;
+
+typedef enum
+{
+  CSI_FFT_WINDOW_NONE,
+  CSI_FFT_WINDOW_HANN, /**< Symmetric Hann, 0.5 * (1 - cos(2 pi i / (n - 1))) */
+} csi_fft_window_t;
+
+/**
+ * @brief Precomputed real-input FFT of one even size n.
+ *
+ * The n real samples are packed into n/2 complex ones, transformed with a
+ * mixed-radix (4, 2, 3, 5, then any other prime) decimation-in-time FFT and
+ * split into the n/2 + 1 non-negative frequency bins, about half the work of a
+ * complex transform of the same data. Every twiddle and window value is computed
+ * once, in double precision, when the plan is built, so no trigonometry runs per
+ * transform and no rounding accumulates across a table.
+ *
+ * All tables live in caller-provided storage of CSI_FFT_STORAGE_FLOATS(n)
+ * floats, so a plan for a fixed size needs no heap: declare the storage static
+ * next to the plan. The work buffer is part of the plan, so one plan serves
+ * one caller at a time.
+ */
+typedef struct
+{
+  int n;                 /**< Real input length */
+  int m;                 /**< Complex transform length, n / 2 */
+  int stages;
+  int factors[2 * CSI_FFT_MAX_STAGES]; /**< (radix, remaining length) pairs */
+  csi_complex_t *twiddles; /**< exp(-j 2 pi i / m), i < m */
+  csi_complex_t *split;    /**< exp(-j 2 pi k / n), k < m, for the real split */
+  csi_complex_t *work;     /**< m packed inputs, then the complex transform */
+  csi_complex_t *scratch;  /**< Generic butterfly, largest radix */
+  float *window;           /**< n coefficients, NULL for CSI_FFT_WINDOW_NONE */
+} csi_fft_plan_t;
+
+bool csi_fft_plan_init(csi_fft_plan_t *plan, int n, csi_fft_window_t window, float *storage, size_t storage_floats);
+void csi_fft_complex(const csi_fft_plan_t *plan, const csi_complex_t *in, csi_complex_t *out);
+void csi_fft_real(const csi_fft_plan_t *plan, const float *in, csi_complex_t *out);
+
+#endif // CSI_FFT_H
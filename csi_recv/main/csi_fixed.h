@@ -0,0 +1,61 @@
+#ifndef CSI_FIXED_H
+#define CSI_FIXED_H
+
+#include <stdint.h>
+
+/**
+ * 1: the motion statistics, the breathing features and the linear breathing
+ * model run in integer arithmetic (Q8/Q15/Q16/Q31 as noted at each use) and
+ * never touch the FPU per packet. 0: the float implementation.
+ *
+ * Set it for the whole component, e.g. target_compile_definitions(${COMPONENT_LIB}
+ * PRIVATE CSI_FIXED_POINT=1), so every file sees the same pipeline.
+ */
+#ifndef CSI_FIXED_POINT
+#define CSI_FIXED_POINT 0
+#endif
+
+#define CSI_Q8_ONE (1 << 8)
+#define CSI_Q15_ONE (1 << 15)
+#define CSI_Q16_ONE (1 << 16)
+
+static inline int32_t csi_sat32(int64_t value)
+{
+  return value > INT32_MAX ? INT32_MAX : value < INT32_MIN ? INT32_MIN : (int32_t)value;
+}
+
+static inline int16_t csi_sat16(int32_t value)
+{
+  return value > INT16_MAX ? INT16_MAX : value < INT16_MIN ? INT16_MIN : (int16_t)value;
+}
+
+// a * b for a in Q(n) and b in Q15, result in Q(n), saturated
+static inline int32_t csi_mul_q15(int32_t a, int32_t b)
+{
+  return csi_sat32(((int64_t)a * b) >> 15);
+}
+
+// floor(sqrt(value)); exact for every 64-bit input
+static inline uint32_t csi_isqrt64(uint64_t value)
+{
+  uint64_t result = 0;
+  uint64_t bit = 1ull << 62;
+  while (bit > value)
+    bit >>= 2;
+  while (bit)
+  {
+    if (value >= result + bit)
+    {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    }
+    else
+    {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint32_t)result;
+}
+
+#endif // CSI_FIXED_H
@@ -0,0 +1,82 @@
+#include <math.h>
+#include <string.h>
+#include "csi_gain.h"
+
+void csi_gain_init(csi_gain_t *gain)
+{
+  memset(gain, 0, sizeof(*gain));
+  atomic_init(&gain->has_ref, false);
+}
+
+/**
+ * @brief Feed one accepted packet's RSSI and the gains the PHY reported for it.
+ */
+csi_gain_action_t csi_gain_update(csi_gain_t *gain, int8_t rssi, uint8_t agc_gain, uint8_t fft_gain)
+{
+  if (!gain->forced)
+  {
+    gain->agc_sum += agc_gain;
+    gain->fft_sum += fft_gain;
+    gain->rssi_sum += rssi;
+    if (++gain->learn_count < CSI_GAIN_LEARN_PACKETS)
+      return CSI_GAIN_NONE;
+
+    gain->agc_force = gain->agc_sum / CSI_GAIN_LEARN_PACKETS;
+    gain->fft_force = gain->fft_sum / CSI_GAIN_LEARN_PACKETS;
+    gain->rssi_learned = gain->rssi_sum / CSI_GAIN_LEARN_PACKETS;
+    gain->rssi_ewma = (int32_t)gain->rssi_learned << CSI_GAIN_RSSI_SHIFT;
+    gain->forced = true;
+    gain->hold = 0;
+    gain->epoch++;
+    gain->stats.forces++;
+    if (!atomic_load_explicit(&gain->has_ref, memory_order_relaxed))
+    {
+      gain->ref_agc = gain->agc_force;
+      gain->ref_fft = gain->fft_force;
+      atomic_store_explicit(&gain->has_ref, true, memory_order_release);
+    }
+    return CSI_GAIN_FORCE;
+  }
+
+  gain->rssi_ewma += (((int32_t)rssi << CSI_GAIN_RSSI_SHIFT) - gain->rssi_ewma) >> CSI_GAIN_RSSI_SHIFT;
+  if (gain->hold < CSI_GAIN_MIN_HOLD_PACKETS)
+  {
+    gain->hold++;
+    return CSI_GAIN_NONE;
+  }
+
+  int32_t drift = gain->rssi_ewma - ((int32_t)gain->rssi_learned << CSI_GAIN_RSSI_SHIFT);
+  if (drift < 0)
+    drift = -drift;
+  if (drift <= (CSI_GAIN_DRIFT_DB << CSI_GAIN_RSSI_SHIFT))
+    return CSI_GAIN_NONE;
+
+  gain->forced = false;
+  gain->learn_count = 0;
+  gain->agc_sum = 0;
+  gain->fft_sum = 0;
+  gain->rssi_sum = 0;
+  gain->stats.releases++;
+  return CSI_GAIN_RELEASE;
+}
+
+/**
+ * @brief Amplitude factor (Q8) that maps a frame captured at @p agc_gain / @p fft_gain
+ *        back to the reference gains. 256 (unity) until a reference exists.
+ */
+uint16_t csi_gain_scale_q8(const csi_gain_t *gain, csi_gain_cache_t *cache, uint8_t agc_gain, uint8_t fft_gain)
+{
+  if (!atomic_load_explicit(&gain->has_ref, memory_order_acquire))
+    return 1 << 8;
+  if (cache->valid && cache->agc == agc_gain && cache->fft == fft_gain)
+    return cache->scale_q8;
+
+  float db = ((int)gain->ref_agc - (int)agc_gain) * CSI_GAIN_AGC_DB_PER_STEP +
+             ((int)gain->ref_fft - (int)fft_gain) * CSI_GAIN_FFT_DB_PER_STEP;
+  float scale = powf(10.0f, db / 20.0f) * (1 << 8);
+  cache->scale_q8 = scale > UINT16_MAX ? UINT16_MAX : scale < 1.0f ? 1 : (uint16_t)(scale + 0.5f);
+  cache->agc = agc_gain;
+  cache->fft = fft_gain;
+  cache->valid = true;
+  return cache->scale_q8;
+}
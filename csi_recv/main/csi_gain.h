@@ -0,0 +1,79 @@
+#ifndef CSI_GAIN_H
+#define CSI_GAIN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Packets averaged with the AGC free-running before the gains are forced
+#define CSI_GAIN_LEARN_PACKETS 100
+// RSSI drift (dB) from the level the gains were learned at that triggers a re-learn
+#define CSI_GAIN_DRIFT_DB 6
+// Minimum packets between two re-learns, so a level sitting on the threshold cannot thrash
+#define CSI_GAIN_MIN_HOLD_PACKETS 1000
+// RSSI smoothing: ewma += (rssi - ewma) >> CSI_GAIN_RSSI_SHIFT
+#define CSI_GAIN_RSSI_SHIFT 6
+// Gain step sizes used for amplitude compensation (Espressif esp-csi convention)
+#define CSI_GAIN_AGC_DB_PER_STEP 1.0f
+#define CSI_GAIN_FFT_DB_PER_STEP 0.25f
+
+typedef enum
+{
+  CSI_GAIN_NONE,    /**< Leave the PHY alone */
+  CSI_GAIN_FORCE,   /**< Force agc_force / fft_force */
+  CSI_GAIN_RELEASE, /**< Hand gain back to the AGC so it can be re-learned */
+} csi_gain_action_t;
+
+typedef struct
+{
+  uint32_t forces;   /**< Times the gains were forced, first learn included */
+  uint32_t releases; /**< Drift-triggered re-learns */
+} csi_gain_stats_t;
+
+/**
+ * @brief Receiver gain manager.
+ *
+ * Learns the AGC/FFT gains over CSI_GAIN_LEARN_PACKETS, forces them, then follows
+ * the smoothed RSSI. When it drifts more than CSI_GAIN_DRIFT_DB from the level the
+ * gains were learned at, the gains are released and learned again. The first
+ * forced pair is the reference that csi_gain_scale_q8() normalises amplitudes to.
+ *
+ * csi_gain_update() runs in the rx callback and only does integer arithmetic; the
+ * caller applies the returned action to the PHY. The PHY holds one forced gain,
+ * so a receiver has one csi_gain_t whatever the number of senders.
+ */
+typedef struct
+{
+  bool forced;
+  uint16_t learn_count;
+  uint32_t agc_sum;
+  uint32_t fft_sum;
+  int32_t rssi_sum;
+  int32_t rssi_ewma;    /**< Smoothed RSSI, dBm << CSI_GAIN_RSSI_SHIFT */
+  int8_t rssi_learned;  /**< Mean RSSI while the current gains were learned */
+  uint32_t hold;        /**< Packets since the last force */
+  uint8_t agc_force;    /**< Gains to apply on CSI_GAIN_FORCE */
+  uint8_t fft_force;
+  uint8_t epoch;        /**< Incremented on every force; recorded with each frame */
+  uint8_t ref_agc;
+  uint8_t ref_fft;
+  _Atomic bool has_ref; /**< ref_agc/ref_fft are valid; read by the processing task */
+  csi_gain_stats_t stats;
+} csi_gain_t;
+
+/**
+ * @brief Last compensation computed, so powf() only runs when the gains change.
+ */
+typedef struct
+{
+  bool valid;
+  uint8_t agc;
+  uint8_t fft;
+  uint16_t scale_q8;
+} csi_gain_cache_t;
+
+void csi_gain_init(csi_gain_t *gain);
+csi_gain_action_t csi_gain_update(csi_gain_t *gain, int8_t rssi, uint8_t agc_gain, uint8_t fft_gain);
+uint16_t csi_gain_scale_q8(const csi_gain_t *gain, csi_gain_cache_t *cache, uint8_t agc_gain, uint8_t fft_gain);
+
+#endif // CSI_GAIN_H
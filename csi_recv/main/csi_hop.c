@@ -0,0 +1,52 @@
+#include "csi_hop.h"
+
+void csi_hop_init(csi_hop_t *hop, int window, int step)
+{
+  hop->window = (uint16_t)window;
+  hop->step = (uint16_t)step;
+  hop->next_end = (uint32_t)window;
+  hop->fired = 0;
+  hop->skipped = 0;
+}
+
+/**
+ * @brief Next due window over the history [@p first, @p end), oldest first.
+ *
+ * Each window is handed out once, in time order. A window that is due but whose
+ * start is no longer held is skipped (counted in `skipped`), so the schedule
+ * stays on its step grid after the history loses samples.
+ *
+ * @param[out] start Stream index of the window's first sample.
+ * @return false when no further window has ended yet.
+ */
+bool csi_hop_next(csi_hop_t *hop, uint32_t first, uint32_t end, uint32_t *start)
+{
+  while ((int32_t)(end - hop->next_end) >= 0)
+  {
+    uint32_t window_start = hop->next_end - hop->window;
+    hop->next_end += hop->step;
+    if ((int32_t)(window_start - first) >= 0)
+    {
+      *start = window_start;
+      hop->fired++;
+      return true;
+    }
+    hop->skipped++;
+  }
+  return false;
+}
+
+/**
+ * @brief Samples the owner may drop from the front of the history [@p first, @p end)
+ *        keeping at least the newest @p keep and every window not handed out yet.
+ *
+ * A trim bounded by this never makes csi_hop_next() skip a window.
+ */
+int csi_hop_droppable(const csi_hop_t *hop, uint32_t first, uint32_t end, int keep)
+{
+  int32_t drop = (int32_t)(end - first) - keep;
+  int32_t unread = (int32_t)(hop->next_end - hop->window - first); // Start of the next window
+  if (unread < drop)
+    drop = unread;
+  return drop > 0 ? (int)drop : 0;
+}
@@ -0,0 +1,29 @@
+#ifndef CSI_HOP_H
+#define CSI_HOP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Hop schedule of overlapping windows over a sample stream.
+ *
+ * Samples are numbered by their position in the stream (32-bit, wrap-around
+ * handled). Windows are `window` samples long and end `step` samples apart; the
+ * first ends at sample `window`. The history the windows are read from is only
+ * described by its first and end stream indices, so it can be shifted, trimmed
+ * and appended to by its owner; the schedule never consumes samples.
+ */
+typedef struct
+{
+  uint16_t window;
+  uint16_t step;
+  uint32_t next_end; /**< Stream index one past the last sample of the next window */
+  uint32_t fired;    /**< Windows handed out */
+  uint32_t skipped;  /**< Due windows whose start had already left the history */
+} csi_hop_t;
+
+void csi_hop_init(csi_hop_t *hop, int window, int step);
+bool csi_hop_next(csi_hop_t *hop, uint32_t first, uint32_t end, uint32_t *start);
+int csi_hop_droppable(const csi_hop_t *hop, uint32_t first, uint32_t end, int keep);
+
+#endif // CSI_HOP_H
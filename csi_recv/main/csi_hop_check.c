@@ -0,0 +1,126 @@
+// Host check: replays csi_q as app_main.c keeps it, with the breathing windows of
+// csi_hop.h read from it and mqtt_send() trimming it, and checks that a window
+// fires exactly once per STEP_SIZE samples whatever the publish interval: none
+// skipped because a trim dropped its start, each one reading the samples it is
+// due, in stream order.
+//
+// csi_q holds each sample's stream index, so a window's content shows where it
+// came from. Per packet, as csi_process(), breathing_rate_estimation() and
+// mqtt_send() do it: shift a full csi_q, append the packet, take the due window,
+// and on a publish trim to CSI_FIFO_LENGTH within csi_hop_droppable().
+//
+// Build: gcc -O2 -o csi_hop_check csi_hop_check.c csi_hop.c
+// Usage: ./csi_hop_check [packets per scenario]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "csi_hop.h"
+#include "breathing_rate_evaluation_svm.h"
+
+#define DEFAULT_PACKETS 200000
+// As in app_main.c
+#define CSI_BUFFER_LENGTH 800
+#define CSI_FIFO_LENGTH 100
+
+typedef struct {
+    const char* name;
+    int samples;      // Samples a packet appends: 1 with CSI_Q_PCA, its CSI bytes without
+    int publish_every; // Packets between two publishes, i.e. send_ms at the packet rate (0: never)
+    bool random;      // Packet sizes 1..samples and publish gaps 1..publish_every instead
+} scenario_t;
+
+static const scenario_t scenarios[] = {
+    {"pca, publish every packet", 1, 1, false},
+    {"pca, send_ms 100", 1, 8, false},
+    {"pca, never published", 1, 0, false},
+    {"128 B, publish every packet", 128, 1, false},
+    {"128 B, send_ms 100", 128, 8, false},
+    {"128 B, send_ms 1000", 128, 80, false},
+    {"128 B, never published", 128, 0, false},
+    {"random sizes and gaps", 128, 20, true},
+};
+#define NUM_SCENARIOS (int)(sizeof(scenarios) / sizeof(scenarios[0]))
+
+static uint32_t lcg_state;
+static int lcg_range(int low, int high) {
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return low + (int)((lcg_state >> 8) % (uint32_t)(high - low + 1));
+}
+
+static int16_t sample_of(uint32_t stream_index) {
+    return (int16_t)(stream_index & 0x7fff);
+}
+
+static bool run(const scenario_t* sc, long packets) {
+    static int16_t csi_q[CSI_BUFFER_LENGTH];
+    int csi_q_index = 0;
+    uint32_t csi_q_end = 0;
+    csi_hop_t hop;
+    csi_hop_init(&hop, WINDOW_SIZE, STEP_SIZE);
+    long errors = 0, trims = 0, estimated = 0;
+    int until_publish = sc->publish_every;
+    lcg_state = 1;
+
+    for (long p = 0; p < packets; p++) {
+        int incoming = sc->random ? lcg_range(1, sc->samples) : sc->samples;
+        // csi_process(): shift a full buffer, then append
+        if (csi_q_index + incoming > CSI_BUFFER_LENGTH) {
+            int shift = csi_q_index < CSI_FIFO_LENGTH ? csi_q_index : CSI_FIFO_LENGTH;
+            memmove(csi_q, csi_q + shift, (csi_q_index - shift) * sizeof(int16_t));
+            csi_q_index -= shift;
+        }
+        for (int i = 0; i < incoming && csi_q_index < CSI_BUFFER_LENGTH; i++) {
+            csi_q[csi_q_index++] = sample_of(csi_q_end++);
+        }
+
+        // breathing_rate_estimation(): the latest due window
+        uint32_t first = csi_q_end - csi_q_index;
+        uint32_t start = 0;
+        bool due = false;
+        while (csi_hop_next(&hop, first, csi_q_end, &start)) due = true;
+        if (due) {
+            estimated++;
+            const int16_t* raw = csi_q + (start - first);
+            if (start % STEP_SIZE != 0 && errors++ < 10) printf("  error: window starts off the step grid at %u\n", start);
+            for (int i = 0; i < WINDOW_SIZE; i++) {
+                if (raw[i] != sample_of(start + i)) {
+                    if (errors++ < 10) printf("  error: window at %u reads the wrong samples\n", start);
+                    break;
+                }
+            }
+        }
+        // Every window that has ended fired once, none skipped
+        uint32_t ended = csi_q_end >= WINDOW_SIZE ? (csi_q_end - WINDOW_SIZE) / STEP_SIZE + 1 : 0;
+        if ((hop.fired != ended || hop.skipped != 0) && errors++ < 10)
+            printf("  error: after %u samples %u windows fired, %u skipped, %u due\n", csi_q_end, hop.fired,
+                   hop.skipped, ended);
+
+        // mqtt_send(): trim on a publish
+        if (sc->publish_every && --until_publish == 0) {
+            until_publish = sc->random ? lcg_range(1, sc->publish_every) : sc->publish_every;
+            int drop = csi_hop_droppable(&hop, first, csi_q_end, CSI_FIFO_LENGTH);
+            if (csi_q_index > CSI_FIFO_LENGTH * 1.5 && drop > 0) {
+                memmove(csi_q, csi_q + drop, (csi_q_index - drop) * sizeof(int16_t));
+                csi_q_index -= drop;
+                trims++;
+            }
+        }
+    }
+    printf("%-28s %10u %10u %9u %10ld %9ld %s\n", sc->name, csi_q_end, hop.fired, hop.skipped, estimated, trims,
+           errors ? "FAIL" : "ok");
+    return errors == 0;
+}
+
+int main(int argc, char** argv) {
+    long packets = argc > 1 ? strtol(argv[1], NULL, 0) : DEFAULT_PACKETS;
+    if (packets <= 0) {
+        printf("Usage: %s [packets per scenario]\n", argv[0]);
+        return 1;
+    }
+    printf("%-28s %10s %10s %9s %10s %9s\n", "scenario", "samples", "fired", "skipped", "estimated", "trims");
+    bool ok = true;
+    for (int s = 0; s < NUM_SCENARIOS; s++) ok &= run(&scenarios[s], packets);
+    printf("\n%s\n", ok ? "Every window fired once per STEP_SIZE" : "Windows lost or misread");
+    return ok ? 0 : 1;
+}
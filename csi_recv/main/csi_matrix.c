@@ -0,0 +1,197 @@
+#include <string.h>
+#include "csi_matrix.h"
+
+#define CSI_MATRIX_MASK (CSI_MATRIX_ROWS - 1)
+#define PI_Q12 12868      // pi * 2^12
+#define HALF_PI_Q12 6434  // pi/2 * 2^12
+#define QUARTER_PI_Q15 25736
+#define ATAN_K_Q15 8946   // 0.273, see atan_q12()
+
+_Static_assert((CSI_MATRIX_ROWS & CSI_MATRIX_MASK) == 0, "CSI_MATRIX_ROWS must be a power of two");
+
+// Packet format and CSI length -> LTF to keep, for the acquisition modes enabled in wifi_csi_init().
+// When several LTFs are present we keep the widest HT-LTF and skip LLTF / STBC copies. A length
+// does not identify the layout by itself: 256 bytes is HT20 LLTF + HT-LTF or a lone HT40 HT-LTF,
+// 384 bytes HT40 LLTF + HT-LTF or HT20 LLTF + HT-LTF + STBC HT-LTF.
+static const struct
+{
+  uint8_t sig_mode; // 0 non-HT, 1 HT
+  uint8_t cwb;      // 0 20 MHz, 1 40 MHz
+  uint8_t stbc;     // 0 or 1
+  uint16_t len;
+  csi_layout_t layout;
+} s_layouts[] = {
+    {0, 0, 0, 128, {0, 64}},    // LLTF
+    {1, 0, 0, 128, {0, 64}},    // HT20 HT-LTF
+    {1, 0, 0, 256, {128, 64}},  // LLTF + HT20 HT-LTF
+    {1, 0, 1, 376, {128, 64}},  // LLTF + HT20 HT-LTF + STBC HT-LTF, secondary channel above
+    {1, 0, 1, 380, {128, 64}},  // The same, secondary channel below
+    {1, 0, 1, 384, {128, 64}},  // The same, no secondary channel
+    {1, 1, 0, 256, {0, 128}},   // HT40 HT-LTF
+    {1, 1, 0, 384, {128, 128}}, // LLTF + HT40 HT-LTF
+    {1, 1, 1, 512, {0, 128}},   // HT40 HT-LTF + STBC HT-LTF
+    {1, 1, 1, 612, {128, 128}}, // LLTF + HT40 HT-LTF + STBC HT-LTF
+};
+
+/**
+ * @brief Where to read the LTF we keep, from the packet format and length in @p meta.
+ *
+ * Returns false for a combination the table does not list, e.g. VHT or a
+ * length that does not match the format; such frames are not decoded.
+ */
+bool csi_layout_decode(const csi_frame_meta_t *meta, csi_layout_t *layout)
+{
+  uint8_t stbc = meta->stbc ? 1 : 0;
+  for (size_t i = 0; i < sizeof(s_layouts) / sizeof(s_layouts[0]); i++)
+  {
+    if (s_layouts[i].sig_mode == meta->sig_mode && s_layouts[i].cwb == meta->cwb && s_layouts[i].stbc == stbc &&
+        s_layouts[i].len == meta->len)
+    {
+      *layout = s_layouts[i].layout;
+      return true;
+    }
+  }
+  return false;
+}
+
+static uint32_t isqrt32(uint32_t value)
+{
+  uint32_t result = 0;
+  uint32_t bit = 1u << 30;
+  while (bit > value)
+    bit >>= 2;
+  while (bit)
+  {
+    if (value >= result + bit)
+    {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    }
+    else
+    {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return result;
+}
+
+// atan(r) for r in [0, 1] (Q15), as r * (pi/4 + 0.273 * (1 - r)); max error ~0.004 rad
+static int32_t atan_q12(uint32_t r_q15)
+{
+  uint32_t k = QUARTER_PI_Q15 + ((ATAN_K_Q15 * (32768 - r_q15)) >> 15);
+  return (int32_t)(((uint64_t)r_q15 * k) >> 18);
+}
+
+static int16_t atan2_q12(int32_t y, int32_t x)
+{
+  int32_t ax = x < 0 ? -x : x;
+  int32_t ay = y < 0 ? -y : y;
+  if (ax == 0 && ay == 0)
+    return 0;
+
+  int32_t angle;
+  if (ay <= ax)
+    angle = atan_q12(((uint32_t)ay << 15) / ax);
+  else
+    angle = HALF_PI_Q12 - atan_q12(((uint32_t)ax << 15) / ay);
+
+  if (x < 0)
+    angle = PI_Q12 - angle;
+  return (int16_t)(y < 0 ? -angle : angle);
+}
+
+void csi_matrix_init(csi_matrix_t *matrix)
+{
+  memset(matrix, 0, sizeof(*matrix));
+}
+
+/**
+ * @brief Decode one frame into a new row of amplitude and phase.
+ *
+ * Returns false for layouts we do not know. A frame whose subcarrier count
+ * differs from the rows already held (e.g. HT20 after HT40) restarts the history.
+ */
+bool csi_matrix_push(csi_matrix_t *matrix, const csi_frame_t *frame)
+{
+  csi_layout_t layout;
+  if (!csi_layout_decode(&frame->meta, &layout))
+    return false;
+
+  if (layout.subcarriers != matrix->subcarriers)
+  {
+    if (matrix->rows_written > 0)
+      matrix->layout_resets++;
+    matrix->subcarriers = layout.subcarriers;
+    matrix->rows_written = 0;
+  }
+
+  int n = layout.subcarriers;
+  int row = matrix->rows_written & CSI_MATRIX_MASK;
+  const int8_t *ltf = frame->buf + layout.offset;
+  // The first four bytes of the buffer are garbage when first_word_invalid is set
+  int invalid_bytes = frame->meta.first_word_invalid ? 4 - layout.offset : 0;
+
+  for (int col = 0; col < n; col++)
+  {
+    int pos = (col + n / 2) & (n - 1); // column -N/2.. -> FFT order
+    int16_t amp = 0, phase = 0;
+    if (2 * pos >= invalid_bytes)
+    {
+      int32_t im = ltf[2 * pos];
+      int32_t re = ltf[2 * pos + 1];
+      amp = (int16_t)isqrt32((uint32_t)(re * re + im * im) << (2 * CSI_AMP_FRAC_BITS));
+      phase = atan2_q12(im, re);
+    }
+    matrix->amp[col][row] = amp;
+    matrix->amp[col][row + CSI_MATRIX_ROWS] = amp;
+    matrix->phase[col][row] = phase;
+    matrix->phase[col][row + CSI_MATRIX_ROWS] = phase;
+  }
+  matrix->timestamp[row] = frame->meta.timestamp;
+  matrix->timestamp[row + CSI_MATRIX_ROWS] = frame->meta.timestamp;
+  matrix->rows_written++;
+  return true;
+}
+
+static int series_start(const csi_matrix_t *matrix, int n)
+{
+  // Newest row lives at both r and r + ROWS; the n rows ending at r + ROWS are contiguous
+  int newest = (matrix->rows_written - 1) & CSI_MATRIX_MASK;
+  return newest + CSI_MATRIX_ROWS - n + 1;
+}
+
+const int16_t *csi_matrix_amp_series(const csi_matrix_t *matrix, int subcarrier, int n)
+{
+  return &matrix->amp[subcarrier][series_start(matrix, n)];
+}
+
+const int16_t *csi_matrix_phase_series(const csi_matrix_t *matrix, int subcarrier, int n)
+{
+  return &matrix->phase[subcarrier][series_start(matrix, n)];
+}
+
+const uint32_t *csi_matrix_timestamps(const csi_matrix_t *matrix, int n)
+{
+  return &matrix->timestamp[series_start(matrix, n)];
+}
+
+float csi_matrix_mean_amp(const csi_matrix_t *matrix)
+{
+  if (matrix->rows_written == 0)
+    return 0.0f;
+  int newest = (matrix->rows_written - 1) & CSI_MATRIX_MASK;
+  int32_t sum = 0;
+  int active = 0;
+  for (int col = 0; col < matrix->subcarriers; col++)
+  {
+    // Guard and DC subcarriers (and first_word_invalid ones) are zero
+    int16_t amp = matrix->amp[col][newest];
+    if (amp != 0)
+    {
+      sum += amp;
+      active++;
+    }
+  }
+  return active ? (float)sum / (active << CSI_AMP_FRAC_BITS) : 0.0f;
+}
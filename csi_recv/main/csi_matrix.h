@@ -0,0 +1,65 @@
+#ifndef CSI_MATRIX_H
+#define CSI_MATRIX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "csi_pool.h"
+
+// Widest layout we decode: HT40 HT-LTF, 128 subcarriers
+#define CSI_MATRIX_MAX_SUBCARRIERS 128
+// Packets of history kept per subcarrier, per session. Must be a power of two.
+#define CSI_MATRIX_ROWS 16
+// Amplitude is stored as |H| * 2^CSI_AMP_FRAC_BITS, phase as radians * 2^CSI_PHASE_FRAC_BITS
+#define CSI_AMP_FRAC_BITS 6
+#define CSI_PHASE_FRAC_BITS 12
+
+/**
+ * @brief Where the channel estimate we keep sits inside a CSI buffer.
+ *
+ * Every subcarrier is two signed bytes, imaginary part first. Within one
+ * LTF the subcarriers are stored in FFT order (0..N/2-1, then -N/2..-1).
+ * Which LTFs a buffer holds follows from the packet's signal mode, bandwidth
+ * and STBC together with its length; the length alone is ambiguous.
+ */
+typedef struct
+{
+  uint16_t offset;      /**< Byte offset of the LTF we use */
+  uint16_t subcarriers; /**< Subcarriers in that LTF */
+} csi_layout_t;
+
+bool csi_layout_decode(const csi_frame_meta_t *meta, csi_layout_t *layout);
+
+/**
+ * @brief Time x subcarrier CSI history, stored as structure-of-arrays.
+ *
+ * Rows are packets and columns are subcarriers (-N/2..N/2-1), but storage is
+ * column-major so each subcarrier's time series is contiguous. Every row is
+ * written twice, CSI_MATRIX_ROWS apart, so the last n samples of a subcarrier
+ * are always one contiguous span regardless of where the ring has wrapped.
+ */
+typedef struct
+{
+  int16_t amp[CSI_MATRIX_MAX_SUBCARRIERS][2 * CSI_MATRIX_ROWS];
+  int16_t phase[CSI_MATRIX_MAX_SUBCARRIERS][2 * CSI_MATRIX_ROWS];
+  uint32_t timestamp[2 * CSI_MATRIX_ROWS];
+  uint16_t subcarriers;  /**< Columns in use, fixed by the first packet's layout */
+  uint32_t rows_written; /**< Packets pushed since the last reset */
+  uint32_t layout_resets;
+} csi_matrix_t;
+
+void csi_matrix_init(csi_matrix_t *matrix);
+bool csi_matrix_push(csi_matrix_t *matrix, const csi_frame_t *frame);
+
+static inline int csi_matrix_rows(const csi_matrix_t *matrix)
+{
+  return matrix->rows_written < CSI_MATRIX_ROWS ? (int)matrix->rows_written : CSI_MATRIX_ROWS;
+}
+
+// Last n (<= csi_matrix_rows()) samples of one subcarrier, oldest first
+const int16_t *csi_matrix_amp_series(const csi_matrix_t *matrix, int subcarrier, int n);
+const int16_t *csi_matrix_phase_series(const csi_matrix_t *matrix, int subcarrier, int n);
+const uint32_t *csi_matrix_timestamps(const csi_matrix_t *matrix, int n);
+// Mean amplitude of the newest row over the subcarriers that carry energy, in |H| units
+float csi_matrix_mean_amp(const csi_matrix_t *matrix);
+
+#endif // CSI_MATRIX_H
@@ -0,0 +1,364 @@
+#include <string.h>
+#include "csi_model.h"
+#include "csi_serial.h"
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#else
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/**
+ * @brief CRC-32 of a blob with its crc32 field left out.
+ */
+uint32_t csi_model_crc(const void *blob, size_t total_size)
+{
+  const uint8_t *bytes = blob;
+  const size_t field = offsetof(csi_model_header_t, crc32);
+  uint32_t crc = csi_serial_crc32(0, bytes, field);
+  return csi_serial_crc32(crc, bytes + field + sizeof(uint32_t), total_size - field - sizeof(uint32_t));
+}
+
+static size_t dtype_size(uint32_t dtype)
+{
+  switch (dtype)
+  {
+  case CSI_MODEL_F32:
+    return sizeof(float);
+  case CSI_MODEL_U8:
+  case CSI_MODEL_I8:
+    return 1;
+  case CSI_MODEL_I32:
+    return sizeof(int32_t);
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief Find a tensor by name, type and element count (0 for any).
+ *
+ * @return Its data inside the blob, or NULL.
+ */
+const void *csi_model_tensor(const csi_model_t *model, const char *name, csi_model_dtype_t dtype, uint32_t count)
+{
+  for (uint32_t i = 0; i < model->header->tensor_count; i++)
+  {
+    const csi_model_tensor_t *tensor = &model->tensors[i];
+    if (strncmp(tensor->name, name, CSI_MODEL_NAME_LEN) == 0 && tensor->dtype == (uint32_t)dtype &&
+        (count == 0 || tensor->count == count))
+      return model->base + tensor->offset;
+  }
+  return NULL;
+}
+
+// The tensors each type must carry; their sizes are checked by whoever uses them
+static const char *check_type(const csi_model_t *model)
+{
+  switch (model->header->type)
+  {
+  case CSI_MODEL_LINEAR:
+    if (!csi_model_tensor(model, "weights", CSI_MODEL_F32, 0) || !csi_model_tensor(model, "means", CSI_MODEL_F32, 0) ||
+        !csi_model_tensor(model, "scales", CSI_MODEL_F32, 0) || !csi_model_tensor(model, "bias", CSI_MODEL_F32, 1))
+      return "linear model needs weights, means, scales and bias";
+    return NULL;
+  case CSI_MODEL_TFLITE:
+    if (!csi_model_tensor(model, "tflite", CSI_MODEL_U8, 0))
+      return "TFLite model needs a tflite tensor";
+    return NULL;
+  case CSI_MODEL_CNN:
+    if (!csi_model_tensor(model, "config", CSI_MODEL_I32, 0) || !csi_model_tensor(model, "weights", CSI_MODEL_I8, 0) ||
+        !csi_model_tensor(model, "biases", CSI_MODEL_I32, 0) || !csi_model_tensor(model, "weight_scales", CSI_MODEL_F32, 0) ||
+        !csi_model_tensor(model, "act_scales", CSI_MODEL_F32, 0) || !csi_model_tensor(model, "act_zeros", CSI_MODEL_I32, 0) ||
+        !csi_model_tensor(model, "head", CSI_MODEL_F32, 0))
+      return "CNN model needs config, weights, biases, weight_scales, act_scales, act_zeros and head";
+    return NULL;
+  default:
+    return "unknown model type";
+  }
+}
+
+/**
+ * @brief Check a blob and index it in place.
+ *
+ * The checksum is verified before anything else in the blob is trusted, then
+ * every tensor must lie inside it, aligned, and the type's tensors must exist.
+ *
+ * @param blob Start of the blob, CSI_MODEL_ALIGN aligned.
+ * @param size Bytes readable at @p blob; the blob may be shorter.
+ * @param[out] reason Set to a description of the first problem, if any.
+ * @return false if the blob must not be used.
+ */
+bool csi_model_parse(const void *blob, size_t size, csi_model_t *model, const char **reason)
+{
+  const csi_model_header_t *header = blob;
+  const char *error = NULL;
+  if ((uintptr_t)blob % CSI_MODEL_ALIGN != 0)
+    error = "blob is not aligned";
+  else if (size < sizeof(*header))
+    error = "shorter than a header";
+  else if (header->magic != CSI_MODEL_MAGIC)
+    error = "not a model blob";
+  else if (header->format_version != CSI_MODEL_FORMAT_VERSION)
+    error = "unsupported format version";
+  else if (header->total_size > size || header->total_size < sizeof(*header))
+    error = "size does not match the blob";
+  else if (header->tensor_count == 0 || header->tensor_count > CSI_MODEL_MAX_TENSORS ||
+           sizeof(*header) + header->tensor_count * sizeof(csi_model_tensor_t) > header->total_size)
+    error = "bad tensor directory";
+  else if (csi_model_crc(blob, header->total_size) != header->crc32)
+    error = "checksum mismatch";
+
+  model->base = blob;
+  model->header = header;
+  model->tensors = (const csi_model_tensor_t *)(header + 1);
+  // Data starts after the directory
+  size_t data_start = error ? 0 : sizeof(*header) + header->tensor_count * sizeof(csi_model_tensor_t);
+  for (uint32_t i = 0; error == NULL && i < header->tensor_count; i++)
+  {
+    const csi_model_tensor_t *tensor = &model->tensors[i];
+    size_t element = dtype_size(tensor->dtype);
+    uint64_t end = tensor->offset + (uint64_t)tensor->count * element;
+    if (memchr(tensor->name, '\0', CSI_MODEL_NAME_LEN) == NULL || element == 0)
+      error = "bad tensor entry";
+    else if (tensor->offset % CSI_MODEL_ALIGN != 0 || tensor->offset < data_start || end > header->total_size)
+      error = "tensor outside the blob";
+  }
+  if (error == NULL)
+    error = check_type(model);
+
+  if (reason)
+    *reason = error;
+  return error == NULL;
+}
+
+#ifdef ESP_PLATFORM
+/**
+ * @brief Find the partition and map whichever of its slots hold a valid blob of @p type.
+ *
+ * @return ESP_ERR_NOT_FOUND without the partition, ESP_ERR_INVALID_SIZE if its
+ *         slots cannot start on MMU pages. An empty partition is not an error.
+ */
+esp_err_t csi_model_store_open(csi_model_store_t *store, const char *label, csi_model_type_t type)
+{
+  memset(store, 0, sizeof(*store));
+  store->writing = -1;
+  store->type = (uint8_t)type;
+  store->partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+  if (store->partition == NULL)
+    return ESP_ERR_NOT_FOUND;
+  store->slot_size = store->partition->size / CSI_MODEL_SLOTS;
+  if (store->partition->address % CONFIG_MMU_PAGE_SIZE != 0 || store->slot_size % CONFIG_MMU_PAGE_SIZE != 0)
+    return ESP_ERR_INVALID_SIZE;
+
+  for (int slot = 0; slot < CSI_MODEL_SLOTS; slot++)
+  {
+    csi_model_header_t header;
+    if (esp_partition_read(store->partition, slot * store->slot_size, &header, sizeof(header)) != ESP_OK ||
+        header.magic != CSI_MODEL_MAGIC || header.total_size > store->slot_size)
+      continue;
+    store->writing = slot;
+    store->expected = header.total_size;
+    csi_model_store_finish(store, NULL);
+  }
+  return ESP_OK;
+}
+
+/**
+ * @brief The valid slot with the highest sequence, -1 if neither holds a blob.
+ */
+int csi_model_store_newest(const csi_model_store_t *store)
+{
+  int newest = -1;
+  for (int slot = 0; slot < CSI_MODEL_SLOTS; slot++)
+  {
+    if (store->valid[slot] &&
+        (newest < 0 || store->models[slot].header->sequence > store->models[newest].header->sequence))
+      newest = slot;
+  }
+  return newest;
+}
+
+/**
+ * @brief Unmap and erase @p slot for a blob of @p total_size bytes. The caller must not be using it.
+ */
+esp_err_t csi_model_store_begin(csi_model_store_t *store, int slot, uint32_t total_size)
+{
+  if (store->partition == NULL || slot < 0 || slot >= CSI_MODEL_SLOTS)
+    return ESP_ERR_INVALID_STATE;
+  if (total_size < sizeof(csi_model_header_t) || total_size > store->slot_size)
+    return ESP_ERR_INVALID_SIZE;
+  if (store->mapped[slot])
+    esp_partition_munmap(store->handles[slot]);
+  store->mapped[slot] = false;
+  store->valid[slot] = false;
+  store->writing = -1;
+
+  uint32_t sector = store->partition->erase_size;
+  uint32_t erase = (total_size + sector - 1) / sector * sector;
+  esp_err_t err = esp_partition_erase_range(store->partition, slot * store->slot_size, erase);
+  if (err != ESP_OK)
+    return err;
+  store->writing = slot;
+  store->expected = total_size;
+  return ESP_OK;
+}
+
+/**
+ * @brief Write part of the blob announced to csi_model_store_begin().
+ */
+esp_err_t csi_model_store_write(csi_model_store_t *store, uint32_t offset, const void *data, size_t len)
+{
+  if (store->writing < 0)
+    return ESP_ERR_INVALID_STATE;
+  if (offset > store->expected || len > store->expected - offset)
+    return ESP_ERR_INVALID_SIZE;
+  return esp_partition_write(store->partition, store->writing * store->slot_size + offset, data, len);
+}
+
+/**
+ * @brief Map the slot just written and check its blob; it becomes usable only if that passes.
+ *
+ * @param[out] reason Why the blob was rejected, if it was.
+ */
+esp_err_t csi_model_store_finish(csi_model_store_t *store, const char **reason)
+{
+  int slot = store->writing;
+  if (slot < 0)
+    return ESP_ERR_INVALID_STATE;
+  store->writing = -1;
+
+  const void *blob;
+  esp_err_t err = esp_partition_mmap(store->partition, slot * store->slot_size, store->expected,
+                                     ESP_PARTITION_MMAP_DATA, &blob, &store->handles[slot]);
+  if (err != ESP_OK)
+  {
+    if (reason)
+      *reason = "cannot map the slot";
+    return err;
+  }
+  store->mapped[slot] = true;
+
+  const char *error = NULL;
+  if (!csi_model_parse(blob, store->expected, &store->models[slot], &error))
+    err = ESP_ERR_INVALID_CRC;
+  else if (store->models[slot].header->type != store->type)
+  {
+    err = ESP_ERR_INVALID_ARG;
+    error = "wrong model type for this partition";
+  }
+  if (err != ESP_OK)
+  {
+    esp_partition_munmap(store->handles[slot]);
+    store->mapped[slot] = false;
+  }
+  store->valid[slot] = err == ESP_OK;
+  if (reason)
+    *reason = error;
+  return err;
+}
+#else
+/**
+ * @brief Map a blob file read-only and check it. The mapping lives until the process exits.
+ */
+bool csi_model_map_file(const char *path, csi_model_t *model, const char **reason)
+{
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+  {
+    *reason = "cannot open the file";
+    return false;
+  }
+  struct stat st;
+  void *blob = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && st.st_size > 0)
+    blob = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (blob == MAP_FAILED)
+  {
+    *reason = "cannot map the file";
+    return false;
+  }
+  if (!csi_model_parse(blob, (size_t)st.st_size, model, reason))
+  {
+    munmap(blob, (size_t)st.st_size);
+    return false;
+  }
+  return true;
+}
+
+static size_t align_up(size_t value)
+{
+  return (value + CSI_MODEL_ALIGN - 1) / CSI_MODEL_ALIGN * CSI_MODEL_ALIGN;
+}
+
+/**
+ * @brief Lay the tensors out after the header and directory, each CSI_MODEL_ALIGN aligned, and seal the blob.
+ *
+ * The result is checked with csi_model_parse(), so a blob the firmware would
+ * reject is never returned.
+ *
+ * @param[out] size Bytes of the blob.
+ * @param[out] reason Why there is no blob, if there is none.
+ * @return The blob, to free(), or NULL.
+ */
+void *csi_model_build(csi_model_type_t type, uint32_t sequence, const csi_model_source_t *tensors, int count,
+                      size_t *size, const char **reason)
+{
+  size_t offsets[CSI_MODEL_MAX_TENSORS];
+  if (count < 1 || count > CSI_MODEL_MAX_TENSORS)
+  {
+    *reason = "bad tensor count";
+    return NULL;
+  }
+  size_t total = align_up(sizeof(csi_model_header_t) + count * sizeof(csi_model_tensor_t));
+  for (int i = 0; i < count; i++)
+  {
+    offsets[i] = total;
+    total = align_up(total + tensors[i].count * dtype_size(tensors[i].dtype));
+  }
+  uint8_t *blob = aligned_alloc(CSI_MODEL_ALIGN, total);
+  if (!blob)
+  {
+    *reason = "out of memory";
+    return NULL;
+  }
+  memset(blob, 0, total);
+
+  csi_model_header_t *header = (csi_model_header_t *)blob;
+  header->magic = CSI_MODEL_MAGIC;
+  header->format_version = CSI_MODEL_FORMAT_VERSION;
+  header->type = (uint16_t)type;
+  header->sequence = sequence;
+  header->total_size = (uint32_t)total;
+  header->tensor_count = (uint32_t)count;
+  csi_model_tensor_t *directory = (csi_model_tensor_t *)(header + 1);
+  for (int i = 0; i < count; i++)
+  {
+    memcpy(directory[i].name, tensors[i].name, CSI_MODEL_NAME_LEN);
+    directory[i].dtype = tensors[i].dtype;
+    directory[i].count = tensors[i].count;
+    directory[i].offset = (uint32_t)offsets[i];
+    memcpy(blob + offsets[i], tensors[i].data, tensors[i].count * dtype_size(tensors[i].dtype));
+  }
+  header->crc32 = csi_model_crc(blob, total);
+
+  csi_model_t model;
+  if (!csi_model_parse(blob, total, &model, reason))
+  {
+    free(blob);
+    return NULL;
+  }
+  *size = total;
+  return blob;
+}
+
+const char *csi_model_dtype_name(uint32_t dtype)
+{
+  static const char *const names[] = {"?", "f32", "u8", "i8", "i32"};
+  return dtype < sizeof(names) / sizeof(names[0]) ? names[dtype] : "?";
+}
+#endif
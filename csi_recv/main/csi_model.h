@@ -0,0 +1,137 @@
+#ifndef CSI_MODEL_H
+#define CSI_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#ifdef ESP_PLATFORM
+#include "esp_err.h"
+#include "esp_partition.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// "CMDL", little-endian
+#define CSI_MODEL_MAGIC 0x4c444d43u
+// Bump when the container layout changes; blobs of another version are rejected
+#define CSI_MODEL_FORMAT_VERSION 1
+// Tensor data offsets are multiples of this, relative to the start of the blob
+#define CSI_MODEL_ALIGN 16
+#define CSI_MODEL_MAX_TENSORS 8
+#define CSI_MODEL_NAME_LEN 16
+
+typedef enum
+{
+  CSI_MODEL_LINEAR = 1, /**< Standardised linear regression: weights, means, scales, bias (float32) */
+  CSI_MODEL_TFLITE = 2, /**< One "tflite" tensor holding a TFLite flatbuffer */
+  CSI_MODEL_CNN = 3,    /**< Streaming int8 1-D CNN, tensors as csi_cnn.h lists them */
+} csi_model_type_t;
+
+typedef enum
+{
+  CSI_MODEL_F32 = 1,
+  CSI_MODEL_U8 = 2,
+  CSI_MODEL_I8 = 3,
+  CSI_MODEL_I32 = 4,
+} csi_model_dtype_t;
+
+/**
+ * @brief Blob header, followed by tensor_count directory entries and the aligned tensor data.
+ *
+ * All fields little-endian. crc32 is the standard CRC-32 of the whole blob up to
+ * total_size with the crc32 field itself left out, so a blob is checked before a
+ * single value of it is used.
+ */
+typedef struct
+{
+  uint32_t magic;
+  uint16_t format_version;
+  uint16_t type;          /**< csi_model_type_t */
+  uint32_t sequence;      /**< Model revision; higher replaces lower */
+  uint32_t total_size;    /**< Header, directory and data, bytes */
+  uint32_t tensor_count;
+  uint32_t crc32;
+} csi_model_header_t;
+
+typedef struct
+{
+  char name[CSI_MODEL_NAME_LEN]; /**< NUL-padded */
+  uint32_t dtype;                /**< csi_model_dtype_t */
+  uint32_t count;                /**< Elements */
+  uint32_t offset;               /**< From the start of the blob, a multiple of CSI_MODEL_ALIGN */
+  uint32_t reserved;
+} csi_model_tensor_t;
+
+#ifndef __cplusplus
+_Static_assert(sizeof(csi_model_header_t) == 24, "csi_model_header_t is a wire format");
+_Static_assert(sizeof(csi_model_tensor_t) == 32, "csi_model_tensor_t is a wire format");
+#endif
+
+/**
+ * @brief A validated blob, read in place: nothing is copied out of it.
+ */
+typedef struct
+{
+  const uint8_t *base;
+  const csi_model_header_t *header;
+  const csi_model_tensor_t *tensors;
+} csi_model_t;
+
+bool csi_model_parse(const void *blob, size_t size, csi_model_t *model, const char **reason);
+const void *csi_model_tensor(const csi_model_t *model, const char *name, csi_model_dtype_t dtype, uint32_t count);
+uint32_t csi_model_crc(const void *blob, size_t total_size);
+
+#ifdef ESP_PLATFORM
+// Blob slots per model partition; a new blob goes into the slot not in use
+#define CSI_MODEL_SLOTS 2
+
+/**
+ * @brief A/B blob slots in one data partition, read through the flash MMU.
+ *
+ * Each slot is half the partition and starts on an MMU page, so a blob is used
+ * straight from flash. A slot holding a valid blob stays mapped; a slot being
+ * rewritten is unmapped first, and the slot in use is never rewritten.
+ */
+typedef struct
+{
+  const esp_partition_t *partition;
+  uint32_t slot_size;
+  uint8_t type; /**< csi_model_type_t the slots must hold */
+  esp_partition_mmap_handle_t handles[CSI_MODEL_SLOTS];
+  bool mapped[CSI_MODEL_SLOTS];
+  csi_model_t models[CSI_MODEL_SLOTS];
+  bool valid[CSI_MODEL_SLOTS];
+  int writing;        /**< Slot csi_model_store_write() fills, -1 if none */
+  uint32_t expected;  /**< Size announced to csi_model_store_begin() */
+} csi_model_store_t;
+
+esp_err_t csi_model_store_open(csi_model_store_t *store, const char *label, csi_model_type_t type);
+int csi_model_store_newest(const csi_model_store_t *store);
+esp_err_t csi_model_store_begin(csi_model_store_t *store, int slot, uint32_t total_size);
+esp_err_t csi_model_store_write(csi_model_store_t *store, uint32_t offset, const void *data, size_t len);
+esp_err_t csi_model_store_finish(csi_model_store_t *store, const char **reason);
+#else
+/**
+ * @brief One tensor for csi_model_build().
+ */
+typedef struct
+{
+  char name[CSI_MODEL_NAME_LEN];
+  uint32_t dtype; /**< csi_model_dtype_t */
+  uint32_t count;
+  const void *data;
+} csi_model_source_t;
+
+bool csi_model_map_file(const char *path, csi_model_t *model, const char **reason);
+void *csi_model_build(csi_model_type_t type, uint32_t sequence, const csi_model_source_t *tensors, int count,
+                      size_t *size, const char **reason);
+const char *csi_model_dtype_name(uint32_t dtype);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSI_MODEL_H
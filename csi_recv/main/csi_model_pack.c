@@ -0,0 +1,189 @@
+// Host tool: pack a breathing model into the versioned blob the firmware loads from
+// its model partitions (csi_model.h), or check an existing blob.
+//
+// Build: gcc -O2 -o csi_model_pack csi_model_pack.c csi_model.c csi_serial.c
+// Usage: ./csi_model_pack linear <model.txt> <sequence> <out.bin>
+//        ./csi_model_pack tflite <model.tflite> <sequence> <out.bin> [scaler.txt]
+//        ./csi_model_pack check <blob.bin>
+//
+// model.txt holds one line per tensor, "name value value ...": weights, means and
+// scales with one value per SVM feature, and bias with one (see
+// breathing_rate_svm_model.txt). '#' starts a comment. For a TFLite model, the
+// means and scales lines of scaler.txt give the standardisation the network was
+// trained behind; the firmware uses the built-in ones without them.
+//
+// Flash a blob into slot 0 of its partition, svm_model for a linear model and
+// nn_model for a TFLite one, for example:
+//   parttool.py write_partition --partition-name svm_model --input out.bin
+// The firmware loads the newest valid slot of each at boot. A TFLite model may only
+// use operators the firmware registers: nn_op_resolver_gen.py --check tells. A linear model can
+// also be sent to the running firmware on the rx/model topic, which writes the
+// spare slot and switches to it between breathing windows:
+//   mosquitto_pub -h <broker> -t rx/model -f out.bin
+// The sequence must exceed the one of the model in use.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "csi_model.h"
+
+#define MAX_VALUES 64
+
+static void* read_file(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    void* data = length > 0 ? malloc((size_t)length) : NULL;
+    if (data && fread(data, 1, (size_t)length, file) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    if (!data) fprintf(stderr, "Cannot read %s\n", path);
+    *size = data ? (size_t)length : 0;
+    return data;
+}
+
+// Build the blob (csi_model_build() checks it as the firmware will) and write it
+static int write_blob(const char* path, csi_model_type_t type, uint32_t sequence, const csi_model_source_t* tensors, int count) {
+    size_t size;
+    const char* reason;
+    void* blob = csi_model_build(type, sequence, tensors, count, &size, &reason);
+    if (!blob) {
+        fprintf(stderr, "Cannot pack the blob: %s\n", reason);
+        return -1;
+    }
+    FILE* file = fopen(path, "wb");
+    int ok = file && fwrite(blob, 1, size, file) == size;
+    if (file) fclose(file);
+    free(blob);
+    if (!ok) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return -1;
+    }
+    printf("%s: %s model, sequence %u, %zu bytes, %d tensors\n", path,
+           type == CSI_MODEL_LINEAR ? "linear" : "TFLite", sequence, size, count);
+    return 0;
+}
+
+// Read "name value value ..." lines for the tensors in names; other names are an error if strict
+static int read_text_tensors(const char* text_path, const char** names, int n, bool strict, csi_model_source_t* tensors,
+                             float (*values)[MAX_VALUES]) {
+    FILE* file = fopen(text_path, "r");
+    if (!file) {
+        fprintf(stderr, "Cannot open %s\n", text_path);
+        return -1;
+    }
+    char line[1024];
+    while (fgets(line, sizeof(line), file)) {
+        char* comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+        char* token = strtok(line, " \t\r\n,");
+        if (!token) continue;
+        int t = 0;
+        while (t < n && strcmp(token, names[t]) != 0) t++;
+        if (t == n) {
+            if (!strict) continue;
+            fprintf(stderr, "Unknown tensor '%s' in %s\n", token, text_path);
+            fclose(file);
+            return -1;
+        }
+        uint32_t count = 0;
+        while ((token = strtok(NULL, " \t\r\n,")) && count < MAX_VALUES) values[t][count++] = strtof(token, NULL);
+        strncpy(tensors[t].name, names[t], CSI_MODEL_NAME_LEN - 1);
+        tensors[t].dtype = CSI_MODEL_F32;
+        tensors[t].count = count;
+        tensors[t].data = values[t];
+    }
+    fclose(file);
+    for (int t = 0; t < n; t++) {
+        if (tensors[t].count == 0) {
+            fprintf(stderr, "%s has no %s line\n", text_path, names[t]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int pack_linear(const char* text_path, uint32_t sequence, const char* out_path) {
+    static const char* names[] = {"weights", "means", "scales", "bias"};
+    static float values[4][MAX_VALUES];
+    csi_model_source_t tensors[4] = {0};
+    if (read_text_tensors(text_path, names, 4, true, tensors, values) != 0) return -1;
+    if (tensors[0].count != tensors[1].count || tensors[0].count != tensors[2].count || tensors[3].count != 1) {
+        fprintf(stderr, "weights, means and scales need one value per feature, bias one value\n");
+        return -1;
+    }
+    return write_blob(out_path, CSI_MODEL_LINEAR, sequence, tensors, 4);
+}
+
+// With a scaler, the blob also carries the means and scales the network was trained behind
+static int pack_tflite(const char* tflite_path, uint32_t sequence, const char* out_path, const char* scaler_path) {
+    static const char* names[] = {"means", "scales"};
+    static float values[2][MAX_VALUES];
+    csi_model_source_t tensors[3] = {{"tflite", CSI_MODEL_U8, 0, NULL}};
+    if (scaler_path) {
+        if (read_text_tensors(scaler_path, names, 2, false, tensors + 1, values) != 0) return -1;
+        if (tensors[1].count != tensors[2].count) {
+            fprintf(stderr, "means and scales need one value per feature\n");
+            return -1;
+        }
+    }
+    size_t size;
+    void* data = read_file(tflite_path, &size);
+    if (!data) return -1;
+    tensors[0].count = (uint32_t)size;
+    tensors[0].data = data;
+    int result = write_blob(out_path, CSI_MODEL_TFLITE, sequence, tensors, scaler_path ? 3 : 1);
+    free(data);
+    return result;
+}
+
+static int check(const char* path) {
+    csi_model_t model;
+    const char* reason;
+    if (!csi_model_map_file(path, &model, &reason)) {
+        fprintf(stderr, "%s: rejected, %s\n", path, reason);
+        return -1;
+    }
+    printf("%s: type %u, sequence %u, %u bytes, crc32 %08x\n", path, model.header->type, model.header->sequence,
+           model.header->total_size, model.header->crc32);
+    for (uint32_t i = 0; i < model.header->tensor_count; i++) {
+        const csi_model_tensor_t* tensor = &model.tensors[i];
+        printf("  %-16.16s %s[%u] at %u\n", tensor->name, csi_model_dtype_name(tensor->dtype), tensor->count,
+               tensor->offset);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 3 && strcmp(argv[1], "check") == 0) return check(argv[2]) == 0 ? 0 : 1;
+    if (argc != 5 && !(argc == 6 && strcmp(argv[1], "tflite") == 0)) {
+        fprintf(stderr,
+                "Usage: %s linear <model.txt> <sequence> <out.bin>\n"
+                "       %s tflite <model.tflite> <sequence> <out.bin> [scaler.txt]\n"
+                "       %s check <blob.bin>\n",
+                argv[0], argv[0], argv[0]);
+        return 2;
+    }
+    uint32_t sequence = (uint32_t)strtoul(argv[3], NULL, 0);
+    if (sequence == 0) {
+        fprintf(stderr, "Sequence 0 is the built-in model; use 1 or more\n");
+        return 2;
+    }
+    int result;
+    if (strcmp(argv[1], "linear") == 0) {
+        result = pack_linear(argv[2], sequence, argv[4]);
+    } else if (strcmp(argv[1], "tflite") == 0) {
+        result = pack_tflite(argv[2], sequence, argv[4], argc == 6 ? argv[5] : NULL);
+    } else {
+        fprintf(stderr, "Unknown model type %s\n", argv[1]);
+        return 2;
+    }
+    return result == 0 ? 0 : 1;
+}
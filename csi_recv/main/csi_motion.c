@@ -0,0 +1,232 @@
+#include <math.h>
+#include <string.h>
+#include "csi_motion.h"
+
+#define CSI_MOTION_MASK (CSI_MOTION_RING - 1)
+
+_Static_assert((CSI_MOTION_RING & CSI_MOTION_MASK) == 0, "CSI_MOTION_RING must be a power of two");
+
+#if CSI_FIXED_POINT
+static inline int16_t ema(const csi_motion_t *motion, int16_t x, int16_t prev)
+{
+  return (int16_t)((motion->alpha_num * x + (motion->alpha_den - motion->alpha_num) * prev) / motion->alpha_den);
+}
+#else
+// Same expression (and float rounding) as the batch smoother in motion_detection()
+static inline int16_t ema(const csi_motion_t *motion, int16_t x, int16_t prev)
+{
+  return motion->alpha * x + (1 - motion->alpha) * prev;
+}
+#endif
+
+// Differences of int16 samples reach 65535, whose square does not fit in 32 bits
+static inline int64_t sq(int32_t v)
+{
+  return (int64_t)v * v;
+}
+
+void csi_motion_init(csi_motion_t *motion)
+{
+  memset(motion, 0, sizeof(*motion));
+  motion->window = CSI_MOTION_WINDOW;
+  motion->alpha_num = CSI_MOTION_ALPHA_NUM;
+  motion->alpha_den = CSI_MOTION_ALPHA_DEN;
+  motion->alpha = CSI_MOTION_ALPHA;
+}
+
+/**
+ * @brief Append samples at the end of the signal. O(1) per sample.
+ *
+ * The caller keeps the signal shorter than CSI_MOTION_RING; samples past that are ignored.
+ */
+void csi_motion_push(csi_motion_t *motion, const int16_t *samples, int n)
+{
+  for (int k = 0; k < n && csi_motion_count(motion) < CSI_MOTION_RING - 1; k++)
+  {
+    uint32_t i = motion->tail;
+    int16_t v = samples[k];
+    int16_t s;
+    if (i == motion->head)
+    {
+      s = v; // The smoother starts from the first sample
+      motion->p1[i & CSI_MOTION_MASK] = 0;
+      motion->p2[i & CSI_MOTION_MASK] = 0;
+    }
+    else
+    {
+      int16_t prev = motion->s[(i - 1) & CSI_MOTION_MASK];
+      s = ema(motion, v, prev);
+      motion->diff_sq += sq(s - prev);
+    }
+    motion->x[i & CSI_MOTION_MASK] = v;
+    motion->s[i & CSI_MOTION_MASK] = s;
+    motion->p1[(i + 1) & CSI_MOTION_MASK] = motion->p1[i & CSI_MOTION_MASK] + (uint32_t)(int32_t)s;
+    motion->p2[(i + 1) & CSI_MOTION_MASK] = motion->p2[i & CSI_MOTION_MASK] + (uint64_t)sq(s);
+    motion->sum += v;
+    motion->sum_sq += sq(v);
+    motion->tail++;
+  }
+}
+
+/**
+ * Re-run the smoother from the new first sample until it agrees with the stored
+ * values; past that point both recurrences see the same state and inputs.
+ */
+static void restart_smoother(csi_motion_t *motion)
+{
+  uint32_t head = motion->head;
+  int16_t *s = motion->s;
+  if (head == motion->tail || s[head & CSI_MOTION_MASK] == motion->x[head & CSI_MOTION_MASK])
+    return;
+
+  int16_t prev_old = s[head & CSI_MOTION_MASK];
+  s[head & CSI_MOTION_MASK] = motion->x[head & CSI_MOTION_MASK];
+  uint32_t i = head + 1;
+  for (; i != motion->tail; i++)
+  {
+    int16_t old = s[i & CSI_MOTION_MASK];
+    int16_t prev = s[(i - 1) & CSI_MOTION_MASK];
+    int16_t value = ema(motion, motion->x[i & CSI_MOTION_MASK], prev);
+    motion->diff_sq += sq(value - prev) - sq(old - prev_old);
+    s[i & CSI_MOTION_MASK] = value;
+    prev_old = old;
+    if (value == old)
+      break;
+  }
+
+  // Prefix sums from the first unchanged sample (or the end) are still valid; rebuild the rest backwards
+  uint32_t end = i == motion->tail ? motion->tail : i;
+  for (uint32_t j = end; j != head; j--)
+  {
+    int16_t value = s[(j - 1) & CSI_MOTION_MASK];
+    motion->p1[(j - 1) & CSI_MOTION_MASK] = motion->p1[j & CSI_MOTION_MASK] - (uint32_t)(int32_t)value;
+    motion->p2[(j - 1) & CSI_MOTION_MASK] = motion->p2[j & CSI_MOTION_MASK] - (uint64_t)sq(value);
+  }
+}
+
+/**
+ * @brief Change the variance window and the EMA factor alpha_num / alpha_den.
+ *
+ * The window only affects csi_motion_features(). A new factor re-smooths the
+ * held signal once, O(n), so the statistics stay exact for the new settings.
+ * The caller validates: 2 <= window, 0 < alpha_num <= alpha_den.
+ */
+void csi_motion_configure(csi_motion_t *motion, int window, int alpha_num, int alpha_den)
+{
+  motion->window = (uint16_t)window;
+  if (alpha_num == motion->alpha_num && alpha_den == motion->alpha_den)
+    return;
+  motion->alpha_num = (uint8_t)alpha_num;
+  motion->alpha_den = (uint8_t)alpha_den;
+  motion->alpha = (float)alpha_num / alpha_den;
+
+  // Re-push the raw samples; sums of x are unaffected and rebuilt along the way
+  uint32_t head = motion->head;
+  uint32_t tail = motion->tail;
+  motion->tail = head;
+  motion->sum = 0;
+  motion->sum_sq = 0;
+  motion->diff_sq = 0;
+  for (uint32_t i = head; i != tail; i++)
+    csi_motion_push(motion, &motion->x[i & CSI_MOTION_MASK], 1);
+}
+
+/**
+ * @brief Remove the @p n oldest samples. O(1) per sample plus the smoother restart.
+ */
+void csi_motion_drop(csi_motion_t *motion, int n)
+{
+  if (n > csi_motion_count(motion))
+    n = csi_motion_count(motion);
+  for (int k = 0; k < n; k++)
+  {
+    uint32_t i = motion->head;
+    int16_t v = motion->x[i & CSI_MOTION_MASK];
+    motion->sum -= v;
+    motion->sum_sq -= sq(v);
+    if (i + 1 != motion->tail)
+      motion->diff_sq -= sq(motion->s[(i + 1) & CSI_MOTION_MASK] - motion->s[i & CSI_MOTION_MASK]);
+    motion->head++;
+  }
+  restart_smoother(motion);
+}
+
+/**
+ * @brief Statistics of the current signal, as motion_detection() defines them.
+ *
+ * @return false with fewer than two samples.
+ */
+bool csi_motion_features(const csi_motion_t *motion, csi_motion_features_t *features)
+{
+  int n = csi_motion_count(motion);
+  if (n < 2)
+    return false;
+
+  // n^2 * variance and W^2 * window variance are exact in integers; only the results go to float
+  int64_t spread = (int64_t)n * motion->sum_sq - motion->sum * motion->sum;
+  features->signal_std = sqrtf((float)spread / ((float)n * n));
+
+  int64_t max_spread = 0, total_spread = 0;
+  int valid_windows = 0;
+  int window = motion->window;
+  int hop = window / 2;
+  for (int start = 0; start < n - window; start += hop)
+  {
+    uint32_t a = (motion->head + start) & CSI_MOTION_MASK;
+    uint32_t b = (motion->head + start + window) & CSI_MOTION_MASK;
+    int32_t s1 = (int32_t)(motion->p1[b] - motion->p1[a]);
+    uint64_t s2 = motion->p2[b] - motion->p2[a];
+    int64_t window_spread = (int64_t)window * (int64_t)s2 - (int64_t)s1 * s1;
+    if (window_spread > max_spread)
+      max_spread = window_spread;
+    total_spread += window_spread;
+    valid_windows++;
+  }
+  const float window_sq = (float)window * window;
+  features->max_variance = (float)max_spread / window_sq;
+  features->avg_variance = valid_windows ? (float)total_spread / window_sq / valid_windows : 0.0f;
+  features->diff_energy = (float)motion->diff_sq / (n - 1);
+  return true;
+}
+
+/**
+ * @brief csi_motion_features() without floating point. Results are Q8, rounded down.
+ *
+ * Variances and the diff energy are the exact values truncated to 1/256; the
+ * standard deviation is floor(sqrt()) of the variance in Q16, so it is within
+ * 1/256 of the exact value as well.
+ */
+bool csi_motion_features_q8(const csi_motion_t *motion, csi_motion_features_q8_t *features)
+{
+  int n = csi_motion_count(motion);
+  if (n < 2)
+    return false;
+
+  // Variance in Q16 as floor(spread * 2^16 / n^2), in two parts: spread itself reaches 2^50
+  int64_t spread = (int64_t)n * motion->sum_sq - motion->sum * motion->sum;
+  uint64_t n_sq = (uint64_t)n * n;
+  uint64_t variance_q16 = ((uint64_t)spread / n_sq << 16) + (((uint64_t)spread % n_sq) << 16) / n_sq;
+  features->signal_std = csi_isqrt64(variance_q16);
+
+  int64_t max_spread = 0, total_spread = 0;
+  int valid_windows = 0;
+  int window = motion->window;
+  int hop = window / 2;
+  for (int start = 0; start < n - window; start += hop)
+  {
+    uint32_t a = (motion->head + start) & CSI_MOTION_MASK;
+    uint32_t b = (motion->head + start + window) & CSI_MOTION_MASK;
+    int32_t s1 = (int32_t)(motion->p1[b] - motion->p1[a]);
+    uint64_t s2 = motion->p2[b] - motion->p2[a];
+    int64_t window_spread = (int64_t)window * (int64_t)s2 - (int64_t)s1 * s1;
+    if (window_spread > max_spread)
+      max_spread = window_spread;
+    total_spread += window_spread;
+    valid_windows++;
+  }
+  const int64_t window_sq = (int64_t)window * window;
+  features->max_variance = csi_sat32((max_spread << 8) / window_sq);
+  features->avg_variance = valid_windows ? csi_sat32((total_spread << 8) / (window_sq * valid_windows)) : 0;
+  features->diff_energy = csi_sat32((motion->diff_sq << 8) / (n - 1));
+  return true;
+}
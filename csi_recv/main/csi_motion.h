@@ -0,0 +1,82 @@
+#ifndef CSI_MOTION_H
+#define CSI_MOTION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "csi_fixed.h"
+
+// Default short-term variance window over the smoothed signal; windows start window / 2 apart
+#define CSI_MOTION_WINDOW 30
+// Default EMA smoothing factor applied before the windowed statistics, and the same factor as a ratio
+#define CSI_MOTION_ALPHA 0.4f
+#define CSI_MOTION_ALPHA_NUM 2
+#define CSI_MOTION_ALPHA_DEN 5
+// History slots. Power of two, larger than the longest signal the detector holds.
+#define CSI_MOTION_RING 1024
+
+typedef struct
+{
+  float signal_std;   /**< Standard deviation of the raw signal */
+  float max_variance; /**< Largest window variance of the smoothed signal */
+  float avg_variance; /**< Mean window variance of the smoothed signal */
+  float diff_energy;  /**< Mean squared first difference of the smoothed signal */
+} csi_motion_features_t;
+
+// The same statistics in Q8 (value * 256), for CSI_FIXED_POINT
+typedef struct
+{
+  int32_t signal_std;
+  int32_t max_variance;
+  int32_t avg_variance;
+  int32_t diff_energy;
+} csi_motion_features_q8_t;
+
+/**
+ * @brief Streaming form of the motion_detection() statistics.
+ *
+ * Holds the same signal as the session's csi_q: samples are appended with
+ * csi_motion_push() and removed from the front with csi_motion_drop(), exactly
+ * as csi_q is filled and shifted. Raw sums, the smoothed signal, its prefix
+ * sums and the difference energy are all updated per sample entering or
+ * leaving, so csi_motion_features() only has to read one prefix-sum pair per
+ * window instead of rescanning the buffer.
+ *
+ * The smoothed signal is the integer EMA restarted at the first sample, as the
+ * batch version computes it. With CSI_FIXED_POINT the EMA step is the exact
+ * ratio (2x + 3s) / 5, truncated toward zero like the float step; the two differ
+ * by one LSB only where float rounding lands just below an integer (about 0.5%
+ * of steps). Every statistic after the EMA is exact integer math in both modes.
+ * When the front moves, the restarted EMA is recomputed only until it meets the
+ * stored values again; from there on the recurrence is identical, so the result
+ * is exact rather than approximate.
+ */
+typedef struct
+{
+  int16_t x[CSI_MOTION_RING];  /**< Raw samples */
+  int16_t s[CSI_MOTION_RING];  /**< EMA-smoothed samples */
+  uint32_t p1[CSI_MOTION_RING]; /**< Prefix sums of s (modular; only differences are used) */
+  uint64_t p2[CSI_MOTION_RING]; /**< Prefix sums of s * s, 64-bit */
+  uint32_t head;               /**< Stream index of the oldest sample */
+  uint32_t tail;               /**< Stream index one past the newest sample */
+  int64_t sum;                 /**< Sum of x */
+  int64_t sum_sq;              /**< Sum of x * x */
+  int64_t diff_sq;             /**< Sum of (s[i] - s[i - 1])^2 */
+  uint16_t window;             /**< Variance window, see csi_motion_configure() */
+  uint8_t alpha_num;           /**< EMA factor alpha_num / alpha_den */
+  uint8_t alpha_den;
+  float alpha;                 /**< The same factor for the float EMA */
+} csi_motion_t;
+
+void csi_motion_init(csi_motion_t *motion);
+void csi_motion_configure(csi_motion_t *motion, int window, int alpha_num, int alpha_den);
+void csi_motion_push(csi_motion_t *motion, const int16_t *samples, int n);
+void csi_motion_drop(csi_motion_t *motion, int n);
+bool csi_motion_features(const csi_motion_t *motion, csi_motion_features_t *features);
+bool csi_motion_features_q8(const csi_motion_t *motion, csi_motion_features_q8_t *features);
+
+static inline int csi_motion_count(const csi_motion_t *motion)
+{
+  return (int)(motion->tail - motion->head);
+}
+
+#endif // CSI_MOTION_H
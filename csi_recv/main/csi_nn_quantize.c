@@ -0,0 +1,809 @@
+// Host tool: post-training int8 quantisation of the breathing network. Reads the
+// float TFLite model (a chain of FULLY_CONNECTED layers, optionally with fused
+// ReLU), calibrates every activation range on the benchmark recordings, and writes
+// a fully integer model: int8 input and output, int8 weights with one symmetric
+// scale per layer, int32 biases. TFLM runs it with its int8 kernels.
+//
+// It then scores both models on the recordings with the same arithmetic as the
+// TFLM reference kernels: MAE against the ground truth at the evaluators' hop,
+// the largest int8 vs float difference over every window, time per inference on
+// this host and the bytes of constant data each model carries.
+//
+// Build: gcc -O2 -o csi_nn_quantize csi_nn_quantize.c csi_features.c -lm
+// Usage: ./csi_nn_quantize <float.tflite> <scaler.txt> <int8.tflite> <model_data_int8.cc>
+//
+// scaler.txt gives the standardisation the network was trained behind as "means"
+// and "scales" lines, in the csi_model_pack format (breathing_rate_svm_model.txt).
+// Run from the same directory as the evaluators: the recordings are read from
+// ../../../benchmark/breathing_rate/evaluation.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include "csi_features.h"
+
+#define MAX_SAMPLES 16000
+#define MAX_GT 200
+#define WINDOW_SIZE 300
+#define STEP_SIZE 150
+#define FEATURE_SIZE CSI_FEATURES_COUNT
+#define MAX_TENSORS 32
+#define MAX_OPS 8
+#define MAX_WIDTH 256
+// Minimum time spent timing each model
+#define BENCH_SECONDS 0.2
+
+// TFLite schema values used here
+#define TFL_FLOAT32 0
+#define TFL_INT32 2
+#define TFL_INT8 9
+#define TFL_FULLY_CONNECTED 9
+#define TFL_FULLY_CONNECTED_OPTIONS 8
+#define TFL_ACT_NONE 0
+#define TFL_ACT_RELU 1
+
+const char* csi_files[] = {
+    "../../../benchmark/breathing_rate/evaluation/CSI20250227_193124.csv",
+    "../../../benchmark/breathing_rate/evaluation/CSI20250227_191018.csv"
+};
+const char* gt_files[] = {
+    "../../../benchmark/breathing_rate/evaluation/gt_20250227_193124.csv",
+    "../../../benchmark/breathing_rate/evaluation/gt_20250227_191018.csv"
+};
+
+typedef struct {
+    char name[128];
+    int32_t shape[4];
+    int dims;
+    int count;             // Elements
+    const float* data;     // Constant float data in the source model, NULL for activations
+    float min, max;        // Calibrated range of an activation
+    float scale;
+    int32_t zero_point;
+} nn_tensor_t;
+
+typedef struct {
+    int input, weights, bias, output;
+    int relu;
+    // int8 kernel parameters, as TFLM derives them in Prepare
+    int32_t multiplier;
+    int shift;
+    int8_t weights_q[MAX_WIDTH * MAX_WIDTH];
+    int32_t bias_q[MAX_WIDTH];
+} nn_op_t;
+
+typedef struct {
+    nn_tensor_t tensors[MAX_TENSORS];
+    int tensor_count;
+    nn_op_t ops[MAX_OPS];
+    int op_count;
+    int input, output;
+} nn_model_t;
+
+// === FlatBuffer reading ===
+static const uint8_t* fb;
+static size_t fb_size;
+
+static uint32_t rd_u32(size_t at) {
+    uint32_t v;
+    memcpy(&v, fb + at, 4);
+    return v;
+}
+
+static size_t deref(size_t at) {
+    return at + rd_u32(at);
+}
+
+// Position of field n of the table at t, 0 if absent
+static size_t field(size_t t, int n) {
+    int32_t soffset;
+    memcpy(&soffset, fb + t, 4);
+    size_t vtable = t - soffset;
+    uint16_t vtable_size, offset;
+    memcpy(&vtable_size, fb + vtable, 2);
+    if (4 + 2 * n >= vtable_size) return 0;
+    memcpy(&offset, fb + vtable + 4 + 2 * n, 2);
+    return offset ? t + offset : 0;
+}
+
+static uint32_t field_u32(size_t t, int n, uint32_t fallback) {
+    size_t at = field(t, n);
+    return at ? rd_u32(at) : fallback;
+}
+
+static uint8_t field_u8(size_t t, int n, uint8_t fallback) {
+    size_t at = field(t, n);
+    return at ? fb[at] : fallback;
+}
+
+// Vector a field refers to: element position and length
+static size_t field_vector(size_t t, int n, uint32_t* length) {
+    size_t at = field(t, n);
+    if (!at) {
+        *length = 0;
+        return 0;
+    }
+    size_t v = deref(at);
+    *length = rd_u32(v);
+    return v + 4;
+}
+
+static int32_t vector_i32(size_t v, uint32_t i) {
+    return (int32_t)rd_u32(v + 4 * i);
+}
+
+static size_t vector_table(size_t v, uint32_t i) {
+    return deref(v + 4 * i);
+}
+
+// === 读取浮点模型 ===
+static int fail(const char* what) {
+    fprintf(stderr, "Unsupported model: %s\n", what);
+    return -1;
+}
+
+static int load_model(const uint8_t* data, size_t size, nn_model_t* model) {
+    fb = data;
+    fb_size = size;
+    if (size < 8 || memcmp(data + 4, "TFL3", 4) != 0) return fail("not a TFLite flatbuffer");
+    size_t root = deref(0);
+    uint32_t n_codes, n_graphs, n_buffers;
+    size_t codes = field_vector(root, 1, &n_codes);
+    size_t graphs = field_vector(root, 2, &n_graphs);
+    size_t buffers = field_vector(root, 4, &n_buffers);
+    if (n_graphs != 1) return fail("more than one subgraph");
+    size_t graph = vector_table(graphs, 0);
+
+    uint32_t n_tensors;
+    size_t tensors = field_vector(graph, 0, &n_tensors);
+    if (n_tensors > MAX_TENSORS) return fail("too many tensors");
+    model->tensor_count = (int)n_tensors;
+    for (uint32_t i = 0; i < n_tensors; i++) {
+        size_t t = vector_table(tensors, i);
+        nn_tensor_t* tensor = &model->tensors[i];
+        memset(tensor, 0, sizeof(*tensor));
+        if (field_u8(t, 1, TFL_FLOAT32) != TFL_FLOAT32) return fail("tensor is not float32");
+        uint32_t dims;
+        size_t shape = field_vector(t, 0, &dims);
+        if (dims > 4) return fail("tensor rank above 4");
+        tensor->dims = (int)dims;
+        tensor->count = 1;
+        for (uint32_t d = 0; d < dims; d++) {
+            tensor->shape[d] = vector_i32(shape, d);
+            if (tensor->shape[d] <= 0 || tensor->shape[d] > MAX_WIDTH) return fail("tensor shape");
+            tensor->count *= tensor->shape[d];
+        }
+        uint32_t name_length;
+        size_t name = field_vector(t, 3, &name_length);
+        if (name_length >= sizeof(tensor->name)) name_length = sizeof(tensor->name) - 1;
+        memcpy(tensor->name, fb + name, name_length);
+
+        uint32_t buffer = field_u32(t, 2, 0), bytes;
+        if (buffer >= n_buffers) return fail("tensor buffer out of range");
+        size_t content = field_vector(vector_table(buffers, buffer), 0, &bytes);
+        if (bytes > 0) {
+            if (bytes != tensor->count * sizeof(float) || content + bytes > fb_size) return fail("buffer size");
+            float* copy = malloc(bytes);
+            memcpy(copy, fb + content, bytes);
+            tensor->data = copy;
+        }
+        tensor->min = INFINITY;
+        tensor->max = -INFINITY;
+    }
+
+    uint32_t n;
+    size_t io = field_vector(graph, 1, &n);
+    if (n != 1) return fail("not one input");
+    model->input = vector_i32(io, 0);
+    io = field_vector(graph, 2, &n);
+    if (n != 1) return fail("not one output");
+    model->output = vector_i32(io, 0);
+
+    uint32_t n_ops;
+    size_t ops = field_vector(graph, 3, &n_ops);
+    if (n_ops == 0 || n_ops > MAX_OPS) return fail("operator count");
+    model->op_count = (int)n_ops;
+    for (uint32_t i = 0; i < n_ops; i++) {
+        size_t op = vector_table(ops, i);
+        uint32_t code_index = field_u32(op, 0, 0);
+        if (code_index >= n_codes) return fail("opcode out of range");
+        size_t code = vector_table(codes, code_index);
+        int32_t builtin = (int32_t)field_u32(code, 3, 0);
+        int8_t deprecated = (int8_t)field_u8(code, 0, 0);
+        if ((builtin > deprecated ? builtin : deprecated) != TFL_FULLY_CONNECTED) return fail("operator other than FULLY_CONNECTED");
+
+        uint32_t n_in, n_out;
+        size_t in = field_vector(op, 1, &n_in);
+        size_t out = field_vector(op, 2, &n_out);
+        if (n_in != 3 || n_out != 1) return fail("FULLY_CONNECTED without a bias");
+        nn_op_t* o = &model->ops[i];
+        memset(o, 0, sizeof(*o));
+        o->input = vector_i32(in, 0);
+        o->weights = vector_i32(in, 1);
+        o->bias = vector_i32(in, 2);
+        o->output = vector_i32(out, 0);
+        size_t options = field(op, 4) ? deref(field(op, 4)) : 0;
+        uint8_t activation = options ? field_u8(options, 0, TFL_ACT_NONE) : TFL_ACT_NONE;
+        if (activation != TFL_ACT_NONE && activation != TFL_ACT_RELU) return fail("activation other than ReLU");
+        o->relu = activation == TFL_ACT_RELU;
+
+        const nn_tensor_t* w = &model->tensors[o->weights];
+        const nn_tensor_t* b = &model->tensors[o->bias];
+        if (!w->data || !b->data || w->dims != 2 || b->count != w->shape[0] ||
+            model->tensors[o->input].count != w->shape[1] || model->tensors[o->output].count != w->shape[0] ||
+            w->shape[0] > MAX_WIDTH)
+            return fail("layer shapes");
+    }
+    return 0;
+}
+
+// === 浮点推理 (记录每个激活值的范围) ===
+static float act[MAX_TENSORS][MAX_WIDTH];
+
+static float run_float(nn_model_t* model, const float* input, bool calibrate) {
+    memcpy(act[model->input], input, FEATURE_SIZE * sizeof(float));
+    for (int i = 0; i < model->op_count; i++) {
+        const nn_op_t* op = &model->ops[i];
+        const nn_tensor_t* w = &model->tensors[op->weights];
+        const float* b = model->tensors[op->bias].data;
+        int outs = w->shape[0], ins = w->shape[1];
+        for (int o = 0; o < outs; o++) {
+            float sum = b[o];
+            for (int k = 0; k < ins; k++) sum += w->data[o * ins + k] * act[op->input][k];
+            act[op->output][o] = op->relu && sum < 0 ? 0 : sum;
+        }
+    }
+    if (calibrate) {
+        for (int t = 0; t < model->tensor_count; t++) {
+            nn_tensor_t* tensor = &model->tensors[t];
+            if (tensor->data) continue;
+            for (int k = 0; k < tensor->count; k++) {
+                if (act[t][k] < tensor->min) tensor->min = act[t][k];
+                if (act[t][k] > tensor->max) tensor->max = act[t][k];
+            }
+        }
+    }
+    return act[model->output][0];
+}
+
+// === 量化 (与 TFLite 的算法一致) ===
+static void quantize_multiplier(double m, int32_t* multiplier, int* shift) {
+    if (m == 0) {
+        *multiplier = 0;
+        *shift = 0;
+        return;
+    }
+    double q = frexp(m, shift);
+    int64_t q_fixed = (int64_t)llround(q * (1LL << 31));
+    if (q_fixed == (1LL << 31)) {
+        q_fixed /= 2;
+        ++*shift;
+    }
+    if (*shift < -31) {
+        *shift = 0;
+        q_fixed = 0;
+    }
+    *multiplier = (int32_t)q_fixed;
+}
+
+static int32_t rounding_doubling_high_mul(int32_t a, int32_t b) {
+    if (a == INT32_MIN && b == INT32_MIN) return INT32_MAX;
+    int64_t ab = (int64_t)a * b;
+    int32_t nudge = ab >= 0 ? (1 << 30) : (1 - (1 << 30));
+    return (int32_t)((ab + nudge) / (1LL << 31));
+}
+
+static int32_t rounding_divide_by_pot(int32_t x, int exponent) {
+    int32_t mask = (int32_t)((1LL << exponent) - 1);
+    int32_t remainder = x & mask;
+    int32_t threshold = (mask >> 1) + (x < 0);
+    return (x >> exponent) + (remainder > threshold);
+}
+
+static int32_t multiply_by_quantized_multiplier(int32_t x, int32_t multiplier, int shift) {
+    int left = shift > 0 ? shift : 0;
+    int right = shift > 0 ? 0 : -shift;
+    return rounding_divide_by_pot(rounding_doubling_high_mul(x * (1 << left), multiplier), right);
+}
+
+// Asymmetric int8 over the calibrated range, widened to hold 0 as TFLite requires
+static void choose_activation_params(nn_tensor_t* tensor) {
+    float lo = tensor->min < 0 ? tensor->min : 0;
+    float hi = tensor->max > 0 ? tensor->max : 0;
+    if (hi - lo < 1e-6f) hi = lo + 1e-6f;
+    tensor->scale = (hi - lo) / 255.0f;
+    long zero_point = lroundf(-128 - lo / tensor->scale);
+    tensor->zero_point = (int32_t)(zero_point < -128 ? -128 : zero_point > 127 ? 127 : zero_point);
+}
+
+static void quantize_model(nn_model_t* model) {
+    for (int t = 0; t < model->tensor_count; t++) {
+        if (!model->tensors[t].data) choose_activation_params(&model->tensors[t]);
+    }
+    for (int i = 0; i < model->op_count; i++) {
+        nn_op_t* op = &model->ops[i];
+        nn_tensor_t* w = &model->tensors[op->weights];
+        nn_tensor_t* b = &model->tensors[op->bias];
+        float max_abs = 0;
+        for (int k = 0; k < w->count; k++) max_abs = fmaxf(max_abs, fabsf(w->data[k]));
+        w->scale = max_abs > 0 ? max_abs / 127.0f : 1.0f;
+        w->zero_point = 0;
+        for (int k = 0; k < w->count; k++) op->weights_q[k] = (int8_t)lroundf(w->data[k] / w->scale);
+
+        const nn_tensor_t* in = &model->tensors[op->input];
+        const nn_tensor_t* out = &model->tensors[op->output];
+        b->scale = in->scale * w->scale;
+        b->zero_point = 0;
+        for (int k = 0; k < b->count; k++) op->bias_q[k] = (int32_t)lround(b->data[k] / (double)b->scale);
+        quantize_multiplier((double)in->scale * w->scale / out->scale, &op->multiplier, &op->shift);
+    }
+}
+
+// === int8 推理 (TFLM 参考 FULLY_CONNECTED 内核的算法) ===
+static int8_t act_q[MAX_TENSORS][MAX_WIDTH];
+
+static int8_t quantize_input(const nn_tensor_t* tensor, float x) {
+    long q = lroundf(x / tensor->scale) + tensor->zero_point;
+    return (int8_t)(q < -128 ? -128 : q > 127 ? 127 : q);
+}
+
+static float run_int8(const nn_model_t* model, const float* input) {
+    const nn_tensor_t* in = &model->tensors[model->input];
+    for (int k = 0; k < FEATURE_SIZE; k++) act_q[model->input][k] = quantize_input(in, input[k]);
+    for (int i = 0; i < model->op_count; i++) {
+        const nn_op_t* op = &model->ops[i];
+        const nn_tensor_t* w = &model->tensors[op->weights];
+        int32_t input_offset = -model->tensors[op->input].zero_point;
+        int32_t output_offset = model->tensors[op->output].zero_point;
+        int32_t low = op->relu ? output_offset : -128;
+        int outs = w->shape[0], ins = w->shape[1];
+        for (int o = 0; o < outs; o++) {
+            int32_t acc = op->bias_q[o];
+            for (int k = 0; k < ins; k++) acc += op->weights_q[o * ins + k] * (act_q[op->input][k] + input_offset);
+            acc = multiply_by_quantized_multiplier(acc, op->multiplier, op->shift) + output_offset;
+            act_q[op->output][o] = (int8_t)(acc < low ? low : acc > 127 ? 127 : acc);
+        }
+    }
+    const nn_tensor_t* out = &model->tensors[model->output];
+    return (act_q[model->output][0] - out->zero_point) * out->scale;
+}
+
+// === FlatBuffer 写出 ===
+// Built front to back: a table is written before what it refers to, and each
+// offset is patched once its target exists, so every offset points forward.
+typedef struct {
+    uint8_t* data;
+    size_t size, capacity;
+} fb_builder_t;
+
+static size_t fb_reserve(fb_builder_t* b, size_t bytes, size_t align) {
+    size_t at = (b->size + align - 1) / align * align;
+    if (at + bytes > b->capacity) {
+        b->capacity = (at + bytes) * 2;
+        b->data = realloc(b->data, b->capacity);
+    }
+    memset(b->data + b->size, 0, at + bytes - b->size);
+    b->size = at + bytes;
+    return at;
+}
+
+static void fb_patch(fb_builder_t* b, size_t at, size_t target) {
+    uint32_t offset = (uint32_t)(target - at);
+    memcpy(b->data + at, &offset, 4);
+}
+
+// Field sizes of a table, in field order; 0 leaves a field out. Returns the
+// table position; field_at[n] receives where field n was placed.
+static size_t fb_table(fb_builder_t* b, int n_fields, const int* sizes, size_t* field_at) {
+    size_t vtable = fb_reserve(b, 4 + 2 * n_fields, 2);
+    // Fields in declaration order, each aligned to its size, after the 4-byte vtable offset
+    uint16_t table_size = 4, offsets[16];
+    for (int i = 0; i < n_fields; i++) {
+        if (!sizes[i]) {
+            offsets[i] = 0;
+            continue;
+        }
+        table_size = (uint16_t)((table_size + sizes[i] - 1) / sizes[i] * sizes[i]);
+        offsets[i] = table_size;
+        table_size = (uint16_t)(table_size + sizes[i]);
+    }
+    size_t table = fb_reserve(b, table_size, 8);
+    uint16_t header[2] = {(uint16_t)(4 + 2 * n_fields), table_size};
+    memcpy(b->data + vtable, header, 4);
+    memcpy(b->data + vtable + 4, offsets, 2 * n_fields);
+    int32_t soffset = (int32_t)(table - vtable);
+    memcpy(b->data + table, &soffset, 4);
+    for (int i = 0; i < n_fields; i++) field_at[i] = offsets[i] ? table + offsets[i] : 0;
+    return table;
+}
+
+static void fb_set(fb_builder_t* b, size_t at, const void* value, size_t bytes) {
+    memcpy(b->data + at, value, bytes);
+}
+
+// Vector of count elements of element bytes; returns the position of the first element
+static size_t fb_vector(fb_builder_t* b, size_t count, size_t element, size_t align, size_t* length_at) {
+    // The length sits right before the elements, which must be aligned
+    size_t at = (b->size + 3) / 4 * 4;
+    while ((at + 4) % align != 0) at += 4;
+    fb_reserve(b, at + 4 + count * element - b->size, 1);
+    uint32_t length = (uint32_t)count;
+    memcpy(b->data + at, &length, 4);
+    if (length_at) *length_at = at;
+    return at + 4;
+}
+
+static size_t fb_vector_of(fb_builder_t* b, size_t offset_field, size_t count, size_t element, size_t align,
+                           const void* values) {
+    size_t length_at;
+    size_t elements = fb_vector(b, count, element, align, &length_at);
+    if (values) memcpy(b->data + elements, values, count * element);
+    fb_patch(b, offset_field, length_at);
+    return elements;
+}
+
+static void fb_string(fb_builder_t* b, size_t offset_field, const char* text) {
+    size_t length = strlen(text);
+    size_t length_at;
+    size_t at = fb_vector(b, length + 1, 1, 4, &length_at);
+    memcpy(b->data + at, text, length);
+    uint32_t stored = (uint32_t)length;
+    memcpy(b->data + length_at, &stored, 4);
+    fb_patch(b, offset_field, length_at);
+}
+
+// Role of each tensor in the int8 model
+static int tensor_type(const nn_model_t* model, int t) {
+    for (int i = 0; i < model->op_count; i++) {
+        if (model->ops[i].bias == t) return TFL_INT32;
+    }
+    return TFL_INT8;
+}
+
+static const void* tensor_payload(const nn_model_t* model, int t, size_t* bytes) {
+    for (int i = 0; i < model->op_count; i++) {
+        const nn_op_t* op = &model->ops[i];
+        if (op->weights == t) {
+            *bytes = model->tensors[t].count;
+            return op->weights_q;
+        }
+        if (op->bias == t) {
+            *bytes = model->tensors[t].count * sizeof(int32_t);
+            return op->bias_q;
+        }
+    }
+    *bytes = 0;
+    return NULL;
+}
+
+static uint8_t* build_int8_model(const nn_model_t* model, size_t* size) {
+    fb_builder_t b = {0};
+    size_t root = fb_reserve(&b, 8, 4);
+    memcpy(b.data + 4, "TFL3", 4);
+
+    // Model: version, operator_codes, subgraphs, description, buffers
+    const int model_sizes[5] = {4, 4, 4, 4, 4};
+    size_t mf[5];
+    size_t model_table = fb_table(&b, 5, model_sizes, mf);
+    fb_patch(&b, root, model_table);
+    uint32_t version = 3;
+    fb_set(&b, mf[0], &version, 4);
+
+    // One operator code: FULLY_CONNECTED, version 4 (int8 input and output)
+    size_t codes = fb_vector_of(&b, mf[1], 1, 4, 4, NULL);
+    const int code_sizes[4] = {1, 0, 4, 4};
+    size_t cf[4];
+    size_t code = fb_table(&b, 4, code_sizes, cf);
+    fb_patch(&b, codes, code);
+    int8_t deprecated = TFL_FULLY_CONNECTED;
+    int32_t code_version = 4, builtin = TFL_FULLY_CONNECTED;
+    fb_set(&b, cf[0], &deprecated, 1);
+    fb_set(&b, cf[2], &code_version, 4);
+    fb_set(&b, cf[3], &builtin, 4);
+
+    // Buffer 0 is the empty sentinel; constant tensors get one each, in tensor order
+    int buffer_of[MAX_TENSORS] = {0};
+    int n_buffers = 1;
+    for (int t = 0; t < model->tensor_count; t++) {
+        size_t bytes;
+        if (tensor_payload(model, t, &bytes)) buffer_of[t] = n_buffers++;
+    }
+
+    // SubGraph: tensors, inputs, outputs, operators, name
+    size_t graphs = fb_vector_of(&b, mf[2], 1, 4, 4, NULL);
+    const int graph_sizes[5] = {4, 4, 4, 4, 4};
+    size_t gf[5];
+    size_t graph = fb_table(&b, 5, graph_sizes, gf);
+    fb_patch(&b, graphs, graph);
+    int32_t input = model->input, output = model->output;
+    fb_vector_of(&b, gf[1], 1, 4, 4, &input);
+    fb_vector_of(&b, gf[2], 1, 4, 4, &output);
+    fb_string(&b, gf[4], "main");
+
+    size_t tensors = fb_vector_of(&b, gf[0], model->tensor_count, 4, 4, NULL);
+    for (int t = 0; t < model->tensor_count; t++) {
+        const nn_tensor_t* tensor = &model->tensors[t];
+        // Tensor: shape, type, buffer, name, quantization
+        const int tensor_sizes[5] = {4, 1, 4, 4, 4};
+        size_t tf[5];
+        size_t table = fb_table(&b, 5, tensor_sizes, tf);
+        fb_patch(&b, tensors + 4 * t, table);
+        uint8_t type = (uint8_t)tensor_type(model, t);
+        uint32_t buffer = (uint32_t)buffer_of[t];
+        fb_set(&b, tf[1], &type, 1);
+        fb_set(&b, tf[2], &buffer, 4);
+        fb_vector_of(&b, tf[0], tensor->dims, 4, 4, tensor->shape);
+        fb_string(&b, tf[3], tensor->name);
+
+        // QuantizationParameters: min, max, scale, zero_point (one per tensor)
+        const int quant_sizes[4] = {0, 0, 4, 4};
+        size_t qf[4];
+        size_t quant = fb_table(&b, 4, quant_sizes, qf);
+        fb_patch(&b, tf[4], quant);
+        int64_t zero_point = tensor->zero_point;
+        fb_vector_of(&b, qf[2], 1, 4, 4, &tensor->scale);
+        fb_vector_of(&b, qf[3], 1, 8, 8, &zero_point);
+    }
+
+    size_t operators = fb_vector_of(&b, gf[3], model->op_count, 4, 4, NULL);
+    for (int i = 0; i < model->op_count; i++) {
+        const nn_op_t* op = &model->ops[i];
+        // Operator: opcode_index, inputs, outputs, builtin_options_type, builtin_options
+        const int op_sizes[5] = {4, 4, 4, 1, 4};
+        size_t of[5];
+        size_t table = fb_table(&b, 5, op_sizes, of);
+        fb_patch(&b, operators + 4 * i, table);
+        uint8_t options_type = TFL_FULLY_CONNECTED_OPTIONS;
+        fb_set(&b, of[3], &options_type, 1);
+        int32_t inputs[3] = {op->input, op->weights, op->bias};
+        fb_vector_of(&b, of[1], 3, 4, 4, inputs);
+        fb_vector_of(&b, of[2], 1, 4, 4, &op->output);
+        // FullyConnectedOptions: fused_activation_function
+        const int options_sizes[1] = {1};
+        size_t pf[1];
+        size_t options = fb_table(&b, 1, options_sizes, pf);
+        fb_patch(&b, of[4], options);
+        uint8_t activation = op->relu ? TFL_ACT_RELU : TFL_ACT_NONE;
+        fb_set(&b, pf[0], &activation, 1);
+    }
+
+    fb_string(&b, mf[3], "int8, csi_nn_quantize");
+
+    size_t buffers = fb_vector_of(&b, mf[4], n_buffers, 4, 4, NULL);
+    const int buffer_sizes[1] = {4};
+    size_t bf[1];
+    fb_patch(&b, buffers, fb_table(&b, 0, buffer_sizes, bf));
+    for (int t = 0; t < model->tensor_count; t++) {
+        size_t bytes;
+        const void* payload = tensor_payload(model, t, &bytes);
+        if (!payload) continue;
+        size_t table = fb_table(&b, 1, buffer_sizes, bf);
+        fb_patch(&b, buffers + 4 * buffer_of[t], table);
+        fb_vector_of(&b, bf[0], bytes, 1, 16, payload);
+    }
+    fb_reserve(&b, 0, 16);
+    *size = b.size;
+    return b.data;
+}
+
+// === 读取数据 ===
+static int read_csi_data(const char* filename, float* buffer, int max_len) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        printf("Error: Cannot open file %s\n", filename);
+        return -1;
+    }
+    char line[8192];
+    int count = 0;
+    fgets(line, sizeof(line), file); // skip header
+    while (fgets(line, sizeof(line), file) && count < max_len) {
+        char* start = strchr(line, '[');
+        if (!start) continue;
+        char* token = strtok(start + 1, ",]");
+        while (token && count < max_len) {
+            buffer[count++] = atof(token);
+            token = strtok(NULL, ",]");
+        }
+    }
+    fclose(file);
+    return count;
+}
+
+static int read_gt_data(const char* filename, float* buffer, int max_len) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        printf("Error: Cannot open GT file %s\n", filename);
+        return -1;
+    }
+    char line[128];
+    int count = 0;
+    fgets(line, sizeof(line), file); // skip header
+    while (fgets(line, sizeof(line), file) && count < max_len) buffer[count++] = atof(strtok(line, ","));
+    fclose(file);
+    return count;
+}
+
+static int read_scaler(const char* path, float* means, float* scales) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return -1;
+    }
+    char line[1024];
+    int found = 0;
+    while (fgets(line, sizeof(line), file)) {
+        char* token = strtok(line, " \t\r\n,");
+        if (!token || token[0] == '#') continue;
+        float* target = strcmp(token, "means") == 0 ? means : strcmp(token, "scales") == 0 ? scales : NULL;
+        if (!target) continue;
+        int count = 0;
+        while ((token = strtok(NULL, " \t\r\n,")) && count < FEATURE_SIZE) target[count++] = strtof(token, NULL);
+        if (count != FEATURE_SIZE) break;
+        found++;
+    }
+    fclose(file);
+    if (found != 2) {
+        fprintf(stderr, "%s needs means and scales lines with %d values\n", path, FEATURE_SIZE);
+        return -1;
+    }
+    return 0;
+}
+
+static void* read_file(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    void* data = length > 0 ? malloc((size_t)length) : NULL;
+    if (data && fread(data, 1, (size_t)length, file) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *size = data ? (size_t)length : 0;
+    return data;
+}
+
+static int write_outputs(const uint8_t* blob, size_t size, const char* tflite_path, const char* cc_path) {
+    FILE* file = fopen(tflite_path, "wb");
+    if (!file || fwrite(blob, 1, size, file) != size) {
+        fprintf(stderr, "Cannot write %s\n", tflite_path);
+        if (file) fclose(file);
+        return -1;
+    }
+    fclose(file);
+    file = fopen(cc_path, "w");
+    if (!file) {
+        fprintf(stderr, "Cannot write %s\n", cc_path);
+        return -1;
+    }
+    fprintf(file, "#include \"model_data.h\"\n");
+    fprintf(file, "// Generated by csi_nn_quantize from breathing_rate_model.tflite; do not edit\n");
+    fprintf(file, "alignas(16) const unsigned char breathing_rate_model_int8_tflite[] = {");
+    for (size_t i = 0; i < size; i++) fprintf(file, "%s0x%02x%s", i % 12 ? " " : "\n  ", blob[i], i + 1 < size ? "," : "");
+    fprintf(file, "\n};\nconst int breathing_rate_model_int8_tflite_len = %zu;\n", size);
+    fclose(file);
+    return 0;
+}
+
+// === 数据集 ===
+// Standardised features of every window (hop 1) of every recording, and which of them the evaluators score
+typedef struct {
+    float (*features)[FEATURE_SIZE];
+    float* gt;        // Reference rate of a scored window, NAN otherwise
+    int count;
+} nn_dataset_t;
+
+static int load_dataset(const float* means, const float* scales, nn_dataset_t* set) {
+    static float csi[MAX_SAMPLES];
+    static float gt[MAX_GT];
+    static csi_features_t features;
+    int num_files = sizeof(csi_files) / sizeof(csi_files[0]);
+    set->features = malloc(num_files * MAX_SAMPLES * sizeof(*set->features));
+    set->gt = malloc(num_files * MAX_SAMPLES * sizeof(float));
+    set->count = 0;
+    for (int f = 0; f < num_files; f++) {
+        int csi_len = read_csi_data(csi_files[f], csi, MAX_SAMPLES);
+        int gt_len = read_gt_data(gt_files[f], gt, MAX_GT);
+        if (csi_len < 0 || gt_len < 0) return -1;
+        csi_features_init(&features, WINDOW_SIZE);
+        for (int n = 0; n < csi_len; n++) {
+            csi_features_push(&features, (int16_t)csi[n]);
+            float* x = set->features[set->count];
+            if (!csi_features_get(&features, x)) continue;
+            for (int k = 0; k < FEATURE_SIZE; k++) x[k] = (x[k] - means[k]) / scales[k];
+            int start = n + 1 - WINDOW_SIZE;
+            bool scored = start % STEP_SIZE == 0 && start / STEP_SIZE < gt_len;
+            set->gt[set->count++] = scored ? gt[start / STEP_SIZE] : NAN;
+        }
+    }
+    return 0;
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Nanoseconds per inference, over the whole dataset until BENCH_SECONDS have passed
+static double time_model(nn_model_t* model, const nn_dataset_t* set, bool int8) {
+    volatile float sink = 0;
+    long runs = 0;
+    double start = now_ns(), elapsed;
+    do {
+        for (int w = 0; w < set->count; w++) sink += int8 ? run_int8(model, set->features[w]) : run_float(model, set->features[w], false);
+        runs += set->count;
+        elapsed = now_ns() - start;
+    } while (elapsed < BENCH_SECONDS * 1e9);
+    (void)sink;
+    return elapsed / runs;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 5) {
+        fprintf(stderr, "Usage: %s <float.tflite> <scaler.txt> <int8.tflite> <model_data_int8.cc>\n", argv[0]);
+        return 2;
+    }
+    size_t size;
+    uint8_t* source = read_file(argv[1], &size);
+    static nn_model_t model;
+    float means[FEATURE_SIZE], scales[FEATURE_SIZE];
+    if (!source || load_model(source, size, &model) != 0 || read_scaler(argv[2], means, scales) != 0) return 1;
+    if (model.tensors[model.input].count != FEATURE_SIZE || model.tensors[model.output].count != 1) {
+        fprintf(stderr, "Model must map %d features to one rate\n", FEATURE_SIZE);
+        return 1;
+    }
+
+    nn_dataset_t set;
+    if (load_dataset(means, scales, &set) != 0) return 1;
+    for (int w = 0; w < set.count; w++) run_float(&model, set.features[w], true);
+    quantize_model(&model);
+    printf("Calibrated on %d windows\n", set.count);
+    for (int t = 0; t < model.tensor_count; t++) {
+        const nn_tensor_t* tensor = &model.tensors[t];
+        if (!tensor->data)
+            printf("  %-40.40s [%8.3f, %8.3f] scale %.6f zero point %d\n", tensor->name, tensor->min, tensor->max,
+                   tensor->scale, tensor->zero_point);
+    }
+
+    size_t int8_size;
+    uint8_t* blob = build_int8_model(&model, &int8_size);
+    if (write_outputs(blob, int8_size, argv[3], argv[4]) != 0) return 1;
+
+    // Accuracy at the evaluators' windows, agreement over all of them
+    double error_float = 0, error_int8 = 0, max_diff = 0;
+    int scored = 0;
+    for (int w = 0; w < set.count; w++) {
+        float pred_float = run_float(&model, set.features[w], false);
+        float pred_int8 = run_int8(&model, set.features[w]);
+        if (fabs(pred_int8 - pred_float) > max_diff) max_diff = fabs(pred_int8 - pred_float);
+        if (isnan(set.gt[w])) continue;
+        error_float += fabs(pred_float - set.gt[w]);
+        error_int8 += fabs(pred_int8 - set.gt[w]);
+        scored++;
+    }
+
+    size_t bytes_float = 0, bytes_int8 = 0;
+    for (int i = 0; i < model.op_count; i++) {
+        const nn_op_t* op = &model.ops[i];
+        bytes_float += (model.tensors[op->weights].count + model.tensors[op->bias].count) * sizeof(float);
+        bytes_int8 += model.tensors[op->weights].count + model.tensors[op->bias].count * sizeof(int32_t);
+    }
+    double ns_float = time_model(&model, &set, false);
+    double ns_int8 = time_model(&model, &set, true);
+
+    printf("\n%-6s %10s %10s %12s %12s\n", "model", "MAE", "file", "constants", "ns/infer");
+    printf("%-6s %10.2f %10zu %12zu %12.1f\n", "float", error_float / scored, size, bytes_float, ns_float);
+    printf("%-6s %10.2f %10zu %12zu %12.1f\n", "int8", error_int8 / scored, int8_size, bytes_int8, ns_int8);
+    printf("Scored %d windows; max |int8 - float| over all %d windows: %.3f BPM\n", scored, set.count, max_diff);
+    printf("Wrote %s and %s\n", argv[3], argv[4]);
+    return 0;
+}
@@ -0,0 +1,353 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "csi_params.h"
+
+#ifdef ESP_PLATFORM
+#include "nvs.h"
+
+#define CSI_PARAMS_NVS_NAMESPACE "csi"
+#define CSI_PARAMS_NVS_KEY "params"
+#endif
+
+typedef enum
+{
+  FIELD_F32,
+  FIELD_U8,
+  FIELD_U16,
+  FIELD_U32,
+  FIELD_RATIO, /**< "a/b" into two uint8_t fields */
+} field_type_t;
+
+// Command keys. The same table formats a set back, so a published set can be sent again as a command.
+static const struct
+{
+  const char *key;
+  field_type_t type;
+  size_t offset;
+  size_t offset2; /**< Denominator of a FIELD_RATIO */
+} s_fields[] = {
+    {"thr", FIELD_F32, offsetof(csi_params_t, base_threshold), 0},
+    {"dthr", FIELD_F32, offsetof(csi_params_t, diff_base_threshold), 0},
+    {"k", FIELD_F32, offsetof(csi_params_t, std_factor), 0},
+    {"dk", FIELD_F32, offsetof(csi_params_t, diff_std_factor), 0},
+    {"vs", FIELD_F32, offsetof(csi_params_t, variance_strong), 0},
+    {"ds", FIELD_F32, offsetof(csi_params_t, diff_strong), 0},
+    {"span", FIELD_F32, offsetof(csi_params_t, score_span), 0},
+    {"strong", FIELD_F32, offsetof(csi_params_t, strong_amplitude), 0},
+    {"instant", FIELD_F32, offsetof(csi_params_t, instant_amplitude), 0},
+    {"win", FIELD_U16, offsetof(csi_params_t, window), 0},
+    {"alpha", FIELD_RATIO, offsetof(csi_params_t, alpha_num), offsetof(csi_params_t, alpha_den)},
+    {"votes", FIELD_RATIO, offsetof(csi_params_t, vote_min), offsetof(csi_params_t, vote_window)},
+    {"cmin", FIELD_U8, offsetof(csi_params_t, continuous_min), 0},
+    {"cmax", FIELD_U8, offsetof(csi_params_t, continuous_max), 0},
+    {"send_ms", FIELD_U32, offsetof(csi_params_t, send_interval_ms), 0},
+    {"est", FIELD_U8, offsetof(csi_params_t, estimators), 0},
+};
+
+/**
+ * @brief The values motion_detection() and mqtt_send() were written with, every breathing estimator on.
+ */
+void csi_params_defaults(csi_params_t *params)
+{
+  memset(params, 0, sizeof(*params));
+  params->version = CSI_PARAMS_VERSION;
+  params->base_threshold = 50.0f;
+  params->diff_base_threshold = 60.0f;
+  params->std_factor = 0.9f;
+  params->diff_std_factor = 1.5f;
+  params->variance_strong = 2.0f;
+  params->diff_strong = 1.5f;
+  params->score_span = 3.0f;
+  params->strong_amplitude = 60.0f;
+  params->instant_amplitude = 75.0f;
+  params->window = 30;
+  params->alpha_num = 2;
+  params->alpha_den = 5;
+  params->vote_window = 5;
+  params->vote_min = 3;
+  params->continuous_min = 4;
+  params->continuous_max = 10;
+  params->send_interval_ms = 5000;
+  params->estimators = 0xff;
+  csi_params_derive(params);
+}
+
+static bool in_range(float value, float low, float high)
+{
+  return isfinite(value) && value >= low && value <= high;
+}
+
+/**
+ * @brief Check every field against the range the detectors (and their Q8/Q15 forms) can take.
+ *
+ * @param[out] reason Set to a short description of the first bad field; may be NULL.
+ */
+bool csi_params_validate(const csi_params_t *params, const char **reason)
+{
+  const char *error = NULL;
+  if (!in_range(params->base_threshold, 0.0f, 1e6f) || !in_range(params->diff_base_threshold, 0.0f, 1e6f))
+    error = "thresholds must be 0..1e6";
+  else if (!in_range(params->std_factor, 0.0f, 16.0f) || !in_range(params->diff_std_factor, 0.0f, 16.0f))
+    error = "k and dk must be 0..16";
+  else if (!in_range(params->variance_strong, 1.0f, 16.0f) || !in_range(params->diff_strong, 1.0f, 16.0f))
+    error = "vs and ds must be 1..16";
+  else if (!in_range(params->score_span, 0.1f, 16.0f))
+    error = "span must be 0.1..16";
+  else if (!in_range(params->strong_amplitude, 0.0f, 100.0f) || !in_range(params->instant_amplitude, 0.0f, 100.0f))
+    error = "strong and instant must be 0..100";
+  else if (params->window < 4 || params->window > CSI_PARAMS_MAX_WINDOW)
+    error = "win out of range";
+  else if (params->alpha_num == 0 || params->alpha_num > params->alpha_den)
+    error = "alpha must be a/b with 0 < a <= b";
+  else if (params->vote_window == 0 || params->vote_window > CSI_PARAMS_MAX_VOTES ||
+           params->vote_min == 0 || params->vote_min > params->vote_window)
+    error = "votes must be a/b with 0 < a <= b <= 8";
+  else if (params->continuous_max == 0 || params->continuous_max > 100 ||
+           params->continuous_min == 0 || params->continuous_min > params->continuous_max)
+    error = "need 0 < cmin <= cmax <= 100";
+  else if (params->send_interval_ms < 100 || params->send_interval_ms > 3600000)
+    error = "send_ms must be 100..3600000";
+  else if (params->estimators == 0)
+    error = "est must enable at least one estimator";
+
+  if (reason)
+    *reason = error;
+  return error == NULL;
+}
+
+/**
+ * @brief Fill the Q-format copies from the float fields. Call after any change.
+ */
+void csi_params_derive(csi_params_t *params)
+{
+  params->q.base_threshold = lroundf(params->base_threshold * (1 << 8));
+  params->q.diff_base_threshold = lroundf(params->diff_base_threshold * (1 << 8));
+  params->q.std_factor = lroundf(params->std_factor * (1 << 15));
+  params->q.diff_std_factor = lroundf(params->diff_std_factor * (1 << 15));
+  params->q.variance_strong = lroundf(params->variance_strong * (1 << 15));
+  params->q.diff_strong = lroundf(params->diff_strong * (1 << 15));
+  params->q.score_span = lroundf(params->score_span * (1 << 15));
+}
+
+static bool parse_field(const char *value, field_type_t type, void *field, void *field2)
+{
+  char *end;
+  if (type == FIELD_F32)
+  {
+    float parsed = strtof(value, &end);
+    if (end == value || *end != '\0')
+      return false;
+    *(float *)field = parsed;
+    return true;
+  }
+
+  unsigned long parsed = strtoul(value, &end, 10);
+  if (end == value)
+    return false;
+  switch (type)
+  {
+  case FIELD_U8:
+    if (*end != '\0' || parsed > UINT8_MAX)
+      return false;
+    *(uint8_t *)field = (uint8_t)parsed;
+    return true;
+  case FIELD_U16:
+    if (*end != '\0' || parsed > UINT16_MAX)
+      return false;
+    *(uint16_t *)field = (uint16_t)parsed;
+    return true;
+  case FIELD_U32:
+    if (*end != '\0' || parsed > UINT32_MAX)
+      return false;
+    *(uint32_t *)field = (uint32_t)parsed;
+    return true;
+  case FIELD_RATIO:
+  {
+    if (*end != '/' || parsed > UINT8_MAX)
+      return false;
+    const char *denominator = end + 1;
+    unsigned long parsed2 = strtoul(denominator, &end, 10);
+    if (end == denominator || *end != '\0' || parsed2 > UINT8_MAX)
+      return false;
+    *(uint8_t *)field = (uint8_t)parsed;
+    *(uint8_t *)field2 = (uint8_t)parsed2;
+    return true;
+  }
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief Apply a command to @p params.
+ *
+ * A command is "key=value" pairs separated by spaces, commas or semicolons,
+ * e.g. "thr=45 k=0.8 votes=3/5 send_ms=2000". Keys not given keep their value;
+ * the word "defaults" first resets every field. The result is validated and
+ * derived; on any error @p params is left untouched.
+ */
+bool csi_params_parse(const char *command, size_t len, csi_params_t *params, const char **reason)
+{
+  char text[CSI_PARAMS_MAX_COMMAND + 1];
+  if (len > CSI_PARAMS_MAX_COMMAND)
+  {
+    *reason = "command too long";
+    return false;
+  }
+  memcpy(text, command, len);
+  text[len] = '\0';
+
+  csi_params_t updated = *params;
+  char *save;
+  for (char *token = strtok_r(text, " ,;\r\n\t", &save); token; token = strtok_r(NULL, " ,;\r\n\t", &save))
+  {
+    if (strcmp(token, "defaults") == 0)
+    {
+      csi_params_defaults(&updated);
+      continue;
+    }
+    char *value = strchr(token, '=');
+    if (!value)
+    {
+      *reason = "expected key=value";
+      return false;
+    }
+    *value++ = '\0';
+
+    size_t i = 0;
+    while (i < sizeof(s_fields) / sizeof(s_fields[0]) && strcmp(s_fields[i].key, token) != 0)
+      i++;
+    if (i == sizeof(s_fields) / sizeof(s_fields[0]))
+    {
+      *reason = "unknown key";
+      return false;
+    }
+    if (!parse_field(value, s_fields[i].type, (uint8_t *)&updated + s_fields[i].offset,
+                     (uint8_t *)&updated + s_fields[i].offset2))
+    {
+      *reason = "malformed value";
+      return false;
+    }
+  }
+
+  if (!csi_params_validate(&updated, reason))
+    return false;
+  csi_params_derive(&updated);
+  *params = updated;
+  return true;
+}
+
+/**
+ * @brief Write @p params as a command string ("thr=50 dthr=60 ...").
+ *
+ * @return Characters written, excluding the terminator, as snprintf() counts them.
+ */
+int csi_params_format(const csi_params_t *params, char *out, size_t out_len)
+{
+  int written = 0;
+  for (size_t i = 0; i < sizeof(s_fields) / sizeof(s_fields[0]); i++)
+  {
+    const uint8_t *field = (const uint8_t *)params + s_fields[i].offset;
+    size_t room = (size_t)written < out_len ? out_len - written : 0;
+    char *at = room ? out + written : NULL;
+    const char *sep = i ? " " : "";
+    switch (s_fields[i].type)
+    {
+    case FIELD_F32:
+      written += snprintf(at, room, "%s%s=%g", sep, s_fields[i].key, *(const float *)field);
+      break;
+    case FIELD_U8:
+      written += snprintf(at, room, "%s%s=%u", sep, s_fields[i].key, *field);
+      break;
+    case FIELD_U16:
+      written += snprintf(at, room, "%s%s=%u", sep, s_fields[i].key, *(const uint16_t *)field);
+      break;
+    case FIELD_U32:
+      written += snprintf(at, room, "%s%s=%lu", sep, s_fields[i].key, (unsigned long)*(const uint32_t *)field);
+      break;
+    case FIELD_RATIO:
+      written += snprintf(at, room, "%s%s=%u/%u", sep, s_fields[i].key, *field,
+                          *((const uint8_t *)params + s_fields[i].offset2));
+      break;
+    }
+  }
+  return written;
+}
+
+void csi_params_exchange_init(csi_params_exchange_t *exchange, const csi_params_t *initial)
+{
+  exchange->slots[0] = *initial;
+  exchange->slots[0].generation = 0;
+  atomic_init(&exchange->active, &exchange->slots[0]);
+  atomic_init(&exchange->acquired, 0);
+}
+
+/**
+ * @brief Writer side: install @p params as the next generation.
+ *
+ * @return false while the reader has not yet acquired the current set, because
+ *         it may still be reading the slot that would be overwritten. Retry later.
+ */
+bool csi_params_publish(csi_params_exchange_t *exchange, const csi_params_t *params)
+{
+  const csi_params_t *current = atomic_load_explicit(&exchange->active, memory_order_relaxed);
+  if (atomic_load_explicit(&exchange->acquired, memory_order_acquire) != current->generation)
+    return false;
+
+  csi_params_t *spare = &exchange->slots[current == &exchange->slots[0] ? 1 : 0];
+  *spare = *params;
+  spare->generation = current->generation + 1;
+  atomic_store_explicit(&exchange->active, spare, memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Reader side: the newest set. Valid until the reader's next call.
+ */
+const csi_params_t *csi_params_acquire(csi_params_exchange_t *exchange)
+{
+  const csi_params_t *params = atomic_load_explicit(&exchange->active, memory_order_acquire);
+  atomic_store_explicit(&exchange->acquired, params->generation, memory_order_release);
+  return params;
+}
+
+#ifdef ESP_PLATFORM
+/**
+ * @brief Read the stored set. Fails if none is stored or it is from another version.
+ */
+esp_err_t csi_params_load(csi_params_t *params)
+{
+  nvs_handle_t handle;
+  esp_err_t err = nvs_open(CSI_PARAMS_NVS_NAMESPACE, NVS_READONLY, &handle);
+  if (err != ESP_OK)
+    return err;
+
+  csi_params_t stored;
+  size_t size = sizeof(stored);
+  err = nvs_get_blob(handle, CSI_PARAMS_NVS_KEY, &stored, &size);
+  nvs_close(handle);
+  if (err != ESP_OK)
+    return err;
+  if (size != sizeof(stored) || stored.version != CSI_PARAMS_VERSION || !csi_params_validate(&stored, NULL))
+    return ESP_ERR_INVALID_VERSION;
+
+  csi_params_derive(&stored);
+  *params = stored;
+  return ESP_OK;
+}
+
+esp_err_t csi_params_save(const csi_params_t *params)
+{
+  nvs_handle_t handle;
+  esp_err_t err = nvs_open(CSI_PARAMS_NVS_NAMESPACE, NVS_READWRITE, &handle);
+  if (err != ESP_OK)
+    return err;
+  err = nvs_set_blob(handle, CSI_PARAMS_NVS_KEY, params, sizeof(*params));
+  if (err == ESP_OK)
+    err = nvs_commit(handle);
+  nvs_close(handle);
+  return err;
+}
+#endif
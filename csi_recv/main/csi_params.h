@@ -0,0 +1,111 @@
+#ifndef CSI_PARAMS_H
+#define CSI_PARAMS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#ifdef ESP_PLATFORM
+#include "esp_err.h"
+#endif
+
+// Bump when csi_params_t changes; NVS blobs of another version are ignored
+#define CSI_PARAMS_VERSION 2
+// Longest history the motion vote can look back over
+#define CSI_PARAMS_MAX_VOTES 8
+// Longest variance window accepted, in csi_q samples (csi_q keeps at least CSI_FIFO_LENGTH)
+#define CSI_PARAMS_MAX_WINDOW 100
+// Longest command accepted on the command topic
+#define CSI_PARAMS_MAX_COMMAND 256
+
+// Bits of the "est" mask: the breathing estimators, in the slot order app_main.c registers
+// them in its ensemble. Host tools that pick a subset translate their own slots to these.
+enum
+{
+  CSI_EST_SVM,
+  CSI_EST_SPECTRAL, /**< Sliding DFT of the decimated series */
+  CSI_EST_PEAK,
+  CSI_EST_FFT,
+  CSI_EST_NN,
+  CSI_EST_CNN,
+  CSI_EST_COUNT
+};
+// Their names in the ensemble, indexed by bit
+#define CSI_EST_NAMES {"svm", "spectral", "peak", "fft", "nn", "cnn"}
+
+/**
+ * @brief Detector tuning that can change at runtime.
+ *
+ * The first block is what a command sets and NVS stores. The Q-format block is
+ * derived from it by csi_params_derive() before a set is published, so the
+ * fixed-point detector never converts on the hot path.
+ */
+typedef struct
+{
+  uint16_t version;
+  // motion_detection()
+  float base_threshold;      /**< Lower bound of the variance threshold */
+  float diff_base_threshold; /**< Lower bound of the diff-energy threshold */
+  float std_factor;          /**< Variance threshold per unit of signal std */
+  float diff_std_factor;     /**< Diff-energy threshold per unit of signal std */
+  float variance_strong;     /**< Variance alone detects above threshold * this */
+  float diff_strong;         /**< Diff energy alone detects above diff threshold * this */
+  float score_span;          /**< A score reaches 100 at threshold * this */
+  float strong_amplitude;    /**< Amplitude counted twice by the state machine */
+  float instant_amplitude;   /**< Amplitude that detects without waiting for the state machine */
+  uint16_t window;           /**< Variance window, samples */
+  uint8_t alpha_num;         /**< Smoothing factor alpha_num / alpha_den */
+  uint8_t alpha_den;
+  uint8_t vote_window;       /**< Recent decisions in the vote */
+  uint8_t vote_min;          /**< Of which this many must be positive */
+  uint8_t continuous_min;    /**< Accumulated evidence that confirms motion */
+  uint8_t continuous_max;    /**< Cap on the accumulated evidence */
+  // mqtt_send()
+  uint32_t send_interval_ms; /**< Minimum time between two results of one session */
+  // breathing_rate_estimation()
+  uint8_t estimators;        /**< Mask of the breathing estimators fused, CSI_EST_* bits */
+  // Derived: thresholds in Q8, factors in Q15
+  struct
+  {
+    int32_t base_threshold;
+    int32_t diff_base_threshold;
+    int32_t std_factor;
+    int32_t diff_std_factor;
+    int32_t variance_strong;
+    int32_t diff_strong;
+    int32_t score_span;
+  } q;
+  uint32_t generation; /**< Set by csi_params_publish() */
+} csi_params_t;
+
+/**
+ * @brief Double-buffered parameter set shared by one writer and one reader.
+ *
+ * The writer fills the spare slot and swaps the active pointer; the reader
+ * loads it with csi_params_acquire() and never takes a lock. A slot is reused
+ * only after the reader has acquired the set that replaced it, so the reader
+ * may use the returned pointer until its next csi_params_acquire().
+ */
+typedef struct
+{
+  csi_params_t slots[2];
+  _Atomic(const csi_params_t *) active;
+  atomic_uint_fast32_t acquired; /**< Generation the reader last acquired */
+} csi_params_exchange_t;
+
+void csi_params_defaults(csi_params_t *params);
+bool csi_params_validate(const csi_params_t *params, const char **reason);
+void csi_params_derive(csi_params_t *params);
+bool csi_params_parse(const char *command, size_t len, csi_params_t *params, const char **reason);
+int csi_params_format(const csi_params_t *params, char *out, size_t out_len);
+
+void csi_params_exchange_init(csi_params_exchange_t *exchange, const csi_params_t *initial);
+bool csi_params_publish(csi_params_exchange_t *exchange, const csi_params_t *params);
+const csi_params_t *csi_params_acquire(csi_params_exchange_t *exchange);
+
+#ifdef ESP_PLATFORM
+esp_err_t csi_params_load(csi_params_t *params);
+esp_err_t csi_params_save(const csi_params_t *params);
+#endif
+
+#endif // CSI_PARAMS_H
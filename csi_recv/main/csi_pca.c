@@ -0,0 +1,166 @@
+#include <string.h>
+#include "csi_pca.h"
+#include "csi_fixed.h"
+
+// 1/sqrt(CSI_PCA_SUBCARRIERS) in Q15, the weight a subcarrier enters the eigenvector with
+#define CSI_PCA_UNIFORM_Q15 11585
+
+_Static_assert(CSI_PCA_SUBCARRIERS == 8, "CSI_PCA_UNIFORM_Q15 assumes 8 kept subcarriers");
+_Static_assert(CSI_PCA_FAST_SHIFT >= 1 && CSI_PCA_SLOW_SHIFT > CSI_PCA_FAST_SHIFT && CSI_PCA_SLOW_SHIFT < 10,
+               "CSI_PCA_ROW_RATE_HZ and the band edges give no usable EMA shifts");
+
+void csi_pca_init(csi_pca_t *pca)
+{
+  memset(pca, 0, sizeof(*pca));
+}
+
+// Restart the covariance row/column of slot k from the subcarrier's band variance alone
+static void reset_slot(csi_pca_t *pca, int k)
+{
+  for (int j = 0; j < CSI_PCA_SUBCARRIERS; j++)
+  {
+    pca->cov[k][j] = 0;
+    pca->cov[j][k] = 0;
+  }
+  uint32_t var = pca->band_var[pca->selected[k]];
+  pca->cov[k][k] = var > INT32_MAX ? INT32_MAX : (int32_t)var;
+  pca->weights[k] = CSI_PCA_UNIFORM_Q15;
+}
+
+static void normalize_weights(csi_pca_t *pca)
+{
+  uint64_t norm_sq = 0;
+  for (int k = 0; k < CSI_PCA_SUBCARRIERS; k++)
+    norm_sq += (int64_t)pca->weights[k] * pca->weights[k];
+  uint32_t norm = csi_isqrt64(norm_sq);
+  for (int k = 0; k < CSI_PCA_SUBCARRIERS; k++)
+    pca->weights[k] = norm ? (int32_t)(((int64_t)pca->weights[k] << 15) / norm) : CSI_PCA_UNIFORM_Q15;
+}
+
+/**
+ * Swap the weakest kept subcarrier for the strongest other one while the
+ * candidate beats it by the hysteresis margin. On the first ranking nothing is
+ * kept yet, so every slot is filled from the strongest down.
+ */
+static void rank_subcarriers(csi_pca_t *pca, bool first)
+{
+  bool kept[CSI_MATRIX_MAX_SUBCARRIERS] = {false};
+  if (!first)
+  {
+    for (int k = 0; k < CSI_PCA_SUBCARRIERS; k++)
+      kept[pca->selected[k]] = true;
+  }
+
+  for (int round = 0; round < CSI_PCA_SUBCARRIERS; round++)
+  {
+    int slot = first ? round : 0;
+    if (!first)
+    {
+      for (int k = 1; k < CSI_PCA_SUBCARRIERS; k++)
+      {
+        if (pca->band_var[pca->selected[k]] < pca->band_var[pca->selected[slot]])
+          slot = k;
+      }
+    }
+
+    int best = -1;
+    for (int col = 0; col < pca->subcarriers; col++)
+    {
+      if (!kept[col] && (best < 0 || pca->band_var[col] > pca->band_var[best]))
+        best = col;
+    }
+    if (best < 0)
+      break;
+    if (!first && (uint64_t)pca->band_var[best] * 4 <=
+                      (uint64_t)pca->band_var[pca->selected[slot]] * CSI_PCA_RANK_HYSTERESIS_QUARTERS)
+      break;
+
+    if (!first)
+    {
+      kept[pca->selected[slot]] = false;
+      pca->swaps++;
+    }
+    kept[best] = true;
+    pca->selected[slot] = (uint8_t)best;
+    reset_slot(pca, slot);
+  }
+  normalize_weights(pca);
+}
+
+/**
+ * @brief Fold the matrix's newest row in and produce this packet's component sample.
+ *
+ * Call once after every successful csi_matrix_push(). A change of matrix width
+ * restarts the state.
+ *
+ * @param[out] sample Band-passed amplitude along the principal component, in matrix amplitude units.
+ * @return false until the first ranking, CSI_PCA_RANK_INTERVAL packets after a (re)start.
+ */
+bool csi_pca_update(csi_pca_t *pca, const csi_matrix_t *matrix, int16_t *sample)
+{
+  if (matrix->subcarriers != pca->subcarriers || matrix->rows_written == 0)
+  {
+    csi_pca_init(pca);
+    pca->subcarriers = matrix->subcarriers;
+  }
+
+  int32_t band[CSI_MATRIX_MAX_SUBCARRIERS];
+  for (int col = 0; col < pca->subcarriers; col++)
+  {
+    int32_t amp = (int32_t)csi_matrix_amp_series(matrix, col, 1)[0] << 8;
+    if (pca->packets == 0)
+    {
+      pca->fast[col] = amp;
+      pca->slow[col] = amp;
+    }
+    pca->fast[col] += (amp - pca->fast[col]) >> CSI_PCA_FAST_SHIFT;
+    pca->slow[col] += (amp - pca->slow[col]) >> CSI_PCA_SLOW_SHIFT;
+    band[col] = (pca->fast[col] - pca->slow[col]) >> 8;
+    int32_t power = band[col] * band[col];
+    pca->band_var[col] += (power - (int32_t)pca->band_var[col]) >> CSI_PCA_VAR_SHIFT;
+  }
+
+  pca->packets++;
+  if (pca->packets < CSI_PCA_RANK_INTERVAL)
+    return false;
+  if (pca->packets % CSI_PCA_RANK_INTERVAL == 0)
+    rank_subcarriers(pca, pca->packets == CSI_PCA_RANK_INTERVAL);
+
+  int32_t y[CSI_PCA_SUBCARRIERS];
+  for (int k = 0; k < CSI_PCA_SUBCARRIERS; k++)
+    y[k] = band[pca->selected[k]];
+  for (int i = 0; i < CSI_PCA_SUBCARRIERS; i++)
+  {
+    for (int j = i; j < CSI_PCA_SUBCARRIERS; j++)
+    {
+      pca->cov[i][j] += (y[i] * y[j] - pca->cov[i][j]) >> CSI_PCA_COV_SHIFT;
+      pca->cov[j][i] = pca->cov[i][j];
+    }
+  }
+
+  // One power-iteration step: weights <- cov * weights / |cov * weights|.
+  // cov is positive semi-definite, so the direction never flips sign between steps.
+  int64_t v[CSI_PCA_SUBCARRIERS];
+  uint64_t norm_sq = 0;
+  for (int i = 0; i < CSI_PCA_SUBCARRIERS; i++)
+  {
+    int64_t acc = 0;
+    for (int j = 0; j < CSI_PCA_SUBCARRIERS; j++)
+      acc += (int64_t)pca->cov[i][j] * pca->weights[j];
+    v[i] = acc >> 15;
+    norm_sq += (uint64_t)(v[i] * v[i]);
+  }
+  uint32_t norm = csi_isqrt64(norm_sq);
+  if (norm > 0)
+  {
+    for (int i = 0; i < CSI_PCA_SUBCARRIERS; i++)
+      pca->weights[i] = (int32_t)((v[i] << 15) / norm);
+    pca->eigenvalue = norm;
+  }
+
+  int64_t projection = 0;
+  for (int k = 0; k < CSI_PCA_SUBCARRIERS; k++)
+    projection += (int64_t)pca->weights[k] * y[k];
+  *sample = csi_sat16((int32_t)(projection >> 15));
+  return true;
+}
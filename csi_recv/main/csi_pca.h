@@ -0,0 +1,73 @@
+#ifndef CSI_PCA_H
+#define CSI_PCA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "csi_matrix.h"
+
+// Subcarriers kept for the principal component, the highest band-limited variance ones
+#define CSI_PCA_SUBCARRIERS 8
+// Packets between two re-rankings of the subcarriers; no output before the first one
+#define CSI_PCA_RANK_INTERVAL 100
+// A candidate replaces a kept subcarrier only with this much more band variance (x/4, i.e. 25%)
+#define CSI_PCA_RANK_HYSTERESIS_QUARTERS 5
+// Rows per second csi_pca_update() sees: one per packet, at csi_send's CONFIG_SEND_FREQUENCY
+#define CSI_PCA_ROW_RATE_HZ 80
+// Band-pass per subcarrier, as the difference of two EMAs: ema += (x - ema) >> shift.
+// Band edges in mHz, breathing and body motion
+#define CSI_PCA_BAND_LOW_MHZ 100
+#define CSI_PCA_BAND_HIGH_MHZ 3000
+// An EMA with shift s has its corner near rate / (2 pi 2^s), so each shift is log2(rate / (2 pi corner))
+// rounded to the nearest integer (x 181/128, about sqrt 2, then floor); 80 rows/s gives shifts 2 and 7
+#define CSI_PCA_ILOG2(x) (((x) >= 2) + ((x) >= 4) + ((x) >= 8) + ((x) >= 16) + ((x) >= 32) + ((x) >= 64) + \
+                          ((x) >= 128) + ((x) >= 256) + ((x) >= 512) + ((x) >= 1024))
+#define CSI_PCA_EMA_SHIFT(corner_mhz) \
+  CSI_PCA_ILOG2(CSI_PCA_ROW_RATE_HZ * 1000000LL / (6283LL * (corner_mhz)) * 181 / 128)
+#define CSI_PCA_FAST_SHIFT CSI_PCA_EMA_SHIFT(CSI_PCA_BAND_HIGH_MHZ)
+#define CSI_PCA_SLOW_SHIFT CSI_PCA_EMA_SHIFT(CSI_PCA_BAND_LOW_MHZ)
+// Smoothing of the band variances and of the covariance of the kept subcarriers
+#define CSI_PCA_VAR_SHIFT 6
+#define CSI_PCA_COV_SHIFT 6
+
+/**
+ * @brief Streaming subcarrier selection and first principal component.
+ *
+ * Every subcarrier's amplitude from the csi_matrix_t is band-passed and its
+ * band power tracked, which ranks the subcarriers. The CSI_PCA_SUBCARRIERS
+ * strongest ones feed a running covariance. One power-iteration step per packet
+ * then updates the leading eigenvector, so the direction follows the channel
+ * without ever running an SVD. The output is one sample per packet: the
+ * band-passed amplitudes projected on that eigenvector.
+ *
+ * Integer only. Amplitudes stay in the matrix format (|H| * 2^CSI_AMP_FRAC_BITS),
+ * EMA states carry 8 more fraction bits, and the eigenvector is Q15.
+ */
+typedef struct
+{
+  int32_t fast[CSI_MATRIX_MAX_SUBCARRIERS];      /**< Fast EMA of the amplitude, 8 extra fraction bits */
+  int32_t slow[CSI_MATRIX_MAX_SUBCARRIERS];      /**< Slow EMA (the DC level), same format */
+  uint32_t band_var[CSI_MATRIX_MAX_SUBCARRIERS]; /**< EMA of the squared band-passed amplitude */
+  uint8_t selected[CSI_PCA_SUBCARRIERS];         /**< Kept subcarrier columns */
+  int32_t cov[CSI_PCA_SUBCARRIERS][CSI_PCA_SUBCARRIERS];
+  int32_t weights[CSI_PCA_SUBCARRIERS];          /**< Leading eigenvector, Q15, unit length */
+  uint32_t eigenvalue;                           /**< |cov * weights|, the band power along it */
+  uint16_t subcarriers;                          /**< Matrix width the state was built for */
+  uint32_t packets;                              /**< Rows seen since the last reset */
+  uint32_t swaps;                                /**< Subcarriers replaced by re-ranking */
+} csi_pca_t;
+
+void csi_pca_init(csi_pca_t *pca);
+bool csi_pca_update(csi_pca_t *pca, const csi_matrix_t *matrix, int16_t *sample);
+
+/**
+ * @brief Share of the kept subcarriers' band power along the principal component, in percent.
+ */
+static inline int csi_pca_explained_pct(const csi_pca_t *pca)
+{
+  uint64_t trace = 0;
+  for (int i = 0; i < CSI_PCA_SUBCARRIERS; i++)
+    trace += (uint32_t)pca->cov[i][i];
+  return trace ? (int)((uint64_t)pca->eigenvalue * 100 / trace) : 0;
+}
+
+#endif // CSI_PCA_H
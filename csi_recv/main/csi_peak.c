@@ -0,0 +1,178 @@
+#include <string.h>
+#include "csi_peak.h"
+#include "csi_fixed.h"
+
+/**
+ * @brief Configure the estimator and clear its state.
+ *
+ * @param rate_hz Input sample rate.
+ * @param window Counting window, samples; also bounds the running mean and variance.
+ * @param smooth Moving-average length, 1..CSI_PEAK_MAX_SMOOTH samples.
+ * @param neighbours Samples a peak must top on each side, 1..CSI_PEAK_MAX_NEIGHBOURS.
+ * @param min_distance A peak at most this many samples after the previous one is ignored.
+ * @return false if a parameter is out of range.
+ */
+bool csi_peak_init(csi_peak_t *peak, uint16_t rate_hz, uint16_t window, uint8_t smooth, uint8_t neighbours,
+                   uint16_t min_distance)
+{
+  memset(peak, 0, sizeof(*peak));
+  if (rate_hz == 0 || window == 0 || smooth == 0 || smooth > CSI_PEAK_MAX_SMOOTH ||
+      neighbours == 0 || neighbours > CSI_PEAK_MAX_NEIGHBOURS)
+    return false;
+  peak->rate_hz = rate_hz;
+  peak->window = window;
+  peak->smooth = smooth;
+  peak->neighbours = neighbours;
+  peak->min_distance = min_distance;
+  return true;
+}
+
+/**
+ * @brief Forget the signal, e.g. across a gap, keeping the configuration.
+ */
+void csi_peak_reset(csi_peak_t *peak)
+{
+  csi_peak_t config = *peak;
+  csi_peak_init(peak, config.rate_hz, config.window, config.smooth, config.neighbours, config.min_distance);
+}
+
+static void add_peak(csi_peak_t *peak, uint32_t index)
+{
+  if (peak->peak_count == CSI_PEAK_MAX_PEAKS)
+  {
+    memmove(peak->peaks, peak->peaks + 1, (CSI_PEAK_MAX_PEAKS - 1) * sizeof(peak->peaks[0]));
+    peak->peak_count--;
+  }
+  peak->peaks[peak->peak_count++] = index;
+  peak->last_peak = index;
+  peak->total_peaks++;
+}
+
+/**
+ * @brief Feed one sample.
+ *
+ * @return true if it confirmed a peak (smooth / 2 + neighbours samples back).
+ */
+bool csi_peak_push(csi_peak_t *peak, int32_t in)
+{
+  int slot = peak->count % peak->smooth;
+  if (peak->count >= peak->smooth)
+    peak->raw_sum -= peak->raw[slot];
+  peak->raw[slot] = in;
+  peak->raw_sum += in;
+  peak->count++;
+  if (peak->count < peak->smooth)
+    return false;
+
+  // The moving sum rather than the average: same shape, and no rounding to flatten a slow crest
+  int32_t smoothed = (int32_t)peak->raw_sum;
+  int64_t value_q8 = (int64_t)smoothed << 8;
+  uint32_t n = ++peak->smoothed_count;
+  if (n == 1)
+  {
+    peak->mean_q8 = value_q8;
+  }
+  else
+  {
+    int64_t div = n < peak->window ? n : peak->window;
+    int64_t dev = value_q8 - peak->mean_q8;
+    peak->mean_q8 += dev / div;
+    peak->var_q16 += (dev * dev - peak->var_q16) / div;
+  }
+
+  int span = 2 * peak->neighbours + 1;
+  peak->smoothed[(n - 1) % span] = smoothed;
+  if (n < (uint32_t)span)
+    return false;
+
+  // The candidate is the middle of the ring, neighbours samples back
+  uint32_t index = n - 1 - peak->neighbours;
+  int32_t candidate = peak->smoothed[index % span];
+  for (int i = 0; i < span; i++)
+  {
+    if (i != (int)(index % span) && peak->smoothed[i] >= candidate)
+      return false;
+  }
+
+  int64_t rise_q8 = ((int64_t)candidate << 8) - peak->mean_q8;
+  int64_t threshold_q8 = ((int64_t)CSI_PEAK_THRESHOLD_Q8 * csi_isqrt64((uint64_t)peak->var_q16)) >> 8;
+  if (rise_q8 <= threshold_q8)
+    return false;
+  if (peak->total_peaks > 0 && index - peak->last_peak <= peak->min_distance)
+    return false;
+  add_peak(peak, index);
+  return true;
+}
+
+/**
+ * @brief Current rate, averaged over the last CSI_PEAK_HISTORY calls; call once per reporting step.
+ *
+ * A window without peaks counts as no estimate. An implausible count keeps the
+ * last plausible estimate, or is clamped into range if there is none yet.
+ *
+ * @return Breaths per minute, 0 before CSI_PEAK_MIN_SECONDS of input or while no estimate exists.
+ */
+int csi_peak_estimate(csi_peak_t *peak)
+{
+  if (peak->count < (uint32_t)peak->rate_hz * CSI_PEAK_MIN_SECONDS)
+    return 0;
+
+  int expired = 0;
+  while (expired < peak->peak_count && peak->peaks[expired] + peak->window <= peak->smoothed_count)
+    expired++;
+  if (expired > 0)
+  {
+    memmove(peak->peaks, peak->peaks + expired, (peak->peak_count - expired) * sizeof(peak->peaks[0]));
+    peak->peak_count -= expired;
+  }
+
+  uint32_t span = peak->smoothed_count < peak->window ? peak->smoothed_count : peak->window;
+  int bpm = 0;
+  if (peak->peak_count > 0 && span > 0)
+  {
+    bpm = (int)(((uint64_t)peak->peak_count * 120 * peak->rate_hz + span) / (2 * (uint64_t)span));
+    if (bpm >= CSI_PEAK_MIN_BPM && bpm <= CSI_PEAK_MAX_BPM)
+      peak->last_plausible = bpm;
+    else if (peak->last_plausible)
+      bpm = peak->last_plausible;
+    else
+      bpm = bpm < CSI_PEAK_MIN_BPM ? CSI_PEAK_MIN_BPM : CSI_PEAK_MAX_BPM;
+  }
+
+  peak->history[peak->history_index] = bpm;
+  peak->history_index = (peak->history_index + 1) % CSI_PEAK_HISTORY;
+  int sum = 0, valid = 0;
+  for (int i = 0; i < CSI_PEAK_HISTORY; i++)
+  {
+    if (peak->history[i] > 0)
+    {
+      sum += peak->history[i];
+      valid++;
+    }
+  }
+  return valid ? sum / valid : 0;
+}
+
+/**
+ * @brief How regular the peaks in the window are, as a confidence for the rate.
+ *
+ * 256 when the intervals between them are all equal, falling to 0 as their
+ * standard deviation reaches half their mean. Needs three peaks in the window.
+ */
+uint16_t csi_peak_confidence_q8(const csi_peak_t *peak)
+{
+  int intervals = peak->peak_count - 1;
+  if (intervals < 2)
+    return 0;
+  int64_t sum = 0, sum_sq = 0;
+  for (int i = 1; i <= intervals; i++)
+  {
+    int64_t interval = peak->peaks[i] - peak->peaks[i - 1];
+    sum += interval;
+    sum_sq += interval * interval;
+  }
+  // std / mean = sqrt(n * sum_sq - sum^2) / sum
+  uint32_t spread = csi_isqrt64((uint64_t)(intervals * sum_sq - sum * sum));
+  int64_t penalty = ((int64_t)spread * 512) / sum;
+  return penalty >= 256 ? 0 : (uint16_t)(256 - penalty);
+}
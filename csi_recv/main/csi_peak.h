@@ -0,0 +1,67 @@
+#ifndef CSI_PEAK_H
+#define CSI_PEAK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Longest moving-average smoother, samples
+#define CSI_PEAK_MAX_SMOOTH 32
+// Widest neighbourhood a peak must top on each side
+#define CSI_PEAK_MAX_NEIGHBOURS 4
+// Peaks remembered inside the counting window; more than a window can hold at any sane rate
+#define CSI_PEAK_MAX_PEAKS 32
+// A peak must stand this far above the running mean, in running standard deviations (Q8, 0.5)
+#define CSI_PEAK_THRESHOLD_Q8 128
+// Nothing is reported before this much signal
+#define CSI_PEAK_MIN_SECONDS 10
+// Plausible breathing range; an estimate outside it keeps the last plausible one
+#define CSI_PEAK_MIN_BPM 8
+#define CSI_PEAK_MAX_BPM 25
+// Estimates averaged into the reported rate
+#define CSI_PEAK_HISTORY 3
+
+/**
+ * @brief Online peak-counting breathing rate estimator.
+ *
+ * Every input costs O(1): a running-sum moving average smooths it, the smoothed
+ * sample neighbours samples back is declared a peak if it tops all neighbours
+ * on both sides, rises above the running mean by CSI_PEAK_THRESHOLD_Q8 standard
+ * deviations and comes more than min_distance after the previous peak. The rate
+ * is the number of peaks in the last window samples. The running mean and
+ * variance are exponential, averaged over up to window samples, so nothing but
+ * the smoother and the neighbourhood is stored.
+ *
+ * Integer only; samples are int32 in any fixed-point format, within +-2^18 so
+ * the variance of the moving sums cannot overflow.
+ */
+typedef struct
+{
+  uint16_t rate_hz;
+  uint16_t window;       /**< Counting window, samples */
+  uint8_t smooth;        /**< Moving-average length, samples */
+  uint8_t neighbours;    /**< Samples a peak must top on each side */
+  uint16_t min_distance; /**< A peak must come more than this many samples after the previous one */
+  int32_t raw[CSI_PEAK_MAX_SMOOTH];
+  int64_t raw_sum;
+  int32_t smoothed[2 * CSI_PEAK_MAX_NEIGHBOURS + 1]; /**< Ring of the latest moving sums */
+  int64_t mean_q8;       /**< Running mean of the moving sums, 8 extra fraction bits */
+  int64_t var_q16;       /**< Running variance, 16 extra fraction bits */
+  uint32_t peaks[CSI_PEAK_MAX_PEAKS]; /**< Smoothed sample index of each peak in the window, oldest first */
+  int peak_count;
+  uint32_t last_peak;    /**< Index of the latest peak; valid once total_peaks > 0 */
+  uint32_t total_peaks;
+  uint32_t count;        /**< Samples pushed since the last reset */
+  uint32_t smoothed_count; /**< Smoothed samples produced */
+  int last_plausible;    /**< Last estimate inside CSI_PEAK_MIN_BPM..CSI_PEAK_MAX_BPM, 0 if none */
+  int history[CSI_PEAK_HISTORY];
+  int history_index;
+} csi_peak_t;
+
+bool csi_peak_init(csi_peak_t *peak, uint16_t rate_hz, uint16_t window, uint8_t smooth, uint8_t neighbours,
+                   uint16_t min_distance);
+void csi_peak_reset(csi_peak_t *peak);
+bool csi_peak_push(csi_peak_t *peak, int32_t in);
+int csi_peak_estimate(csi_peak_t *peak);
+uint16_t csi_peak_confidence_q8(const csi_peak_t *peak);
+
+#endif // CSI_PEAK_H
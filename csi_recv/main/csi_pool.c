@@ -0,0 +1,72 @@
+#include <string.h>
+#include "csi_pool.h"
+
+_Static_assert(CSI_POOL_SIZE > 0 && CSI_POOL_SIZE <= 32, "CSI_POOL_SIZE must fit in the 32-bit free mask");
+
+#define CSI_POOL_ALL_FREE (CSI_POOL_SIZE == 32 ? 0xFFFFFFFFu : ((1u << CSI_POOL_SIZE) - 1u))
+
+void csi_pool_init(csi_pool_t *pool)
+{
+  memset(pool, 0, sizeof(*pool));
+  for (int i = 0; i < CSI_POOL_SIZE; i++)
+    atomic_init(&pool->slots[i].refcount, 0);
+  atomic_init(&pool->free_mask, CSI_POOL_ALL_FREE);
+  atomic_init(&pool->alloc_failed, 0);
+  atomic_init(&pool->high_water, 0);
+}
+
+/**
+ * @brief Take a free slot with a reference count of one, or NULL if every slot is in use.
+ *
+ * Lock-free and safe from any task; the caller owns the returned reference.
+ */
+csi_frame_t *csi_pool_alloc(csi_pool_t *pool)
+{
+  uint32_t mask = atomic_load_explicit(&pool->free_mask, memory_order_acquire);
+  int index;
+  do
+  {
+    if (mask == 0)
+    {
+      atomic_fetch_add_explicit(&pool->alloc_failed, 1, memory_order_relaxed);
+      return NULL;
+    }
+    index = __builtin_ctz(mask);
+  } while (!atomic_compare_exchange_weak_explicit(&pool->free_mask, &mask, mask & ~(1u << index),
+                                                  memory_order_acquire, memory_order_acquire));
+
+  uint32_t in_use = CSI_POOL_SIZE - __builtin_popcount(mask & ~(1u << index));
+  uint32_t high_water = atomic_load_explicit(&pool->high_water, memory_order_relaxed);
+  while (in_use > high_water &&
+         !atomic_compare_exchange_weak_explicit(&pool->high_water, &high_water, in_use,
+                                                memory_order_relaxed, memory_order_relaxed))
+    ;
+
+  csi_frame_t *frame = &pool->slots[index];
+  atomic_store_explicit(&frame->refcount, 1, memory_order_relaxed);
+  return frame;
+}
+
+void csi_frame_retain(csi_frame_t *frame)
+{
+  atomic_fetch_add_explicit(&frame->refcount, 1, memory_order_relaxed);
+}
+
+/**
+ * @brief Drop one reference; the slot goes back to the pool when the last one is gone.
+ */
+void csi_pool_release(csi_pool_t *pool, csi_frame_t *frame)
+{
+  if (atomic_fetch_sub_explicit(&frame->refcount, 1, memory_order_acq_rel) != 1)
+    return;
+  int index = frame - pool->slots;
+  atomic_fetch_or_explicit(&pool->free_mask, 1u << index, memory_order_release);
+}
+
+void csi_pool_get_stats(csi_pool_t *pool, csi_pool_stats_t *stats)
+{
+  uint32_t mask = atomic_load_explicit(&pool->free_mask, memory_order_relaxed);
+  stats->alloc_failed = atomic_load_explicit(&pool->alloc_failed, memory_order_relaxed);
+  stats->in_use = CSI_POOL_SIZE - __builtin_popcount(mask);
+  stats->high_water = atomic_load_explicit(&pool->high_water, memory_order_relaxed);
+}
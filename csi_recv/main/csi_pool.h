@@ -0,0 +1,74 @@
+#ifndef CSI_POOL_H
+#define CSI_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Largest CSI payload the receiver can be handed: HT40 with LLTF + HT-LTF + STBC HT-LTF.
+#define CSI_FRAME_MAX_LEN 612
+// Number of preallocated frame slots. At most 32 (one bit per slot in the free mask).
+#define CSI_POOL_SIZE 32
+
+/**
+ * @brief The part of wifi_csi_info_t / rx_ctrl the processing stages need.
+ *
+ * Kept free of ESP-IDF types so the pool also builds on the host.
+ */
+typedef struct
+{
+  uint8_t mac[6];
+  int8_t rssi;
+  uint8_t rate;
+  uint8_t sig_mode; /**< rx_ctrl.sig_mode: 0 non-HT (11bg), 1 HT (11n), 3 VHT (11ac) */
+  uint8_t cwb;      /**< rx_ctrl.cwb: 0 20 MHz, 1 40 MHz */
+  uint8_t stbc;     /**< rx_ctrl.stbc: 0 non-STBC, otherwise STBC */
+  int8_t noise_floor;
+  uint8_t channel;
+  uint8_t fft_gain;
+  uint8_t agc_gain;
+  uint8_t gain_epoch; /**< csi_gain_t epoch the gains above were forced in, 0 before the first force */
+  uint32_t timestamp; /**< rx_ctrl.timestamp, microseconds */
+  uint16_t sig_len;
+  uint8_t rx_state;
+  bool first_word_invalid;
+  uint16_t len;    /**< Number of valid bytes in buf */
+  uint8_t session; /**< Transmitter session id from csi_session_lookup() */
+  uint32_t seq;    /**< Receiver packet counter, assigned in the rx callback */
+} csi_frame_meta_t;
+
+/**
+ * @brief One pool slot: the only copy of a packet's CSI made after the driver hands it over.
+ *
+ * Stages borrow the frame by pointer. A stage that keeps it past the call it was
+ * given in takes a reference with csi_frame_retain() and drops it with csi_pool_release().
+ */
+typedef struct
+{
+  csi_frame_meta_t meta;
+  _Atomic uint16_t refcount;
+  int8_t buf[CSI_FRAME_MAX_LEN] __attribute__((aligned(4)));
+} csi_frame_t;
+
+typedef struct
+{
+  uint32_t alloc_failed; /**< csi_pool_alloc() calls that found no free slot */
+  uint32_t in_use;       /**< Slots currently referenced */
+  uint32_t high_water;   /**< Most slots ever referenced at once */
+} csi_pool_stats_t;
+
+typedef struct
+{
+  csi_frame_t slots[CSI_POOL_SIZE];
+  _Atomic uint32_t free_mask; /**< Bit i set when slots[i] is free */
+  _Atomic uint32_t alloc_failed;
+  _Atomic uint32_t high_water;
+} csi_pool_t;
+
+void csi_pool_init(csi_pool_t *pool);
+csi_frame_t *csi_pool_alloc(csi_pool_t *pool);
+void csi_frame_retain(csi_frame_t *frame);
+void csi_pool_release(csi_pool_t *pool, csi_frame_t *frame);
+void csi_pool_get_stats(csi_pool_t *pool, csi_pool_stats_t *stats);
+
+#endif // CSI_POOL_H
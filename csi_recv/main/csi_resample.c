@@ -0,0 +1,117 @@
+#include <string.h>
+#include "csi_resample.h"
+
+void csi_resampler_init(csi_resampler_t *resampler, uint32_t rate_hz, csi_interp_t interp, uint32_t max_gap_us)
+{
+  memset(resampler, 0, sizeof(*resampler));
+  resampler->interp = interp;
+  resampler->period_us = 1000000 / rate_hz;
+  resampler->max_gap_us = max_gap_us;
+}
+
+static void emit(csi_resampler_t *resampler, float value, float *out, int max_out, int *n)
+{
+  // Grid points that do not fit in out are skipped rather than emitted late
+  if (*n < max_out)
+    out[(*n)++] = value;
+  resampler->stats.emitted++;
+  resampler->next += resampler->period_us;
+}
+
+static void emit_linear(csi_resampler_t *resampler, float *out, int max_out, int *n)
+{
+  int64_t t0 = resampler->t[resampler->count - 2], t1 = resampler->t[resampler->count - 1];
+  float v0 = resampler->v[resampler->count - 2], v1 = resampler->v[resampler->count - 1];
+  while (resampler->next <= t1)
+  {
+    float s = (float)(resampler->next - t0) / (float)(t1 - t0);
+    emit(resampler, v0 + s * (v1 - v0), out, max_out, n);
+  }
+}
+
+/**
+ * Cubic Hermite over [t[i1], t[i2]) with tangents from the neighbouring inputs.
+ * A missing left neighbour (at the start of a run) is replaced by t[i1] itself,
+ * which reduces that tangent to a one-sided difference.
+ */
+static void emit_cubic(csi_resampler_t *resampler, int i0, int i1, int i2, int i3,
+                       float *out, int max_out, int *n)
+{
+  const int64_t *t = resampler->t;
+  const float *v = resampler->v;
+  float h = (float)(t[i2] - t[i1]);
+  float m1 = (v[i2] - v[i0]) / (float)(t[i2] - t[i0]);
+  float m2 = (v[i3] - v[i1]) / (float)(t[i3] - t[i1]);
+  while (resampler->next < t[i2])
+  {
+    float s = (float)(resampler->next - t[i1]) / h;
+    float s2 = s * s, s3 = s2 * s;
+    float value = (2 * s3 - 3 * s2 + 1) * v[i1] + (s3 - 2 * s2 + s) * h * m1 +
+                  (-2 * s3 + 3 * s2) * v[i2] + (s3 - s2) * h * m2;
+    emit(resampler, value, out, max_out, n);
+  }
+}
+
+/**
+ * @brief Feed one input and write the grid samples it completes to @p out.
+ *
+ * @return Number of samples written. @p restarted (optional) is set when a gap
+ *         ended the previous run; the samples returned then all belong to the
+ *         new run, and downstream state should not bridge the gap.
+ */
+int csi_resampler_push(csi_resampler_t *resampler, uint32_t timestamp_us, float value,
+                       float *out, int max_out, bool *restarted)
+{
+  int n = 0;
+  if (restarted)
+    *restarted = false;
+
+  if (!resampler->started)
+  {
+    resampler->started = true;
+    resampler->now = timestamp_us;
+    resampler->next = resampler->now;
+  }
+  else
+  {
+    int32_t delta = (int32_t)(timestamp_us - resampler->last_raw);
+    if (delta <= 0)
+    {
+      resampler->stats.out_of_order++;
+      return 0;
+    }
+    resampler->now += delta;
+    if ((uint32_t)delta > resampler->max_gap_us)
+    {
+      resampler->stats.gaps++;
+      resampler->count = 0;
+      resampler->next = resampler->now;
+      if (restarted)
+        *restarted = true;
+    }
+  }
+  resampler->last_raw = timestamp_us;
+
+  if (resampler->count == 4)
+  {
+    memmove(resampler->t, resampler->t + 1, 3 * sizeof(resampler->t[0]));
+    memmove(resampler->v, resampler->v + 1, 3 * sizeof(resampler->v[0]));
+    resampler->count = 3;
+  }
+  resampler->t[resampler->count] = resampler->now;
+  resampler->v[resampler->count] = value;
+  resampler->count++;
+
+  int c = resampler->count;
+  if (resampler->interp == CSI_INTERP_LINEAR)
+  {
+    if (c >= 2)
+      emit_linear(resampler, out, max_out, &n);
+  }
+  else if (c >= 3)
+  {
+    // The newest input only supplies the right-hand tangent of the segment before it
+    emit_cubic(resampler, c >= 4 ? c - 4 : c - 3, c - 3, c - 2, c - 1, out, max_out, &n);
+  }
+  return n;
+}
@@ -0,0 +1,52 @@
+#ifndef CSI_RESAMPLE_H
+#define CSI_RESAMPLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Output rate of the resampler. Every stage downstream of it works on this grid.
+#define CSI_SAMPLE_RATE_HZ 20
+// Input gaps longer than this restart the grid instead of being interpolated across
+#define CSI_RESAMPLE_MAX_GAP_US 500000
+
+typedef enum
+{
+  CSI_INTERP_LINEAR,
+  CSI_INTERP_CUBIC, /**< Cubic Hermite with finite-difference tangents; one input of extra latency */
+} csi_interp_t;
+
+typedef struct
+{
+  uint32_t emitted;      /**< Grid samples produced */
+  uint32_t gaps;         /**< Grid restarts caused by gaps over max_gap_us */
+  uint32_t out_of_order; /**< Inputs dropped for a non-increasing timestamp */
+} csi_resampler_stats_t;
+
+/**
+ * @brief Streaming resampler from packet arrival times onto a fixed-rate grid.
+ *
+ * Inputs carry rx_ctrl.timestamp (32-bit microseconds, wrap-around handled).
+ * Each grid point is interpolated from the inputs around it, so jitter and
+ * isolated drops are absorbed; a gap longer than max_gap_us is not bridged and
+ * the grid restarts at the next input, which push() reports through @p restarted.
+ */
+typedef struct
+{
+  csi_interp_t interp;
+  uint32_t period_us;
+  uint32_t max_gap_us;
+  int64_t t[4];   /**< Last inputs on the unwrapped time axis, oldest first */
+  float v[4];
+  int count;      /**< Valid entries in t/v */
+  bool started;
+  uint32_t last_raw;
+  int64_t now;    /**< Unwrapped time of the latest input */
+  int64_t next;   /**< Unwrapped time of the next grid point */
+  csi_resampler_stats_t stats;
+} csi_resampler_t;
+
+void csi_resampler_init(csi_resampler_t *resampler, uint32_t rate_hz, csi_interp_t interp, uint32_t max_gap_us);
+int csi_resampler_push(csi_resampler_t *resampler, uint32_t timestamp_us, float value,
+                       float *out, int max_out, bool *restarted);
+
+#endif // CSI_RESAMPLE_H
@@ -0,0 +1,81 @@
+#include <string.h>
+#include "csi_ring.h"
+
+#define CSI_RING_MASK (CSI_RING_CAPACITY - 1)
+
+_Static_assert((CSI_RING_CAPACITY & CSI_RING_MASK) == 0, "CSI_RING_CAPACITY must be a power of two");
+
+void csi_ring_init(csi_ring_t *ring)
+{
+  memset(ring, 0, sizeof(*ring));
+  atomic_init(&ring->head, 0);
+  atomic_init(&ring->tail, 0);
+  atomic_init(&ring->pushed, 0);
+  atomic_init(&ring->dropped_full, 0);
+  atomic_init(&ring->dropped_oversize, 0);
+  atomic_init(&ring->high_water, 0);
+}
+
+/**
+ * @brief Queue a frame for the consumer.
+ *
+ * Returns false (and counts a drop) if the ring is full, in which case the
+ * caller still owns the frame's reference.
+ */
+bool csi_ring_push(csi_ring_t *ring, csi_frame_t *frame)
+{
+  uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+  if (head - tail >= CSI_RING_CAPACITY)
+  {
+    atomic_fetch_add_explicit(&ring->dropped_full, 1, memory_order_relaxed);
+    return false;
+  }
+  ring->slots[head & CSI_RING_MASK] = frame;
+  atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+  atomic_fetch_add_explicit(&ring->pushed, 1, memory_order_relaxed);
+
+  // Only the producer writes high_water, so a plain compare is enough
+  uint32_t used = head + 1 - tail;
+  if (used > atomic_load_explicit(&ring->high_water, memory_order_relaxed))
+    atomic_store_explicit(&ring->high_water, used, memory_order_relaxed);
+  return true;
+}
+
+void csi_ring_drop_oversize(csi_ring_t *ring)
+{
+  atomic_fetch_add_explicit(&ring->dropped_oversize, 1, memory_order_relaxed);
+}
+
+uint32_t csi_ring_available(csi_ring_t *ring)
+{
+  uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+  uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  return head - tail;
+}
+
+/**
+ * @brief Borrow the frame @p offset positions after the oldest unconsumed one.
+ *
+ * @p offset must be below the value last returned by csi_ring_available().
+ */
+csi_frame_t *csi_ring_peek(csi_ring_t *ring, uint32_t offset)
+{
+  uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  return ring->slots[(tail + offset) & CSI_RING_MASK];
+}
+
+void csi_ring_consume(csi_ring_t *ring, uint32_t count)
+{
+  uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  atomic_store_explicit(&ring->tail, tail + count, memory_order_release);
+}
+
+void csi_ring_get_stats(csi_ring_t *ring, csi_ring_stats_t *stats)
+{
+  stats->pushed = atomic_load_explicit(&ring->pushed, memory_order_relaxed);
+  stats->popped = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  stats->dropped_full = atomic_load_explicit(&ring->dropped_full, memory_order_relaxed);
+  stats->dropped_oversize = atomic_load_explicit(&ring->dropped_oversize, memory_order_relaxed);
+  stats->high_water = atomic_load_explicit(&ring->high_water, memory_order_relaxed);
+}
@@ -0,0 +1,55 @@
+#ifndef CSI_RING_H
+#define CSI_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "csi_pool.h"
+
+// Number of frames the ring can hold. Must be a power of two.
+#define CSI_RING_CAPACITY 32
+
+typedef struct
+{
+  uint32_t pushed;           /**< Frames committed by the producer */
+  uint32_t popped;           /**< Frames consumed by the consumer */
+  uint32_t dropped_full;     /**< Frames lost because the ring was full */
+  uint32_t dropped_oversize; /**< Frames longer than CSI_FRAME_MAX_LEN */
+  uint32_t high_water;       /**< Highest occupancy seen after a push */
+} csi_ring_stats_t;
+
+/**
+ * @brief Lock-free single-producer/single-consumer ring of CSI frame references.
+ *
+ * The producer (the Wi-Fi CSI callback) hands over a pool slot with
+ * csi_ring_push(), passing its reference to the ring. The consumer (the
+ * processing task) borrows frames with csi_ring_peek() and takes them out in
+ * batches with csi_ring_consume(), after which it owns their references.
+ * Neither side allocates or blocks.
+ */
+typedef struct
+{
+  csi_frame_t *slots[CSI_RING_CAPACITY];
+  _Atomic uint32_t head; /**< Next slot to write, owned by the producer */
+  _Atomic uint32_t tail; /**< Next slot to read, owned by the consumer */
+  _Atomic uint32_t pushed;
+  _Atomic uint32_t dropped_full;
+  _Atomic uint32_t dropped_oversize;
+  _Atomic uint32_t high_water;
+} csi_ring_t;
+
+void csi_ring_init(csi_ring_t *ring);
+
+// Producer side
+bool csi_ring_push(csi_ring_t *ring, csi_frame_t *frame);
+void csi_ring_drop_oversize(csi_ring_t *ring);
+
+// Consumer side
+uint32_t csi_ring_available(csi_ring_t *ring);
+csi_frame_t *csi_ring_peek(csi_ring_t *ring, uint32_t offset);
+void csi_ring_consume(csi_ring_t *ring, uint32_t count);
+
+// Either side
+void csi_ring_get_stats(csi_ring_t *ring, csi_ring_stats_t *stats);
+
+#endif // CSI_RING_H
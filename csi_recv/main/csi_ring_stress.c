@@ -0,0 +1,267 @@
+// Host stress test: runs the CSI ring and frame pool between two threads, as the
+// Wi-Fi callback and csi_task use them, far above the CONFIG_SEND_FREQUENCY packet
+// rate. The producer allocates a slot, stamps it and pushes it, releasing it when
+// the ring is full; the consumer drains the ring in batches of CSI_TASK_BATCH,
+// checks each frame and releases it, keeping some frames for a while with an extra
+// reference the way a later stage would.
+//
+// With one pool of CSI_RING_CAPACITY slots, as the firmware has, the pool runs out
+// before the ring can fill. The "ring full" scenario feeds the ring from a second
+// pool as well, so pushes to a full ring happen too.
+//
+// Checked in every scenario:
+//   - frames arrive in push order, none lost or repeated (FIFO)
+//   - a frame's payload is intact until its last reference goes (no slot reused early)
+//   - a borrowed frame holds exactly the references handed out for it
+//   - pushed, popped, dropped_full and dropped_oversize match what each thread saw;
+//     high_water is at least the occupancy the consumer saw, at most CSI_RING_CAPACITY
+//   - each pool's alloc_failed matches the failed allocations; afterwards every slot
+//     is free with no reference left (no leak)
+//
+// Build: gcc -O2 -pthread -o csi_ring_stress csi_ring_stress.c csi_ring.c csi_pool.c
+//        (add -fsanitize=thread to have the data-race detector watch it too)
+// Usage: ./csi_ring_stress [frames per scenario]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "csi_ring.h"
+#include "csi_pool.h"
+
+#define DEFAULT_FRAMES 1000000
+// As in app_main.c
+#define CSI_TASK_BATCH 8
+#define CONFIG_SEND_FREQUENCY 80
+// Frames the consumer keeps an extra reference to at once; fewer than a pool, so frames keep flowing
+#define MAX_HELD (CSI_POOL_SIZE / 2)
+
+typedef struct {
+    const char* name;
+    int pools;          // Pools the producer allocates from, the second once the first is empty
+    int producer_spin;  // Busy-wait between two callbacks, sets the packet rate
+    int consumer_spin;  // Busy-wait per frame in the consumer, slows it below the producer
+    int hold_every;     // Every n-th frame is kept with an extra reference (0: none)
+    int hold_frames;    // ... and released this many frames later
+    int oversize_every; // Every n-th callback reports an oversize frame instead (0: none)
+} scenario_t;
+
+static const scenario_t scenarios[] = {
+    {"fast consumer", 1, 200, 0, 0, 0, 0},
+    {"slow consumer", 1, 0, 400, 0, 0, 97},
+    {"held frames", 1, 100, 50, 3, 24, 0},
+    {"pool exhaustion", 1, 0, 200, 1, 40, 0},
+    {"ring full", 2, 0, 400, 5, 16, 0},
+};
+#define NUM_SCENARIOS (int)(sizeof(scenarios) / sizeof(scenarios[0]))
+
+typedef struct {
+    const scenario_t* scenario;
+    long frames;
+    csi_ring_t ring;
+    csi_pool_t pools[2];
+    atomic_bool done;
+    // Producer's view
+    uint32_t pushed, dropped_full, dropped_oversize, alloc_failed[2];
+    // Consumer's view
+    uint32_t popped, max_available, errors;
+} stress_t;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Payload derived from the push index, so a reused slot shows as a wrong payload
+static void stamp(csi_frame_t* frame, uint32_t index) {
+    frame->meta.seq = index;
+    frame->meta.len = (uint16_t)(64 + index % (CSI_FRAME_MAX_LEN - 64));
+    for (int i = 0; i < frame->meta.len; i++) frame->buf[i] = (int8_t)(index * 31 + i);
+}
+
+static bool intact(const csi_frame_t* frame) {
+    uint32_t index = frame->meta.seq;
+    if (frame->meta.len != 64 + index % (CSI_FRAME_MAX_LEN - 64)) return false;
+    for (int i = 0; i < frame->meta.len; i++) {
+        if (frame->buf[i] != (int8_t)(index * 31 + i)) return false;
+    }
+    return true;
+}
+
+static void error(stress_t* st, const char* what, uint32_t index) {
+    if (st->errors++ < 10) printf("  error: %s (%u)\n", what, index);
+}
+
+static void release(stress_t* st, csi_frame_t* frame) {
+    csi_pool_t* pool = &st->pools[frame >= st->pools[1].slots && frame < st->pools[1].slots + CSI_POOL_SIZE];
+    csi_pool_release(pool, frame);
+}
+
+static void* producer(void* arg) {
+    stress_t* st = (stress_t*)arg;
+    const scenario_t* sc = st->scenario;
+    volatile uint32_t sink = 0;
+    for (long n = 0; n < st->frames; n++) {
+        for (int k = 0; k < sc->producer_spin; k++) sink += k;
+        if (sc->oversize_every && n % sc->oversize_every == 0) {
+            csi_ring_drop_oversize(&st->ring);
+            st->dropped_oversize++;
+            continue;
+        }
+        csi_frame_t* frame = NULL;
+        for (int p = 0; p < sc->pools && !frame; p++) {
+            frame = csi_pool_alloc(&st->pools[p]);
+            if (!frame) st->alloc_failed[p]++;
+        }
+        if (!frame) {
+            // Give a consumer sharing this CPU the chance to free slots
+            sched_yield();
+            continue;
+        }
+        stamp(frame, st->pushed);
+        if (!csi_ring_push(&st->ring, frame)) {
+            release(st, frame);
+            st->dropped_full++;
+            continue;
+        }
+        st->pushed++;
+    }
+    atomic_store(&st->done, true);
+    return NULL;
+}
+
+static void* consumer(void* arg) {
+    stress_t* st = (stress_t*)arg;
+    const scenario_t* sc = st->scenario;
+    csi_frame_t* held[MAX_HELD];
+    uint32_t held_until[MAX_HELD];
+    int held_count = 0;
+    uint32_t expected = 0;
+    volatile uint32_t sink = 0;
+
+    while (true) {
+        bool finished = atomic_load(&st->done);
+        uint32_t available = csi_ring_available(&st->ring);
+        if (available == 0) {
+            if (finished) break;
+            sched_yield();
+            continue;
+        }
+        if (available > st->max_available) st->max_available = available;
+        if (available > CSI_RING_CAPACITY) error(st, "more frames available than the ring holds", available);
+
+        uint32_t batch = available < CSI_TASK_BATCH ? available : CSI_TASK_BATCH;
+        csi_frame_t* frames[CSI_TASK_BATCH];
+        for (uint32_t i = 0; i < batch; i++) frames[i] = csi_ring_peek(&st->ring, i);
+        csi_ring_consume(&st->ring, batch);
+
+        for (uint32_t i = 0; i < batch; i++) {
+            csi_frame_t* frame = frames[i];
+            if (frame->meta.seq != expected) error(st, "out of order, frame", frame->meta.seq);
+            if (!intact(frame)) error(st, "payload overwritten while referenced, frame", frame->meta.seq);
+            if (atomic_load(&frame->refcount) != 1) error(st, "borrowed frame without exactly one reference", expected);
+            expected = frame->meta.seq + 1;
+            for (int k = 0; k < sc->consumer_spin; k++) sink += k;
+
+            if (sc->hold_every && expected % sc->hold_every == 0 && held_count < MAX_HELD) {
+                csi_frame_retain(frame);
+                if (atomic_load(&frame->refcount) != 2) error(st, "retain did not add a reference, frame", expected);
+                held[held_count] = frame;
+                held_until[held_count++] = expected + sc->hold_frames;
+            }
+            release(st, frame);
+            st->popped++;
+        }
+
+        // Release held frames that are due, checking nothing reused them meanwhile
+        for (int h = 0; h < held_count;) {
+            if ((int32_t)(expected - held_until[h]) < 0) {
+                h++;
+                continue;
+            }
+            if (!intact(held[h])) error(st, "held frame reused, frame", held[h]->meta.seq);
+            release(st, held[h]);
+            held[h] = held[--held_count];
+            held_until[h] = held_until[held_count];
+        }
+    }
+    for (int h = 0; h < held_count; h++) {
+        if (!intact(held[h])) error(st, "held frame reused, frame", held[h]->meta.seq);
+        release(st, held[h]);
+    }
+    if (expected != st->pushed) error(st, "frames lost between push and pop, popped up to", expected);
+    return NULL;
+}
+
+// Counters against what the threads saw, and fully free pools
+static void check_counters(stress_t* st) {
+    csi_ring_stats_t ring;
+    csi_ring_get_stats(&st->ring, &ring);
+    if (ring.pushed != st->pushed) error(st, "ring pushed", ring.pushed);
+    if (ring.popped != st->popped) error(st, "ring popped", ring.popped);
+    if (ring.dropped_full != st->dropped_full) error(st, "ring dropped_full", ring.dropped_full);
+    if (ring.dropped_oversize != st->dropped_oversize) error(st, "ring dropped_oversize", ring.dropped_oversize);
+    if (ring.high_water < st->max_available || ring.high_water > CSI_RING_CAPACITY)
+        error(st, "ring high_water outside the occupancy seen", ring.high_water);
+    if (st->dropped_full && ring.high_water != CSI_RING_CAPACITY)
+        error(st, "ring dropped frames without ever being full, high_water", ring.high_water);
+
+    for (int p = 0; p < 2; p++) {
+        csi_pool_stats_t pool;
+        csi_pool_get_stats(&st->pools[p], &pool);
+        if (pool.alloc_failed != st->alloc_failed[p]) error(st, "pool alloc_failed", pool.alloc_failed);
+        if (pool.high_water > CSI_POOL_SIZE) error(st, "pool high_water", pool.high_water);
+        if (pool.in_use != 0) error(st, "slots leaked", pool.in_use);
+        for (int i = 0; i < CSI_POOL_SIZE; i++) {
+            if (atomic_load(&st->pools[p].slots[i].refcount) != 0) error(st, "slot left with a reference", i);
+        }
+    }
+}
+
+static bool run(const scenario_t* sc, long frames) {
+    static stress_t st;
+    memset(&st, 0, sizeof(st));
+    st.scenario = sc;
+    st.frames = frames;
+    csi_ring_init(&st.ring);
+    csi_pool_init(&st.pools[0]);
+    csi_pool_init(&st.pools[1]);
+    atomic_init(&st.done, false);
+
+    pthread_t threads[2];
+    double start = now_s();
+    pthread_create(&threads[1], NULL, consumer, &st);
+    pthread_create(&threads[0], NULL, producer, &st);
+    pthread_join(threads[0], NULL);
+    pthread_join(threads[1], NULL);
+    double seconds = now_s() - start;
+    check_counters(&st);
+
+    csi_ring_stats_t ring;
+    csi_pool_stats_t pool;
+    csi_ring_get_stats(&st.ring, &ring);
+    csi_pool_get_stats(&st.pools[0], &pool);
+    printf("%-16s %10.0f %8.0fx %9u %9u %8u %6u/%-3d %9u %6u/%-3d %s\n", sc->name, frames / seconds,
+           frames / seconds / CONFIG_SEND_FREQUENCY, ring.popped, ring.dropped_full, ring.dropped_oversize,
+           ring.high_water, CSI_RING_CAPACITY, pool.alloc_failed, pool.high_water, CSI_POOL_SIZE,
+           st.errors ? "FAIL" : "ok");
+    return st.errors == 0;
+}
+
+int main(int argc, char** argv) {
+    long frames = argc > 1 ? strtol(argv[1], NULL, 0) : DEFAULT_FRAMES;
+    if (frames <= 0) {
+        printf("Usage: %s [frames per scenario]\n", argv[0]);
+        return 1;
+    }
+    printf("%-16s %10s %9s %9s %9s %8s %10s %9s %10s\n", "scenario", "frames/s", "x send", "popped", "full",
+           "oversize", "ring hw", "no slot", "pool hw");
+    bool ok = true;
+    for (int s = 0; s < NUM_SCENARIOS; s++) ok &= run(&scenarios[s], frames);
+    printf("\n%s\n", ok ? "All scenarios consistent" : "Inconsistencies found");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+#include <math.h>
+#include <string.h>
+#include "csi_sdft.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * @brief Set up the band [@p lo_hz, @p hi_hz] of an @p n point DFT at @p rate_hz.
+ *
+ * @return false if the band needs more than CSI_SDFT_MAX_BINS bins or does not
+ *         leave room for the neighbour bins (k_lo >= 2, k_hi + 2 < n / 2).
+ */
+bool csi_sdft_init(csi_sdft_t *sdft, int n, float rate_hz, float lo_hz, float hi_hz)
+{
+  memset(sdft, 0, sizeof(*sdft));
+  sdft->n = n;
+  sdft->rate_hz = rate_hz;
+  sdft->k_lo = (int)(lo_hz * n / rate_hz);
+  sdft->k_hi = (int)(hi_hz * n / rate_hz);
+  sdft->k_first = sdft->k_lo - 2;
+  sdft->bins = sdft->k_hi + 2 - sdft->k_first + 1;
+  if (sdft->k_first < 0 || sdft->k_hi < sdft->k_lo || sdft->k_hi + 2 >= n / 2 || sdft->bins > CSI_SDFT_MAX_BINS)
+    return false;
+
+  sdft->damping_n = powf(CSI_SDFT_DAMPING, n);
+  for (int b = 0; b < sdft->bins; b++)
+  {
+    double angle = 2.0 * M_PI * (sdft->k_first + b) / n;
+    sdft->tw_re[b] = CSI_SDFT_DAMPING * (float)cos(angle);
+    sdft->tw_im[b] = CSI_SDFT_DAMPING * (float)sin(angle);
+  }
+  return true;
+}
+
+void csi_sdft_reset(csi_sdft_t *sdft)
+{
+  memset(sdft->re, 0, sizeof(sdft->re));
+  memset(sdft->im, 0, sizeof(sdft->im));
+  sdft->count = 0;
+}
+
+/**
+ * @brief Add @p in and drop @p out, the sample pushed n samples earlier (0 while the window fills).
+ */
+void csi_sdft_push(csi_sdft_t *sdft, float in, float out)
+{
+  float delta = in - sdft->damping_n * out;
+  for (int b = 0; b < sdft->bins; b++)
+  {
+    float re = sdft->re[b] + delta;
+    float im = sdft->im[b];
+    sdft->re[b] = re * sdft->tw_re[b] - im * sdft->tw_im[b];
+    sdft->im[b] = re * sdft->tw_im[b] + im * sdft->tw_re[b];
+  }
+  sdft->count++;
+}
+
+// |Hann-windowed bin k|; bin 0 counts as zero (window mean removed)
+static float windowed_magnitude(const csi_sdft_t *sdft, int k)
+{
+  int b = k - sdft->k_first;
+  float re = 0.5f * sdft->re[b];
+  float im = 0.5f * sdft->im[b];
+  if (k - 1 > 0)
+  {
+    re -= 0.25f * sdft->re[b - 1];
+    im -= 0.25f * sdft->im[b - 1];
+  }
+  re -= 0.25f * sdft->re[b + 1];
+  im -= 0.25f * sdft->im[b + 1];
+  return sqrtf(re * re + im * im);
+}
+
+/**
+ * @brief Strongest in-band frequency, refined by a parabola through the peak bin and its neighbours.
+ *
+ * @return false until a full window has been pushed.
+ */
+bool csi_sdft_peak(const csi_sdft_t *sdft, float *freq_hz, float *magnitude)
+{
+  if (!csi_sdft_ready(sdft))
+    return false;
+
+  float mag[CSI_SDFT_MAX_BINS];
+  for (int k = sdft->k_lo - 1; k <= sdft->k_hi + 1; k++)
+    mag[k - sdft->k_first] = windowed_magnitude(sdft, k);
+
+  int peak = sdft->k_lo;
+  for (int k = sdft->k_lo + 1; k <= sdft->k_hi; k++)
+  {
+    if (mag[k - sdft->k_first] > mag[peak - sdft->k_first])
+      peak = k;
+  }
+
+  float alpha = mag[peak - 1 - sdft->k_first];
+  float beta = mag[peak - sdft->k_first];
+  float gamma = mag[peak + 1 - sdft->k_first];
+  float denom = alpha - 2 * beta + gamma;
+  float refined = denom != 0 ? peak + 0.5f * (alpha - gamma) / denom : (float)peak;
+
+  *freq_hz = refined * sdft->rate_hz / sdft->n;
+  if (magnitude)
+    *magnitude = beta;
+  return true;
+}
+
+/**
+ * @brief Mean windowed magnitude over the search band, the floor a peak is compared with.
+ */
+float csi_sdft_band_mean(const csi_sdft_t *sdft)
+{
+  if (!csi_sdft_ready(sdft))
+    return 0.0f;
+  float sum = 0.0f;
+  for (int k = sdft->k_lo; k <= sdft->k_hi; k++)
+    sum += windowed_magnitude(sdft, k);
+  return sum / (sdft->k_hi - sdft->k_lo + 1);
+}
@@ -0,0 +1,50 @@
+#ifndef CSI_SDFT_H
+#define CSI_SDFT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Bins tracked: the search band plus two on each side for the Hann window and the peak fit
+#define CSI_SDFT_MAX_BINS 64
+// Pole radius of the damped recurrence, keeps float rounding from accumulating
+#define CSI_SDFT_DAMPING 0.99999f
+
+/**
+ * @brief Sliding DFT over the last n samples, restricted to one frequency band.
+ *
+ * Only the bins of the band (and their neighbours) are kept, each updated in
+ * O(1) per sample, so the spectrum is current after every input instead of once
+ * per block. The Hann window is applied in the frequency domain,
+ * Y[k] = X[k] / 2 - (X[k - 1] + X[k + 1]) / 4, with X[0] taken as zero, which
+ * is the same as removing the window mean before windowing. The input history
+ * is not stored: the caller passes the sample leaving the window with each new
+ * one, typically from the ring buffer it already keeps.
+ */
+typedef struct
+{
+  int n;          /**< Window length, samples */
+  float rate_hz;  /**< Input sample rate */
+  int k_lo, k_hi; /**< Peak search band, bins, as (int)(f * n / rate_hz) */
+  int k_first;    /**< Lowest bin tracked, k_lo - 2 */
+  int bins;       /**< Bins tracked, k_first .. k_hi + 2 */
+  float damping_n; /**< CSI_SDFT_DAMPING^n, applied to the leaving sample */
+  float tw_re[CSI_SDFT_MAX_BINS]; /**< CSI_SDFT_DAMPING * exp(j 2 pi k / n) */
+  float tw_im[CSI_SDFT_MAX_BINS];
+  float re[CSI_SDFT_MAX_BINS];
+  float im[CSI_SDFT_MAX_BINS];
+  uint32_t count; /**< Samples pushed since the last reset */
+} csi_sdft_t;
+
+bool csi_sdft_init(csi_sdft_t *sdft, int n, float rate_hz, float lo_hz, float hi_hz);
+void csi_sdft_reset(csi_sdft_t *sdft);
+void csi_sdft_push(csi_sdft_t *sdft, float in, float out);
+bool csi_sdft_peak(const csi_sdft_t *sdft, float *freq_hz, float *magnitude);
+float csi_sdft_band_mean(const csi_sdft_t *sdft);
+
+// True once a full window has been pushed
+static inline bool csi_sdft_ready(const csi_sdft_t *sdft)
+{
+  return sdft->count >= (uint32_t)sdft->n;
+}
+
+#endif // CSI_SDFT_H
@@ -0,0 +1,160 @@
+#include <string.h>
+#include "csi_serial.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_rom_crc.h"
+#endif
+
+_Static_assert(sizeof(csi_serial_header_t) == 28, "csi_serial_header_t is a wire format");
+
+/**
+ * @brief Standard CRC-32 (reflected 0xEDB88320), chainable: pass 0 to start.
+ */
+uint32_t csi_serial_crc32(uint32_t crc, const uint8_t *data, size_t len)
+{
+#ifdef ESP_PLATFORM
+  return esp_rom_crc32_le(crc, data, len);
+#else
+  static const uint32_t table[16] = {
+      0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+      0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+  };
+  crc = ~crc;
+  for (size_t i = 0; i < len; i++)
+  {
+    crc = (crc >> 4) ^ table[(crc ^ data[i]) & 0x0F];
+    crc = (crc >> 4) ^ table[(crc ^ (data[i] >> 4)) & 0x0F];
+  }
+  return ~crc;
+#endif
+}
+
+typedef struct
+{
+  uint8_t *out;
+  size_t code_pos; /**< Where the current block's length code goes */
+  size_t pos;
+  uint8_t code;
+} cobs_writer_t;
+
+static void cobs_start(cobs_writer_t *w, uint8_t *out)
+{
+  // Leading delimiter: console text written since the previous packet becomes its own
+  // (rejected) frame instead of corrupting this one
+  out[0] = 0x00;
+  w->out = out;
+  w->code_pos = 1;
+  w->pos = 2;
+  w->code = 1;
+}
+
+static void cobs_put(cobs_writer_t *w, const uint8_t *data, size_t len)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    if (data[i] != 0)
+    {
+      w->out[w->pos++] = data[i];
+      w->code++;
+    }
+    if (data[i] == 0 || w->code == 0xFF)
+    {
+      w->out[w->code_pos] = w->code;
+      w->code_pos = w->pos++;
+      w->code = 1;
+    }
+  }
+}
+
+static size_t cobs_finish(cobs_writer_t *w)
+{
+  w->out[w->code_pos] = w->code;
+  w->out[w->pos++] = 0x00;
+  return w->pos;
+}
+
+/**
+ * @brief Serialize one frame as a delimited COBS packet, ready for a single UART write.
+ *
+ * @return Bytes written to @p out (both delimiters included), or 0 if @p out_len is too small.
+ */
+size_t csi_serial_encode(const csi_frame_meta_t *meta, const int8_t *payload, uint8_t *out, size_t out_len)
+{
+  if (meta->len > CSI_FRAME_MAX_LEN || out_len < CSI_SERIAL_MAX_FRAME)
+    return 0;
+
+  csi_serial_header_t header = {
+      .magic = CSI_SERIAL_MAGIC,
+      .version = CSI_SERIAL_VERSION,
+      .seq = meta->seq,
+      .rssi = meta->rssi,
+      .rate = meta->rate,
+      .noise_floor = meta->noise_floor,
+      .fft_gain = meta->fft_gain,
+      .agc_gain = meta->agc_gain,
+      .channel = meta->channel,
+      .timestamp = meta->timestamp,
+      .sig_len = meta->sig_len,
+      .rx_state = meta->rx_state,
+      .first_word_invalid = meta->first_word_invalid,
+      .len = meta->len,
+  };
+  memcpy(header.mac, meta->mac, sizeof(header.mac));
+
+  uint32_t crc = csi_serial_crc32(0, (const uint8_t *)&header, sizeof(header));
+  crc = csi_serial_crc32(crc, (const uint8_t *)payload, meta->len);
+  uint8_t crc_bytes[CSI_SERIAL_CRC_LEN] = {crc & 0xFF, (crc >> 8) & 0xFF, (crc >> 16) & 0xFF, crc >> 24};
+
+  cobs_writer_t w;
+  cobs_start(&w, out);
+  cobs_put(&w, (const uint8_t *)&header, sizeof(header));
+  cobs_put(&w, (const uint8_t *)payload, meta->len);
+  cobs_put(&w, crc_bytes, sizeof(crc_bytes));
+  return cobs_finish(&w);
+}
+
+/**
+ * @brief Decode one packet. @p in is the bytes between two 0x00 delimiters.
+ */
+csi_serial_status_t csi_serial_decode(const uint8_t *in, size_t in_len, csi_serial_header_t *header,
+                                      int8_t *payload, size_t payload_max)
+{
+  uint8_t raw[CSI_SERIAL_MAX_RAW];
+  size_t n = 0;
+  size_t i = 0;
+  while (i < in_len)
+  {
+    uint8_t code = in[i++];
+    if (code == 0 || i + code - 1 > in_len)
+      return CSI_SERIAL_ERR_COBS;
+    if (n + code - 1 > sizeof(raw))
+      return CSI_SERIAL_ERR_LENGTH;
+    memcpy(raw + n, in + i, code - 1);
+    n += code - 1;
+    i += code - 1;
+    // A short block stands for a zero byte, except at the very end
+    if (code < 0xFF && i < in_len)
+    {
+      if (n == sizeof(raw))
+        return CSI_SERIAL_ERR_LENGTH;
+      raw[n++] = 0;
+    }
+  }
+
+  if (n < sizeof(*header) + CSI_SERIAL_CRC_LEN)
+    return CSI_SERIAL_ERR_LENGTH;
+  memcpy(header, raw, sizeof(*header));
+  if (header->magic != CSI_SERIAL_MAGIC || header->version != CSI_SERIAL_VERSION)
+    return CSI_SERIAL_ERR_VERSION;
+  if (n != sizeof(*header) + header->len + CSI_SERIAL_CRC_LEN || header->len > payload_max)
+    return CSI_SERIAL_ERR_LENGTH;
+
+  size_t body = sizeof(*header) + header->len;
+  uint32_t crc = (uint32_t)raw[body] | (uint32_t)raw[body + 1] << 8 |
+                 (uint32_t)raw[body + 2] << 16 | (uint32_t)raw[body + 3] << 24;
+  if (crc != csi_serial_crc32(0, raw, body))
+    return CSI_SERIAL_ERR_CRC;
+
+  memcpy(payload, raw + sizeof(*header), header->len);
+  return CSI_SERIAL_OK;
+}
@@ -0,0 +1,57 @@
+#ifndef CSI_SERIAL_H
+#define CSI_SERIAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "csi_pool.h"
+
+#define CSI_SERIAL_MAGIC 0xC5
+#define CSI_SERIAL_VERSION 1
+
+/**
+ * @brief Fixed header in front of every serialized packet. Little-endian on the wire.
+ *
+ * A packet on the wire is COBS(header | payload[len] | crc32) between two 0x00
+ * delimiters. The CRC is the standard CRC-32 (zlib) over header and payload, so a
+ * frame corrupted or interleaved with console text is rejected by the decoder
+ * instead of being parsed, and @ref seq shows how many packets were lost.
+ */
+typedef struct __attribute__((packed))
+{
+  uint8_t magic;   /**< CSI_SERIAL_MAGIC */
+  uint8_t version; /**< CSI_SERIAL_VERSION */
+  uint32_t seq;    /**< Receiver packet counter; a gap means packets were dropped */
+  uint8_t mac[6];
+  int8_t rssi;
+  uint8_t rate;
+  int8_t noise_floor;
+  uint8_t fft_gain;
+  uint8_t agc_gain;
+  uint8_t channel;
+  uint32_t timestamp;
+  uint16_t sig_len;
+  uint8_t rx_state;
+  uint8_t first_word_invalid;
+  uint16_t len; /**< Payload bytes that follow the header */
+} csi_serial_header_t;
+
+#define CSI_SERIAL_CRC_LEN 4
+#define CSI_SERIAL_MAX_RAW (sizeof(csi_serial_header_t) + CSI_FRAME_MAX_LEN + CSI_SERIAL_CRC_LEN)
+// COBS adds one byte per 254 plus one, then the two 0x00 delimiters
+#define CSI_SERIAL_MAX_FRAME (CSI_SERIAL_MAX_RAW + CSI_SERIAL_MAX_RAW / 254 + 3)
+
+typedef enum
+{
+  CSI_SERIAL_OK,
+  CSI_SERIAL_ERR_COBS,    /**< Malformed COBS block */
+  CSI_SERIAL_ERR_LENGTH,  /**< Shorter than a header, or len disagrees with the frame size */
+  CSI_SERIAL_ERR_CRC,     /**< CRC mismatch */
+  CSI_SERIAL_ERR_VERSION, /**< Bad magic or unsupported version */
+} csi_serial_status_t;
+
+uint32_t csi_serial_crc32(uint32_t crc, const uint8_t *data, size_t len);
+size_t csi_serial_encode(const csi_frame_meta_t *meta, const int8_t *payload, uint8_t *out, size_t out_len);
+csi_serial_status_t csi_serial_decode(const uint8_t *in, size_t in_len, csi_serial_header_t *header,
+                                      int8_t *payload, size_t payload_max);
+
+#endif // CSI_SERIAL_H
@@ -0,0 +1,134 @@
+// Host tool: decode a binary serial CSI capture (CSI_SERIAL_BINARY in app_main.c)
+// into the CSV layout the breathing_rate_evaluation programs read, and optionally
+// into a flat binary file of header + payload records.
+//
+// Build: gcc -O2 -o csi_serial_decode csi_serial_decode.c csi_serial.c
+// Usage: ./csi_serial_decode <capture.bin | -> <out.csv> [out.csib]
+//
+// out.csib starts with "CSIB" and a little-endian uint32 version, followed by one
+// csi_serial_header_t and header.len payload bytes per packet, in arrival order.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "csi_serial.h"
+
+#define CSIB_VERSION 1
+
+typedef struct {
+    unsigned long frames;
+    unsigned long lost;
+    unsigned long bad[CSI_SERIAL_ERR_VERSION + 1];
+    unsigned long oversize;
+} decode_stats_t;
+
+static const char* status_name[] = {"ok", "cobs", "length", "crc", "version"};
+
+static void write_csv_row(FILE* csv, const csi_serial_header_t* h, const int8_t* payload) {
+    fprintf(csv, "CSI_DATA,%lu,%02x:%02x:%02x:%02x:%02x:%02x,%d,%d,%d,%d,%d,%d,%lu,%d,%d",
+            (unsigned long)h->seq, h->mac[0], h->mac[1], h->mac[2], h->mac[3], h->mac[4], h->mac[5],
+            h->rssi, h->rate, h->noise_floor, h->fft_gain, h->agc_gain, h->channel,
+            (unsigned long)h->timestamp, h->sig_len, h->rx_state);
+    fprintf(csv, ",%d,%d,\"[", h->len, h->first_word_invalid);
+    for (int i = 0; i < h->len; i++) {
+        fprintf(csv, i ? ",%d" : "%d", payload[i]);
+    }
+    fprintf(csv, "]\"\n");
+}
+
+static void handle_frame(const uint8_t* frame, size_t len, FILE* csv, FILE* bin, decode_stats_t* stats,
+                         int* have_seq, uint32_t* last_seq) {
+    csi_serial_header_t header;
+    int8_t payload[CSI_FRAME_MAX_LEN];
+
+    if (len == 0) return; // Back-to-back delimiters
+    csi_serial_status_t status = csi_serial_decode(frame, len, &header, payload, sizeof(payload));
+    if (status != CSI_SERIAL_OK) {
+        stats->bad[status]++;
+        return;
+    }
+
+    if (*have_seq && header.seq != *last_seq + 1) {
+        stats->lost += header.seq - *last_seq - 1;
+    }
+    *have_seq = 1;
+    *last_seq = header.seq;
+    stats->frames++;
+
+    write_csv_row(csv, &header, payload);
+    if (bin) {
+        fwrite(&header, sizeof(header), 1, bin);
+        fwrite(payload, 1, header.len, bin);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        printf("Usage: %s <capture.bin | -> <out.csv> [out.csib]\n", argv[0]);
+        return -1;
+    }
+
+    FILE* in = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "rb");
+    if (!in) {
+        printf("Error: Cannot open capture %s\n", argv[1]);
+        return -1;
+    }
+    FILE* csv = fopen(argv[2], "w");
+    if (!csv) {
+        printf("Error: Cannot create %s\n", argv[2]);
+        return -1;
+    }
+    FILE* bin = NULL;
+    if (argc > 3) {
+        bin = fopen(argv[3], "wb");
+        if (!bin) {
+            printf("Error: Cannot create %s\n", argv[3]);
+            return -1;
+        }
+        uint32_t version = CSIB_VERSION;
+        fwrite("CSIB", 1, 4, bin);
+        fwrite(&version, sizeof(version), 1, bin);
+    }
+
+    fprintf(csv, "type, seq, mac, rssi, rate, noise_floor, fft_gain, agc_gain, channel, timestamp, sig_len, rx_state, len, first_word_invalid, data\n");
+
+    decode_stats_t stats = {0};
+    static uint8_t chunk[65536];
+    static uint8_t frame[CSI_SERIAL_MAX_FRAME];
+    size_t frame_len = 0;
+    int overflow = 0;
+    int have_seq = 0;
+    uint32_t last_seq = 0;
+    size_t n;
+
+    // Everything up to the first delimiter may be the tail of a packet sent before the
+    // capture started; it simply fails to decode like any other corrupted frame.
+    while ((n = fread(chunk, 1, sizeof(chunk), in)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            if (chunk[i] == 0x00) {
+                if (overflow) {
+                    stats.oversize++;
+                } else {
+                    handle_frame(frame, frame_len, csv, bin, &stats, &have_seq, &last_seq);
+                }
+                frame_len = 0;
+                overflow = 0;
+            } else if (frame_len < sizeof(frame)) {
+                frame[frame_len++] = chunk[i];
+            } else {
+                overflow = 1; // Console text or a lost delimiter; skip to the next one
+            }
+        }
+    }
+
+    printf("Decoded packets: %lu\n", stats.frames);
+    printf("Lost packets (sequence gaps): %lu\n", stats.lost);
+    for (int i = CSI_SERIAL_ERR_COBS; i <= CSI_SERIAL_ERR_VERSION; i++) {
+        printf("Rejected (%s): %lu\n", status_name[i], stats.bad[i]);
+    }
+    printf("Rejected (oversize): %lu\n", stats.oversize);
+
+    if (in != stdin) fclose(in);
+    fclose(csv);
+    if (bin) fclose(bin);
+    return 0;
+}
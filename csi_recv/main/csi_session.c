@@ -0,0 +1,92 @@
+#include <string.h>
+#include "csi_session.h"
+
+#define CSI_SESSION_MASK (CSI_SESSION_TABLE_SIZE - 1)
+
+_Static_assert((CSI_SESSION_TABLE_SIZE & CSI_SESSION_MASK) == 0, "CSI_SESSION_TABLE_SIZE must be a power of two");
+_Static_assert(CSI_SESSION_TABLE_SIZE >= 2 * CSI_SESSION_MAX, "CSI session table too small for CSI_SESSION_MAX");
+
+static inline uint64_t mac_key(const uint8_t mac[6])
+{
+  // Bit 48 keeps the all-zero MAC distinct from an empty slot
+  return ((uint64_t)1 << 48) | ((uint64_t)mac[0] << 40) | ((uint64_t)mac[1] << 32) |
+         ((uint64_t)mac[2] << 24) | ((uint64_t)mac[3] << 16) | ((uint64_t)mac[4] << 8) | mac[5];
+}
+
+static inline uint32_t mac_hash(uint64_t key)
+{
+  // Fibonacci hashing; the NIC-specific low bytes end up in the top bits
+  return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+void csi_session_table_init(csi_session_table_t *table)
+{
+  memset(table, 0, sizeof(*table));
+  for (int i = 0; i < CSI_SESSION_TABLE_SIZE; i++)
+    atomic_init(&table->slots[i].accepted, 0);
+  atomic_init(&table->rejected, 0);
+}
+
+/**
+ * @brief Permit a transmitter and return its session id, or -1 if the table is full.
+ *
+ * Adding a MAC that is already present returns its existing id.
+ */
+int csi_session_add(csi_session_table_t *table, const uint8_t mac[6])
+{
+  uint64_t key = mac_key(mac);
+  uint32_t index = mac_hash(key);
+  for (int probe = 0; probe < CSI_SESSION_TABLE_SIZE; probe++, index++)
+  {
+    csi_session_entry_t *slot = &table->slots[index & CSI_SESSION_MASK];
+    if (slot->key == key)
+      return slot->id;
+    if (slot->key == 0)
+    {
+      if (table->count >= CSI_SESSION_MAX)
+        return -1;
+      slot->key = key;
+      slot->id = table->count;
+      memcpy(table->macs[slot->id], mac, 6);
+      return table->count++;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Session id for @p mac, or -1 (counted as rejected) if it is not permitted.
+ */
+int csi_session_lookup(csi_session_table_t *table, const uint8_t mac[6])
+{
+  uint64_t key = mac_key(mac);
+  uint32_t index = mac_hash(key);
+  for (int probe = 0; probe < CSI_SESSION_TABLE_SIZE; probe++, index++)
+  {
+    csi_session_entry_t *slot = &table->slots[index & CSI_SESSION_MASK];
+    if (slot->key == key)
+    {
+      atomic_fetch_add_explicit(&slot->accepted, 1, memory_order_relaxed);
+      return slot->id;
+    }
+    if (slot->key == 0)
+      break;
+  }
+  atomic_fetch_add_explicit(&table->rejected, 1, memory_order_relaxed);
+  return -1;
+}
+
+uint32_t csi_session_accepted(csi_session_table_t *table, int id)
+{
+  for (int i = 0; i < CSI_SESSION_TABLE_SIZE; i++)
+  {
+    if (table->slots[i].key != 0 && table->slots[i].id == id)
+      return atomic_load_explicit(&table->slots[i].accepted, memory_order_relaxed);
+  }
+  return 0;
+}
+
+uint32_t csi_session_rejected(csi_session_table_t *table)
+{
+  return atomic_load_explicit(&table->rejected, memory_order_relaxed);
+}
@@ -0,0 +1,40 @@
+#ifndef CSI_SESSION_H
+#define CSI_SESSION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Transmitters (csi_send nodes) one receiver can track at once
+#define CSI_SESSION_MAX 3
+// Open-addressing slots. Power of two, at least twice CSI_SESSION_MAX to keep probes short.
+#define CSI_SESSION_TABLE_SIZE 8
+
+typedef struct
+{
+  uint64_t key; /**< MAC packed into the low 48 bits, 0 for an empty slot */
+  uint8_t id;   /**< Session index handed out by csi_session_add() */
+  _Atomic uint32_t accepted;
+} csi_session_entry_t;
+
+/**
+ * @brief Permitted transmitter MACs, looked up first thing in the CSI callback.
+ *
+ * Filled once with csi_session_add() before CSI is enabled, then read-only
+ * apart from the counters, so the callback can probe it without locking.
+ */
+typedef struct
+{
+  csi_session_entry_t slots[CSI_SESSION_TABLE_SIZE];
+  uint8_t macs[CSI_SESSION_MAX][6]; /**< MAC of each session id */
+  int count;
+  _Atomic uint32_t rejected;
+} csi_session_table_t;
+
+void csi_session_table_init(csi_session_table_t *table);
+int csi_session_add(csi_session_table_t *table, const uint8_t mac[6]);
+int csi_session_lookup(csi_session_table_t *table, const uint8_t mac[6]);
+uint32_t csi_session_accepted(csi_session_table_t *table, int id);
+uint32_t csi_session_rejected(csi_session_table_t *table);
+
+#endif // CSI_SESSION_H
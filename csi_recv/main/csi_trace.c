@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <string.h>
+#include "csi_trace.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_cpu.h"
+#else
+#include <time.h>
+#endif
+
+#define CSI_TRACE_MASK (CSI_TRACE_CAPACITY - 1)
+
+_Static_assert((CSI_TRACE_CAPACITY & CSI_TRACE_MASK) == 0, "CSI_TRACE_CAPACITY must be a power of two");
+
+// Bit of argument i in the float, unsigned and Q8 masks of an event
+#define ARG(i) (1u << (i))
+
+static const struct
+{
+  const char *name;
+  const char *args[CSI_TRACE_ARGS];
+  uint8_t float_mask;
+  uint8_t unsigned_mask;
+  uint8_t q8_mask;
+} s_events[CSI_EV_COUNT] = {
+    [CSI_EV_RX] = {"rx", {"len", "rssi", "timestamp"}, 0, ARG(2)},
+    [CSI_EV_PROCESS] = {"process", {"csi_q_index", "len"}, 0, 0},
+    [CSI_EV_PROCESS_DONE] = {"process_done", {"cycles"}, 0, ARG(0)},
+    [CSI_EV_MOTION] = {"motion", {"amplitude", "var_score", "diff_score", "final"}, 0, 0, ARG(0) | ARG(1) | ARG(2)},
+    [CSI_EV_MOTION_RAW] = {"motion_raw", {"max_var", "threshold", "diff", "diff_threshold"}, 0, 0, ARG(0) | ARG(1) | ARG(2) | ARG(3)},
+    [CSI_EV_MOTION_STATS] = {"motion_stats", {"avg_var", "max_var", "diff_energy", "signal_std"}, 0, 0, ARG(0) | ARG(1) | ARG(2) | ARG(3)},
+    [CSI_EV_MOTION_VOTE] = {"motion_vote", {"history", "continuous", "intensity", "final"}, 0, 0},
+    [CSI_EV_BREATH_WAIT] = {"breath_wait", {"csi_q_index"}, 0, 0},
+    [CSI_EV_BREATH_SAMPLE] = {"breath_sample", {"index", "value"}, ARG(1), 0},
+    [CSI_EV_BREATH_FEATURE] = {"breath_feature", {"index", "value"}, ARG(1), 0},
+    [CSI_EV_BREATH] = {"breath", {"bpm", "confidence"}, 0, 0, ARG(0) | ARG(1)},
+    [CSI_EV_BREATH_SPECTRAL] = {"breath_spectral", {"bpm", "magnitude"}, ARG(1), 0, ARG(0)},
+    [CSI_EV_BREATH_ESTIMATE] = {"breath_estimate", {"estimator", "bpm", "confidence"}, 0, 0, ARG(1) | ARG(2)},
+    [CSI_EV_RESULT] = {"result", {"motion", "amplitude", "intensity", "bpm"}, ARG(1), 0},
+};
+
+static csi_trace_record_t s_records[CSI_TRACE_CAPACITY];
+static _Atomic uint32_t s_head;
+static uint32_t s_tail; // Reader side only
+static uint32_t s_lost;
+
+uint32_t csi_trace_cycles(void)
+{
+#ifdef ESP_PLATFORM
+  return esp_cpu_get_cycle_count();
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000000ull + ts.tv_nsec);
+#endif
+}
+
+/**
+ * @brief Append a record. Lock-free, callable from any task; never blocks or formats.
+ */
+void csi_trace_write(csi_trace_event_t event, uint8_t session, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3)
+{
+  uint32_t index = atomic_fetch_add_explicit(&s_head, 1, memory_order_relaxed);
+  csi_trace_record_t *record = &s_records[index & CSI_TRACE_MASK];
+
+  atomic_store_explicit(&record->seq, 0, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  record->cycles = csi_trace_cycles();
+  record->event = event;
+  record->session = session;
+  record->args[0] = a0;
+  record->args[1] = a1;
+  record->args[2] = a2;
+  record->args[3] = a3;
+  atomic_store_explicit(&record->seq, index + 1, memory_order_release);
+}
+
+/**
+ * @brief Copy out the oldest unread record. Single reader only.
+ *
+ * Records overwritten before they were read are skipped and counted in csi_trace_lost().
+ */
+bool csi_trace_read(csi_trace_record_t *record)
+{
+  while (true)
+  {
+    uint32_t head = atomic_load_explicit(&s_head, memory_order_acquire);
+    if (s_tail == head)
+      return false;
+    if (head - s_tail > CSI_TRACE_CAPACITY)
+    {
+      s_lost += head - s_tail - CSI_TRACE_CAPACITY;
+      s_tail = head - CSI_TRACE_CAPACITY;
+    }
+
+    csi_trace_record_t *slot = &s_records[s_tail & CSI_TRACE_MASK];
+    uint32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    if (seq != s_tail + 1)
+    {
+      if ((int32_t)(seq - (s_tail + 1)) > 0)
+      {
+        // A writer has lapped us on this slot
+        s_lost++;
+        s_tail++;
+        continue;
+      }
+      return false; // Claimed but not yet published
+    }
+
+    record->cycles = slot->cycles;
+    record->event = slot->event;
+    record->session = slot->session;
+    memcpy(record->args, slot->args, sizeof(record->args));
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&slot->seq, memory_order_relaxed) != seq)
+    {
+      s_lost++; // Overwritten while we were copying it
+      s_tail++;
+      continue;
+    }
+    atomic_store_explicit(&record->seq, seq, memory_order_relaxed);
+    s_tail++;
+    return true;
+  }
+}
+
+uint32_t csi_trace_lost(void)
+{
+  return s_lost;
+}
+
+/**
+ * @brief Render a record as "cycles s<session> <event> name=value ...".
+ */
+int csi_trace_format(const csi_trace_record_t *record, char *buf, size_t len)
+{
+  if (record->event >= CSI_EV_COUNT)
+    return snprintf(buf, len, "%lu s%u unknown_event_%u", (unsigned long)record->cycles,
+                    record->session, record->event);
+
+  int pos = snprintf(buf, len, "%lu s%u %s", (unsigned long)record->cycles, record->session,
+                     s_events[record->event].name);
+  for (int i = 0; i < CSI_TRACE_ARGS && s_events[record->event].args[i] && pos < (int)len; i++)
+  {
+    const char *name = s_events[record->event].args[i];
+    uint32_t raw = record->args[i];
+    if (s_events[record->event].float_mask & (1u << i))
+    {
+      float value;
+      memcpy(&value, &raw, sizeof(value));
+      pos += snprintf(buf + pos, len - pos, " %s=%.2f", name, value);
+    }
+    else if (s_events[record->event].q8_mask & (1u << i))
+    {
+      pos += snprintf(buf + pos, len - pos, " %s=%.2f", name, (int32_t)raw / 256.0);
+    }
+    else if (s_events[record->event].unsigned_mask & (1u << i))
+    {
+      pos += snprintf(buf + pos, len - pos, " %s=%lu", name, (unsigned long)raw);
+    }
+    else
+    {
+      pos += snprintf(buf + pos, len - pos, " %s=%ld", name, (long)(int32_t)raw);
+    }
+  }
+  return pos;
+}
@@ -0,0 +1,87 @@
+#ifndef CSI_TRACE_H
+#define CSI_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#define CSI_TRACE_LEVEL_NONE 0
+#define CSI_TRACE_LEVEL_ERROR 1
+#define CSI_TRACE_LEVEL_WARN 2
+#define CSI_TRACE_LEVEL_INFO 3
+#define CSI_TRACE_LEVEL_DEBUG 4
+#define CSI_TRACE_LEVEL_VERBOSE 5
+
+// Trace points above this level compile to nothing, arguments included
+#ifndef CSI_TRACE_LEVEL
+#define CSI_TRACE_LEVEL CSI_TRACE_LEVEL_INFO
+#endif
+
+// Records kept in RAM. Must be a power of two; the oldest are overwritten when full.
+#define CSI_TRACE_CAPACITY 256
+#define CSI_TRACE_ARGS 4
+
+typedef enum
+{
+  CSI_EV_RX,             /**< len, rssi, timestamp */
+  CSI_EV_PROCESS,        /**< csi_q_index, len */
+  CSI_EV_PROCESS_DONE,   /**< cycles spent in csi_process() */
+  CSI_EV_MOTION,         /**< amplitude, var_score, diff_score (Q8), final */
+  CSI_EV_MOTION_RAW,     /**< max_var, threshold, diff, diff_threshold (Q8) */
+  CSI_EV_MOTION_STATS,   /**< avg_var, max_var, diff_energy, signal_std (Q8) */
+  CSI_EV_MOTION_VOTE,    /**< history, continuous, intensity, final */
+  CSI_EV_BREATH_WAIT,    /**< csi_q_index */
+  CSI_EV_BREATH_SAMPLE,  /**< index, value */
+  CSI_EV_BREATH_FEATURE, /**< index, value */
+  CSI_EV_BREATH,         /**< fused bpm, confidence (Q8) */
+  CSI_EV_BREATH_SPECTRAL, /**< bpm (Q8), peak magnitude */
+  CSI_EV_BREATH_ESTIMATE, /**< estimator, bpm, confidence (Q8) */
+  CSI_EV_RESULT,         /**< motion, amplitude, intensity, bpm */
+  CSI_EV_COUNT
+} csi_trace_event_t;
+
+/**
+ * @brief One fixed-size binary trace record.
+ *
+ * Arguments are raw 32-bit words; the event table in csi_trace.c says which of
+ * them are floats or Q8 fixed point, so a record can be formatted later on the device or on the host.
+ */
+typedef struct
+{
+  _Atomic uint32_t seq; /**< Publication stamp: index + 1 once the record is complete */
+  uint32_t cycles;      /**< CPU cycle counter when the record was written */
+  uint16_t event;
+  uint8_t session;
+  uint8_t reserved;
+  uint32_t args[CSI_TRACE_ARGS];
+} csi_trace_record_t;
+
+void csi_trace_write(csi_trace_event_t event, uint8_t session, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+bool csi_trace_read(csi_trace_record_t *record);
+uint32_t csi_trace_lost(void);
+uint32_t csi_trace_cycles(void);
+int csi_trace_format(const csi_trace_record_t *record, char *buf, size_t len);
+
+static inline uint32_t csi_trace_f(float value)
+{
+  union
+  {
+    float f;
+    uint32_t u;
+  } bits = {.f = value};
+  return bits.u;
+}
+
+#define CSI_TRACE(level, event, session, a0, a1, a2, a3)                                                   \
+  do                                                                                                       \
+  {                                                                                                        \
+    if (CSI_TRACE_LEVEL >= (level))                                                                        \
+      csi_trace_write((event), (session), (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3)); \
+  } while (0)
+
+#define CSI_TRACEI(event, session, a0, a1, a2, a3) CSI_TRACE(CSI_TRACE_LEVEL_INFO, event, session, a0, a1, a2, a3)
+#define CSI_TRACED(event, session, a0, a1, a2, a3) CSI_TRACE(CSI_TRACE_LEVEL_DEBUG, event, session, a0, a1, a2, a3)
+#define CSI_TRACEV(event, session, a0, a1, a2, a3) CSI_TRACE(CSI_TRACE_LEVEL_VERBOSE, event, session, a0, a1, a2, a3)
+
+#endif // CSI_TRACE_H
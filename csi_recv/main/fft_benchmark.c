@@ -0,0 +1,154 @@
+// Host benchmark: checks the csi_fft real-input plan against a double precision
+// reference DFT and reports transforms per second for each size. Power-of-two
+// sizes are also run through the radix-2 complex FFT the breathing rate
+// evaluator used before, for comparison.
+//
+// Build: gcc -O2 -o fft_benchmark fft_benchmark.c csi_fft.c -lm
+// Usage: ./fft_benchmark [size ...]   (even sizes; default covers the window lengths in use)
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "csi_fft.h"
+
+#define PI 3.14159265358979323846
+// Minimum time spent timing one size
+#define BENCH_SECONDS 0.2
+// Relative spectrum error the float transform must stay under
+#define MAX_RELATIVE_ERROR 1e-5
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Largest bin error relative to the largest bin, windowed as the plan is
+static double reference_error(const float* x, const csi_complex_t* spectrum, int n, const float* window) {
+    double max_error = 0, max_magnitude = 0;
+    for (int k = 0; k <= n / 2; k++) {
+        double re = 0, im = 0;
+        for (int i = 0; i < n; i++) {
+            double v = window ? (double)x[i] * window[i] : x[i];
+            double angle = -2.0 * PI * (double)((long long)k * i % n) / n;
+            re += v * cos(angle);
+            im += v * sin(angle);
+        }
+        double error = hypot(re - spectrum[k].re, im - spectrum[k].im);
+        if (error > max_error) max_error = error;
+        double magnitude = hypot(re, im);
+        if (magnitude > max_magnitude) max_magnitude = magnitude;
+    }
+    return max_magnitude > 0 ? max_error / max_magnitude : max_error;
+}
+
+// The previous evaluator transform: in-place radix-2, twiddles by recurrence
+static void radix2_fft(csi_complex_t* data, int n) {
+    for (int i = 0, j = 0; i < n - 1; i++) {
+        if (i < j) {
+            csi_complex_t t = data[i];
+            data[i] = data[j];
+            data[j] = t;
+        }
+        int k = n >> 1;
+        while (k <= j) {
+            j -= k;
+            k >>= 1;
+        }
+        j += k;
+    }
+    for (int size = 2; size <= n; size *= 2) {
+        int half = size / 2;
+        float angle = -2 * PI / size;
+        csi_complex_t w = {cosf(angle), sinf(angle)};
+        for (int k = 0; k < n; k += size) {
+            csi_complex_t wk = {1.0f, 0.0f};
+            for (int j = 0; j < half; j++) {
+                csi_complex_t b = data[k + j + half];
+                csi_complex_t t = {wk.re * b.re - wk.im * b.im, wk.re * b.im + wk.im * b.re};
+                csi_complex_t u = data[k + j];
+                data[k + j].re = u.re + t.re;
+                data[k + j].im = u.im + t.im;
+                data[k + j + half].re = u.re - t.re;
+                data[k + j + half].im = u.im - t.im;
+                float re = wk.re * w.re - wk.im * w.im;
+                wk.im = wk.re * w.im + wk.im * w.re;
+                wk.re = re;
+            }
+        }
+    }
+}
+
+static int bench_size(int n) {
+    float* storage = malloc(CSI_FFT_STORAGE_FLOATS(n) * sizeof(float));
+    float* x = malloc(n * sizeof(float));
+    csi_complex_t* spectrum = malloc((n / 2 + 1) * sizeof(csi_complex_t));
+    csi_complex_t* buffer = malloc(n * sizeof(csi_complex_t));
+    csi_fft_plan_t plan;
+    int ok = storage && x && spectrum && buffer &&
+             csi_fft_plan_init(&plan, n, CSI_FFT_WINDOW_HANN, storage, CSI_FFT_STORAGE_FLOATS(n));
+    if (!ok) {
+        printf("%6d  plan failed\n", n);
+        free(storage); free(x); free(spectrum); free(buffer);
+        return 0;
+    }
+
+    srand(n);
+    for (int i = 0; i < n; i++) {
+        // A breathing-like tone plus noise, as the evaluator feeds it
+        x[i] = sinf(2 * PI * 0.25f * i / 20.0f) + (rand() / (float)RAND_MAX - 0.5f);
+    }
+    csi_fft_real(&plan, x, spectrum);
+    double error = reference_error(x, spectrum, n, plan.window);
+
+    long transforms = 0;
+    double start = now_ns(), elapsed;
+    do {
+        for (int r = 0; r < 16; r++) {
+            csi_fft_real(&plan, x, spectrum);
+        }
+        transforms += 16;
+        elapsed = now_ns() - start;
+    } while (elapsed < BENCH_SECONDS * 1e9);
+    double rate = transforms * 1e9 / elapsed;
+
+    char radix2[48] = "-";
+    if ((n & (n - 1)) == 0) {
+        long runs = 0;
+        start = now_ns();
+        do {
+            for (int r = 0; r < 16; r++) {
+                for (int i = 0; i < n; i++) {
+                    buffer[i].re = x[i] * plan.window[i];
+                    buffer[i].im = 0;
+                }
+                radix2_fft(buffer, n);
+            }
+            runs += 16;
+            elapsed = now_ns() - start;
+        } while (elapsed < BENCH_SECONDS * 1e9);
+        snprintf(radix2, sizeof(radix2), "%.0f", runs * 1e9 / elapsed);
+    }
+
+    printf("%6d %14.0f %14.2f %16s  %.2e %s\n", n, rate, 1e6 / rate, radix2,
+           error, error < MAX_RELATIVE_ERROR ? "ok" : "FAIL");
+    free(storage); free(x); free(spectrum); free(buffer);
+    return error < MAX_RELATIVE_ERROR;
+}
+
+int main(int argc, char** argv) {
+    static const int default_sizes[] = {64, 100, 128, 200, 256, 300, 500, 512, 1000, 1024, 2000, 2048, 4000, 4096};
+    int count = argc > 1 ? argc - 1 : (int)(sizeof(default_sizes) / sizeof(default_sizes[0]));
+    int failures = 0;
+
+    printf("%6s %14s %14s %16s  %s\n", "size", "transforms/s", "us/transform", "radix-2 cplx/s", "max rel error");
+    for (int i = 0; i < count; i++) {
+        int n = argc > 1 ? atoi(argv[i + 1]) : default_sizes[i];
+        if (n < 2 || n % 2) {
+            printf("%6d  skipped: size must be even and at least 2\n", n);
+            continue;
+        }
+        if (!bench_size(n)) failures++;
+    }
+    return failures ? 1 : 0;
+}
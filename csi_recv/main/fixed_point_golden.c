@@ -0,0 +1,268 @@
+// Host check: runs the CSI_FIXED_POINT functions over the inputs recorded in
+// fixed_point_golden.txt and compares every result with the one recorded next to
+// it, bit for bit: extract_features_q() and predict_q() (built-in linear model) per
+// window, csi_motion_features_q8() after each step of a push/drop/configure
+// sequence. Any difference fails; an intended change regenerates the file with
+// --write and shows up in its diff.
+//
+// The inputs are deterministic: breathing-like amplitudes, steps, spikes, full-range
+// noise and alternating int16 extremes, whose differences do not fit in 31 bits once
+// squared. Motion inputs are in the amplitude range csi_process() feeds csi_motion,
+// then full range with the EMA off (configure ... 1 1), which csi_params allows.
+//
+// Build: gcc -O2 -DCSI_FIXED_POINT=1 -DSVM_EVALUATION_NO_MAIN -o fixed_point_golden fixed_point_golden.c
+//            breathing_rate_evaluation_svm.c csi_features.c csi_model.c csi_serial.c csi_motion.c -lm
+// Usage: ./fixed_point_golden [fixed_point_golden.txt]
+//        ./fixed_point_golden --write fixed_point_golden.txt
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <math.h>
+#include "breathing_rate_evaluation_svm.h"
+#include "csi_motion.h"
+#include "csi_params.h"
+
+#if !CSI_FIXED_POINT
+#error "Build with -DCSI_FIXED_POINT=1: the golden values are those of the integer EMA"
+#endif
+
+#define MAX_LINE 16384
+#define MOTION_STEPS 400
+#define EXTREME_STEPS 80
+// As in app_main.c: csi_q is trimmed to CSI_FIFO_LENGTH once it passes CSI_BUFFER_LENGTH
+#define CSI_BUFFER_LENGTH 800
+#define CSI_FIFO_LENGTH 100
+
+static uint32_t lcg_state;
+static uint32_t lcg(void) {
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return lcg_state >> 8;
+}
+
+// Uniform in [low, high]
+static int lcg_range(int low, int high) {
+    return low + (int)(lcg() % (uint32_t)(high - low + 1));
+}
+
+static void write_window(FILE* out, const char* name, const int16_t* window) {
+    fprintf(out, "window %s", name);
+    for (int i = 0; i < WINDOW_SIZE; i++) fprintf(out, " %d", window[i]);
+    fprintf(out, "\nfeatures_q ?\npredict_q ?\n");
+}
+
+// The inputs, with every expected value left as "?"
+static void generate(FILE* out) {
+    int16_t window[WINDOW_SIZE];
+
+    lcg_state = 1;
+    for (int i = 0; i < WINDOW_SIZE; i++)
+        window[i] = (int16_t)lrint(40 + 8 * sin(2 * M_PI * i / 60.0) + lcg_range(-3, 3));
+    write_window(out, "breathing", window);
+
+    for (int i = 0; i < WINDOW_SIZE; i++) window[i] = i < WINDOW_SIZE / 2 ? 20 : 60;
+    write_window(out, "step", window);
+
+    for (int i = 0; i < WINDOW_SIZE; i++) window[i] = 37;
+    write_window(out, "constant", window);
+
+    for (int i = 0; i < WINDOW_SIZE; i++) window[i] = (int16_t)(-1000 + lcg_range(-50, 50));
+    write_window(out, "negative", window);
+
+    for (int i = 0; i < WINDOW_SIZE; i++) window[i] = i == WINDOW_SIZE / 3 ? 30000 : 0;
+    write_window(out, "spike", window);
+
+    for (int i = 0; i < WINDOW_SIZE; i++) window[i] = (int16_t)lcg_range(INT16_MIN, INT16_MAX);
+    write_window(out, "noise", window);
+
+    for (int i = 0; i < WINDOW_SIZE; i++) window[i] = i % 2 ? INT16_MIN : INT16_MAX;
+    write_window(out, "extremes", window);
+
+    // Packets of 1..8 samples, still or moving, trimmed as mqtt_send() trims csi_q
+    fprintf(out, "motion packets\n");
+    lcg_state = 2;
+    int count = 0;
+    for (int step = 0; step < MOTION_STEPS; step++) {
+        if (step == MOTION_STEPS / 2) fprintf(out, "configure 20 1 3\nfeatures_q8 ?\n");
+        if (step == MOTION_STEPS * 3 / 4) fprintf(out, "configure %d %d %d\nfeatures_q8 ?\n", CSI_MOTION_WINDOW,
+                                                  CSI_MOTION_ALPHA_NUM, CSI_MOTION_ALPHA_DEN);
+        bool moving = (step / 50) % 2;
+        int n = lcg_range(1, 8);
+        fprintf(out, "push %d", n);
+        for (int k = 0; k < n; k++) fprintf(out, " %d", moving ? lcg_range(0, 200) : 50 + lcg_range(-4, 4));
+        fprintf(out, "\n");
+        count += n;
+        if (count > CSI_BUFFER_LENGTH) {
+            fprintf(out, "drop %d\n", count - CSI_FIFO_LENGTH);
+            count = CSI_FIFO_LENGTH;
+        }
+        fprintf(out, "features_q8 ?\n");
+    }
+
+    // Full-range samples without smoothing (alpha 1/1) over the longest window csi_params
+    // accepts: differences up to 65535, whose squares and window sums pass 32 bits
+    fprintf(out, "motion extremes\nconfigure %d 1 1\n", CSI_PARAMS_MAX_WINDOW);
+    lcg_state = 3;
+    count = 0;
+    for (int step = 0; step < EXTREME_STEPS; step++) {
+        if (step == EXTREME_STEPS / 2) fprintf(out, "configure %d %d %d\nfeatures_q8 ?\n", CSI_MOTION_WINDOW,
+                                               CSI_MOTION_ALPHA_NUM, CSI_MOTION_ALPHA_DEN);
+        int n = lcg_range(8, 32);
+        fprintf(out, "push %d", n);
+        for (int k = 0; k < n; k++)
+            fprintf(out, " %d", step % 2 ? lcg_range(INT16_MIN, INT16_MAX) : (count + k) % 2 ? INT16_MIN : INT16_MAX);
+        fprintf(out, "\n");
+        count += n;
+        if (count > CSI_BUFFER_LENGTH) {
+            fprintf(out, "drop %d\n", count - CSI_FIFO_LENGTH);
+            count = CSI_FIFO_LENGTH;
+        }
+        fprintf(out, "features_q8 ?\n");
+    }
+}
+
+// Reads n integers after the keyword; false if the line holds fewer
+static bool parse_values(char* text, int64_t* values, int n) {
+    char* end;
+    for (int i = 0; i < n; i++) {
+        values[i] = strtoll(text, &end, 10);
+        if (end == text) return false;
+        text = end;
+    }
+    return true;
+}
+
+// Compares, or with out set writes, one expectation line
+static bool expect(FILE* out, int line_no, const char* keyword, char* text, const int64_t* actual, int n,
+                   bool valid) {
+    if (out) {
+        fprintf(out, "%s", keyword);
+        if (!valid) fprintf(out, " none");
+        for (int i = 0; valid && i < n; i++) fprintf(out, " %" PRId64, actual[i]);
+        fprintf(out, "\n");
+        return true;
+    }
+    int64_t expected[8];
+    bool expected_valid = strncmp(text, " none", 5) != 0;
+    if (expected_valid && !parse_values(text, expected, n)) {
+        printf("line %d: malformed %s\n", line_no, keyword);
+        return false;
+    }
+    bool same = expected_valid == valid;
+    for (int i = 0; same && valid && i < n; i++) same = expected[i] == actual[i];
+    if (!same) {
+        printf("line %d: %s differs:%s", line_no, keyword, valid ? "" : " none");
+        for (int i = 0; valid && i < n; i++) printf(" %" PRId64, actual[i]);
+        printf(" (golden%s)\n", text);
+    }
+    return same;
+}
+
+// Runs the script in; checks each expectation, or copies the script to out with them filled in
+static int run(FILE* in, FILE* out, int* checked) {
+    static char line[MAX_LINE];
+    static csi_motion_t motion;
+    int16_t window[WINDOW_SIZE];
+    int16_t samples[64];
+    int64_t features[FEATURE_SIZE];
+    int failures = 0, line_no = 0;
+    *checked = 0;
+
+    while (fgets(line, sizeof(line), in)) {
+        line_no++;
+        line[strcspn(line, "\n")] = 0;
+        char* rest = strchr(line, ' ');
+        size_t length = rest ? (size_t)(rest - line) : strlen(line);
+        if (line[0] == '#' || line[0] == 0) {
+            if (out) fprintf(out, "%s\n", line);
+            continue;
+        }
+        if (!rest) rest = line + length;
+
+        int64_t values[WINDOW_SIZE];
+        bool ok = true;
+        if (strncmp(line, "window", length) == 0) {
+            char* samples_text = strchr(rest + 1, ' ');
+            ok = samples_text && parse_values(samples_text, values, WINDOW_SIZE);
+            for (int i = 0; ok && i < WINDOW_SIZE; i++) window[i] = (int16_t)values[i];
+            if (ok) extract_features_q(window, features);
+            if (out) fprintf(out, "%s\n", line);
+        } else if (strncmp(line, "features_q", length) == 0) {
+            failures += !expect(out, line_no, "features_q", rest, features, FEATURE_SIZE, true);
+            (*checked)++;
+        } else if (strncmp(line, "predict_q", length) == 0) {
+            int64_t bpm_q16 = predict_q(features);
+            failures += !expect(out, line_no, "predict_q", rest, &bpm_q16, 1, true);
+            (*checked)++;
+        } else if (strncmp(line, "motion", length) == 0) {
+            csi_motion_init(&motion);
+            if (out) fprintf(out, "%s\n", line);
+        } else if (strncmp(line, "configure", length) == 0) {
+            ok = parse_values(rest, values, 3);
+            if (ok) csi_motion_configure(&motion, (int)values[0], (int)values[1], (int)values[2]);
+            if (out) fprintf(out, "%s\n", line);
+        } else if (strncmp(line, "push", length) == 0) {
+            ok = parse_values(rest, values, 1) && values[0] > 0 && values[0] <= 64;
+            int n = ok ? (int)values[0] : 0;
+            ok = ok && parse_values(rest, values, n + 1);
+            for (int i = 0; ok && i < n; i++) samples[i] = (int16_t)values[i + 1];
+            if (ok) csi_motion_push(&motion, samples, n);
+            if (out) fprintf(out, "%s\n", line);
+        } else if (strncmp(line, "drop", length) == 0) {
+            ok = parse_values(rest, values, 1);
+            if (ok) csi_motion_drop(&motion, (int)values[0]);
+            if (out) fprintf(out, "%s\n", line);
+        } else if (strncmp(line, "features_q8", length) == 0) {
+            csi_motion_features_q8_t q8;
+            bool valid = csi_motion_features_q8(&motion, &q8);
+            int64_t actual[] = {q8.signal_std, q8.max_variance, q8.avg_variance, q8.diff_energy};
+            failures += !expect(out, line_no, "features_q8", rest, actual, 4, valid);
+            (*checked)++;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            printf("line %d: cannot parse \"%.40s\"\n", line_no, line);
+            return -1;
+        }
+    }
+    return failures;
+}
+
+int main(int argc, char** argv) {
+    int checked;
+    if (argc == 3 && strcmp(argv[1], "--write") == 0) {
+        FILE* script = tmpfile();
+        FILE* out = fopen(argv[2], "w");
+        if (!script || !out) {
+            printf("Error: cannot write %s\n", argv[2]);
+            return 1;
+        }
+        fprintf(script, "# Golden outputs of the CSI_FIXED_POINT pipeline; checked by fixed_point_golden.c,\n");
+        fprintf(script, "# regenerated with fixed_point_golden --write only for an intended change.\n");
+        fprintf(script, "# window: samples; features_q: extract_features_q(), Q16; predict_q: predict_q(), BPM Q16\n");
+        fprintf(script, "# motion: csi_motion_init(); push n samples, drop n, configure window num den,\n");
+        fprintf(script, "# then features_q8: csi_motion_features_q8() (none when it returns false)\n");
+        generate(script);
+        rewind(script);
+        int result = run(script, out, &checked);
+        fclose(script);
+        fclose(out);
+        if (result != 0) return 1;
+        printf("%s: %d golden values written\n", argv[2], checked);
+        return 0;
+    }
+
+    const char* path = argc > 1 ? argv[1] : "fixed_point_golden.txt";
+    FILE* in = fopen(path, "r");
+    if (!in) {
+        printf("Error: cannot open %s\n", path);
+        return 1;
+    }
+    int failures = run(in, NULL, &checked);
+    fclose(in);
+    if (failures < 0) return 1;
+    printf("%s: %d of %d golden values differ\n", path, failures, checked);
+    return failures ? 1 : 0;
+}
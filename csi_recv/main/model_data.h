@@ -1,7 +1,11 @@
 #ifndef MODEL_DATA_H
 #define MODEL_DATA_H
 
+// TFLite flatbuffers, 16-byte aligned so TFLM can read them in place
 extern const unsigned char breathing_rate_model_tflite[];
 extern const int breathing_rate_model_tflite_len;
+// int8 quantisation of the model above (csi_nn_quantize)
+extern const unsigned char breathing_rate_model_int8_tflite[];
+extern const int breathing_rate_model_int8_tflite_len;
 
 #endif // MODEL_DATA_H
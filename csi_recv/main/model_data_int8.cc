@@ -0,0 +1,516 @@
+#include "model_data.h"
+// Generated by csi_nn_quantize from breathing_rate_model.tflite; do not edit
+alignas(16) const unsigned char breathing_rate_model_int8_tflite[] = {
+  0x18, 0x00, 0x00, 0x00, 0x54, 0x46, 0x4c, 0x33, 0x0e, 0x00, 0x18, 0x00,
+  0x04, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x10, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x10, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x34, 0x00, 0x00, 0x00, 0x70, 0x09, 0x00, 0x00, 0x88, 0x09, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x10, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x10, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+  0x09, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x0e, 0x00, 0x18, 0x00, 0x04, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x10, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00,
+  0x10, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0xc0, 0x07, 0x00, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+  0x6d, 0x61, 0x69, 0x6e, 0x00, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x00, 0x00,
+  0x48, 0x00, 0x00, 0x00, 0xcc, 0x00, 0x00, 0x00, 0x58, 0x01, 0x00, 0x00,
+  0xe4, 0x01, 0x00, 0x00, 0x70, 0x02, 0x00, 0x00, 0xf4, 0x02, 0x00, 0x00,
+  0x70, 0x03, 0x00, 0x00, 0xec, 0x03, 0x00, 0x00, 0x68, 0x04, 0x00, 0x00,
+  0xe4, 0x04, 0x00, 0x00, 0x90, 0x05, 0x00, 0x00, 0x44, 0x06, 0x00, 0x00,
+  0xf8, 0x06, 0x00, 0x00, 0x0e, 0x00, 0x18, 0x00, 0x04, 0x00, 0x08, 0x00,
+  0x0c, 0x00, 0x10, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00,
+  0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+  0x1d, 0x00, 0x00, 0x00, 0x73, 0x65, 0x72, 0x76, 0x69, 0x6e, 0x67, 0x5f,
+  0x64, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x5f, 0x64, 0x65, 0x6e, 0x73,
+  0x65, 0x5f, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x3a, 0x30, 0x00, 0x0c, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0xcc, 0x85, 0xce, 0x3c,
+  0x01, 0x00, 0x00, 0x00, 0xfa, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0x0e, 0x00, 0x18, 0x00, 0x04, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x10, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x4c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+  0x29, 0x00, 0x00, 0x00, 0x73, 0x65, 0x71, 0x75, 0x65, 0x6e, 0x74, 0x69,
+  0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e, 0x73, 0x65, 0x5f, 0x31, 0x2f, 0x42,
+  0x69, 0x61, 0x73, 0x41, 0x64, 0x64, 0x2f, 0x52, 0x65, 0x61, 0x64, 0x56,
+  0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x4f, 0x70, 0x00, 0x0c, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0xfb, 0xae, 0x4e, 0x38,
+  0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x0e, 0x00, 0x18, 0x00, 0x04, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x10, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x4c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x29, 0x00, 0x00, 0x00, 0x73, 0x65, 0x71, 0x75, 0x65, 0x6e, 0x74, 0x69,
+  0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e, 0x73, 0x65, 0x5f, 0x32, 0x2f, 0x42,
+  0x69, 0x61, 0x73, 0x41, 0x64, 0x64, 0x2f, 0x52, 0x65, 0x61, 0x64, 0x56,
+  0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x4f, 0x70, 0x00, 0x0c, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x04, 0x85, 0xb3, 0x38,
+  0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x0e, 0x00, 0x18, 0x00, 0x04, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x10, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x02, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x4c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0x29, 0x00, 0x00, 0x00, 0x73, 0x65, 0x71, 0x75, 0x65, 0x6e, 0x74, 0x69,
+  0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e, 0x73, 0x65, 0x5f, 0x33, 0x2f, 0x42,
+  0x69, 0x61, 0x73, 0x41, 0x64, 0x64, 0x2f, 0x52, 0x65, 0x61, 0x64, 0x56,
+  0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x4f, 0x70, 0x00, 0x0c, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x6c, 0x57, 0x06, 0x39,
+  0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x0e, 0x00, 0x18, 0x00, 0x04, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x10, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x44, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00,
+  0x27, 0x00, 0x00, 0x00, 0x73, 0x65, 0x71, 0x75, 0x65, 0x6e, 0x74, 0x69,
+  0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e, 0x73, 0x65, 0x2f, 0x42, 0x69, 0x61,
+  0x73, 0x41, 0x64, 0x64, 0x2f, 0x52, 0x65, 0x61, 0x64, 0x56, 0x61, 0x72,
+  0x69, 0x61, 0x62, 0x6c, 0x65, 0x4f, 0x70, 0x00, 0x0c, 0x00, 0x0c, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x00, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0x49, 0x13, 0xd9, 0x38, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x18, 0x00, 0x04, 0x00, 0x08, 0x00,
+  0x0c, 0x00, 0x10, 0x00, 0x14, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+  0x40, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x00,
+  0x73, 0x65, 0x71, 0x75, 0x65, 0x6e, 0x74, 0x69, 0x61, 0x6c, 0x2f, 0x64,
+  0x65, 0x6e, 0x73, 0x65, 0x2f, 0x4d, 0x61, 0x74, 0x4d, 0x75, 0x6c, 0x00,
+  0x0c, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x08, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x59, 0x8a, 0x86, 0x3b,
+  0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x0e, 0x00, 0x18, 0x00, 0x04, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x10, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x09, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x3c, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+  0x40, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00, 0x73, 0x65, 0x71, 0x75,
+  0x65, 0x6e, 0x74, 0x69, 0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e, 0x73, 0x65,
+  0x5f, 0x31, 0x2f, 0x4d, 0x61, 0x74, 0x4d, 0x75, 0x6c, 0x00, 0x0c, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x0e, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x89, 0x7a, 0x94, 0x3b, 0x01, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x18, 0x00,
+  0x04, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x10, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x10, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+  0x07, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00,
+  0x02, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+  0x19, 0x00, 0x00, 0x00, 0x73, 0x65, 0x71, 0x75, 0x65, 0x6e, 0x74, 0x69,
+  0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e, 0x73, 0x65, 0x5f, 0x32, 0x2f, 0x4d,
+  0x61, 0x74, 0x4d, 0x75, 0x6c, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0xa3, 0x1c, 0xcd, 0x3b, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x18, 0x00, 0x04, 0x00, 0x08, 0x00,
+  0x0c, 0x00, 0x10, 0x00, 0x14, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00,
+  0x73, 0x65, 0x71, 0x75, 0x65, 0x6e, 0x74, 0x69, 0x61, 0x6c, 0x2f, 0x64,
+  0x65, 0x6e, 0x73, 0x65, 0x5f, 0x33, 0x2f, 0x4d, 0x61, 0x74, 0x4d, 0x75,
+  0x6c, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x96, 0x56, 0x9c, 0x3b,
+  0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x0e, 0x00, 0x18, 0x00, 0x04, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x10, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x6c, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0x40, 0x00, 0x00, 0x00, 0x46, 0x00, 0x00, 0x00, 0x73, 0x65, 0x71, 0x75,
+  0x65, 0x6e, 0x74, 0x69, 0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e, 0x73, 0x65,
+  0x2f, 0x4d, 0x61, 0x74, 0x4d, 0x75, 0x6c, 0x3b, 0x73, 0x65, 0x71, 0x75,
+  0x65, 0x6e, 0x74, 0x69, 0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e, 0x73, 0x65,
+  0x2f, 0x52, 0x65, 0x6c, 0x75, 0x3b, 0x73, 0x65, 0x71, 0x75, 0x65, 0x6e,
+  0x74, 0x69, 0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e, 0x73, 0x65, 0x2f, 0x42,
+  0x69, 0x61, 0x73, 0x41, 0x64, 0x64, 0x00, 0x00, 0x0c, 0x00, 0x0c, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x10, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x54, 0x2d, 0x32, 0x3c, 0x01, 0x00, 0x00, 0x00,
+  0x80, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0e, 0x00, 0x18, 0x00,
+  0x04, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x10, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x10, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x74, 0x00, 0x00, 0x00,
+  0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+  0x4c, 0x00, 0x00, 0x00, 0x73, 0x65, 0x71, 0x75, 0x65, 0x6e, 0x74, 0x69,
+  0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e, 0x73, 0x65, 0x5f, 0x31, 0x2f, 0x4d,
+  0x61, 0x74, 0x4d, 0x75, 0x6c, 0x3b, 0x73, 0x65, 0x71, 0x75, 0x65, 0x6e,
+  0x74, 0x69, 0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e, 0x73, 0x65, 0x5f, 0x31,
+  0x2f, 0x52, 0x65, 0x6c, 0x75, 0x3b, 0x73, 0x65, 0x71, 0x75, 0x65, 0x6e,
+  0x74, 0x69, 0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e, 0x73, 0x65, 0x5f, 0x31,
+  0x2f, 0x42, 0x69, 0x61, 0x73, 0x41, 0x64, 0x64, 0x00, 0x00, 0x0c, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0xed, 0x0e, 0x60, 0x3c,
+  0x01, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0x0e, 0x00, 0x18, 0x00, 0x04, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x10, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x74, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0x10, 0x00, 0x00, 0x00, 0x4c, 0x00, 0x00, 0x00, 0x73, 0x65, 0x71, 0x75,
+  0x65, 0x6e, 0x74, 0x69, 0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e, 0x73, 0x65,
+  0x5f, 0x32, 0x2f, 0x4d, 0x61, 0x74, 0x4d, 0x75, 0x6c, 0x3b, 0x73, 0x65,
+  0x71, 0x75, 0x65, 0x6e, 0x74, 0x69, 0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e,
+  0x73, 0x65, 0x5f, 0x32, 0x2f, 0x52, 0x65, 0x6c, 0x75, 0x3b, 0x73, 0x65,
+  0x71, 0x75, 0x65, 0x6e, 0x74, 0x69, 0x61, 0x6c, 0x2f, 0x64, 0x65, 0x6e,
+  0x73, 0x65, 0x5f, 0x32, 0x2f, 0x42, 0x69, 0x61, 0x73, 0x41, 0x64, 0x64,
+  0x00, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0x1c, 0xfb, 0xdb, 0x3c, 0x01, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0x0e, 0x00, 0x18, 0x00, 0x04, 0x00, 0x08, 0x00,
+  0x0c, 0x00, 0x10, 0x00, 0x14, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00,
+  0x53, 0x74, 0x61, 0x74, 0x65, 0x66, 0x75, 0x6c, 0x50, 0x61, 0x72, 0x74,
+  0x69, 0x74, 0x69, 0x6f, 0x6e, 0x65, 0x64, 0x43, 0x61, 0x6c, 0x6c, 0x3a,
+  0x30, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x75, 0xf6, 0x31, 0x3d,
+  0x01, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0x04, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00,
+  0xbc, 0x00, 0x00, 0x00, 0x08, 0x01, 0x00, 0x00, 0x0e, 0x00, 0x18, 0x00,
+  0x04, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x10, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x10, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x24, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0x09, 0x00, 0x00, 0x00, 0x06, 0x00, 0x05, 0x00, 0x04, 0x00, 0x00, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0e, 0x00, 0x18, 0x00, 0x04, 0x00,
+  0x08, 0x00, 0x0c, 0x00, 0x10, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x1c, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00,
+  0x03, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00,
+  0x06, 0x00, 0x05, 0x00, 0x04, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x0e, 0x00, 0x18, 0x00, 0x04, 0x00, 0x08, 0x00, 0x0c, 0x00,
+  0x10, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+  0x0a, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x0b, 0x00, 0x00, 0x00, 0x06, 0x00, 0x05, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0e, 0x00,
+  0x18, 0x00, 0x04, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x10, 0x00, 0x14, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x10, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x24, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x0b, 0x00, 0x00, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x06, 0x00, 0x05, 0x00, 0x04, 0x00, 0x00, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00,
+  0x69, 0x6e, 0x74, 0x38, 0x2c, 0x20, 0x63, 0x73, 0x69, 0x5f, 0x6e, 0x6e,
+  0x5f, 0x71, 0x75, 0x61, 0x6e, 0x74, 0x69, 0x7a, 0x65, 0x00, 0x00, 0x00,
+  0x09, 0x00, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00,
+  0xc8, 0x00, 0x00, 0x00, 0x24, 0x01, 0x00, 0x00, 0x48, 0x01, 0x00, 0x00,
+  0x5c, 0x02, 0x00, 0x00, 0xb8, 0x03, 0x00, 0x00, 0xd4, 0x0b, 0x00, 0x00,
+  0xf0, 0x0d, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00,
+  0x06, 0x00, 0x08, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x80, 0x00, 0x00, 0x00, 0x49, 0x0c, 0x00, 0x00, 0xd7, 0xfe, 0xff, 0xff,
+  0x60, 0x0c, 0x00, 0x00, 0x41, 0x0d, 0x00, 0x00, 0x9b, 0xfd, 0xff, 0xff,
+  0xa5, 0xfe, 0xff, 0xff, 0x60, 0x0c, 0x00, 0x00, 0xf8, 0xfc, 0xff, 0xff,
+  0x10, 0xfe, 0xff, 0xff, 0xf1, 0xfd, 0xff, 0xff, 0x86, 0xfe, 0xff, 0xff,
+  0x66, 0xfe, 0xff, 0xff, 0xb4, 0x0c, 0x00, 0x00, 0xd4, 0xf8, 0xff, 0xff,
+  0xb4, 0x0e, 0x00, 0x00, 0x39, 0x08, 0x00, 0x00, 0x57, 0xfd, 0xff, 0xff,
+  0x1d, 0xfe, 0xff, 0xff, 0x6e, 0x0b, 0x00, 0x00, 0xd9, 0x0b, 0x00, 0x00,
+  0x03, 0x0c, 0x00, 0x00, 0xd6, 0x09, 0x00, 0x00, 0x25, 0xfa, 0xff, 0xff,
+  0xce, 0x0a, 0x00, 0x00, 0x1a, 0xfd, 0xff, 0xff, 0x0b, 0xfc, 0xff, 0xff,
+  0x02, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x24, 0x0d, 0x00, 0x00,
+  0xf4, 0xfe, 0xff, 0xff, 0x22, 0x02, 0x00, 0x00, 0x94, 0x0e, 0x00, 0x00,
+  0x06, 0x00, 0x08, 0x00, 0x04, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x9e, 0x05, 0x00, 0x00,
+  0x1c, 0xfd, 0xff, 0xff, 0x25, 0x06, 0x00, 0x00, 0x73, 0xfe, 0xff, 0xff,
+  0x0e, 0xff, 0xff, 0xff, 0x66, 0x07, 0x00, 0x00, 0x7e, 0x06, 0x00, 0x00,
+  0x35, 0xff, 0xff, 0xff, 0x38, 0xff, 0xff, 0xff, 0xb5, 0x03, 0x00, 0x00,
+  0x1f, 0xff, 0xff, 0xff, 0xa1, 0x07, 0x00, 0x00, 0x45, 0xfd, 0xff, 0xff,
+  0x1f, 0xfd, 0xff, 0xff, 0x30, 0xfe, 0xff, 0xff, 0x39, 0x05, 0x00, 0x00,
+  0x06, 0x00, 0x08, 0x00, 0x04, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x44, 0x03, 0x00, 0x00,
+  0x06, 0x00, 0x08, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x01, 0x00, 0x00, 0xc4, 0x05, 0x00, 0x00, 0x03, 0x07, 0x00, 0x00,
+  0x64, 0x06, 0x00, 0x00, 0x5d, 0x08, 0x00, 0x00, 0x0f, 0x07, 0x00, 0x00,
+  0x69, 0x07, 0x00, 0x00, 0xad, 0x05, 0x00, 0x00, 0x43, 0x06, 0x00, 0x00,
+  0xa4, 0x06, 0x00, 0x00, 0x77, 0x08, 0x00, 0x00, 0xdd, 0x07, 0x00, 0x00,
+  0x22, 0x00, 0x00, 0x00, 0x10, 0x08, 0x00, 0x00, 0xf9, 0xf9, 0xff, 0xff,
+  0x1d, 0x06, 0x00, 0x00, 0x27, 0x08, 0x00, 0x00, 0x66, 0x08, 0x00, 0x00,
+  0x4d, 0x09, 0x00, 0x00, 0x71, 0x06, 0x00, 0x00, 0x07, 0x08, 0x00, 0x00,
+  0x9c, 0x08, 0x00, 0x00, 0xcb, 0x07, 0x00, 0x00, 0x9f, 0x06, 0x00, 0x00,
+  0x07, 0x08, 0x00, 0x00, 0x2c, 0x06, 0x00, 0x00, 0x76, 0xfe, 0xff, 0xff,
+  0xc8, 0x07, 0x00, 0x00, 0x41, 0x09, 0x00, 0x00, 0xc1, 0x05, 0x00, 0x00,
+  0xe1, 0x08, 0x00, 0x00, 0x43, 0x0a, 0x00, 0x00, 0x38, 0x08, 0x00, 0x00,
+  0x9d, 0x0a, 0x00, 0x00, 0xcf, 0x09, 0x00, 0x00, 0x86, 0xfc, 0xff, 0xff,
+  0x95, 0xfe, 0xff, 0xff, 0x3f, 0x07, 0x00, 0x00, 0x59, 0x06, 0x00, 0x00,
+  0xd9, 0xfb, 0xff, 0xff, 0x60, 0x09, 0x00, 0x00, 0xda, 0x08, 0x00, 0x00,
+  0xd8, 0x06, 0x00, 0x00, 0x28, 0x06, 0x00, 0x00, 0x02, 0x0a, 0x00, 0x00,
+  0xdd, 0x07, 0x00, 0x00, 0x6d, 0x08, 0x00, 0x00, 0xb0, 0x07, 0x00, 0x00,
+  0xce, 0x03, 0x00, 0x00, 0xdc, 0xfb, 0xff, 0xff, 0x86, 0x09, 0x00, 0x00,
+  0x5c, 0xfe, 0xff, 0xff, 0xf4, 0x07, 0x00, 0x00, 0xa4, 0x05, 0x00, 0x00,
+  0x55, 0x07, 0x00, 0x00, 0x6f, 0x09, 0x00, 0x00, 0x2a, 0x07, 0x00, 0x00,
+  0x7e, 0x08, 0x00, 0x00, 0x70, 0x08, 0x00, 0x00, 0x33, 0x04, 0x00, 0x00,
+  0xfc, 0x07, 0x00, 0x00, 0x88, 0x08, 0x00, 0x00, 0x76, 0x08, 0x00, 0x00,
+  0x99, 0x0a, 0x00, 0x00, 0x6e, 0x0a, 0x00, 0x00, 0x06, 0x00, 0x08, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x40, 0x01, 0x00, 0x00, 0xcc, 0x55, 0x3d, 0x94, 0xd1, 0x2a, 0x36, 0xce,
+  0xa5, 0xe8, 0xd0, 0xce, 0xc9, 0xf9, 0xcd, 0x10, 0x52, 0x04, 0xb2, 0xeb,
+  0xd3, 0x3f, 0xcc, 0x08, 0xe2, 0xc8, 0xe9, 0xc8, 0x1b, 0xb7, 0x29, 0xae,
+  0xe9, 0x2d, 0xb1, 0xbf, 0xc3, 0xe2, 0x00, 0xb8, 0x07, 0xe4, 0xe2, 0xd4,
+  0xe6, 0x39, 0x0d, 0x24, 0x24, 0x08, 0x1d, 0xfa, 0xcf, 0x9a, 0x29, 0x1e,
+  0x3a, 0x03, 0x14, 0x55, 0xc9, 0xc3, 0xbd, 0xce, 0x0d, 0x22, 0x07, 0xea,
+  0xfe, 0x84, 0x20, 0xdf, 0xfd, 0x0e, 0xba, 0xf4, 0xb4, 0xf0, 0x30, 0x3f,
+  0x17, 0x3c, 0xe1, 0x04, 0xf1, 0xd4, 0xde, 0xde, 0x96, 0x2f, 0xb9, 0xe5,
+  0x43, 0x08, 0xbc, 0x3f, 0xf5, 0x31, 0x00, 0x17, 0x22, 0x0b, 0xdf, 0x93,
+  0xe0, 0xd8, 0xe5, 0xef, 0x03, 0x31, 0xe0, 0xba, 0xbb, 0x32, 0xe0, 0xf0,
+  0x5a, 0x0b, 0x07, 0xff, 0x39, 0xb9, 0x0b, 0xb5, 0xbc, 0xc0, 0xed, 0x28,
+  0xc3, 0x43, 0xdf, 0x5b, 0xda, 0x0d, 0x18, 0xd7, 0xed, 0x06, 0x9b, 0x23,
+  0xfa, 0x0b, 0xf8, 0xd2, 0xcf, 0xde, 0xce, 0xc2, 0x96, 0xe2, 0x3e, 0xcc,
+  0x1e, 0x84, 0x3c, 0x33, 0xdc, 0xf2, 0x88, 0x2d, 0x29, 0x0b, 0x08, 0x0f,
+  0xdb, 0x31, 0xd4, 0x10, 0x91, 0x28, 0x2a, 0xee, 0x01, 0xfb, 0x1a, 0xac,
+  0x22, 0xd3, 0x1d, 0x2c, 0x43, 0x4f, 0xe7, 0x10, 0x14, 0xce, 0xbb, 0xd3,
+  0x21, 0x2d, 0xd2, 0xe4, 0xe1, 0x0e, 0xbd, 0x14, 0xfe, 0xe1, 0x96, 0xc1,
+  0xb7, 0x1b, 0xfb, 0xcd, 0x13, 0xd1, 0x40, 0xd5, 0xd6, 0xe8, 0xe9, 0x36,
+  0x14, 0x25, 0x17, 0x20, 0xc6, 0x36, 0x91, 0x29, 0x03, 0x45, 0x0c, 0x22,
+  0xf0, 0x04, 0x3a, 0x06, 0xfb, 0xbd, 0xfa, 0xa7, 0x11, 0xa4, 0x39, 0xfb,
+  0xd2, 0xf7, 0xf1, 0x25, 0xe6, 0xde, 0xf9, 0xde, 0xce, 0xe1, 0xcd, 0x39,
+  0x12, 0x0f, 0x38, 0x1d, 0x3e, 0x1c, 0x0d, 0xf7, 0x0b, 0x24, 0xe2, 0xdc,
+  0x52, 0x3d, 0xfc, 0xc0, 0x15, 0xcc, 0x2c, 0xdd, 0xaa, 0xf9, 0xf8, 0xd2,
+  0x2d, 0x81, 0x01, 0xc6, 0xbe, 0xca, 0xc5, 0xd6, 0xf7, 0xfe, 0x20, 0x19,
+  0xd3, 0xda, 0x44, 0xdd, 0xa1, 0x3c, 0x42, 0xda, 0xef, 0x19, 0xc4, 0xe9,
+  0x2b, 0xc8, 0xfb, 0xed, 0xfa, 0x29, 0xdd, 0xb5, 0xda, 0x46, 0x0f, 0x30,
+  0x24, 0x01, 0xd7, 0xf5, 0x3c, 0x02, 0x1f, 0x46, 0xfc, 0xfa, 0xdd, 0x0e,
+  0x06, 0x00, 0x08, 0x00, 0x04, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x07, 0x32, 0x3d, 0x17,
+  0x2f, 0xf1, 0x2f, 0x44, 0x1a, 0xef, 0xfa, 0xfa, 0x08, 0xd8, 0xfe, 0x33,
+  0x49, 0x0d, 0x2d, 0xf4, 0x15, 0x15, 0x3a, 0x38, 0x32, 0xee, 0x12, 0x42,
+  0x37, 0xfe, 0x03, 0x43, 0x21, 0xef, 0xed, 0x1f, 0x36, 0xf3, 0xfe, 0x3b,
+  0x00, 0x52, 0x2a, 0x14, 0x23, 0x56, 0x23, 0x05, 0xc9, 0xf7, 0x1c, 0xf8,
+  0x0b, 0x2c, 0xec, 0xe8, 0x0a, 0x31, 0xe1, 0x0f, 0x25, 0x1b, 0x43, 0xf7,
+  0x12, 0xf8, 0xc8, 0x0e, 0x03, 0x2f, 0xdb, 0x02, 0x06, 0xf0, 0x16, 0x25,
+  0x03, 0x0a, 0xcc, 0x12, 0x11, 0xee, 0x0e, 0xdd, 0xcf, 0xee, 0xfe, 0xf1,
+  0x2e, 0x29, 0xdf, 0xf0, 0xde, 0xdc, 0xe8, 0x24, 0x1f, 0xd0, 0xff, 0x1d,
+  0xd9, 0x02, 0x1c, 0xe2, 0xf2, 0xea, 0xf9, 0xd6, 0xe8, 0xdd, 0xd5, 0x26,
+  0x0c, 0xd6, 0x32, 0xef, 0xc9, 0xd0, 0xfa, 0x29, 0xd8, 0xe2, 0xff, 0xc6,
+  0x17, 0xea, 0xf9, 0xe4, 0xf0, 0xf3, 0x05, 0x01, 0x29, 0x08, 0x06, 0xec,
+  0x12, 0xe9, 0x2d, 0xd0, 0xf4, 0xae, 0x3d, 0x04, 0xfb, 0x41, 0xf2, 0x35,
+  0x2a, 0x4f, 0xdd, 0xf4, 0x3b, 0xe3, 0x07, 0x31, 0x2e, 0x43, 0xfb, 0x39,
+  0x31, 0x2d, 0xfe, 0xcb, 0xeb, 0x40, 0x07, 0x2a, 0x2e, 0x58, 0x17, 0x13,
+  0x25, 0x4d, 0x54, 0x21, 0x0c, 0x0b, 0xdf, 0x0d, 0x26, 0x58, 0x30, 0x2d,
+  0x38, 0xf0, 0xf7, 0x00, 0x05, 0xe3, 0x28, 0xe6, 0xe2, 0xe7, 0x31, 0x47,
+  0xe1, 0x28, 0xf8, 0x01, 0x31, 0xf7, 0xe9, 0xa5, 0x31, 0xe1, 0x04, 0x2a,
+  0x2f, 0x27, 0x26, 0x0d, 0xff, 0xe5, 0x38, 0x3b, 0x24, 0xdd, 0x39, 0x55,
+  0xde, 0xe4, 0x29, 0x4c, 0xfc, 0xe8, 0x2c, 0xec, 0x3e, 0x26, 0x19, 0x07,
+  0x01, 0xfb, 0xd7, 0x1f, 0xee, 0x56, 0xfc, 0xef, 0xc9, 0x0e, 0xf7, 0x2d,
+  0x30, 0x2f, 0x0f, 0x1c, 0x0c, 0x2d, 0xea, 0x35, 0xf5, 0x2a, 0x10, 0x1d,
+  0xe4, 0xed, 0xde, 0x30, 0xd5, 0x13, 0x12, 0x01, 0xc7, 0xcf, 0xf7, 0x11,
+  0x2b, 0xe2, 0x33, 0xcc, 0x15, 0x22, 0x19, 0xd9, 0xf0, 0xed, 0xc4, 0xf8,
+  0xde, 0x05, 0xcb, 0x03, 0xc9, 0xd0, 0x13, 0xf0, 0xe1, 0x2e, 0x0e, 0xcd,
+  0xff, 0x18, 0xe5, 0x1f, 0xcc, 0xe6, 0xec, 0xcd, 0x16, 0x37, 0x1b, 0xf8,
+  0xd7, 0x21, 0x2d, 0x1d, 0xcc, 0xe0, 0xed, 0x24, 0xeb, 0x07, 0xdb, 0xc8,
+  0x2a, 0xd1, 0x0f, 0x1b, 0xe0, 0x22, 0xcb, 0x11, 0xe2, 0x11, 0xdc, 0xfb,
+  0x2e, 0x0d, 0x15, 0xdc, 0x02, 0x19, 0xea, 0x24, 0xc5, 0x24, 0x1d, 0x00,
+  0xfb, 0x2a, 0x2e, 0xf2, 0x16, 0xdc, 0xd9, 0x0b, 0xf7, 0x20, 0xe0, 0xdb,
+  0xc9, 0x17, 0xf6, 0x04, 0x28, 0x2e, 0xdb, 0x22, 0xf4, 0xfb, 0x2f, 0xde,
+  0x21, 0x2d, 0x2c, 0x1e, 0xdc, 0xcd, 0xf4, 0xf2, 0xe5, 0xd1, 0xda, 0xfd,
+  0xc8, 0xe1, 0xfe, 0x12, 0xf1, 0x00, 0xe9, 0x15, 0x1a, 0xf1, 0xe8, 0x1c,
+  0x49, 0x20, 0x23, 0x2a, 0xe5, 0x12, 0x20, 0xc4, 0x49, 0x25, 0x0b, 0x04,
+  0x4c, 0x0d, 0x0d, 0xfe, 0x4a, 0x13, 0x24, 0x2d, 0x00, 0xf3, 0xf5, 0x4f,
+  0xee, 0x32, 0xf6, 0xfe, 0x50, 0xef, 0xe5, 0xe6, 0x2a, 0x40, 0xd7, 0x09,
+  0xfb, 0x16, 0x07, 0x58, 0xf2, 0x56, 0x25, 0x0f, 0xd3, 0x0b, 0xdd, 0x30,
+  0x14, 0x31, 0x52, 0x2b, 0x36, 0xeb, 0x3d, 0x45, 0x28, 0x15, 0x0b, 0x1f,
+  0x0d, 0x23, 0xdb, 0xe3, 0xf7, 0x08, 0x0c, 0x1d, 0x1b, 0xfa, 0xe6, 0x13,
+  0x26, 0x10, 0xcf, 0x08, 0x2c, 0xdd, 0xe4, 0x23, 0x33, 0x1e, 0xe3, 0xf8,
+  0xfe, 0xd6, 0xf3, 0xbf, 0x05, 0xd7, 0xea, 0x2a, 0xd1, 0xe0, 0x1d, 0x13,
+  0x25, 0x2e, 0x1b, 0xde, 0xdd, 0x1d, 0xfd, 0x0a, 0xd2, 0xce, 0x15, 0x08,
+  0x2e, 0xd2, 0x27, 0xf5, 0x2b, 0x2d, 0x0d, 0xd0, 0x2f, 0x0a, 0xef, 0xd6,
+  0xe5, 0xf9, 0xf7, 0xee, 0x0f, 0x15, 0xf6, 0xcf, 0xeb, 0xd5, 0x2f, 0xf4,
+  0x21, 0xf7, 0xdf, 0xe7, 0x23, 0x1d, 0xdd, 0x1a, 0xff, 0x28, 0xe2, 0xf2,
+  0xf6, 0xf0, 0xd8, 0x0a, 0x12, 0xe4, 0x25, 0x08, 0xfc, 0xf6, 0xe5, 0xd4,
+  0x00, 0xf3, 0xfd, 0xc8, 0xd0, 0xda, 0xf4, 0xfa, 0x0d, 0xdc, 0x10, 0xe4,
+  0xf2, 0xcd, 0xe6, 0xf4, 0x25, 0x13, 0x36, 0xcc, 0xd2, 0xd7, 0x25, 0x1b,
+  0xee, 0xe1, 0x0b, 0xce, 0x0e, 0xd5, 0x03, 0xde, 0x09, 0xea, 0xe3, 0xe9,
+  0x26, 0xf2, 0x13, 0xc8, 0xcd, 0x2f, 0xd6, 0xdc, 0xd5, 0x03, 0xcd, 0x1b,
+  0xee, 0xe0, 0xed, 0xf1, 0xde, 0x0b, 0x28, 0x22, 0xe2, 0xcd, 0x2e, 0x1b,
+  0x01, 0x2a, 0xce, 0xf2, 0x36, 0xce, 0x0c, 0xf6, 0x26, 0xee, 0x30, 0x02,
+  0xe2, 0x03, 0xd1, 0xeb, 0xd6, 0x1b, 0x23, 0x23, 0x09, 0xf9, 0xff, 0x2a,
+  0xdc, 0x0a, 0xeb, 0x1a, 0x2d, 0x11, 0xe1, 0xf7, 0xf6, 0xdf, 0x0c, 0x2e,
+  0xfa, 0xeb, 0xef, 0xe2, 0x29, 0x19, 0xdf, 0xed, 0xec, 0xf7, 0xd4, 0x13,
+  0x2a, 0xc3, 0x2c, 0x07, 0xfe, 0xf4, 0xe9, 0x38, 0xf2, 0xf0, 0xe4, 0xe2,
+  0x2c, 0x21, 0x06, 0x32, 0x2d, 0xd2, 0xea, 0x12, 0xe2, 0xd8, 0xfc, 0x04,
+  0xc8, 0xd4, 0x0e, 0x11, 0x27, 0x0b, 0xd8, 0xcf, 0xe4, 0xf5, 0xcd, 0xcd,
+  0x08, 0xf7, 0xe2, 0x27, 0xff, 0xf8, 0xf9, 0xc7, 0x15, 0xd2, 0x13, 0x08,
+  0xe5, 0xfc, 0xc7, 0x27, 0x38, 0xc3, 0x16, 0xed, 0x33, 0xee, 0x09, 0xd8,
+  0x0a, 0xd3, 0x07, 0x25, 0xea, 0xd4, 0x0d, 0x33, 0x06, 0xe7, 0x2a, 0x1b,
+  0xd0, 0x40, 0x06, 0xf4, 0x05, 0x23, 0x36, 0x1d, 0xe6, 0xee, 0xc2, 0xcd,
+  0xc2, 0x1a, 0xf9, 0x3f, 0xf9, 0x00, 0xca, 0x19, 0x05, 0xe4, 0xd4, 0x2b,
+  0xe7, 0x2b, 0xea, 0x0e, 0x08, 0x1d, 0xcd, 0x1b, 0x00, 0x21, 0xd4, 0x04,
+  0xe1, 0x1d, 0xe2, 0xf6, 0x2b, 0x0d, 0xec, 0xef, 0xec, 0x11, 0xe7, 0x26,
+  0x45, 0x3a, 0xd6, 0xe1, 0x32, 0x42, 0x3f, 0x0a, 0xf8, 0xbc, 0x06, 0xfc,
+  0x2c, 0x39, 0xdd, 0x48, 0x1b, 0x30, 0x1c, 0x10, 0xe1, 0x31, 0x47, 0x1d,
+  0x3f, 0x1a, 0x46, 0x4e, 0xed, 0x22, 0xcd, 0x03, 0x24, 0x0e, 0xcd, 0x3e,
+  0x15, 0x44, 0x38, 0x01, 0x08, 0x23, 0x02, 0x4e, 0x06, 0x0a, 0x1b, 0xe9,
+  0x48, 0x15, 0x05, 0x12, 0xe7, 0x4d, 0xe2, 0x25, 0x49, 0x0f, 0x30, 0x50,
+  0xf4, 0x19, 0x3b, 0xcb, 0x11, 0x46, 0x23, 0x47, 0xec, 0x1e, 0xaf, 0xee,
+  0x2a, 0x37, 0x3c, 0xc9, 0x02, 0xd8, 0x48, 0xb7, 0x05, 0x32, 0x13, 0x05,
+  0x0f, 0x2b, 0x0a, 0xc1, 0x3b, 0x2e, 0xa8, 0xaa, 0xde, 0xb1, 0xf0, 0x0e,
+  0xeb, 0x08, 0xf2, 0xe1, 0x00, 0xfd, 0xfa, 0xac, 0xbb, 0x15, 0xf7, 0xcf,
+  0x19, 0x09, 0x1e, 0x27, 0xe8, 0x34, 0x05, 0xf6, 0x15, 0xf9, 0xd9, 0xe3,
+  0xe3, 0x11, 0x07, 0xc3, 0x06, 0xf4, 0x0b, 0x00, 0xf5, 0xe5, 0xd7, 0xf1,
+  0xf4, 0x52, 0x2c, 0x02, 0x1d, 0xad, 0xdd, 0xf9, 0x3c, 0x5e, 0x04, 0x13,
+  0x17, 0x09, 0xdb, 0xf8, 0x17, 0x06, 0xe4, 0x4e, 0xdf, 0x0a, 0x30, 0x16,
+  0x3e, 0x01, 0xd3, 0xb5, 0x03, 0x0a, 0xf1, 0x35, 0x3e, 0x19, 0xfc, 0x29,
+  0x4b, 0x22, 0x65, 0x00, 0xc4, 0x28, 0xf1, 0x27, 0x32, 0xf9, 0x5b, 0xe9,
+  0xe2, 0x16, 0xef, 0x2c, 0x00, 0x44, 0x2e, 0x52, 0x08, 0xde, 0xdd, 0x2a,
+  0x3a, 0xdd, 0x1d, 0x1b, 0x22, 0x12, 0x33, 0xf3, 0x43, 0x03, 0x36, 0xed,
+  0xfc, 0x3e, 0x2c, 0x1d, 0x06, 0xfa, 0xe7, 0x00, 0x1d, 0x02, 0x07, 0x4f,
+  0xe7, 0x36, 0x13, 0x47, 0x0d, 0x47, 0xe7, 0xc2, 0xf9, 0x21, 0x29, 0x05,
+  0x2c, 0xfa, 0xfe, 0x27, 0xfd, 0x4b, 0x08, 0xf5, 0xc2, 0x1e, 0x25, 0x25,
+  0x29, 0x33, 0x22, 0xd8, 0x0e, 0x1b, 0x32, 0x06, 0xff, 0xe6, 0x08, 0xfb,
+  0xd5, 0x12, 0xcd, 0xe4, 0x15, 0x0e, 0x0b, 0xd5, 0x19, 0x0c, 0xe2, 0xed,
+  0xe8, 0x2e, 0x28, 0xcf, 0xe8, 0xd5, 0xfe, 0x0c, 0x04, 0x0a, 0x08, 0x1a,
+  0x00, 0x0f, 0xd7, 0xf0, 0x08, 0xdc, 0x02, 0x06, 0x14, 0xcb, 0xf1, 0xf3,
+  0x2c, 0x07, 0x23, 0xc9, 0x0d, 0x17, 0xdd, 0xc4, 0xc7, 0x2e, 0x29, 0x24,
+  0xdb, 0xec, 0x24, 0x22, 0xed, 0xde, 0x28, 0xd6, 0x22, 0x02, 0x08, 0xe7,
+  0x02, 0xc8, 0xd2, 0x13, 0x18, 0x03, 0x21, 0x03, 0xea, 0xee, 0xd1, 0xd1,
+  0xd6, 0xc8, 0x0e, 0x2c, 0xf4, 0x29, 0x10, 0xdd, 0xdb, 0xe9, 0x1a, 0xcb,
+  0x2e, 0xde, 0xf6, 0xf4, 0x2e, 0xce, 0x0b, 0xea, 0xd1, 0xe2, 0x26, 0x16,
+  0xfc, 0xca, 0xfa, 0x2d, 0xd2, 0xf4, 0x2d, 0x0f, 0xe7, 0xfe, 0x06, 0x12,
+  0xce, 0x25, 0xec, 0xef, 0xeb, 0x1f, 0xf6, 0x2a, 0x31, 0xd7, 0xe4, 0xce,
+  0x21, 0x0d, 0xd8, 0x29, 0xde, 0xd3, 0xdb, 0x13, 0xe7, 0x25, 0x1a, 0x11,
+  0x06, 0x2f, 0x20, 0x11, 0x0f, 0x1b, 0x4b, 0xc6, 0x12, 0xd3, 0xfc, 0x19,
+  0x46, 0x3d, 0xee, 0xfc, 0xff, 0x01, 0x2b, 0xe8, 0x1c, 0xe0, 0xf3, 0x01,
+  0xe0, 0x27, 0x1c, 0x3c, 0x43, 0x05, 0xf3, 0xd6, 0xf8, 0x29, 0x0a, 0xe0,
+  0x19, 0xe7, 0x39, 0xf0, 0x48, 0x44, 0x4e, 0x32, 0xf0, 0x3e, 0xd7, 0xe7,
+  0x31, 0x32, 0x22, 0xf8, 0x17, 0x3c, 0xee, 0x49, 0x3e, 0x34, 0x18, 0x10,
+  0x0d, 0x44, 0xdf, 0x2f, 0x4f, 0x07, 0xd1, 0xd6, 0x09, 0x0d, 0x47, 0xc4,
+  0x06, 0xc6, 0x3e, 0x40, 0x36, 0x2f, 0x25, 0xf1, 0x4d, 0x48, 0xd6, 0x22,
+  0xe4, 0xd9, 0x39, 0x28, 0x29, 0x4b, 0xfc, 0x0e, 0x3a, 0x0c, 0xd3, 0x0b,
+  0xf3, 0xee, 0xc4, 0x22, 0x44, 0x4b, 0x2e, 0xec, 0x11, 0xfe, 0xf8, 0x14,
+  0xcc, 0x3d, 0x0c, 0xf8, 0x2d, 0xf5, 0xfa, 0xe7, 0x0b, 0x43, 0x08, 0x0c,
+  0x23, 0xe5, 0x01, 0x00, 0x46, 0x0e, 0xe9, 0x52, 0x06, 0x04, 0x3b, 0xda,
+  0x35, 0xeb, 0x27, 0xe6, 0x22, 0xb4, 0xed, 0x0f, 0xf8, 0x1b, 0x34, 0xf3,
+  0x4c, 0x52, 0x05, 0x51, 0xf9, 0xd9, 0x30, 0x2a, 0xe4, 0x11, 0x4a, 0x52,
+  0x3f, 0x52, 0xf1, 0x08, 0x13, 0x3d, 0x1f, 0x32, 0x38, 0x2c, 0x1a, 0x3a,
+  0xed, 0x55, 0x1c, 0xe3, 0xd9, 0x13, 0xe1, 0x05, 0x3c, 0x06, 0x32, 0x1b,
+  0x1d, 0x19, 0x40, 0x0a, 0x39, 0x3a, 0x44, 0x0d, 0x3d, 0x32, 0x22, 0x06,
+  0xee, 0xf5, 0x1b, 0x2e, 0xdb, 0x02, 0x04, 0x07, 0x1a, 0x18, 0xf5, 0x23,
+  0x44, 0x3a, 0xde, 0x08, 0x4d, 0x31, 0x32, 0xef, 0x2c, 0xe8, 0x00, 0x58,
+  0x3a, 0xe9, 0x34, 0xf5, 0x4b, 0x3f, 0x13, 0xe5, 0x29, 0x36, 0xf1, 0x4e,
+  0x17, 0xf6, 0xe2, 0x39, 0xe4, 0x30, 0xf2, 0xda, 0xcf, 0x2d, 0x07, 0x1f,
+  0x2e, 0x26, 0xfb, 0xe4, 0x15, 0x42, 0xe7, 0x2f, 0x4e, 0x30, 0x11, 0x23,
+  0xec, 0xae, 0x0f, 0xd1, 0xf5, 0x06, 0x15, 0x34, 0x31, 0xbc, 0x97, 0x1e,
+  0xcf, 0x63, 0x0e, 0xaf, 0xd2, 0xac, 0x1d, 0xde, 0x36, 0xf8, 0x35, 0xf4,
+  0x28, 0xd8, 0xf8, 0x0f, 0xef, 0x1c, 0x0e, 0xf2, 0xdf, 0xeb, 0xe3, 0x31,
+  0xd5, 0xc8, 0xf7, 0xe2, 0xfe, 0x29, 0x2f, 0xf1, 0xec, 0x44, 0x15, 0xc5,
+  0xea, 0x23, 0xdf, 0x15, 0xe2, 0xc8, 0x06, 0x15, 0x35, 0xac, 0x1d, 0xe4,
+  0x1a, 0x1c, 0x96, 0xe1, 0xf5, 0x16, 0x36, 0x18, 0xf9, 0x39, 0x26, 0x25,
+  0xf6, 0x30, 0xf6, 0xc7, 0x3a, 0xbe, 0x0c, 0x30, 0x1a, 0x48, 0xfb, 0x33,
+  0x06, 0x1e, 0xf3, 0x09, 0xf6, 0x37, 0x23, 0x1f, 0x0f, 0x01, 0x2a, 0x14,
+  0x06, 0x28, 0xcd, 0xe5, 0x3b, 0x09, 0xf4, 0x2a, 0x53, 0x23, 0x27, 0x29,
+  0xfe, 0x12, 0x28, 0xec, 0x2d, 0x03, 0x0b, 0x36, 0x1b, 0xf1, 0xf7, 0xec,
+  0x3c, 0x25, 0x01, 0x29, 0x35, 0x09, 0x08, 0x2f, 0x16, 0xf5, 0x3a, 0xf9,
+  0xf8, 0xd7, 0x46, 0x16, 0xea, 0xce, 0xed, 0x06, 0x31, 0x6b, 0x17, 0xc4,
+  0x04, 0xc5, 0x33, 0xc9, 0x0f, 0x09, 0x27, 0x28, 0x29, 0x0a, 0xcb, 0xc3,
+  0x2c, 0x06, 0x06, 0xde, 0xdd, 0x0e, 0xea, 0x30, 0xe1, 0xf7, 0xdf, 0x2f,
+  0xe9, 0x14, 0xd4, 0xd6, 0x18, 0xe9, 0xbd, 0xed, 0x34, 0xfb, 0x18, 0x2a,
+  0xfa, 0x1c, 0x06, 0xde, 0x1b, 0xed, 0x18, 0xce, 0xe1, 0xe3, 0xe0, 0x3b,
+  0xf0, 0xda, 0x19, 0xd6, 0x28, 0xfe, 0xda, 0x16, 0x12, 0xcf, 0x1b, 0x32,
+  0xbc, 0xbd, 0x23, 0x30, 0x06, 0x23, 0x0f, 0xe1, 0xe1, 0x04, 0x22, 0xdb,
+  0x0c, 0x24, 0xe9, 0x22, 0xf5, 0x15, 0xde, 0xce, 0x0d, 0x24, 0xdb, 0xfa,
+  0x09, 0x20, 0xd8, 0x01, 0xc9, 0xcd, 0xcf, 0xeb, 0xf3, 0xc6, 0x1d, 0xcb,
+  0xe2, 0x21, 0xd4, 0x29, 0x20, 0xc0, 0xf8, 0xd4, 0xcc, 0xc2, 0x18, 0xed,
+  0xfc, 0xfb, 0x12, 0xe7, 0x38, 0x1f, 0x12, 0x44, 0x15, 0x3d, 0x1b, 0x05,
+  0xf5, 0x1d, 0x37, 0xbf, 0x1b, 0xbd, 0x36, 0x30, 0x52, 0x1f, 0x35, 0xfe,
+  0x45, 0xe9, 0x2b, 0x2a, 0x07, 0xf6, 0x26, 0x2e, 0xf7, 0x4a, 0xfa, 0x0a,
+  0x49, 0x16, 0xd2, 0xd8, 0x39, 0x32, 0xcb, 0x4e, 0xf7, 0x51, 0xe7, 0x03,
+  0x40, 0xfa, 0x32, 0x09, 0x06, 0x3e, 0x02, 0x14, 0xf1, 0x37, 0xf5, 0x2b,
+  0xe4, 0x1b, 0xe4, 0x53, 0x3b, 0x2d, 0x26, 0x37, 0xe8, 0xdc, 0xdc, 0xf3,
+  0x0b, 0x14, 0xff, 0x03, 0xdb, 0x05, 0xcf, 0xed, 0xd4, 0x2b, 0xf7, 0xce,
+  0x04, 0x1f, 0xf5, 0xd1, 0xee, 0x14, 0xd9, 0xe4, 0xdb, 0xd5, 0xf5, 0xd3,
+  0xd9, 0x36, 0xe7, 0xef, 0xf9, 0xf2, 0x0b, 0x13, 0xca, 0x09, 0xce, 0xe8,
+  0xe8, 0xed, 0xe2, 0xf3, 0x20, 0xf1, 0x28, 0x24, 0xde, 0xd7, 0xcf, 0x33,
+  0x14, 0x2d, 0xca, 0x1e, 0x0f, 0xfe, 0x09, 0xcd, 0x30, 0xe0, 0x0e, 0x0d,
+  0x05, 0x4e, 0xda, 0x25, 0x3b, 0xf7, 0x11, 0xf8, 0xf7, 0x0b, 0x0c, 0xd2,
+  0x35, 0xb7, 0x1a, 0xf8, 0x29, 0x49, 0x40, 0x03, 0x24, 0x0d, 0x3e, 0x4c,
+  0x1b, 0x0a, 0x1c, 0x25, 0x3f, 0x13, 0xee, 0x40, 0x12, 0xf6, 0xdd, 0xe4,
+  0x4b, 0x48, 0xdb, 0x03, 0x51, 0x4f, 0x18, 0x26, 0xf9, 0x08, 0xff, 0x29,
+  0xe8, 0x43, 0xed, 0xe6, 0xed, 0x2a, 0x0f, 0x24, 0x13, 0x28, 0xe0, 0x44,
+  0x50, 0xf6, 0xf3, 0x08, 0xc8, 0xf8, 0x23, 0xe9, 0x11, 0xfc, 0xdb, 0x15,
+  0x21, 0xfd, 0xe8, 0x00, 0x13, 0xcf, 0x03, 0x12, 0x1a, 0xda, 0xf9, 0x09,
+  0xcb, 0xeb, 0xf6, 0xe8, 0xdd, 0xcd, 0x28, 0x0e, 0x1c, 0xd3, 0xe5, 0xcc,
+  0xc7, 0xe6, 0x31, 0xdc, 0xcb, 0xef, 0x09, 0xd3, 0x09, 0x0b, 0xe9, 0xef,
+  0x1b, 0xcc, 0xcf, 0xed, 0xff, 0xe1, 0xf3, 0xf3, 0x23, 0xec, 0xf5, 0x26,
+  0x13, 0xef, 0x02, 0x2a, 0xd2, 0xfb, 0x31, 0x08, 0x29, 0x24, 0x31, 0x15,
+  0xd3, 0x1f, 0x00, 0xfc, 0xdf, 0xda, 0x31, 0x01, 0xe0, 0xc8, 0xd0, 0xfa,
+  0x20, 0x3f, 0xd5, 0x15, 0x3a, 0xfb, 0xce, 0xde, 0x04, 0x84, 0xf2, 0x01,
+  0xf3, 0x2d, 0x17, 0xd7, 0xf5, 0x29, 0xda, 0x81, 0xdf, 0x00, 0xcb, 0xe9,
+  0xfe, 0xeb, 0xd0, 0x24, 0x44, 0x10, 0x35, 0xd1, 0xf4, 0x20, 0xe2, 0x3b,
+  0xca, 0xfd, 0xf8, 0x18, 0x57, 0xc7, 0xd0, 0x34, 0x73, 0xe8, 0x23, 0x1c,
+  0xfa, 0xdd, 0x1f, 0xf9, 0xe1, 0x22, 0xc0, 0xff, 0x2d, 0xf6, 0x36, 0x93,
+  0x14, 0x93, 0x02, 0x30, 0x45, 0x18, 0xe5, 0xfa, 0x06, 0x04, 0xca, 0x0a,
+  0xcb, 0xa0, 0xe5, 0x49, 0x33, 0x3e, 0x3b, 0x3e, 0x50, 0xe7, 0xa2, 0xb0,
+  0xe5, 0x18, 0xd0, 0x21, 0xe0, 0x1d, 0x06, 0x22, 0xd7, 0x3b, 0x3c, 0x4a,
+  0x98, 0xf1, 0x01, 0x36, 0x21, 0x02, 0x3b, 0xee, 0x47, 0x1d, 0xd7, 0x0f,
+  0x22, 0xf0, 0x42, 0x25, 0x06, 0x00, 0x08, 0x00, 0x04, 0x00, 0x00, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+  0x46, 0xdf, 0x4d, 0x24, 0x1a, 0x09, 0x44, 0xd0, 0xfd, 0x07, 0x20, 0xca,
+  0x23, 0xe3, 0x02, 0x05, 0xd0, 0xdf, 0x19, 0x4d, 0x46, 0xea, 0xf3, 0x2f,
+  0x20, 0xe4, 0x3c, 0x33, 0x25, 0xe7, 0x77, 0x31, 0x2f, 0x29, 0x27, 0xe3,
+  0x29, 0x00, 0xf8, 0x17, 0x2b, 0xe5, 0x33, 0xd3, 0xe5, 0x53, 0xcc, 0x18,
+  0x24, 0x22, 0xce, 0x26, 0x04, 0xec, 0x10, 0x2c, 0x51, 0xc2, 0x0b, 0xd1,
+  0x05, 0xe8, 0xdb, 0xfe, 0x29, 0xe8, 0x0b, 0xef, 0xd2, 0x12, 0x2a, 0xdb,
+  0xec, 0xdb, 0xdf, 0xbc, 0x49, 0xb5, 0xed, 0x3f, 0x13, 0x31, 0xfe, 0x52,
+  0x11, 0x10, 0x32, 0xde, 0xcc, 0xdf, 0x4a, 0x16, 0x2f, 0x28, 0x0e, 0x56,
+  0xe0, 0xcf, 0x1e, 0x0b, 0x34, 0x31, 0xfb, 0x26, 0x0f, 0xdf, 0xf8, 0x12,
+  0x04, 0xcd, 0x1f, 0x0f, 0xe7, 0x03, 0x21, 0x2b, 0x1e, 0xc2, 0x17, 0xfb,
+  0xe8, 0xd9, 0xc6, 0xfb, 0xe5, 0x05, 0xf0, 0xe6, 0xe6, 0x2b, 0xf2, 0x00,
+  0x2d, 0x2c, 0xe8, 0x31, 0x10, 0x19, 0xcc, 0xfc, 0x0b, 0x0d, 0xd8, 0x1c,
+  0x11, 0x2d, 0x09, 0x2f, 0xc4, 0xea, 0xfe, 0xd0, 0x12, 0x13, 0x04, 0xe3,
+  0xd6, 0x0e, 0xe6, 0x11, 0x3f, 0x2e, 0x25, 0x26, 0xd8, 0xff, 0x0c, 0x0b,
+  0x35, 0xfb, 0x2a, 0xed, 0x13, 0xe2, 0x4c, 0xf2, 0xfb, 0x07, 0xe7, 0xe6,
+  0x12, 0xf9, 0xcd, 0xe0, 0xda, 0xfa, 0x11, 0x14, 0x28, 0xcf, 0x7f, 0x4c,
+  0xe6, 0xee, 0x4f, 0x41, 0xf4, 0xf5, 0x0d, 0xe3, 0xf7, 0xdd, 0xe6, 0xc1,
+  0xf2, 0xd9, 0x42, 0x23, 0xe0, 0xff, 0x35, 0xfa, 0xff, 0x35, 0xce, 0x30,
+  0x01, 0x04, 0x48, 0xd2, 0xf0, 0x0e, 0x1e, 0x22, 0x27, 0xf3, 0x0e, 0xcb,
+  0x13, 0xfe, 0xdc, 0x2a, 0x0b, 0xdc, 0xcc, 0x2f, 0xd4, 0xd5, 0xed, 0x03,
+  0xde, 0xf8, 0x1d, 0x34, 0xd3, 0xe4, 0xc8, 0xf7, 0x06, 0xf8, 0x1f, 0xe9,
+  0xfe, 0x01, 0x10, 0xef, 0x32, 0xfb, 0xfe, 0xe5, 0x06, 0x02, 0xcc, 0x2e,
+  0xe7, 0xd7, 0xed, 0xdf, 0x06, 0xcd, 0xf6, 0x08, 0x27, 0x01, 0xd7, 0xdf,
+  0xd4, 0xd3, 0xea, 0x20, 0x25, 0x28, 0x26, 0x26, 0x00, 0x25, 0x31, 0x1d,
+  0x1d, 0xea, 0x1e, 0xdb, 0x17, 0xe0, 0x3f, 0x29, 0xc8, 0x2c, 0xe2, 0xbf,
+  0x42, 0x9e, 0x29, 0xdc, 0x21, 0x18, 0xfa, 0xea, 0xf1, 0x17, 0xff, 0x23,
+  0xcb, 0xec, 0x25, 0xd6, 0x03, 0x35, 0x4e, 0x18, 0xc8, 0x01, 0x2f, 0xe1,
+  0xf7, 0xf7, 0xfa, 0x0d, 0x0b, 0xe2, 0xcc, 0x25, 0xfb, 0x1a, 0xf0, 0xd1,
+  0xd7, 0x33, 0xdf, 0x07, 0x23, 0xdc, 0xf2, 0xe4, 0x13, 0x2d, 0xfe, 0xf9,
+  0xef, 0xee, 0xef, 0xe5, 0x4a, 0x17, 0xf0, 0x00, 0xd9, 0x46, 0x3b, 0x26,
+  0x2f, 0xfa, 0x34, 0x14, 0xed, 0xd9, 0x01, 0x1b, 0x32, 0xe5, 0x0a, 0x3b,
+  0x1c, 0x15, 0xf0, 0x2c, 0xb0, 0x0e, 0x34, 0x23, 0xe4, 0xe0, 0x5f, 0x58,
+  0xdb, 0xd6, 0x0d, 0x03, 0xea, 0xf7, 0xff, 0xda, 0xd3, 0x11, 0xea, 0x11,
+  0x06, 0x01, 0xeb, 0xe3, 0xdd, 0x24, 0xc9, 0xd4, 0x10, 0x17, 0xca, 0x00,
+  0xf4, 0x0b, 0x2b, 0x11, 0xef, 0xf0, 0x0b, 0xcd, 0x08, 0xde, 0xfd, 0xc2,
+  0x2f, 0x23, 0xe8, 0x2f, 0xce, 0xeb, 0xe6, 0x06, 0xfa, 0x23, 0x12, 0x1c,
+  0x03, 0x2a, 0xfe, 0x28, 0x2e, 0xf4, 0xea, 0x27, 0xf7, 0xde, 0xcc, 0xe3,
+  0x1a, 0xe4, 0x13, 0xf7, 0xf4, 0x21, 0x2e, 0x1a, 0xec, 0xf3, 0x14, 0xc7,
+  0xc6, 0x17, 0x1b, 0xdc, 0x0b, 0xe0, 0xc3, 0xf6, 0xda, 0x2e, 0x0c, 0xf6,
+  0xdd, 0x21, 0x0b, 0x0c, 0xfd, 0xf9, 0xc4, 0x2f, 0xdf, 0xec, 0x1d, 0x24,
+  0x3b, 0xf3, 0x3b, 0xee, 0xe7, 0x01, 0x4a, 0x06, 0xe7, 0x1c, 0xf4, 0xf7,
+  0x4a, 0xca, 0x41, 0x1a, 0xd2, 0xd2, 0x4a, 0x2e, 0x3c, 0x45, 0xfc, 0x46,
+  0xb7, 0x25, 0x0d, 0x14, 0x2c, 0xed, 0x19, 0xf5, 0x06, 0x00, 0x08, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x10, 0x00, 0x00, 0x00, 0x79, 0xb0, 0x44, 0xa2, 0xcf, 0x63, 0x62, 0xd8,
+  0x8a, 0x19, 0x9a, 0x23, 0xed, 0x99, 0xd0, 0x7f
+};
+const int breathing_rate_model_int8_tflite_len = 6128;
@@ -0,0 +1,291 @@
+// Host benchmark: replays a recorded CSI capture through the original O(N) motion
+// detector and the streaming csi_motion detector, packet by packet exactly as
+// csi_process() fills csi_q, checks that both give the same decisions and reports
+// the time each spends per packet.
+//
+// Build: gcc -O2 -o motion_detection_benchmark motion_detection_benchmark.c csi_motion.c -lm
+//        (add -DCSI_FIXED_POINT=1 to measure the integer pipeline against the float reference)
+// Usage: ./motion_detection_benchmark [capture.csv ...]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include "csi_motion.h"
+
+#define CSI_BUFFER_LENGTH 800
+#define CSI_FIFO_LENGTH 100
+#define MAX_PACKET_LEN 612
+#if CSI_FIXED_POINT
+// Only reported: the integer EMA and Q8 scores are not bit-identical to float
+#define AMPLITUDE_TOLERANCE 2.0f
+#else
+#define AMPLITUDE_TOLERANCE 0.01f
+#endif
+
+typedef struct {
+    float amplitude;
+    int intensity;
+    bool raw;
+    bool final;
+} motion_result_t;
+
+typedef struct {
+    float motion_amplitude;
+    int motion_intensity;
+    bool last_few_results[5];
+    int history_index;
+    int continuous_motion_count;
+} motion_state_t;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Thresholds, scores, vote and state machine, shared by both detectors (as in app_main.c)
+static motion_result_t decide(motion_state_t* st, float signal_std, float max_variance, float diff_energy) {
+    const float base_threshold = 50.0f;
+    float threshold = fmaxf(base_threshold, signal_std * 0.9f);
+    float diff_threshold = fmaxf(60.0f, signal_std * 1.5f);
+
+    bool motion_by_variance = (max_variance > threshold);
+    bool motion_by_diff = (diff_energy > diff_threshold);
+    bool motion_detected = (motion_by_variance && motion_by_diff) ||
+                           (max_variance > threshold * 2.0f) ||
+                           (diff_energy > diff_threshold * 1.5f);
+
+    float variance_score = fminf((max_variance / (threshold * 3.0f)) * 100.0f, 100.0f);
+    float diff_score = fminf((diff_energy / (diff_threshold * 3.0f)) * 100.0f, 100.0f);
+    st->motion_amplitude = (variance_score + diff_score) / 2.0f;
+
+    if (st->motion_amplitude < 30.0f) st->motion_intensity = 0;
+    else if (st->motion_amplitude < 50.0f) st->motion_intensity = 1;
+    else if (st->motion_amplitude < 75.0f) st->motion_intensity = 2;
+    else st->motion_intensity = 3;
+
+    st->last_few_results[st->history_index] = motion_detected;
+    st->history_index = (st->history_index + 1) % 5;
+    int motion_count = 0;
+    for (int i = 0; i < 5; i++)
+        if (st->last_few_results[i]) motion_count++;
+    bool history_vote = (motion_count >= 3);
+
+    if (motion_detected) {
+        st->continuous_motion_count = (st->motion_amplitude > 60.0f) ? fminf(st->continuous_motion_count + 2, 10) : fminf(st->continuous_motion_count + 1, 10);
+    } else {
+        st->continuous_motion_count = fmaxf(st->continuous_motion_count - 1, 0);
+    }
+    bool state_machine_result = (st->motion_amplitude > 75.0f) || (st->continuous_motion_count >= 4);
+
+    motion_result_t r = {st->motion_amplitude, st->motion_intensity, motion_detected, state_machine_result && history_vote};
+    return r;
+}
+
+#if CSI_FIXED_POINT
+// The Q8 branch of motion_detection() in app_main.c
+static motion_result_t decide_q8(motion_state_t* st, const csi_motion_features_q8_t* f) {
+    int32_t threshold = csi_mul_q15(f->signal_std, 29491);
+    if (threshold < (50 << 8)) threshold = 50 << 8;
+    int32_t diff_threshold = f->signal_std + f->signal_std / 2;
+    if (diff_threshold < (60 << 8)) diff_threshold = 60 << 8;
+
+    bool motion_detected = (f->max_variance > threshold && f->diff_energy > diff_threshold) ||
+                           ((int64_t)f->max_variance > (int64_t)threshold * 2) ||
+                           ((int64_t)f->diff_energy * 2 > (int64_t)diff_threshold * 3);
+    int64_t variance_score = (int64_t)f->max_variance * (100 << 8) / ((int64_t)threshold * 3);
+    int64_t diff_score = (int64_t)f->diff_energy * (100 << 8) / ((int64_t)diff_threshold * 3);
+    if (variance_score > (100 << 8)) variance_score = 100 << 8;
+    if (diff_score > (100 << 8)) diff_score = 100 << 8;
+    int32_t amplitude = (int32_t)((variance_score + diff_score) / 2);
+    st->motion_amplitude = amplitude * (1.0f / CSI_Q8_ONE);
+
+    if (amplitude < (30 << 8)) st->motion_intensity = 0;
+    else if (amplitude < (50 << 8)) st->motion_intensity = 1;
+    else if (amplitude < (75 << 8)) st->motion_intensity = 2;
+    else st->motion_intensity = 3;
+
+    st->last_few_results[st->history_index] = motion_detected;
+    st->history_index = (st->history_index + 1) % 5;
+    int motion_count = 0;
+    for (int i = 0; i < 5; i++)
+        if (st->last_few_results[i]) motion_count++;
+    bool history_vote = (motion_count >= 3);
+
+    if (motion_detected) {
+        st->continuous_motion_count = (st->motion_amplitude > 60.0f) ? fminf(st->continuous_motion_count + 2, 10) : fminf(st->continuous_motion_count + 1, 10);
+    } else {
+        st->continuous_motion_count = fmaxf(st->continuous_motion_count - 1, 0);
+    }
+    bool state_machine_result = (st->motion_amplitude > 75.0f) || (st->continuous_motion_count >= 4);
+
+    motion_result_t r = {st->motion_amplitude, st->motion_intensity, motion_detected, state_machine_result && history_vote};
+    return r;
+}
+#endif
+
+// The statistics part of motion_detection() before csi_motion, unchanged
+static void batch_features(const int16_t* csi_q, int csi_q_index, float* out_std, float* out_max_var, float* out_diff) {
+    const int window_size = 30;
+    const float alpha = 0.4;
+
+    float signal_mean = 0;
+    for (int i = 0; i < csi_q_index; i++)
+        signal_mean += csi_q[i];
+    signal_mean /= csi_q_index;
+
+    float signal_variance = 0;
+    for (int i = 0; i < csi_q_index; i++)
+        signal_variance += (csi_q[i] - signal_mean) * (csi_q[i] - signal_mean);
+    float signal_std = sqrtf(signal_variance / csi_q_index);
+
+    int16_t smoothed[CSI_BUFFER_LENGTH];
+    smoothed[0] = csi_q[0];
+    for (int i = 1; i < csi_q_index; i++) {
+        smoothed[i] = alpha * csi_q[i] + (1 - alpha) * smoothed[i - 1];
+    }
+
+    float max_variance = 0;
+    for (int start = 0; start < csi_q_index - window_size; start += window_size / 2) {
+        float mean = 0, variance = 0;
+        for (int i = 0; i < window_size && (start + i) < csi_q_index; i++) {
+            mean += smoothed[start + i];
+        }
+        mean /= window_size;
+        for (int i = 0; i < window_size && (start + i) < csi_q_index; i++) {
+            variance += (smoothed[start + i] - mean) * (smoothed[start + i] - mean);
+        }
+        variance /= window_size;
+        max_variance = fmaxf(max_variance, variance);
+    }
+
+    float diff_energy = 0;
+    for (int i = 1; i < csi_q_index; i++) {
+        diff_energy += (smoothed[i] - smoothed[i - 1]) * (smoothed[i] - smoothed[i - 1]);
+    }
+    diff_energy /= (csi_q_index - 1);
+
+    *out_std = signal_std;
+    *out_max_var = max_variance;
+    *out_diff = diff_energy;
+}
+
+static int parse_packet(char* line, int8_t* packet) {
+    char* data_start = strchr(line, '[');
+    if (!data_start) return 0;
+    int len = 0;
+    char* token = strtok(data_start + 1, ",]");
+    while (token && len < MAX_PACKET_LEN) {
+        if (*token != '"' && *token != '\n') packet[len++] = (int8_t)atoi(token);
+        token = strtok(NULL, ",]");
+    }
+    return len;
+}
+
+static int run_file(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        printf("Error: Cannot open file %s\n", filename);
+        return -1;
+    }
+
+    static char line[8192];
+    static int16_t csi_q[CSI_BUFFER_LENGTH];
+    static csi_motion_t motion;
+    int8_t packet[MAX_PACKET_LEN];
+    int csi_q_index = 0;
+    motion_state_t batch_state = {0}, stream_state = {0};
+    csi_motion_init(&motion);
+
+    long packets = 0, evaluated = 0, mismatches = 0, decision_mismatches = 0;
+    float max_amp_error = 0;
+    double batch_ns = 0, stream_ns = 0;
+
+    fgets(line, sizeof(line), file);
+    while (fgets(line, sizeof(line), file)) {
+        int length = parse_packet(line, packet);
+        if (length == 0) continue;
+        packets++;
+
+        // Same buffer handling as csi_process()
+        double t0 = now_ns();
+        if (csi_q_index + length > CSI_BUFFER_LENGTH) {
+            int shift = csi_q_index < CSI_FIFO_LENGTH ? csi_q_index : CSI_FIFO_LENGTH;
+            memmove(csi_q, csi_q + shift, (csi_q_index - shift) * sizeof(int16_t));
+            csi_q_index -= shift;
+            csi_motion_drop(&motion, shift);
+        }
+        int appended_from = csi_q_index;
+        for (int i = 0; i < length && csi_q_index < CSI_BUFFER_LENGTH; i++) {
+            csi_q[csi_q_index++] = packet[i];
+        }
+        csi_motion_push(&motion, csi_q + appended_from, csi_q_index - appended_from);
+        double t1 = now_ns();
+        stream_ns += t1 - t0;
+
+        if (csi_q_index < 50) continue;
+        evaluated++;
+
+        float std_b, max_var_b, diff_b;
+        t0 = now_ns();
+        batch_features(csi_q, csi_q_index, &std_b, &max_var_b, &diff_b);
+        motion_result_t rb = decide(&batch_state, std_b, max_var_b, diff_b);
+        t1 = now_ns();
+        batch_ns += t1 - t0;
+
+        t0 = now_ns();
+#if CSI_FIXED_POINT
+        csi_motion_features_q8_t f;
+        csi_motion_features_q8(&motion, &f);
+        motion_result_t rs = decide_q8(&stream_state, &f);
+#else
+        csi_motion_features_t f;
+        csi_motion_features(&motion, &f);
+        motion_result_t rs = decide(&stream_state, f.signal_std, f.max_variance, f.diff_energy);
+#endif
+        t1 = now_ns();
+        stream_ns += t1 - t0;
+
+        float amp_error = fabsf(rb.amplitude - rs.amplitude);
+        if (amp_error > max_amp_error) max_amp_error = amp_error;
+        bool decision_differs = rb.raw != rs.raw || rb.final != rs.final || rb.intensity != rs.intensity;
+        if (decision_differs) decision_mismatches++;
+        if (decision_differs || amp_error > AMPLITUDE_TOLERANCE) {
+            if (mismatches < 10) {
+                printf("Mismatch at packet %ld: batch amp=%.4f int=%d raw=%d final=%d | stream amp=%.4f int=%d raw=%d final=%d\n",
+                       packets, rb.amplitude, rb.intensity, rb.raw, rb.final, rs.amplitude, rs.intensity, rs.raw, rs.final);
+            }
+            mismatches++;
+        }
+    }
+    fclose(file);
+
+    printf("File: %s\n", filename);
+    printf("Packets: %ld, evaluated: %ld, mismatches: %ld (decisions: %ld), max amplitude error: %.6f\n",
+           packets, evaluated, mismatches, decision_mismatches, max_amp_error);
+    if (evaluated > 0) {
+        printf("Batch detector:     %.1f ns/packet\n", batch_ns / evaluated);
+        printf("Streaming detector: %.1f ns/packet (buffer updates included)\n", stream_ns / evaluated);
+        printf("Speedup: %.1fx\n", batch_ns / stream_ns);
+    }
+    return mismatches > 0 ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    const char* default_files[] = {
+        "../../../benchmark/breathing_rate/evaluation/CSI20250227_193124.csv",
+        "../../../benchmark/breathing_rate/evaluation/CSI20250227_191018.csv"
+    };
+    int num_files = argc > 1 ? argc - 1 : (int)(sizeof(default_files) / sizeof(default_files[0]));
+
+    int failed = 0;
+    for (int i = 0; i < num_files; i++) {
+        const char* filename = argc > 1 ? argv[i + 1] : default_files[i];
+        int result = run_file(filename);
+        if (result != 0) failed = 1;
+        printf("\n");
+    }
+    return failed;
+}
@@ -0,0 +1,283 @@
+// Host benchmark: runs the breathing network through TFLM, exactly as the firmware
+// does (NeuralNetwork_breathing_rate.cc), over every window of the benchmark
+// recordings, with the features csi_features computes for the SVM. Reports the MAE
+// against the ground truth, the percentiles of the time one inference takes,
+// inferences per second and the tensor arena the model needs. --compare adds the
+// linear model of breathing_rate_evaluation_svm.c on the same windows, prints every
+// model side by side, window by window, and the mean and largest difference of each
+// pair: the int8 network against the float one, both against the linear model.
+//
+// MAE is over the STEP_SIZE windows the ground truth covers, as the evaluators
+// score; latency over every window, a hop of one sample, until BENCH_SECONDS
+// have passed. A latency is setInput() excluded, predict() included: Invoke()
+// and the dequantisation of its one output.
+//
+// Build in a scratch directory, host_build/, so nothing generated lands next to the
+// sources: an nn_op_resolver.h here would shadow the one the firmware build makes.
+// First the op resolver, generated as the firmware build does, and the C objects:
+//   mkdir -p host_build
+//   python3 nn_op_resolver_gen.py -o host_build/nn_op_resolver.h model_data.cc model_data_int8.cc
+//   for f in breathing_rate_evaluation_svm csi_features csi_model csi_serial; do
+//       gcc -O2 -DSVM_EVALUATION_NO_MAIN -c $f.c -o host_build/$f.o; done
+//   SOURCES="nn_breathing_benchmark.cc NeuralNetwork_breathing_rate.cc model_data.cc model_data_int8.cc host_build/*.o"
+// Against TFLM: a tflite-micro checkout $TFLM with its library built for the host.
+// The first make fetches flatbuffers, gemmlowp and ruy into downloads/, and the
+// library lands under gen/<target>_<arch>_<build>_<toolchain>/lib:
+//   MAKE_DIR=$TFLM/tensorflow/lite/micro/tools/make; DL=$MAKE_DIR/downloads
+//   make -C $TFLM -f tensorflow/lite/micro/tools/make/Makefile -j4 microlite
+//   g++ -O2 -std=c++17 -DTF_LITE_STATIC_MEMORY -I. -Ihost_build -I$TFLM -I$DL/flatbuffers/include
+//       -I$DL/gemmlowp -I$DL/ruy -o nn_breathing_benchmark $SOURCES
+//       $(find $MAKE_DIR/gen -name libtensorflow-microlite.a | head -1) -lm
+// Without TFLM, tflm_host/ stands in for it: the same sources against its headers
+// and runtime (tflm_host/tflm_host.cc). Rates and MAE are what TFLM computes;
+// latencies and the arena column are the stand-in's, not TFLM's:
+//   g++ -O2 -std=c++17 -I. -Ihost_build -Itflm_host -o nn_breathing_benchmark $SOURCES tflm_host/tflm_host.cc -lm
+// Against TFLM, the arena column is what NN_ARENA_SIZE is set from; add
+// -DNN_ARENA_SIZE=<bytes> to check that both built-in networks still load with it.
+// Usage: ./nn_breathing_benchmark [--compare] [model.tflite | blob.bin ...]
+//   Without a model: the built-in int8 and float networks. A csi_model_pack blob
+//   brings the means and scales its network was trained behind, if it has them.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <vector>
+#include "NeuralNetwork_breathing_rate.h"
+#include "model_data.h"
+#include "breathing_rate_evaluation_svm.h"
+#include "csi_features.h"
+
+#define MAX_SAMPLES 16000
+#define MAX_GT 200
+// Minimum time spent timing one model
+#define BENCH_SECONDS 0.2
+
+static const char* csi_files[] = {
+    "../../../benchmark/breathing_rate/evaluation/CSI20250227_193124.csv",
+    "../../../benchmark/breathing_rate/evaluation/CSI20250227_191018.csv",
+};
+static const char* gt_files[] = {
+    "../../../benchmark/breathing_rate/evaluation/gt_20250227_193124.csv",
+    "../../../benchmark/breathing_rate/evaluation/gt_20250227_191018.csv",
+};
+#define NUM_FILES (int)(sizeof(csi_files) / sizeof(csi_files[0]))
+
+// Raw features of every window, in stream order
+struct window_t {
+    float features[FEATURE_SIZE];
+    float gt;   // Ground truth of a scored window, NAN otherwise
+    int file;
+};
+
+// One model under test: a network, or the linear model when nn is null
+struct candidate_t {
+    const char* name;
+    NeuralNetwork* nn;
+    size_t model_bytes;
+    std::vector<float> predictions;   // Per window
+    std::vector<double> latencies_ns; // Per inference timed
+};
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Slide csi_features along each recording, as the firmware does between hops
+static bool load_windows(std::vector<window_t>& windows) {
+    static float csi[MAX_SAMPLES];
+    static float gt[MAX_GT];
+    static csi_features_t features;
+    for (int f = 0; f < NUM_FILES; f++) {
+        int csi_len = read_csi_data(csi_files[f], csi, MAX_SAMPLES);
+        int gt_len = (int)read_gt_data(gt_files[f], gt, MAX_GT);
+        if (csi_len < 0 || gt_len < 0) return false;
+        csi_features_init(&features, WINDOW_SIZE);
+        for (int n = 0; n < csi_len; n++) {
+            window_t window;
+            csi_features_push(&features, (int16_t)csi[n]);
+            if (!csi_features_get(&features, window.features)) continue;
+            int start = n + 1 - WINDOW_SIZE;
+            bool scored = start % STEP_SIZE == 0 && start / STEP_SIZE < gt_len;
+            window.gt = scored ? gt[start / STEP_SIZE] : NAN;
+            window.file = f;
+            windows.push_back(window);
+        }
+        printf("%s: %d samples, %d scored windows\n", csi_files[f], csi_len, gt_len);
+    }
+    return true;
+}
+
+static float run(candidate_t& candidate, const window_t& window, bool timed) {
+    float bpm;
+    double start = 0;
+    if (candidate.nn) {
+        candidate.nn->setInput(window.features);
+        start = now_ns();
+        bpm = candidate.nn->predict();
+    } else {
+        start = now_ns();
+        bpm = predict(window.features);
+    }
+    if (timed) candidate.latencies_ns.push_back(now_ns() - start);
+    return bpm;
+}
+
+static void measure(candidate_t& candidate, const std::vector<window_t>& windows) {
+    for (const window_t& window : windows) candidate.predictions.push_back(run(candidate, window, false));
+    double start = now_ns();
+    do {
+        for (const window_t& window : windows) run(candidate, window, true);
+    } while (now_ns() - start < BENCH_SECONDS * 1e9);
+}
+
+// Mean of the per-file MAEs, as breathing_rate_evaluation_svm reports it
+static double mae(const candidate_t& candidate, const std::vector<window_t>& windows) {
+    double error[NUM_FILES] = {0};
+    int scored[NUM_FILES] = {0};
+    for (size_t w = 0; w < windows.size(); w++) {
+        if (isnan(windows[w].gt)) continue;
+        error[windows[w].file] += fabs(candidate.predictions[w] - windows[w].gt);
+        scored[windows[w].file]++;
+    }
+    double total = 0;
+    for (int f = 0; f < NUM_FILES; f++) total += scored[f] ? error[f] / scored[f] : 0;
+    return total / NUM_FILES;
+}
+
+static void report(candidate_t& candidate, const std::vector<window_t>& windows) {
+    std::vector<double>& ns = candidate.latencies_ns;
+    std::sort(ns.begin(), ns.end());
+    double sum = 0;
+    for (double t : ns) sum += t;
+    auto percentile = [&ns](double p) { return ns[(size_t)(p * (ns.size() - 1))]; };
+    char arena[32] = "-";
+    if (candidate.nn) snprintf(arena, sizeof(arena), "%zu/%d", candidate.nn->arenaUsedBytes(), NN_ARENA_SIZE);
+    printf("%-28.28s %6.2f %8.0f %8.0f %8.0f %8.0f %10.0f %10s %8zu\n", candidate.name, mae(candidate, windows),
+           percentile(0.5), percentile(0.9), percentile(0.99), ns.back(), ns.size() * 1e9 / sum, arena,
+           candidate.model_bytes);
+}
+
+// A .tflite file or a csi_model_pack blob; NULL, with the reason printed, if it does not load
+static NeuralNetwork* load_model(const char* path, size_t* bytes) {
+    csi_model_t blob;
+    const char* reason;
+    const void* tflite;
+    const float* nn_means = means;
+    const float* nn_scales = scales;
+    if (csi_model_map_file(path, &blob, &reason)) {
+        tflite = csi_model_tensor(&blob, "tflite", CSI_MODEL_U8, 0);
+        const float* blob_means = (const float*)csi_model_tensor(&blob, "means", CSI_MODEL_F32, FEATURE_SIZE);
+        const float* blob_scales = (const float*)csi_model_tensor(&blob, "scales", CSI_MODEL_F32, FEATURE_SIZE);
+        if (!tflite) {
+            printf("Error: %s holds no TFLite model\n", path);
+            return NULL;
+        }
+        if (blob_means && blob_scales) {
+            nn_means = blob_means;
+            nn_scales = blob_scales;
+        }
+        for (uint32_t i = 0; i < blob.header->tensor_count; i++) {
+            if (strcmp(blob.tensors[i].name, "tflite") == 0) *bytes = blob.tensors[i].count;
+        }
+    } else {
+        // Not a blob: a flatbuffer, read into 16-byte aligned memory as TFLM wants
+        FILE* file = fopen(path, "rb");
+        if (!file) {
+            printf("Error: cannot open %s\n", path);
+            return NULL;
+        }
+        fseek(file, 0, SEEK_END);
+        long length = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        void* data = length > 8 ? aligned_alloc(16, (length + 15) / 16 * 16) : NULL;
+        bool ok = data && fread(data, 1, length, file) == (size_t)length && memcmp((char*)data + 4, "TFL3", 4) == 0;
+        fclose(file);
+        if (!ok) {
+            printf("Error: %s is neither a model blob nor a TFLite flatbuffer\n", path);
+            free(data);
+            return NULL;
+        }
+        tflite = data;
+        *bytes = (size_t)length;
+    }
+    NeuralNetwork* nn = new NeuralNetwork(tflite, nn_means, nn_scales);
+    if (!nn->ready()) {
+        printf("Error: %s does not load\n", path);
+        delete nn;
+        return NULL;
+    }
+    return nn;
+}
+
+static void compare(const std::vector<candidate_t>& candidates, const std::vector<window_t>& windows) {
+    printf("\n%-8s %8s", "window", "truth");
+    for (const candidate_t& candidate : candidates) printf(" %14.14s", candidate.name);
+    printf("\n");
+    int index = 0;
+    for (size_t w = 0; w < windows.size(); w++) {
+        if (isnan(windows[w].gt)) continue;
+        printf("%-8d %8.2f", index++, windows[w].gt);
+        for (const candidate_t& candidate : candidates) printf(" %14.2f", candidate.predictions[w]);
+        printf("\n");
+    }
+    // Every network against every later candidate, the linear model last, over all windows:
+    // the built-in int8 network against the float one it was quantised from, then both against linear
+    for (size_t c = 0; c + 1 < candidates.size(); c++) {
+        for (size_t d = c + 1; d < candidates.size(); d++) {
+            double sum = 0, max = 0;
+            for (size_t w = 0; w < windows.size(); w++) {
+                double diff = fabs(candidates[c].predictions[w] - candidates[d].predictions[w]);
+                sum += diff;
+                if (diff > max) max = diff;
+            }
+            printf("%s vs %s over %zu windows: mean |difference| %.3f BPM, max %.3f BPM\n", candidates[c].name,
+                   candidates[d].name, windows.size(), sum / windows.size(), max);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    bool with_linear = argc > 1 && strcmp(argv[1], "--compare") == 0;
+    int first_model = with_linear ? 2 : 1;
+
+    std::vector<window_t> windows;
+    if (!load_windows(windows)) return 1;
+#ifdef TFLM_HOST_STAND_IN
+    printf("Runtime: tflm_host stand-in, not TFLM; its latencies and arena figures are its own\n");
+#endif
+
+    std::vector<candidate_t> candidates;
+    if (first_model == argc) {
+        candidates.push_back({"built-in int8", new NeuralNetwork(breathing_rate_model_int8_tflite, means, scales),
+                              (size_t)breathing_rate_model_int8_tflite_len, {}, {}});
+        candidates.push_back({"built-in float", new NeuralNetwork(breathing_rate_model_tflite, means, scales),
+                              (size_t)breathing_rate_model_tflite_len, {}, {}});
+        for (const candidate_t& candidate : candidates) {
+            if (!candidate.nn->ready()) {
+                printf("Error: %s network does not load\n", candidate.name);
+                return 1;
+            }
+        }
+    }
+    for (int i = first_model; i < argc; i++) {
+        size_t bytes = 0;
+        NeuralNetwork* nn = load_model(argv[i], &bytes);
+        if (!nn) return 1;
+        const char* name = strrchr(argv[i], '/');
+        candidates.push_back({name ? name + 1 : argv[i], nn, bytes, {}, {}});
+    }
+    if (with_linear) candidates.push_back({"linear (svm)", NULL, sizeof(svm_model_t), {}, {}});
+
+    printf("\n%-28s %6s %8s %8s %8s %8s %10s %10s %8s\n", "model", "MAE", "p50 ns", "p90 ns", "p99 ns", "max ns",
+           "infer/s", "arena", "bytes");
+    for (candidate_t& candidate : candidates) {
+        measure(candidate, windows);
+        report(candidate, windows);
+    }
+    if (with_linear) compare(candidates, windows);
+    return 0;
+}
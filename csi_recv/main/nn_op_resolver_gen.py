@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""Generate the TFLM op resolver for the breathing networks the firmware ships.
+
+Reads every model given (a .tflite flatbuffer, a C array source such as
+model_data.cc, or a csi_model_pack blob) and writes nn_op_resolver.h: a
+MicroMutableOpResolver sized to exactly the builtin operators they use, and the
+function registering them. An operator without a known registration, or a
+custom one, fails the build here rather than AllocateTensors() on the device.
+
+The component's CMakeLists.txt runs this on model_data.cc and model_data_int8.cc
+at every build where they change. To check that a model meant for the nn_model
+partition only needs what the firmware registers:
+
+    python nn_op_resolver_gen.py --check build/esp-idf/main/nn_op_resolver.h model.tflite
+
+Standard library only, so it runs with the Python ESP-IDF itself uses.
+"""
+import argparse
+import re
+import struct
+import sys
+
+# BuiltinOperator values of the TFLite schema and the MicroMutableOpResolver
+# method registering each. Extend as models start to use more.
+REGISTRATIONS = {
+    0: ("ADD", "AddAdd"),
+    1: ("AVERAGE_POOL_2D", "AddAveragePool2D"),
+    2: ("CONCATENATION", "AddConcatenation"),
+    3: ("CONV_2D", "AddConv2D"),
+    4: ("DEPTHWISE_CONV_2D", "AddDepthwiseConv2D"),
+    6: ("DEQUANTIZE", "AddDequantize"),
+    9: ("FULLY_CONNECTED", "AddFullyConnected"),
+    14: ("LOGISTIC", "AddLogistic"),
+    17: ("MAX_POOL_2D", "AddMaxPool2D"),
+    18: ("MUL", "AddMul"),
+    19: ("RELU", "AddRelu"),
+    21: ("RELU6", "AddRelu6"),
+    22: ("RESHAPE", "AddReshape"),
+    25: ("SOFTMAX", "AddSoftmax"),
+    28: ("TANH", "AddTanh"),
+    34: ("PAD", "AddPad"),
+    40: ("MEAN", "AddMean"),
+    41: ("SUB", "AddSub"),
+    43: ("SQUEEZE", "AddSqueeze"),
+    45: ("STRIDED_SLICE", "AddStridedSlice"),
+    55: ("MAXIMUM", "AddMaximum"),
+    57: ("MINIMUM", "AddMinimum"),
+    70: ("EXPAND_DIMS", "AddExpandDims"),
+    98: ("LEAKY_RELU", "AddLeakyRelu"),
+    114: ("QUANTIZE", "AddQuantize"),
+    117: ("HARD_SWISH", "AddHardSwish"),
+}
+CUSTOM = 32
+
+CSI_MODEL_MAGIC = 0x4C444D43
+CSI_MODEL_U8 = 2
+
+
+def load_flatbuffer(path):
+    """The TFLite flatbuffer in a .tflite file, a C array source or a csi_model blob."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if path.endswith((".cc", ".c", ".h")):
+        text = data.decode()
+        body = text[text.index("{") + 1:text.index("}")]
+        data = bytes(int(byte, 16) for byte in re.findall(r"0x([0-9a-fA-F]{2})", body))
+    elif len(data) >= 24 and struct.unpack_from("<I", data, 0)[0] == CSI_MODEL_MAGIC:
+        # csi_model.h: 24-byte header, then 32-byte directory entries
+        count = struct.unpack_from("<I", data, 16)[0]
+        for i in range(count):
+            name, dtype, length, offset = struct.unpack_from("<16sIII", data, 24 + 32 * i)
+            if name.rstrip(b"\0") == b"tflite" and dtype == CSI_MODEL_U8:
+                data = data[offset:offset + length]
+                break
+        else:
+            raise ValueError("%s: blob holds no tflite tensor" % path)
+    if len(data) < 8 or data[4:8] != b"TFL3":
+        raise ValueError("%s: not a TFLite flatbuffer" % path)
+    return data
+
+
+def operators(data):
+    """BuiltinOperator values the model's operator codes refer to."""
+    u32 = lambda at: struct.unpack_from("<I", data, at)[0]
+    deref = lambda at: at + u32(at)
+
+    def field(table, n):
+        vtable = table - struct.unpack_from("<i", data, table)[0]
+        vtable_size = struct.unpack_from("<H", data, vtable)[0]
+        if 4 + 2 * n >= vtable_size:
+            return None
+        offset = struct.unpack_from("<H", data, vtable + 4 + 2 * n)[0]
+        return table + offset if offset else None
+
+    model = deref(0)
+    codes_at = field(model, 1)
+    if codes_at is None:
+        return set()
+    codes = deref(codes_at)
+    ops = set()
+    for i in range(u32(codes)):
+        code = deref(codes + 4 + 4 * i)
+        # builtin_code (int32) superseded deprecated_builtin_code (int8) at 127 operators
+        deprecated = field(code, 0)
+        builtin = field(code, 3)
+        value = max(struct.unpack_from("<b", data, deprecated)[0] if deprecated else 0,
+                    struct.unpack_from("<i", data, builtin)[0] if builtin else 0)
+        ops.add(value)
+    return ops
+
+
+def needed(paths):
+    ops = set()
+    for path in paths:
+        for op in operators(load_flatbuffer(path)):
+            if op == CUSTOM:
+                raise ValueError("%s: custom operators are not supported" % path)
+            if op not in REGISTRATIONS:
+                raise ValueError("%s: builtin operator %d has no registration in %s" % (path, op, __file__))
+            ops.add(op)
+    return sorted(ops)
+
+
+def write_header(path, ops, sources):
+    lines = [
+        "// Generated by nn_op_resolver_gen.py from %s; do not edit" % ", ".join(sources),
+        "#ifndef NN_OP_RESOLVER_H",
+        "#define NN_OP_RESOLVER_H",
+        "",
+        '#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"',
+        "",
+        "// Operators the built-in models use, and no others",
+        "#define NN_OP_COUNT %d" % len(ops),
+        "typedef tflite::MicroMutableOpResolver<NN_OP_COUNT> NnOpResolver;",
+        "",
+        "static inline TfLiteStatus nn_register_ops(NnOpResolver &resolver)",
+        "{",
+    ]
+    for op in ops:
+        name, method = REGISTRATIONS[op]
+        lines.append("  if (resolver.%s() != kTfLiteOk) // %s" % (method, name))
+        lines.append("    return kTfLiteError;")
+    lines += ["  return kTfLiteOk;", "}", "", "#endif // NN_OP_RESOLVER_H", ""]
+    with open(path, "w") as f:
+        f.write("\n".join(lines))
+
+
+def registered(header):
+    """Operators a generated header registers, from its comments."""
+    with open(header) as f:
+        names = re.findall(r"!= kTfLiteOk\) // (\w+)", f.read())
+    return {op for op, (name, _) in REGISTRATIONS.items() if name in names}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("models", nargs="+", help=".tflite, C array source or csi_model blob")
+    target = parser.add_mutually_exclusive_group(required=True)
+    target.add_argument("-o", "--output", help="header to write")
+    target.add_argument("--check", metavar="HEADER", help="fail if the models need operators HEADER lacks")
+    args = parser.parse_args()
+
+    try:
+        ops = needed(args.models)
+    except (OSError, ValueError) as error:
+        sys.exit("nn_op_resolver_gen: %s" % error)
+    if args.check:
+        missing = [REGISTRATIONS[op][0] for op in ops if op not in registered(args.check)]
+        if missing:
+            sys.exit("nn_op_resolver_gen: %s not registered by the firmware: %s" % (", ".join(args.models),
+                                                                                    ", ".join(missing)))
+        return
+    write_header(args.output, ops, [re.split(r"[\\/]", path)[-1] for path in args.models])
+
+
+if __name__ == "__main__":
+    main()
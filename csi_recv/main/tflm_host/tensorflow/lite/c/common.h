@@ -0,0 +1,37 @@
+// tflm_host stand-in (see tflm_host.cc): the part of TFLM's common.h that
+// NeuralNetwork_breathing_rate.cc uses, with TFLM's names and values.
+#ifndef TFLM_HOST_COMMON_H
+#define TFLM_HOST_COMMON_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum { kTfLiteOk = 0, kTfLiteError = 1 } TfLiteStatus;
+
+typedef enum {
+    kTfLiteNoType = 0,
+    kTfLiteFloat32 = 1,
+    kTfLiteInt32 = 2,
+    kTfLiteInt8 = 9,
+} TfLiteType;
+
+typedef struct {
+    float scale;
+    int32_t zero_point;
+} TfLiteQuantizationParams;
+
+typedef union {
+    int32_t* i32;
+    float* f;
+    int8_t* int8;
+    void* data;
+} TfLitePtrUnion;
+
+typedef struct {
+    TfLiteType type;
+    TfLitePtrUnion data;
+    TfLiteQuantizationParams params;  // First channel's, as in TFLM
+    size_t bytes;
+} TfLiteTensor;
+
+#endif // TFLM_HOST_COMMON_H
@@ -0,0 +1,80 @@
+// tflm_host stand-in (see tflm_host.cc): TFLM's interpreter interface, running
+// chains of FULLY_CONNECTED layers, float or int8, with the reference kernels'
+// arithmetic.
+#ifndef TFLM_HOST_MICRO_INTERPRETER_H
+#define TFLM_HOST_MICRO_INTERPRETER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/micro/micro_op_resolver.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+// Lets a host tool say its figures are not TFLM's
+#define TFLM_HOST_STAND_IN 1
+
+namespace tflite {
+
+class MicroInterpreter {
+public:
+    static constexpr int kMaxTensors = 32;
+    static constexpr int kMaxOps = 8;
+    static constexpr int kMaxIo = 4;
+    static constexpr int kMaxChannels = 256;
+
+    MicroInterpreter(const Model* model, const MicroOpResolver& op_resolver, uint8_t* tensor_arena,
+                     size_t tensor_arena_size);
+    MicroInterpreter(const MicroInterpreter&) = delete;
+
+    TfLiteStatus AllocateTensors();
+    TfLiteStatus Invoke();
+    TfLiteTensor* input(size_t index) { return index < inputs_count_ ? &tensors_[inputs_[index]] : nullptr; }
+    TfLiteTensor* output(size_t index) { return index < outputs_count_ ? &tensors_[outputs_[index]] : nullptr; }
+    size_t inputs_size() const { return inputs_count_; }
+    size_t outputs_size() const { return outputs_count_; }
+    // Activation buffers only: TFLM also keeps its tensor, node and kernel records in
+    // the arena, so it needs more than this for the same model
+    size_t arena_used_bytes() const { return arena_used_; }
+
+private:
+    struct Tensor {
+        int count;                  // Elements
+        const uint8_t* scales;      // Per-channel float scales in the flatbuffer, if any
+        uint32_t scale_count;
+        bool constant;
+    };
+    struct Op {
+        int input, weights, bias, output;  // bias -1 when absent
+        int activation;
+        // int8: per output channel, as the reference kernel's Prepare derives them
+        int32_t multiplier[kMaxChannels];
+        int shift[kMaxChannels];
+        int32_t act_min, act_max;
+    };
+
+    TfLiteStatus Fail(const char* what);
+    TfLiteStatus PrepareFullyConnected(Op* op);
+    void EvalFloat(const Op& op);
+    void EvalInt8(const Op& op);
+
+    const Model* model_;
+    const MicroOpResolver& resolver_;
+    uint8_t* arena_;
+    size_t arena_size_;
+    size_t arena_used_ = 0;
+    bool allocated_ = false;
+
+    TfLiteTensor tensors_[kMaxTensors];
+    Tensor info_[kMaxTensors];
+    int tensors_count_ = 0;
+    Op ops_[kMaxOps];
+    int ops_count_ = 0;
+    int inputs_[kMaxIo];
+    int outputs_[kMaxIo];
+    size_t inputs_count_ = 0;
+    size_t outputs_count_ = 0;
+};
+
+}  // namespace tflite
+
+#endif // TFLM_HOST_MICRO_INTERPRETER_H
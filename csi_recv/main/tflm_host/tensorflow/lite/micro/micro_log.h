@@ -0,0 +1,7 @@
+// tflm_host stand-in (see tflm_host.cc): TFLM's log call, to stdout.
+#ifndef TFLM_HOST_MICRO_LOG_H
+#define TFLM_HOST_MICRO_LOG_H
+
+void MicroPrintf(const char* format, ...);
+
+#endif // TFLM_HOST_MICRO_LOG_H
@@ -0,0 +1,74 @@
+// tflm_host stand-in (see tflm_host.cc): TFLM's fixed-size op resolver, with the
+// registration methods nn_op_resolver_gen.py can emit. Registering works for
+// every one of them, as with TFLM; the stand-in interpreter only runs
+// FULLY_CONNECTED and fails AllocateTensors() on a model using anything else.
+#ifndef TFLM_HOST_MICRO_MUTABLE_OP_RESOLVER_H
+#define TFLM_HOST_MICRO_MUTABLE_OP_RESOLVER_H
+
+#include "tensorflow/lite/micro/micro_op_resolver.h"
+#include "tensorflow/lite/micro/micro_log.h"
+
+namespace tflite {
+
+template <unsigned int tOpCount>
+class MicroMutableOpResolver : public MicroOpResolver {
+public:
+    bool HasBuiltin(int32_t op) const override {
+        for (unsigned int i = 0; i < count_; i++) {
+            if (ops_[i] == op) return true;
+        }
+        return false;
+    }
+
+#define TFLM_HOST_ADD(method, op) \
+    TfLiteStatus method() { return AddBuiltin(op); }
+    TFLM_HOST_ADD(AddAdd, 0)
+    TFLM_HOST_ADD(AddAveragePool2D, 1)
+    TFLM_HOST_ADD(AddConcatenation, 2)
+    TFLM_HOST_ADD(AddConv2D, 3)
+    TFLM_HOST_ADD(AddDepthwiseConv2D, 4)
+    TFLM_HOST_ADD(AddDequantize, 6)
+    TFLM_HOST_ADD(AddFullyConnected, 9)
+    TFLM_HOST_ADD(AddLogistic, 14)
+    TFLM_HOST_ADD(AddMaxPool2D, 17)
+    TFLM_HOST_ADD(AddMul, 18)
+    TFLM_HOST_ADD(AddRelu, 19)
+    TFLM_HOST_ADD(AddRelu6, 21)
+    TFLM_HOST_ADD(AddReshape, 22)
+    TFLM_HOST_ADD(AddSoftmax, 25)
+    TFLM_HOST_ADD(AddTanh, 28)
+    TFLM_HOST_ADD(AddPad, 34)
+    TFLM_HOST_ADD(AddMean, 40)
+    TFLM_HOST_ADD(AddSub, 41)
+    TFLM_HOST_ADD(AddSqueeze, 43)
+    TFLM_HOST_ADD(AddStridedSlice, 45)
+    TFLM_HOST_ADD(AddMaximum, 55)
+    TFLM_HOST_ADD(AddMinimum, 57)
+    TFLM_HOST_ADD(AddExpandDims, 70)
+    TFLM_HOST_ADD(AddLeakyRelu, 98)
+    TFLM_HOST_ADD(AddQuantize, 114)
+    TFLM_HOST_ADD(AddHardSwish, 117)
+#undef TFLM_HOST_ADD
+
+private:
+    // Fails, as TFLM does, on a second registration or one beyond tOpCount
+    TfLiteStatus AddBuiltin(int32_t op) {
+        if (HasBuiltin(op)) {
+            MicroPrintf("Calling AddBuiltin with the same op more than once is not supported (Op: #%d).", (int)op);
+            return kTfLiteError;
+        }
+        if (count_ >= tOpCount) {
+            MicroPrintf("Couldn't register builtin op #%d, resolver size is too small (%d).", (int)op, (int)tOpCount);
+            return kTfLiteError;
+        }
+        ops_[count_++] = op;
+        return kTfLiteOk;
+    }
+
+    int32_t ops_[tOpCount];
+    unsigned int count_ = 0;
+};
+
+}  // namespace tflite
+
+#endif // TFLM_HOST_MICRO_MUTABLE_OP_RESOLVER_H
@@ -0,0 +1,19 @@
+// tflm_host stand-in (see tflm_host.cc): what the interpreter asks a resolver.
+#ifndef TFLM_HOST_MICRO_OP_RESOLVER_H
+#define TFLM_HOST_MICRO_OP_RESOLVER_H
+
+#include <stdint.h>
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+
+class MicroOpResolver {
+public:
+    virtual ~MicroOpResolver() {}
+    // Whether the BuiltinOperator was registered
+    virtual bool HasBuiltin(int32_t op) const = 0;
+};
+
+}  // namespace tflite
+
+#endif // TFLM_HOST_MICRO_OP_RESOLVER_H
@@ -0,0 +1,27 @@
+// tflm_host stand-in (see tflm_host.cc): the model handle of TFLM's generated
+// schema, with only the accessor NeuralNetwork_breathing_rate.cc calls.
+#ifndef TFLM_HOST_SCHEMA_GENERATED_H
+#define TFLM_HOST_SCHEMA_GENERATED_H
+
+#include <stdint.h>
+
+#define TFLITE_SCHEMA_VERSION 3
+
+namespace tflite {
+
+// Points at the flatbuffer itself; never constructed, only cast to
+class Model {
+public:
+    uint32_t version() const;
+    const uint8_t* buffer() const { return reinterpret_cast<const uint8_t*>(this); }
+
+    Model() = delete;
+};
+
+inline const Model* GetModel(const void* buf) {
+    return reinterpret_cast<const Model*>(buf);
+}
+
+}  // namespace tflite
+
+#endif // TFLM_HOST_SCHEMA_GENERATED_H
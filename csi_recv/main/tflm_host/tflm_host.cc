@@ -0,0 +1,394 @@
+// Host stand-in for the part of TensorFlow Lite Micro the breathing network uses,
+// so that NeuralNetwork_breathing_rate.cc and nn_breathing_benchmark.cc build and
+// run on a machine without a TFLM checkout: compiled with -Itflm_host, the
+// headers under tflm_host/tensorflow take the place of TFLM's own, unchanged
+// includes and all. It is not TFLM and is not part of the firmware build.
+//
+// It reads the model's flatbuffer and runs chains of FULLY_CONNECTED layers (no,
+// ReLU or ReLU6 activation), float32, or int8 with int32 biases and per-tensor or
+// per-channel weight scales, with the arithmetic of TFLM's reference kernels
+// (the same as csi_nn_quantize.c). A model using any other operator or type fails
+// AllocateTensors(). Its rates therefore match what TFLM computes; its timings
+// and arena_used_bytes() do not describe TFLM's.
+//
+// Activation tensors are placed in the arena one after the other, 16-byte aligned,
+// with no reuse between layers; constant tensors are read from the flatbuffer in
+// place, as TFLM reads them.
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+// TFLite schema values used here
+#define TFL_FLOAT32 0
+#define TFL_INT32 2
+#define TFL_INT8 9
+#define TFL_FULLY_CONNECTED 9
+#define TFL_ACT_NONE 0
+#define TFL_ACT_RELU 1
+#define TFL_ACT_RELU6 3
+#define ARENA_ALIGNMENT 16
+
+void MicroPrintf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    printf("\n");
+}
+
+// === FlatBuffer reading, as in csi_nn_quantize.c ===
+namespace {
+
+uint32_t rd_u32(const uint8_t* fb, size_t at) {
+    uint32_t v;
+    memcpy(&v, fb + at, 4);
+    return v;
+}
+
+size_t deref(const uint8_t* fb, size_t at) {
+    return at + rd_u32(fb, at);
+}
+
+// Position of field n of the table at t, 0 if absent
+size_t field(const uint8_t* fb, size_t t, int n) {
+    int32_t soffset;
+    memcpy(&soffset, fb + t, 4);
+    size_t vtable = t - soffset;
+    uint16_t vtable_size, offset;
+    memcpy(&vtable_size, fb + vtable, 2);
+    if (4 + 2 * n >= vtable_size) return 0;
+    memcpy(&offset, fb + vtable + 4 + 2 * n, 2);
+    return offset ? t + offset : 0;
+}
+
+uint32_t field_u32(const uint8_t* fb, size_t t, int n, uint32_t fallback) {
+    size_t at = field(fb, t, n);
+    return at ? rd_u32(fb, at) : fallback;
+}
+
+uint8_t field_u8(const uint8_t* fb, size_t t, int n, uint8_t fallback) {
+    size_t at = field(fb, t, n);
+    return at ? fb[at] : fallback;
+}
+
+// Table a field refers to, 0 if absent
+size_t field_table(const uint8_t* fb, size_t t, int n) {
+    size_t at = field(fb, t, n);
+    return at ? deref(fb, at) : 0;
+}
+
+// Vector a field refers to: element position and length
+size_t field_vector(const uint8_t* fb, size_t t, int n, uint32_t* length) {
+    size_t at = field(fb, t, n);
+    if (!at) {
+        *length = 0;
+        return 0;
+    }
+    size_t v = deref(fb, at);
+    *length = rd_u32(fb, v);
+    return v + 4;
+}
+
+int32_t vector_i32(const uint8_t* fb, size_t v, uint32_t i) {
+    return (int32_t)rd_u32(fb, v + 4 * i);
+}
+
+size_t vector_table(const uint8_t* fb, size_t v, uint32_t i) {
+    return deref(fb, v + 4 * i);
+}
+
+// Constant data need not be aligned in a flatbuffer built by hand
+float load_f32(const void* data, int i) {
+    float v;
+    memcpy(&v, (const uint8_t*)data + 4 * i, 4);
+    return v;
+}
+
+int32_t load_i32(const void* data, int i) {
+    int32_t v;
+    memcpy(&v, (const uint8_t*)data + 4 * i, 4);
+    return v;
+}
+
+// === TFLM reference quantisation arithmetic (quantization_util.cc, common.h) ===
+void quantize_multiplier(double m, int32_t* multiplier, int* shift) {
+    if (m == 0) {
+        *multiplier = 0;
+        *shift = 0;
+        return;
+    }
+    double q = frexp(m, shift);
+    int64_t q_fixed = (int64_t)llround(q * (1LL << 31));
+    if (q_fixed == (1LL << 31)) {
+        q_fixed /= 2;
+        ++*shift;
+    }
+    if (*shift < -31) {
+        *shift = 0;
+        q_fixed = 0;
+    }
+    *multiplier = (int32_t)q_fixed;
+}
+
+int32_t rounding_doubling_high_mul(int32_t a, int32_t b) {
+    if (a == INT32_MIN && b == INT32_MIN) return INT32_MAX;
+    int64_t ab = (int64_t)a * b;
+    int32_t nudge = ab >= 0 ? (1 << 30) : (1 - (1 << 30));
+    return (int32_t)((ab + nudge) / (1LL << 31));
+}
+
+int32_t rounding_divide_by_pot(int32_t x, int exponent) {
+    int32_t mask = (int32_t)((1LL << exponent) - 1);
+    int32_t remainder = x & mask;
+    int32_t threshold = (mask >> 1) + (x < 0);
+    return (x >> exponent) + (remainder > threshold);
+}
+
+int32_t multiply_by_quantized_multiplier(int32_t x, int32_t multiplier, int shift) {
+    int left = shift > 0 ? shift : 0;
+    int right = shift > 0 ? 0 : -shift;
+    return rounding_divide_by_pot(rounding_doubling_high_mul(x * (1 << left), multiplier), right);
+}
+
+}  // namespace
+
+namespace tflite {
+
+uint32_t Model::version() const {
+    const uint8_t* fb = buffer();
+    return field_u32(fb, deref(fb, 0), 0, 0);
+}
+
+MicroInterpreter::MicroInterpreter(const Model* model, const MicroOpResolver& op_resolver, uint8_t* tensor_arena,
+                                   size_t tensor_arena_size)
+    : model_(model), resolver_(op_resolver), arena_(tensor_arena), arena_size_(tensor_arena_size) {
+    memset(tensors_, 0, sizeof(tensors_));
+    memset(info_, 0, sizeof(info_));
+}
+
+TfLiteStatus MicroInterpreter::Fail(const char* what) {
+    MicroPrintf("tflm_host: %s", what);
+    return kTfLiteError;
+}
+
+TfLiteStatus MicroInterpreter::AllocateTensors() {
+    const uint8_t* fb = model_->buffer();
+    allocated_ = false;
+    arena_used_ = 0;
+    if (memcmp(fb + 4, "TFL3", 4) != 0) return Fail("not a TFLite flatbuffer");
+    size_t root = deref(fb, 0);
+    uint32_t n_codes, n_graphs, n_buffers;
+    size_t codes = field_vector(fb, root, 1, &n_codes);
+    size_t graphs = field_vector(fb, root, 2, &n_graphs);
+    size_t buffers = field_vector(fb, root, 4, &n_buffers);
+    if (n_graphs != 1) return Fail("only models with one subgraph are supported");
+    size_t graph = vector_table(fb, graphs, 0);
+
+    uint32_t n_tensors;
+    size_t tensors = field_vector(fb, graph, 0, &n_tensors);
+    if (n_tensors > (uint32_t)kMaxTensors) return Fail("too many tensors");
+    tensors_count_ = (int)n_tensors;
+    for (uint32_t i = 0; i < n_tensors; i++) {
+        size_t t = vector_table(fb, tensors, i);
+        TfLiteTensor* tensor = &tensors_[i];
+        Tensor* info = &info_[i];
+        memset(tensor, 0, sizeof(*tensor));
+        memset(info, 0, sizeof(*info));
+
+        size_t element;
+        switch (field_u8(fb, t, 1, TFL_FLOAT32)) {
+        case TFL_FLOAT32: tensor->type = kTfLiteFloat32; element = sizeof(float); break;
+        case TFL_INT32: tensor->type = kTfLiteInt32; element = sizeof(int32_t); break;
+        case TFL_INT8: tensor->type = kTfLiteInt8; element = sizeof(int8_t); break;
+        default: return Fail("tensor type other than float32, int32 or int8");
+        }
+        uint32_t dims;
+        size_t shape = field_vector(fb, t, 0, &dims);
+        info->count = 1;
+        for (uint32_t d = 0; d < dims; d++) {
+            int32_t extent = vector_i32(fb, shape, d);
+            if (extent <= 0 || extent > 65536) return Fail("tensor shape");
+            info->count *= extent;
+        }
+        tensor->bytes = info->count * element;
+
+        size_t quantization = field_table(fb, t, 4);
+        if (quantization) {
+            uint32_t n_scales, n_zero_points;
+            size_t scales = field_vector(fb, quantization, 2, &n_scales);
+            size_t zero_points = field_vector(fb, quantization, 3, &n_zero_points);
+            if (n_scales > 0) tensor->params.scale = load_f32(fb + scales, 0);
+            if (n_zero_points > 0) tensor->params.zero_point = load_i32(fb + zero_points, 0);  // int64, low half
+            info->scales = n_scales > 0 ? fb + scales : nullptr;
+            info->scale_count = n_scales;
+        }
+
+        uint32_t buffer = field_u32(fb, t, 2, 0), bytes = 0;
+        if (buffer >= n_buffers) return Fail("tensor buffer out of range");
+        size_t content = field_vector(fb, vector_table(fb, buffers, buffer), 0, &bytes);
+        if (bytes > 0) {
+            if (bytes != tensor->bytes) return Fail("constant tensor size differs from its shape");
+            tensor->data.data = const_cast<uint8_t*>(fb + content);
+            info->constant = true;
+            continue;
+        }
+        size_t at = (arena_used_ + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+        if (at + tensor->bytes > arena_size_) {
+            MicroPrintf("Failed to resize buffer. Requested: %u, available %u, missing: %u",
+                        (unsigned)(at + tensor->bytes), (unsigned)arena_size_,
+                        (unsigned)(at + tensor->bytes - arena_size_));
+            return kTfLiteError;
+        }
+        tensor->data.data = arena_ + at;
+        arena_used_ = at + tensor->bytes;
+    }
+
+    uint32_t n;
+    size_t io = field_vector(fb, graph, 1, &n);
+    if (n == 0 || n > (uint32_t)kMaxIo) return Fail("input count");
+    inputs_count_ = n;
+    for (uint32_t i = 0; i < n; i++) inputs_[i] = vector_i32(fb, io, i);
+    io = field_vector(fb, graph, 2, &n);
+    if (n == 0 || n > (uint32_t)kMaxIo) return Fail("output count");
+    outputs_count_ = n;
+    for (uint32_t i = 0; i < n; i++) outputs_[i] = vector_i32(fb, io, i);
+    for (size_t i = 0; i < inputs_count_; i++) {
+        if (inputs_[i] < 0 || inputs_[i] >= tensors_count_) return Fail("input tensor out of range");
+    }
+    for (size_t i = 0; i < outputs_count_; i++) {
+        if (outputs_[i] < 0 || outputs_[i] >= tensors_count_) return Fail("output tensor out of range");
+    }
+
+    uint32_t n_ops;
+    size_t ops = field_vector(fb, graph, 3, &n_ops);
+    if (n_ops > (uint32_t)kMaxOps) return Fail("too many operators");
+    ops_count_ = (int)n_ops;
+    for (uint32_t i = 0; i < n_ops; i++) {
+        size_t op = vector_table(fb, ops, i);
+        uint32_t code_index = field_u32(fb, op, 0, 0);
+        if (code_index >= n_codes) return Fail("opcode out of range");
+        size_t code = vector_table(fb, codes, code_index);
+        int32_t builtin = (int32_t)field_u32(fb, code, 3, 0);
+        int8_t deprecated = (int8_t)field_u8(fb, code, 0, 0);
+        if (deprecated > builtin) builtin = deprecated;
+        if (!resolver_.HasBuiltin(builtin)) {
+            MicroPrintf("Didn't find op for builtin opcode %d", (int)builtin);
+            return kTfLiteError;
+        }
+        if (builtin != TFL_FULLY_CONNECTED) return Fail("operator other than FULLY_CONNECTED");
+
+        uint32_t n_in, n_out;
+        size_t in = field_vector(fb, op, 1, &n_in);
+        size_t out = field_vector(fb, op, 2, &n_out);
+        if (n_in < 2 || n_in > 3 || n_out != 1) return Fail("FULLY_CONNECTED inputs or outputs");
+        Op* o = &ops_[i];
+        o->input = vector_i32(fb, in, 0);
+        o->weights = vector_i32(fb, in, 1);
+        o->bias = n_in == 3 ? vector_i32(fb, in, 2) : -1;
+        o->output = vector_i32(fb, out, 0);
+        size_t options = field_table(fb, op, 4);
+        o->activation = options ? field_u8(fb, options, 0, TFL_ACT_NONE) : TFL_ACT_NONE;
+        if (options && field_u8(fb, options, 1, 0) != 0) return Fail("shuffled FULLY_CONNECTED weights");
+        if (PrepareFullyConnected(o) != kTfLiteOk) return kTfLiteError;
+    }
+    allocated_ = true;
+    return kTfLiteOk;
+}
+
+// Shapes, types and, for int8, the requantisation of each output channel
+TfLiteStatus MicroInterpreter::PrepareFullyConnected(Op* op) {
+    if (op->input < 0 || op->input >= tensors_count_ || op->weights < 0 || op->weights >= tensors_count_ ||
+        op->output < 0 || op->output >= tensors_count_ || op->bias >= tensors_count_)
+        return Fail("FULLY_CONNECTED tensor out of range");
+    if (op->activation != TFL_ACT_NONE && op->activation != TFL_ACT_RELU && op->activation != TFL_ACT_RELU6)
+        return Fail("activation other than ReLU or ReLU6");
+    const TfLiteTensor* in = &tensors_[op->input];
+    const TfLiteTensor* w = &tensors_[op->weights];
+    const TfLiteTensor* out = &tensors_[op->output];
+    int outs = info_[op->output].count;
+    if (!info_[op->weights].constant || outs <= 0 || outs > kMaxChannels ||
+        info_[op->weights].count != outs * info_[op->input].count ||
+        (op->bias >= 0 && info_[op->bias].count != outs))
+        return Fail("FULLY_CONNECTED shapes");
+
+    if (in->type == kTfLiteFloat32) {
+        if (w->type != kTfLiteFloat32 || out->type != kTfLiteFloat32 ||
+            (op->bias >= 0 && tensors_[op->bias].type != kTfLiteFloat32))
+            return Fail("float FULLY_CONNECTED with other tensor types");
+        return kTfLiteOk;
+    }
+    if (in->type != kTfLiteInt8 || w->type != kTfLiteInt8 || out->type != kTfLiteInt8 ||
+        (op->bias >= 0 && tensors_[op->bias].type != kTfLiteInt32))
+        return Fail("int8 FULLY_CONNECTED needs int8 input, weights, output and int32 bias");
+    if (w->params.zero_point != 0) return Fail("int8 weights with a zero point");
+    if (!(in->params.scale > 0) || !(out->params.scale > 0)) return Fail("int8 tensor without a scale");
+
+    const Tensor* w_info = &info_[op->weights];
+    if (w_info->scale_count != 1 && w_info->scale_count != (uint32_t)outs) return Fail("weight scale count");
+    for (int o = 0; o < outs; o++) {
+        float w_scale = load_f32(w_info->scales, w_info->scale_count == 1 ? 0 : o);
+        quantize_multiplier((double)in->params.scale * w_scale / out->params.scale, &op->multiplier[o], &op->shift[o]);
+    }
+    // CalculateActivationRangeQuantized
+    op->act_min = -128;
+    op->act_max = 127;
+    if (op->activation != TFL_ACT_NONE) {
+        int32_t zero = out->params.zero_point;
+        op->act_min = zero > -128 ? zero : -128;
+        if (op->activation == TFL_ACT_RELU6) {
+            int32_t six = zero + (int32_t)lroundf(6.0f / out->params.scale);
+            op->act_max = six < 127 ? six : 127;
+        }
+    }
+    return kTfLiteOk;
+}
+
+void MicroInterpreter::EvalFloat(const Op& op) {
+    const float* x = tensors_[op.input].data.f;
+    const void* w = tensors_[op.weights].data.data;
+    const void* b = op.bias >= 0 ? tensors_[op.bias].data.data : nullptr;
+    float* y = tensors_[op.output].data.f;
+    int outs = info_[op.output].count, ins = info_[op.input].count;
+    for (int o = 0; o < outs; o++) {
+        float sum = 0;
+        for (int k = 0; k < ins; k++) sum += load_f32(w, o * ins + k) * x[k];
+        if (b) sum += load_f32(b, o);
+        if (op.activation != TFL_ACT_NONE && sum < 0) sum = 0;
+        if (op.activation == TFL_ACT_RELU6 && sum > 6) sum = 6;
+        y[o] = sum;
+    }
+}
+
+void MicroInterpreter::EvalInt8(const Op& op) {
+    const int8_t* x = tensors_[op.input].data.int8;
+    const int8_t* w = tensors_[op.weights].data.int8;
+    const void* b = op.bias >= 0 ? tensors_[op.bias].data.data : nullptr;
+    int8_t* y = tensors_[op.output].data.int8;
+    int32_t input_offset = -tensors_[op.input].params.zero_point;
+    int32_t output_offset = tensors_[op.output].params.zero_point;
+    int outs = info_[op.output].count, ins = info_[op.input].count;
+    for (int o = 0; o < outs; o++) {
+        int32_t acc = 0;
+        for (int k = 0; k < ins; k++) acc += w[o * ins + k] * (x[k] + input_offset);
+        if (b) acc += load_i32(b, o);
+        acc = multiply_by_quantized_multiplier(acc, op.multiplier[o], op.shift[o]) + output_offset;
+        y[o] = (int8_t)(acc < op.act_min ? op.act_min : acc > op.act_max ? op.act_max : acc);
+    }
+}
+
+TfLiteStatus MicroInterpreter::Invoke() {
+    if (!allocated_) return Fail("Invoke() before AllocateTensors()");
+    for (int i = 0; i < ops_count_; i++) {
+        if (tensors_[ops_[i].input].type == kTfLiteFloat32)
+            EvalFloat(ops_[i]);
+        else
+            EvalInt8(ops_[i]);
+    }
+    return kTfLiteOk;
+}
+
+}  // namespace tflite